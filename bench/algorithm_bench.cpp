@@ -0,0 +1,240 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "algo/algorithm.h"
+#include "bench_util.h"
+
+namespace {
+
+// 两组算法用同样的接口包一层，数据都放在std::vector里，只比较算法本身
+template <class T>
+struct nostd_ops {
+    using value_type = T;
+    using iter = typename std::vector<T>::iterator;
+
+    static iter find(iter first, iter last, const T &v) { return nostd::find(first, last, v); }
+    template <class Pred>
+    static bool all_of(iter first, iter last, Pred pred) {
+        return nostd::all_of(first, last, pred);
+    }
+    template <class Op>
+    static iter transform(iter first, iter last, iter out, Op op) {
+        return nostd::transform(first, last, out, op);
+    }
+    static iter remove(iter first, iter last, const T &v) { return nostd::remove(first, last, v); }
+    static iter unique(iter first, iter last) { return nostd::unique(first, last); }
+    static void replace(iter first, iter last, const T &a, const T &b) { nostd::replace(first, last, a, b); }
+    static iter min_element(iter first, iter last) { return nostd::min_element(first, last); }
+    static iter max_element(iter first, iter last) { return nostd::max_element(first, last); }
+    static void make_heap(iter first, iter last) { nostd::make_heap(first, last); }
+    static void sort_heap(iter first, iter last) { nostd::sort_heap(first, last); }
+    static iter merge(iter f1, iter l1, iter f2, iter l2, iter out) { return nostd::merge(f1, l1, f2, l2, out); }
+    static iter upper_bound(iter first, iter last, const T &v) { return nostd::upper_bound(first, last, v); }
+    static bool lexicographical_compare(iter f1, iter l1, iter f2, iter l2) {
+        return nostd::lexicographical_compare(f1, l1, f2, l2);
+    }
+};
+
+template <class T>
+struct std_ops {
+    using value_type = T;
+    using iter = typename std::vector<T>::iterator;
+
+    static iter find(iter first, iter last, const T &v) { return std::find(first, last, v); }
+    template <class Pred>
+    static bool all_of(iter first, iter last, Pred pred) {
+        return std::all_of(first, last, pred);
+    }
+    template <class Op>
+    static iter transform(iter first, iter last, iter out, Op op) {
+        return std::transform(first, last, out, op);
+    }
+    static iter remove(iter first, iter last, const T &v) { return std::remove(first, last, v); }
+    static iter unique(iter first, iter last) { return std::unique(first, last); }
+    static void replace(iter first, iter last, const T &a, const T &b) { std::replace(first, last, a, b); }
+    static iter min_element(iter first, iter last) { return std::min_element(first, last); }
+    static iter max_element(iter first, iter last) { return std::max_element(first, last); }
+    static void make_heap(iter first, iter last) { std::make_heap(first, last); }
+    static void sort_heap(iter first, iter last) { std::sort_heap(first, last); }
+    static iter merge(iter f1, iter l1, iter f2, iter l2, iter out) { return std::merge(f1, l1, f2, l2, out); }
+    static iter upper_bound(iter first, iter last, const T &v) { return std::upper_bound(first, last, v); }
+    static bool lexicographical_compare(iter f1, iter l1, iter f2, iter l2) {
+        return std::lexicographical_compare(f1, l1, f2, l2);
+    }
+};
+
+// 查找一个不存在的值，遍历整个区间
+template <class Ops>
+void BM_Algo_Find(benchmark::State &state) {
+    using T = typename Ops::value_type;
+    std::vector<T> v = bench::random_values<T>(state.range(0));
+    const T missing = bench::random_values<T>(1, 7)[0];
+    v.erase(std::remove(v.begin(), v.end(), missing), v.end());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ops::find(v.begin(), v.end(), missing));
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+template <class Ops>
+void BM_Algo_AllOf(benchmark::State &state) {
+    using T = typename Ops::value_type;
+    std::vector<T> v = bench::random_values<T>(state.range(0));
+    const T first = v[0];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ops::all_of(v.begin(), v.end(), [&first](const T &x) { return !(x < first) || x < first; }));
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+template <class Ops>
+void BM_Algo_Transform(benchmark::State &state) {
+    using T = typename Ops::value_type;
+    std::vector<T> v = bench::random_values<T>(state.range(0));
+    std::vector<T> out(v.size());
+    for (auto _ : state) {
+        Ops::transform(v.begin(), v.end(), out.begin(), [](const T &x) { return x + x; });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+// 每轮都从同一份数据出发，拷贝不计时
+template <class Ops>
+void BM_Algo_Remove(benchmark::State &state) {
+    using T = typename Ops::value_type;
+    const std::vector<T> src = bench::random_values<T>(state.range(0));
+    std::vector<T> v;
+    for (auto _ : state) {
+        state.PauseTiming();
+        v = src;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(Ops::remove(v.begin(), v.end(), src[src.size() / 2]));
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+// 一半的元素与前一个重复
+template <class Ops>
+void BM_Algo_Unique(benchmark::State &state) {
+    using T = typename Ops::value_type;
+    std::vector<T> src = bench::random_values<T>(state.range(0));
+    for (size_t i = 1; i < src.size(); i += 2) {
+        src[i] = src[i - 1];
+    }
+    std::vector<T> v;
+    for (auto _ : state) {
+        state.PauseTiming();
+        v = src;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(Ops::unique(v.begin(), v.end()));
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+template <class Ops>
+void BM_Algo_Replace(benchmark::State &state) {
+    using T = typename Ops::value_type;
+    std::vector<T> v = bench::random_values<T>(state.range(0));
+    const T a = v[0], b = v[v.size() / 2];
+    for (auto _ : state) {
+        Ops::replace(v.begin(), v.end(), a, b);
+        Ops::replace(v.begin(), v.end(), b, a);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * v.size() * 2);
+}
+
+template <class Ops>
+void BM_Algo_MinMaxElement(benchmark::State &state) {
+    using T = typename Ops::value_type;
+    std::vector<T> v = bench::random_values<T>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ops::min_element(v.begin(), v.end()));
+        benchmark::DoNotOptimize(Ops::max_element(v.begin(), v.end()));
+    }
+    state.SetItemsProcessed(state.iterations() * v.size() * 2);
+}
+
+template <class Ops>
+void BM_Algo_HeapSort(benchmark::State &state) {
+    using T = typename Ops::value_type;
+    const std::vector<T> src = bench::random_values<T>(state.range(0));
+    std::vector<T> v;
+    for (auto _ : state) {
+        state.PauseTiming();
+        v = src;
+        state.ResumeTiming();
+        Ops::make_heap(v.begin(), v.end());
+        Ops::sort_heap(v.begin(), v.end());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+template <class Ops>
+void BM_Algo_Merge(benchmark::State &state) {
+    using T = typename Ops::value_type;
+    std::vector<T> a = bench::random_values<T>(state.range(0), 1);
+    std::vector<T> b = bench::random_values<T>(state.range(0), 2);
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    std::vector<T> out(a.size() + b.size());
+    for (auto _ : state) {
+        Ops::merge(a.begin(), a.end(), b.begin(), b.end(), out.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+template <class Ops>
+void BM_Algo_UpperBound(benchmark::State &state) {
+    using T = typename Ops::value_type;
+    std::vector<T> v = bench::random_values<T>(state.range(0), 1);
+    std::sort(v.begin(), v.end());
+    std::vector<T> keys = bench::random_values<T>(1024, 2);
+    for (auto _ : state) {
+        for (const T &k : keys) {
+            benchmark::DoNotOptimize(Ops::upper_bound(v.begin(), v.end(), k));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <class Ops>
+void BM_Algo_LexicographicalCompare(benchmark::State &state) {
+    using T = typename Ops::value_type;
+    std::vector<T> a = bench::random_values<T>(state.range(0));
+    std::vector<T> b(a);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ops::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+}  // namespace
+
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Find, nostd_ops<int>, std_ops<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Find, nostd_ops<double>, std_ops<double>, "double", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Find, nostd_ops<std::string>, std_ops<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_AllOf, nostd_ops<int>, std_ops<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Transform, nostd_ops<int>, std_ops<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Transform, nostd_ops<double>, std_ops<double>, "double", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Remove, nostd_ops<int>, std_ops<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Remove, nostd_ops<std::string>, std_ops<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Unique, nostd_ops<int>, std_ops<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Unique, nostd_ops<std::string>, std_ops<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Replace, nostd_ops<int>, std_ops<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_MinMaxElement, nostd_ops<int>, std_ops<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_MinMaxElement, nostd_ops<double>, std_ops<double>, "double", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_HeapSort, nostd_ops<int>, std_ops<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_HeapSort, nostd_ops<std::string>, std_ops<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Merge, nostd_ops<int>, std_ops<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_Merge, nostd_ops<std::string>, std_ops<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_UpperBound, nostd_ops<int>, std_ops<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_UpperBound, nostd_ops<std::string>, std_ops<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_LexicographicalCompare, nostd_ops<int>, std_ops<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Algo_LexicographicalCompare, nostd_ops<double>, std_ops<double>, "double", bench::size_args);
@@ -0,0 +1,65 @@
+/*
+ * 基准测试的公共工具
+ *
+ * 命名约定：同一个操作的nostd实现和std对照组分别以_Nostd/_Std结尾，
+ * 其余部分(含模板参数和range参数)完全相同，bench/compare.py据此把两者配对
+ */
+#ifndef __BENCH_UTIL_H
+#define __BENCH_UTIL_H
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// 用同一个模板函数分别实例化nostd和std的类型，注册为func_Nostd<label>和func_Std<label>，
+// apply负责设置range参数
+#define EASYSTL_BENCHMARK_PAIR(func, nostd_type, std_type, label, apply)            \
+    BENCHMARK_TEMPLATE(func, nostd_type)->Name(#func "_Nostd<" label ">")->Apply(apply); \
+    BENCHMARK_TEMPLATE(func, std_type)->Name(#func "_Std<" label ">")->Apply(apply)
+
+namespace bench {
+
+// 容器规模：小(放得进L1)、中(L2)、大(超出LLC)
+inline void size_args(benchmark::internal::Benchmark *b) {
+    b->Arg(64)->Arg(4096)->Arg(1 << 18);
+}
+
+// 随机值：整数和浮点数均匀分布，字符串长度8~24(有一部分超过SSO的长度)
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, T>::type random_value(std::mt19937_64 &rng) {
+    return static_cast<T>(rng());
+}
+
+template <class T>
+typename std::enable_if<std::is_floating_point<T>::value, T>::type random_value(std::mt19937_64 &rng) {
+    return static_cast<T>(static_cast<double>(rng() >> 11) / static_cast<double>(uint64_t(1) << 53));
+}
+
+template <class T>
+typename std::enable_if<std::is_same<T, std::string>::value, T>::type random_value(std::mt19937_64 &rng) {
+    std::string s(8 + rng() % 17, ' ');
+    for (char &c : s) {
+        c = static_cast<char>('a' + rng() % 26);
+    }
+    return s;
+}
+
+template <class T>
+std::vector<T> random_values(size_t n, uint64_t seed = 42) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        v.push_back(random_value<T>(rng));
+    }
+    return v;
+}
+
+}  // namespace bench
+
+#endif  // !__BENCH_UTIL_H
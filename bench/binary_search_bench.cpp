@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+
+#include "algo/algorithm.h"
+#include "container/eytzinger_index.h"
+#include "container/vector.h"
+
+namespace {
+
+// 1B个uint32_t的有序表加上Eytzinger布局需要8GB内存，默认只跑到128M
+// 机器内存足够时用环境变量EASYSTL_BENCH_MAX_N放开
+size_t max_table_size() {
+    const char *env = std::getenv("EASYSTL_BENCH_MAX_N");
+    return env != nullptr ? static_cast<size_t>(std::strtoull(env, nullptr, 10)) : (size_t(1) << 27);
+}
+
+// 有序表的元素是0,2,4...，查询的key一半命中一半不命中
+nostd::vector<uint32_t> make_table(size_t n) {
+    nostd::vector<uint32_t> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        v.push_back(static_cast<uint32_t>(2 * i));
+    }
+    return v;
+}
+
+nostd::vector<uint32_t> make_keys(size_t n) {
+    std::mt19937_64 rng(2024);
+    nostd::vector<uint32_t> keys;
+    keys.reserve(1 << 16);
+    for (size_t i = 0; i < (1 << 16); ++i) {
+        keys.push_back(static_cast<uint32_t>(rng() % (2 * n)));
+    }
+    return keys;
+}
+
+void BM_LowerBound_Std(benchmark::State &state) {
+    const size_t n = state.range(0);
+    if (n > max_table_size()) {
+        state.SkipWithError("table larger than EASYSTL_BENCH_MAX_N");
+        return;
+    }
+    nostd::vector<uint32_t> table = make_table(n);
+    nostd::vector<uint32_t> keys = make_keys(n);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::lower_bound(table.begin(), table.end(), keys[i++ & 0xffff]));
+    }
+}
+
+void BM_LowerBound_Nostd(benchmark::State &state) {
+    const size_t n = state.range(0);
+    if (n > max_table_size()) {
+        state.SkipWithError("table larger than EASYSTL_BENCH_MAX_N");
+        return;
+    }
+    nostd::vector<uint32_t> table = make_table(n);
+    nostd::vector<uint32_t> keys = make_keys(n);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nostd::lower_bound(table.begin(), table.end(), keys[i++ & 0xffff]));
+    }
+}
+
+void BM_LowerBound_Eytzinger(benchmark::State &state) {
+    const size_t n = state.range(0);
+    if (n > max_table_size()) {
+        state.SkipWithError("table larger than EASYSTL_BENCH_MAX_N");
+        return;
+    }
+    nostd::eytzinger_index<uint32_t> idx(make_table(n));
+    nostd::vector<uint32_t> keys = make_keys(n);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(idx.lower_bound(keys[i++ & 0xffff]));
+    }
+}
+
+}  // namespace
+
+// 1K ~ 1B
+BENCHMARK(BM_LowerBound_Std)->RangeMultiplier(32)->Range(1 << 10, 1 << 30);
+BENCHMARK(BM_LowerBound_Nostd)->RangeMultiplier(32)->Range(1 << 10, 1 << 30);
+BENCHMARK(BM_LowerBound_Eytzinger)->RangeMultiplier(32)->Range(1 << 10, 1 << 30);
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <bitset>
+#include <cstdint>
+#include <random>
+
+#include "bench_util.h"
+#include "container/bitset.h"
+
+namespace {
+
+void no_args(benchmark::internal::Benchmark *) {}
+
+template <class B>
+void fill_random(B &b, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    for (size_t i = 0; i < b.size(); ++i) {
+        if (rng() & 1) {
+            b.set(i);
+        }
+    }
+}
+
+template <class B>
+void BM_Bitset_SetTest(benchmark::State &state) {
+    B b;
+    std::mt19937_64 rng(1);
+    uint32_t pos[1024];
+    for (uint32_t &p : pos) {
+        p = static_cast<uint32_t>(rng() % b.size());
+    }
+    for (auto _ : state) {
+        size_t hits = 0;
+        for (uint32_t p : pos) {
+            b.set(p, !b[p]);
+            hits += b[p] ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+template <class B>
+void BM_Bitset_Count(benchmark::State &state) {
+    B b;
+    fill_random(b, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(b.count());
+    }
+    state.SetBytesProcessed(state.iterations() * (b.size() / 8));
+}
+
+template <class B>
+void BM_Bitset_Shift(benchmark::State &state) {
+    B b;
+    fill_random(b, 1);
+    for (auto _ : state) {
+        b <<= 13;
+        b >>= 7;
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * (b.size() / 8) * 2);
+}
+
+template <class B>
+void BM_Bitset_BitwiseOps(benchmark::State &state) {
+    B a, b, c;
+    fill_random(a, 1);
+    fill_random(b, 2);
+    fill_random(c, 3);
+    for (auto _ : state) {
+        a &= b;
+        a |= c;
+        a ^= b;
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * (a.size() / 8) * 3);
+}
+
+}  // namespace
+
+EASYSTL_BENCHMARK_PAIR(BM_Bitset_SetTest, nostd::bitset<256>, std::bitset<256>, "256", no_args);
+EASYSTL_BENCHMARK_PAIR(BM_Bitset_SetTest, nostd::bitset<65536>, std::bitset<65536>, "65536", no_args);
+EASYSTL_BENCHMARK_PAIR(BM_Bitset_Count, nostd::bitset<256>, std::bitset<256>, "256", no_args);
+EASYSTL_BENCHMARK_PAIR(BM_Bitset_Count, nostd::bitset<4096>, std::bitset<4096>, "4096", no_args);
+EASYSTL_BENCHMARK_PAIR(BM_Bitset_Count, nostd::bitset<65536>, std::bitset<65536>, "65536", no_args);
+EASYSTL_BENCHMARK_PAIR(BM_Bitset_Shift, nostd::bitset<256>, std::bitset<256>, "256", no_args);
+EASYSTL_BENCHMARK_PAIR(BM_Bitset_Shift, nostd::bitset<65536>, std::bitset<65536>, "65536", no_args);
+EASYSTL_BENCHMARK_PAIR(BM_Bitset_BitwiseOps, nostd::bitset<256>, std::bitset<256>, "256", no_args);
+EASYSTL_BENCHMARK_PAIR(BM_Bitset_BitwiseOps, nostd::bitset<4096>, std::bitset<4096>, "4096", no_args);
+EASYSTL_BENCHMARK_PAIR(BM_Bitset_BitwiseOps, nostd::bitset<65536>, std::bitset<65536>, "65536", no_args);
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""比较google benchmark的JSON结果(--benchmark_out_format=json)。
+
+  compare.py current.json
+      同一次运行内，把xxx_Nostd<...>和对应的xxx_Std<...>配对，列出nostd/std的耗时比，只做参考，退出码总是0
+  compare.py baseline.json current.json
+      和基线逐项比较，耗时增加超过阈值的记为退化
+
+只有和基线比较出现退化时退出码为1，可以直接用在CI里。
+带--benchmark_repetitions运行时取中位数。
+"""
+
+import argparse
+import json
+import re
+import sys
+
+
+def load(path, metric):
+    """返回 {基准名: 耗时(ns)}"""
+    with open(path) as f:
+        data = json.load(f)
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    runs, medians = {}, {}
+    for b in data.get("benchmarks", []):
+        if b.get("error_occurred"):
+            continue
+        value = b[metric] * scale[b.get("time_unit", "ns")]
+        name = b.get("run_name", b["name"])
+        if b.get("run_type") == "aggregate":
+            if b.get("aggregate_name") == "median":
+                medians[name] = value
+        else:
+            runs.setdefault(name, []).append(value)
+    result = {name: sorted(v)[len(v) // 2] for name, v in runs.items()}
+    result.update(medians)
+    return result
+
+
+def fmt_time(ns):
+    for unit, div in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= div:
+            return "%.3g %s" % (ns / div, unit)
+    return "%.3g ns" % ns
+
+
+def report(rows, header, threshold):
+    """rows: [(名字, 旧值, 新值)]，比值超过1+threshold的行标记出来，返回标记的个数"""
+    width = max([len(header[0])] + [len(r[0]) for r in rows])
+    print("%-*s  %12s  %12s  %8s" % (width, header[0], header[1], header[2], "ratio"))
+    flagged = 0
+    for name, old, new in rows:
+        ratio = new / old if old > 0 else float("inf")
+        mark = ""
+        if ratio > 1 + threshold:
+            mark = "  <-- slower"
+            flagged += 1
+        print("%-*s  %12s  %12s  %8.3f%s" % (width, name, fmt_time(old), fmt_time(new), ratio, mark))
+    return flagged
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="+", metavar="json", help="current.json 或 baseline.json current.json")
+    parser.add_argument("--threshold", type=float, default=0.10, help="允许的变慢比例，默认0.10(10%%)")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"), default="cpu_time")
+    parser.add_argument("--filter", default="", help="只比较名字匹配该正则的基准")
+    args = parser.parse_args()
+    if len(args.files) > 2:
+        parser.error("at most two json files")
+
+    pattern = re.compile(args.filter)
+    current = load(args.files[-1], args.metric)
+    current = {k: v for k, v in current.items() if pattern.search(k)}
+
+    if len(args.files) == 1:
+        rows = []
+        for name in sorted(current):
+            if "_Nostd" in name:
+                std_name = name.replace("_Nostd", "_Std", 1)
+                if std_name in current:
+                    rows.append((name, current[std_name], current[name]))
+        if not rows:
+            print("no _Nostd/_Std pairs found")
+            return 0
+        flagged = report(rows, ("benchmark", "std", "nostd"), args.threshold)
+        print("\n%d of %d nostd benchmarks are more than %.0f%% slower than std (informational, "
+              "pass a baseline json to check for regressions)" % (flagged, len(rows), args.threshold * 100))
+        return 0
+
+    baseline = load(args.files[0], args.metric)
+    rows = [(name, baseline[name], current[name]) for name in sorted(current) if name in baseline]
+    missing = sorted(name for name in baseline if name not in current and pattern.search(name))
+    flagged = report(rows, ("benchmark", "baseline", "current"), args.threshold)
+    for name in missing:
+        print("missing in current: %s" % name)
+    print("\n%d of %d benchmarks regressed by more than %.0f%%" % (flagged, len(rows), args.threshold * 100))
+    return 1 if flagged else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
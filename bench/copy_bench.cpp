@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "algo/algorithm.h"
+#include "container/vector.h"
+
+namespace {
+
+// range(0): 字节数
+void BM_Copy_Memcpy(benchmark::State &state) {
+    const size_t n = state.range(0);
+    nostd::vector<char> src(n, 'a');
+    nostd::vector<char> dst(n, 'b');
+    for (auto _ : state) {
+        std::memcpy(dst.begin(), src.begin(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+void BM_Copy_Nostd(benchmark::State &state) {
+    const size_t n = state.range(0) / sizeof(uint64_t);
+    nostd::vector<uint64_t> src(n, 1);
+    nostd::vector<uint64_t> dst(n, 2);
+    for (auto _ : state) {
+        nostd::copy(src.begin(), src.end(), dst.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(uint64_t));
+}
+
+void BM_Fill_Nostd(benchmark::State &state) {
+    const size_t n = state.range(0) / sizeof(uint32_t);
+    nostd::vector<uint32_t> dst(n, 2);
+    uint32_t value = 0;
+    for (auto _ : state) {
+        nostd::fill(dst.begin(), dst.end(), value);
+        benchmark::ClobberMemory();
+        value ^= 0x01010101;
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(uint32_t));
+}
+
+void BM_Equal_Nostd(benchmark::State &state) {
+    const size_t n = state.range(0) / sizeof(uint32_t);
+    nostd::vector<uint32_t> a(n, 7);
+    nostd::vector<uint32_t> b(n, 7);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nostd::equal(a.begin(), a.end(), b.begin()));
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(uint32_t));
+}
+
+}  // namespace
+
+BENCHMARK(BM_Copy_Memcpy)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_Copy_Nostd)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_Fill_Nostd)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_Equal_Nostd)->Range(1 << 10, 1 << 24);
@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+
+#include "container/format.h"
+
+namespace {
+
+void BM_Format_Mixed(benchmark::State &state) {
+    nostd::string out;
+    for (auto _ : state) {
+        out.clear();
+        nostd::format_to(out, "id={} name={} score={:.2f} ratio={}", 123456, "easystl", 98.765, 0.125);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_Snprintf_Mixed(benchmark::State &state) {
+    char buf[128];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::snprintf(buf, sizeof(buf), "id=%d name=%s score=%.2f ratio=%g", 123456, "easystl",
+                                               98.765, 0.125));
+    }
+}
+
+void BM_Builder_Integers(benchmark::State &state) {
+    nostd::string_builder b(1 << 16);
+    for (auto _ : state) {
+        b.clear();
+        for (int i = 0; i < 1000; ++i) {
+            b << i * 7919 << ',';
+        }
+        benchmark::DoNotOptimize(b.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+void BM_Snprintf_Integers(benchmark::State &state) {
+    static char buf[1 << 16];
+    for (auto _ : state) {
+        size_t n = 0;
+        for (int i = 0; i < 1000; ++i) {
+            n += static_cast<size_t>(std::snprintf(buf + n, sizeof(buf) - n, "%d,", i * 7919));
+        }
+        benchmark::DoNotOptimize(buf);
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+}  // namespace
+
+BENCHMARK(BM_Format_Mixed);
+BENCHMARK(BM_Snprintf_Mixed);
+BENCHMARK(BM_Builder_Integers);
+BENCHMARK(BM_Snprintf_Integers);
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "container/mmap_vector.h"
+
+namespace {
+
+// range(0)个uint64_t写进临时文件，析构时删除
+struct temp_data_file {
+    std::string path;
+    explicit temp_data_file(size_t n) {
+        char buf[] = "/tmp/easystl_bench_XXXXXX";
+        int fd = ::mkstemp(buf);
+        ::close(fd);
+        path = buf;
+        std::vector<uint64_t> data = bench::random_values<uint64_t>(n);
+        FILE *f = std::fopen(path.c_str(), "wb");
+        std::fwrite(data.data(), sizeof(uint64_t), data.size(), f);
+        std::fclose(f);
+    }
+    ~temp_data_file() { std::remove(path.c_str()); }
+};
+
+// std的对照组：fread整个文件到std::vector
+void load(nostd::mmap_vector<uint64_t> &v, const std::string &path) { v.open(path.c_str()); }
+void load(std::vector<uint64_t> &v, const std::string &path) {
+    FILE *f = std::fopen(path.c_str(), "rb");
+    std::fseek(f, 0, SEEK_END);
+    v.resize(static_cast<size_t>(std::ftell(f)) / sizeof(uint64_t));
+    std::fseek(f, 0, SEEK_SET);
+    size_t n = std::fread(v.data(), sizeof(uint64_t), v.size(), f);
+    std::fclose(f);
+    v.resize(n);
+}
+
+// 打开文件并顺序读完全部元素
+template <class V>
+void BM_MmapVector_LoadSum(benchmark::State &state) {
+    temp_data_file file(state.range(0));
+    for (auto _ : state) {
+        V v;
+        load(v, file.path);
+        uint64_t sum = 0;
+        for (uint64_t x : v) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(uint64_t));
+}
+
+}  // namespace
+
+EASYSTL_BENCHMARK_PAIR(BM_MmapVector_LoadSum, nostd::mmap_vector<uint64_t>, std::vector<uint64_t>, "uint64_t", bench::size_args);
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "algo/algorithm.h"
+#include "base/ranges.h"
+#include "bench_util.h"
+
+namespace {
+
+struct is_valid {
+    bool operator()(int64_t x) const { return (x & 3) != 0; }
+};
+
+struct scale {
+    int64_t operator()(int64_t x) const { return (x >> 8) * 3 + 1; }
+};
+
+// 过滤、变换、再过滤，最后求和；对照组每一步都生成一个临时vector
+void BM_Pipeline_Views(benchmark::State &state) {
+    const std::vector<int64_t> in = bench::random_values<int64_t>(state.range(0));
+    for (auto _ : state) {
+        auto r = in | nostd::views::filter(is_valid()) | nostd::views::transform(scale()) |
+                 nostd::views::filter(is_valid());
+        int64_t sum = 0;
+        for (int64_t x : r) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * in.size());
+}
+
+void BM_Pipeline_Materialized(benchmark::State &state) {
+    const std::vector<int64_t> in = bench::random_values<int64_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<int64_t> valid, scaled, out;
+        nostd::copy_if(in.begin(), in.end(), std::back_inserter(valid), is_valid());
+        scaled.resize(valid.size());
+        nostd::transform(valid.begin(), valid.end(), scaled.begin(), scale());
+        nostd::copy_if(scaled.begin(), scaled.end(), std::back_inserter(out), is_valid());
+        int64_t sum = 0;
+        for (int64_t x : out) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * in.size());
+}
+
+}  // namespace
+
+BENCHMARK(BM_Pipeline_Views)->Apply(bench::size_args);
+BENCHMARK(BM_Pipeline_Materialized)->Apply(bench::size_args);
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <set>
+#include <vector>
+
+#include "bench_util.h"
+#include "container/roaring_bitmap.h"
+
+namespace {
+
+// std的对照组是std::set<uint32_t>，两者用同样的三个操作包一层
+void add(nostd::roaring_bitmap &s, uint32_t v) { s.add(v); }
+void add(std::set<uint32_t> &s, uint32_t v) { s.insert(v); }
+bool contains(const nostd::roaring_bitmap &s, uint32_t v) { return s.contains(v); }
+bool contains(const std::set<uint32_t> &s, uint32_t v) { return s.count(v) != 0; }
+
+uint64_t intersect_size(const nostd::roaring_bitmap &a, const nostd::roaring_bitmap &b) { return (a & b).cardinality(); }
+uint64_t intersect_size(const std::set<uint32_t> &a, const std::set<uint32_t> &b) {
+    std::vector<uint32_t> out;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    return out.size();
+}
+
+// range(0)个id，均匀分布在[0, 2^24)
+std::vector<uint32_t> random_ids(size_t n, uint64_t seed) {
+    std::vector<uint32_t> ids = bench::random_values<uint32_t>(n, seed);
+    for (uint32_t &id : ids) {
+        id &= (1u << 24) - 1;
+    }
+    return ids;
+}
+
+template <class S>
+void BM_Roaring_Add(benchmark::State &state) {
+    const std::vector<uint32_t> ids = random_ids(state.range(0), 1);
+    for (auto _ : state) {
+        S s;
+        for (uint32_t id : ids) {
+            add(s, id);
+        }
+        benchmark::DoNotOptimize(&s);
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+
+template <class S>
+void BM_Roaring_Contains(benchmark::State &state) {
+    S s;
+    for (uint32_t id : random_ids(state.range(0), 1)) {
+        add(s, id);
+    }
+    const std::vector<uint32_t> keys = random_ids(1024, 2);
+    for (auto _ : state) {
+        size_t hits = 0;
+        for (uint32_t k : keys) {
+            hits += contains(s, k) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <class S>
+void BM_Roaring_Intersect(benchmark::State &state) {
+    S a, b;
+    for (uint32_t id : random_ids(state.range(0), 1)) {
+        add(a, id);
+    }
+    for (uint32_t id : random_ids(state.range(0), 2)) {
+        add(b, id);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(intersect_size(a, b));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+
+}  // namespace
+
+EASYSTL_BENCHMARK_PAIR(BM_Roaring_Add, nostd::roaring_bitmap, std::set<uint32_t>, "uint32_t", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Roaring_Contains, nostd::roaring_bitmap, std::set<uint32_t>, "uint32_t", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Roaring_Intersect, nostd::roaring_bitmap, std::set<uint32_t>, "uint32_t", bench::size_args);
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "bench_util.h"
+#include "container/rope.h"
+
+namespace {
+
+// 每次在随机位置插入16个字符，直到长度达到range(0)
+template <class R>
+void BM_Rope_RandomInsert(benchmark::State &state) {
+    const size_t n = state.range(0);
+    for (auto _ : state) {
+        std::mt19937_64 rng(1);
+        R r;
+        while (r.size() < n) {
+            r.insert(rng() % (r.size() + 1), "0123456789abcdef");
+        }
+        benchmark::DoNotOptimize(&r);
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+template <class R>
+void BM_Rope_Append(benchmark::State &state) {
+    const size_t n = state.range(0);
+    for (auto _ : state) {
+        R r;
+        while (r.size() < n) {
+            r.append("0123456789abcdef", 16);
+        }
+        benchmark::DoNotOptimize(&r);
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 取中间一半，再随机读若干字符
+template <class R>
+void BM_Rope_SubstrAccess(benchmark::State &state) {
+    const size_t n = state.range(0);
+    R r;
+    while (r.size() < n) {
+        r.append("0123456789abcdef", 16);
+    }
+    std::mt19937_64 rng(2);
+    for (auto _ : state) {
+        R sub = r.substr(n / 4, n / 2);
+        unsigned sum = 0;
+        for (int i = 0; i < 64; ++i) {
+            sum += static_cast<unsigned char>(sub[rng() % sub.size()]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+}  // namespace
+
+EASYSTL_BENCHMARK_PAIR(BM_Rope_RandomInsert, nostd::rope, std::string, "char", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Rope_Append, nostd::rope, std::string, "char", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Rope_SubstrAccess, nostd::rope, std::string, "char", bench::size_args);
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "algo/algorithm.h"
+
+namespace {
+
+// 模拟倒排索引的posting list: 严格递增, 平均间隔为gap
+template <typename T>
+std::vector<T> make_posting(size_t n, uint64_t gap, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> v(n);
+    uint64_t cur = 0;
+    for (size_t i = 0; i < n; ++i) {
+        cur += 1 + rng() % (2 * gap);
+        v[i] = static_cast<T>(cur);
+    }
+    return v;
+}
+
+// range(0): 长列表长度, range(1): 短列表是长列表的1/range(1)
+template <typename T>
+void BM_Intersect_Std(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const size_t ratio = state.range(1);
+    std::vector<T> a = make_posting<T>(n / ratio, 4 * ratio, 1);
+    std::vector<T> b = make_posting<T>(n, 4, 2);
+    std::vector<T> out(a.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), out.begin()));
+    }
+    state.SetItemsProcessed(state.iterations() * (a.size() + b.size()));
+}
+
+template <typename T>
+void BM_Intersect_Nostd(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const size_t ratio = state.range(1);
+    std::vector<T> a = make_posting<T>(n / ratio, 4 * ratio, 1);
+    std::vector<T> b = make_posting<T>(n, 4, 2);
+    std::vector<T> out(a.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            nostd::set_intersection(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), out.data()));
+    }
+    state.SetItemsProcessed(state.iterations() * (a.size() + b.size()));
+}
+
+template <typename T>
+void BM_Union_Std(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const size_t ratio = state.range(1);
+    std::vector<T> a = make_posting<T>(n / ratio, 4 * ratio, 1);
+    std::vector<T> b = make_posting<T>(n, 4, 2);
+    std::vector<T> out(a.size() + b.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::set_union(a.begin(), a.end(), b.begin(), b.end(), out.begin()));
+    }
+    state.SetItemsProcessed(state.iterations() * (a.size() + b.size()));
+}
+
+template <typename T>
+void BM_Union_Nostd(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const size_t ratio = state.range(1);
+    std::vector<T> a = make_posting<T>(n / ratio, 4 * ratio, 1);
+    std::vector<T> b = make_posting<T>(n, 4, 2);
+    std::vector<T> out(a.size() + b.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            nostd::set_union(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), out.data()));
+    }
+    state.SetItemsProcessed(state.iterations() * (a.size() + b.size()));
+}
+
+void SetOpsArgs(benchmark::internal::Benchmark *b) {
+    for (int ratio : {1, 4, 64, 1024}) {
+        b->Args({1 << 20, ratio});
+    }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Intersect_Std, uint32_t)->Apply(SetOpsArgs);
+BENCHMARK_TEMPLATE(BM_Intersect_Nostd, uint32_t)->Apply(SetOpsArgs);
+BENCHMARK_TEMPLATE(BM_Intersect_Std, uint64_t)->Apply(SetOpsArgs);
+BENCHMARK_TEMPLATE(BM_Intersect_Nostd, uint64_t)->Apply(SetOpsArgs);
+BENCHMARK_TEMPLATE(BM_Union_Std, uint32_t)->Apply(SetOpsArgs);
+BENCHMARK_TEMPLATE(BM_Union_Nostd, uint32_t)->Apply(SetOpsArgs);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "container/static_map.h"
+
+namespace {
+
+// 常见的HTTP头名，std的对照组是std::unordered_map<std::string, int>
+const nostd::static_map<int, 24> kHeaders = {
+    {"accept", 0},           {"accept-encoding", 1}, {"accept-language", 2}, {"authorization", 3},
+    {"cache-control", 4},    {"connection", 5},      {"content-encoding", 6}, {"content-length", 7},
+    {"content-type", 8},     {"cookie", 9},          {"date", 10},            {"etag", 11},
+    {"expires", 12},         {"host", 13},           {"if-modified-since", 14}, {"if-none-match", 15},
+    {"last-modified", 16},   {"location", 17},       {"origin", 18},          {"referer", 19},
+    {"server", 20},          {"set-cookie", 21},     {"transfer-encoding", 22}, {"user-agent", 23}};
+
+// 查询序列：3/4命中，其余是不在表里的自定义头
+std::vector<std::string> make_queries(size_t n) {
+    std::mt19937 rng(42);
+    std::vector<std::string> q;
+    q.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (rng() % 4 != 0) {
+            const auto &e = kHeaders.begin()[rng() % kHeaders.size()];
+            q.emplace_back(e.first.data(), e.first.size());
+        } else {
+            q.push_back("x-custom-" + std::to_string(rng() % 100));
+        }
+    }
+    return q;
+}
+
+void BM_StaticMap_Find_Nostd(benchmark::State &state) {
+    const std::vector<std::string> queries = make_queries(1024);
+    for (auto _ : state) {
+        int sum = 0;
+        for (const std::string &q : queries) {
+            auto it = kHeaders.find(nostd::string_view(q.data(), q.size()));
+            sum += it == kHeaders.end() ? -1 : it->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+void BM_StaticMap_Find_Std(benchmark::State &state) {
+    const std::vector<std::string> queries = make_queries(1024);
+    std::unordered_map<std::string, int> m;
+    for (const auto &e : kHeaders) {
+        m.emplace(std::string(e.first.data(), e.first.size()), e.second);
+    }
+    for (auto _ : state) {
+        int sum = 0;
+        for (const std::string &q : queries) {
+            auto it = m.find(q);
+            sum += it == m.end() ? -1 : it->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+}  // namespace
+
+BENCHMARK(BM_StaticMap_Find_Nostd);
+BENCHMARK(BM_StaticMap_Find_Std);
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "container/string.h"
+
+namespace {
+
+template <class S>
+void BM_String_AppendChar(benchmark::State &state) {
+    const size_t n = state.range(0);
+    for (auto _ : state) {
+        S s;
+        for (size_t i = 0; i < n; ++i) {
+            s += static_cast<char>('a' + i % 26);
+        }
+        benchmark::DoNotOptimize(s.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+template <class S>
+void BM_String_AppendChunks(benchmark::State &state) {
+    const std::vector<std::string> words = bench::random_values<std::string>(state.range(0));
+    size_t bytes = 0;
+    for (const std::string &w : words) {
+        bytes += w.size();
+    }
+    for (auto _ : state) {
+        S s;
+        for (const std::string &w : words) {
+            s.append(w.data(), w.size());
+        }
+        benchmark::DoNotOptimize(s.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+template <class S>
+void BM_String_Copy(benchmark::State &state) {
+    const S src(state.range(0), 'x');
+    for (auto _ : state) {
+        S s(src);
+        benchmark::DoNotOptimize(s.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// 在随机文本里找一个只出现在末尾的串
+template <class S>
+void BM_String_Find(benchmark::State &state) {
+    S s;
+    for (const std::string &w : bench::random_values<std::string>(state.range(0) / 16 + 1)) {
+        s.append(w.data(), w.size());
+    }
+    s.append("NEEDLE", 6);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(s.find("NEEDLE"));
+    }
+    state.SetBytesProcessed(state.iterations() * s.size());
+}
+
+template <class S>
+void BM_String_Compare(benchmark::State &state) {
+    const S a(state.range(0), 'x');
+    S b(a);
+    b[b.size() - 1] = 'y';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.compare(b));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// nostd::to_string(charconv) 与 std::to_string(snprintf)
+template <class S>
+S to_string_of(int v);
+
+template <>
+nostd::string to_string_of<nostd::string>(int v) {
+    return nostd::to_string(v);
+}
+
+template <>
+std::string to_string_of<std::string>(int v) {
+    return std::to_string(v);
+}
+
+template <class S>
+void BM_String_ToString(benchmark::State &state) {
+    const std::vector<int> values = bench::random_values<int>(state.range(0));
+    for (auto _ : state) {
+        for (int v : values) {
+            S s = to_string_of<S>(v);
+            benchmark::DoNotOptimize(s.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+}  // namespace
+
+EASYSTL_BENCHMARK_PAIR(BM_String_AppendChar, nostd::string, std::string, "char", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_String_AppendChunks, nostd::string, std::string, "char", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_String_Copy, nostd::string, std::string, "char", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_String_Find, nostd::string, std::string, "char", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_String_Compare, nostd::string, std::string, "char", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_String_ToString, nostd::string, std::string, "int", bench::size_args);
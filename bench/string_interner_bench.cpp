@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "bench_util.h"
+#include "container/string_interner.h"
+
+namespace {
+
+// std的对照组是std::unordered_set<std::string>
+const void *intern(nostd::string_interner &s, const std::string &w) { return s.intern(nostd::string_view(w.data(), w.size())).c_str(); }
+const void *intern(std::unordered_set<std::string> &s, const std::string &w) { return &*s.insert(w).first; }
+bool contains(const nostd::string_interner &s, const std::string &w) { return s.contains(nostd::string_view(w.data(), w.size())); }
+bool contains(const std::unordered_set<std::string> &s, const std::string &w) { return s.count(w) != 0; }
+
+// range(0)个单词，其中一半是重复的
+std::vector<std::string> make_words(size_t n) {
+    std::vector<std::string> words = bench::random_values<std::string>(n / 2 + 1);
+    words.reserve(n);
+    for (size_t i = 0; words.size() < n; ++i) {
+        words.push_back(words[i]);
+    }
+    return words;
+}
+
+template <class S>
+void BM_Interner_Intern(benchmark::State &state) {
+    const std::vector<std::string> words = make_words(state.range(0));
+    for (auto _ : state) {
+        S s;
+        for (const std::string &w : words) {
+            benchmark::DoNotOptimize(intern(s, w));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * words.size());
+}
+
+template <class S>
+void BM_Interner_Find(benchmark::State &state) {
+    const std::vector<std::string> words = make_words(state.range(0));
+    S s;
+    for (const std::string &w : words) {
+        intern(s, w);
+    }
+    for (auto _ : state) {
+        size_t hits = 0;
+        for (const std::string &w : words) {
+            hits += contains(s, w) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * words.size());
+}
+
+}  // namespace
+
+EASYSTL_BENCHMARK_PAIR(BM_Interner_Intern, nostd::string_interner, std::unordered_set<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Interner_Find, nostd::string_interner, std::unordered_set<std::string>, "string", bench::size_args);
@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+
+#include "algo/algorithm.h"
+#include "container/timer_wheel.h"
+#include "container/vector.h"
+
+namespace {
+
+constexpr uint64_t kMaxDelay = 1 << 16;
+
+// nostd::push_heap用operator>上浮, pop_heap用operator<下沉, 比较反过来得到小顶堆
+struct heap_entry {
+    uint64_t expire;
+    uint32_t id;
+
+    bool operator<(const heap_entry &rhs) const { return expire > rhs.expire; }
+    bool operator>(const heap_entry &rhs) const { return expire < rhs.expire; }
+};
+
+nostd::vector<uint64_t> make_delays(size_t n) {
+    std::mt19937_64 rng(2023);
+    std::uniform_int_distribution<uint64_t> dist(1, kMaxDelay);
+    nostd::vector<uint64_t> delays(n);
+    for (size_t i = 0; i < n; ++i) {
+        delays[i] = dist(rng);
+    }
+    return delays;
+}
+
+// 添加n个定时器, 然后推进到全部过期
+void BM_TimerWheel_AddExpire(benchmark::State &state) {
+    const size_t n = state.range(0);
+    nostd::vector<uint64_t> delays = make_delays(n);
+    for (auto _ : state) {
+        nostd::timer_wheel<uint32_t> tw;
+        for (size_t i = 0; i < n; ++i) {
+            tw.add(delays[i], static_cast<uint32_t>(i));
+        }
+        uint64_t sum = 0;
+        tw.advance(kMaxDelay, [&sum](uint32_t id) {
+            sum += id;
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_Heap_AddExpire(benchmark::State &state) {
+    const size_t n = state.range(0);
+    nostd::vector<uint64_t> delays = make_delays(n);
+    for (auto _ : state) {
+        nostd::vector<heap_entry> heap;
+        for (size_t i = 0; i < n; ++i) {
+            heap.push_back(heap_entry{delays[i], static_cast<uint32_t>(i)});
+            nostd::push_heap(heap.begin(), heap.end());
+        }
+        uint64_t sum = 0;
+        for (uint64_t now = 1; now <= kMaxDelay; ++now) {
+            while (!heap.empty() && heap.front().expire <= now) {
+                sum += heap.front().id;
+                nostd::pop_heap(heap.begin(), heap.end());
+                heap.pop_back();
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// n个定时器常驻, 每个tick重置一批定时器(cancel后重新add), 模拟连接空闲超时的刷新
+void BM_TimerWheel_Churn(benchmark::State &state) {
+    const size_t n = state.range(0);
+    nostd::vector<uint64_t> delays = make_delays(n);
+    nostd::timer_wheel<uint32_t> tw;
+    nostd::vector<nostd::timer_wheel<uint32_t>::handle> handles(n);
+    for (size_t i = 0; i < n; ++i) {
+        handles[i] = tw.add(delays[i], static_cast<uint32_t>(i));
+    }
+    size_t cursor = 0;
+    for (auto _ : state) {
+        for (int k = 0; k < 1024; ++k) {
+            tw.cancel(handles[cursor]);
+            handles[cursor] = tw.add(delays[cursor], static_cast<uint32_t>(cursor));
+            cursor = (cursor + 1) % n;
+        }
+        tw.advance(1, [&](uint32_t id) {
+            handles[id] = tw.add(kMaxDelay, id);
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+// 堆无法O(1)删除任意元素, 采用惰性删除: 用版本号标记失效的条目, 出堆时跳过
+void BM_Heap_Churn(benchmark::State &state) {
+    const size_t n = state.range(0);
+    nostd::vector<uint64_t> delays = make_delays(n);
+    nostd::vector<heap_entry> heap;
+    nostd::vector<uint64_t> current(n);
+    for (size_t i = 0; i < n; ++i) {
+        current[i] = delays[i];
+        heap.push_back(heap_entry{delays[i], static_cast<uint32_t>(i)});
+        nostd::push_heap(heap.begin(), heap.end());
+    }
+    uint64_t now = 0;
+    size_t cursor = 0;
+    for (auto _ : state) {
+        for (int k = 0; k < 1024; ++k) {
+            current[cursor] = now + delays[cursor];
+            heap.push_back(heap_entry{current[cursor], static_cast<uint32_t>(cursor)});
+            nostd::push_heap(heap.begin(), heap.end());
+            cursor = (cursor + 1) % n;
+        }
+        ++now;
+        while (!heap.empty() && heap.front().expire <= now) {
+            heap_entry top = heap.front();
+            nostd::pop_heap(heap.begin(), heap.end());
+            heap.pop_back();
+            if (current[top.id] == top.expire) {
+                current[top.id] = now + kMaxDelay;
+                heap.push_back(heap_entry{current[top.id], top.id});
+                nostd::push_heap(heap.begin(), heap.end());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+}  // namespace
+
+BENCHMARK(BM_TimerWheel_AddExpire)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Heap_AddExpire)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimerWheel_Churn)->Arg(1 << 20);
+BENCHMARK(BM_Heap_Churn)->Arg(1 << 20);
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+
+#include "base/utf.h"
+#include "container/string.h"
+#include "container/vector.h"
+
+namespace {
+
+// range(1): 非ASCII码点所占的百分比
+nostd::string make_text(size_t bytes, int percent) {
+    std::mt19937 rng(42);
+    nostd::string s;
+    s.reserve(bytes + 4);
+    char buf[4];
+    while (s.size() < bytes) {
+        char32_t cp = static_cast<int>(rng() % 100) < percent ? 0x4E00 + rng() % 0x5000 : 'a' + rng() % 26;
+        s.append(buf, nostd::convert_valid_utf32_to_utf8(&cp, 1, buf));
+    }
+    return s;
+}
+
+void BM_Utf8_Validate(benchmark::State &state) {
+    nostd::string s = make_text(state.range(0), static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nostd::validate_utf8(s.data(), s.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * s.size());
+}
+
+void BM_Utf8_ValidateScalar(benchmark::State &state) {
+    nostd::string s = make_text(state.range(0), static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nostd::_utf::validate_utf8_scalar(s.data(), s.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * s.size());
+}
+
+void BM_Utf8_ToUtf16(benchmark::State &state) {
+    nostd::string s = make_text(state.range(0), static_cast<int>(state.range(1)));
+    nostd::vector<char16_t> out(s.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nostd::convert_utf8_to_utf16(s.data(), s.size(), out.begin()));
+    }
+    state.SetBytesProcessed(state.iterations() * s.size());
+}
+
+void BM_Utf16_ToUtf8(benchmark::State &state) {
+    nostd::u16string s = nostd::to_utf16(make_text(state.range(0), static_cast<int>(state.range(1))));
+    nostd::vector<char> out(s.size() * 3);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nostd::convert_utf16_to_utf8(s.data(), s.size(), out.begin()));
+    }
+    state.SetBytesProcessed(state.iterations() * s.size() * sizeof(char16_t));
+}
+
+}  // namespace
+
+BENCHMARK(BM_Utf8_Validate)->ArgsProduct({{1 << 12, 1 << 20}, {0, 10, 100}});
+BENCHMARK(BM_Utf8_ValidateScalar)->ArgsProduct({{1 << 12, 1 << 20}, {0, 10, 100}});
+BENCHMARK(BM_Utf8_ToUtf16)->ArgsProduct({{1 << 12, 1 << 20}, {0, 10, 100}});
+BENCHMARK(BM_Utf16_ToUtf8)->ArgsProduct({{1 << 12, 1 << 20}, {0, 10, 100}});
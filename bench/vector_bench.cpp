@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "container/vector.h"
+
+namespace {
+
+template <class V>
+void BM_Vector_PushBack(benchmark::State &state) {
+    using T = typename V::value_type;
+    const std::vector<T> src = bench::random_values<T>(state.range(0));
+    for (auto _ : state) {
+        V v;
+        for (const T &x : src) {
+            v.push_back(x);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+template <class V>
+void BM_Vector_ReservePushBack(benchmark::State &state) {
+    using T = typename V::value_type;
+    const std::vector<T> src = bench::random_values<T>(state.range(0));
+    for (auto _ : state) {
+        V v;
+        v.reserve(src.size());
+        for (const T &x : src) {
+            v.push_back(x);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+template <class V>
+void BM_Vector_RangeConstruct(benchmark::State &state) {
+    using T = typename V::value_type;
+    const std::vector<T> src = bench::random_values<T>(state.range(0));
+    for (auto _ : state) {
+        V v(src.data(), src.data() + src.size());
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+template <class V>
+void BM_Vector_CopyConstruct(benchmark::State &state) {
+    using T = typename V::value_type;
+    const std::vector<T> src = bench::random_values<T>(state.range(0));
+    const V from(src.data(), src.data() + src.size());
+    for (auto _ : state) {
+        V v(from);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+template <class V>
+void BM_Vector_Resize(benchmark::State &state) {
+    const size_t n = state.range(0);
+    for (auto _ : state) {
+        V v;
+        v.resize(n);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 顺序遍历，逐个和第一个元素比较
+template <class V>
+void BM_Vector_Iterate(benchmark::State &state) {
+    using T = typename V::value_type;
+    const std::vector<T> src = bench::random_values<T>(state.range(0));
+    const V v(src.data(), src.data() + src.size());
+    for (auto _ : state) {
+        size_t hits = 0;
+        for (auto it = v.begin(); it != v.end(); ++it) {
+            hits += *it == v[0] ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+// 从非连续的前向区间批量追加：nostd::vector::append_range与std::vector::insert(end, ...)
+template <class T, class It>
+void append_to(nostd::vector<T> &v, It first, It last) {
+    v.append_range(first, last);
+}
+
+template <class T, class It>
+void append_to(std::vector<T> &v, It first, It last) {
+    v.insert(v.end(), first, last);
+}
+
+template <class V>
+void BM_Vector_AppendRange(benchmark::State &state) {
+    using T = typename V::value_type;
+    const std::vector<T> values = bench::random_values<T>(state.range(0));
+    const std::list<T> src(values.begin(), values.end());
+    for (auto _ : state) {
+        V v;
+        append_to(v, src.begin(), src.end());
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+}  // namespace
+
+EASYSTL_BENCHMARK_PAIR(BM_Vector_PushBack, nostd::vector<int>, std::vector<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_PushBack, nostd::vector<double>, std::vector<double>, "double", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_PushBack, nostd::vector<std::string>, std::vector<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_ReservePushBack, nostd::vector<int>, std::vector<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_ReservePushBack, nostd::vector<std::string>, std::vector<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_RangeConstruct, nostd::vector<int>, std::vector<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_RangeConstruct, nostd::vector<std::string>, std::vector<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_CopyConstruct, nostd::vector<int>, std::vector<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_CopyConstruct, nostd::vector<double>, std::vector<double>, "double", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_CopyConstruct, nostd::vector<std::string>, std::vector<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_Resize, nostd::vector<int>, std::vector<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_Resize, nostd::vector<std::string>, std::vector<std::string>, "string", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_Iterate, nostd::vector<int>, std::vector<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_Iterate, nostd::vector<double>, std::vector<double>, "double", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_AppendRange, nostd::vector<int>, std::vector<int>, "int", bench::size_args);
+EASYSTL_BENCHMARK_PAIR(BM_Vector_AppendRange, nostd::vector<std::string>, std::vector<std::string>, "string", bench::size_args);
@@ -1,12 +1,75 @@
 #ifndef __ALGORITHM_H
 #define __ALGORITHM_H
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
+#include "base/bit.h"
+#include "base/config.h"
+#include "base/iterator.h"
+#include "base/simd.h"
+#include "base/trace.h"
+
 // ref：https://zh.cppreference.com/w/cpp/algorithm
 
 namespace nostd {
+//-------Helpers for dispatching on iterator and value type-------//
+// std和nostd的随机访问迭代器都走随机访问的实现
+template <class Iterator, class Category = typename std::iterator_traits<Iterator>::iterator_category>
+struct _is_random_access_iter
+    : std::integral_constant<bool, std::is_base_of<std::random_access_iterator_tag, Category>::value ||
+                                       std::is_base_of<nostd::random_access_iterator_tag, Category>::value> {};
+
+// 连续迭代器(包括指针和包装过的连续迭代器)的元素类型，保留const；不是连续迭代器时为void
+template <class Iterator, bool = is_contiguous_iterator<Iterator>::value>
+struct _contiguous_element {
+    using type = void;
+};
+
+template <class Iterator>
+struct _contiguous_element<Iterator, true> {
+    using type = typename std::remove_pointer<decltype(nostd::to_address(std::declval<Iterator>()))>::type;
+};
+
+// 两边都是指向同一种可平凡复制类型的连续迭代器时，copy/move可以直接memmove
+template <class InputIterator, class OutputIterator,
+          class T1 = typename _contiguous_element<InputIterator>::type,
+          class T2 = typename _contiguous_element<OutputIterator>::type>
+struct _is_trivial_copy_contiguous
+    : std::integral_constant<bool, is_contiguous_iterator<InputIterator>::value &&
+                                       is_contiguous_iterator<OutputIterator>::value &&
+                                       std::is_same<typename std::remove_const<T1>::type, T2>::value &&
+                                       !std::is_volatile<T2>::value && std::is_trivially_copyable<T2>::value> {};
+
+// 指向可平凡复制类型的非const连续迭代器，fill可以按字节或者展开的循环写
+template <class Iterator, class T = typename _contiguous_element<Iterator>::type>
+struct _is_trivial_fill_contiguous
+    : std::integral_constant<bool, is_contiguous_iterator<Iterator>::value && !std::is_const<T>::value &&
+                                       !std::is_volatile<T>::value && std::is_trivially_copyable<T>::value> {};
+
+// 相等就是逐字节相等的类型(整数、枚举、指针)，equal可以直接memcmp
+template <class Iterator1, class Iterator2,
+          class T1 = typename std::remove_cv<typename _contiguous_element<Iterator1>::type>::type,
+          class T2 = typename std::remove_cv<typename _contiguous_element<Iterator2>::type>::type>
+struct _is_bitwise_equal_contiguous
+    : std::integral_constant<bool, is_contiguous_iterator<Iterator1>::value && is_contiguous_iterator<Iterator2>::value &&
+                                       std::is_same<T1, T2>::value &&
+                                       (std::is_integral<T1>::value || std::is_enum<T1>::value ||
+                                        std::is_pointer<T1>::value)> {};
+
+// 不带比较操作的版本使用operator<，两边的类型可以不同
+struct _less_op {
+    template <class T1, class T2>
+    EASYSTL_CONSTEXPR14 bool operator()(const T1& lhs, const T2& rhs) const {
+        return lhs < rhs;
+    }
+};
+
 //-------Non-modifying sequence operations-------//
 
 ///@brief whether all elements in range satisfy condition
@@ -14,7 +77,7 @@ namespace nostd {
 ///@param pred: unary predicate function that accepts an element in the range as argument
 ///@return true if pred return true for `all` the elements in the range[first,last).
 template <typename InputIterator, typename UnaryPredicate>
-bool all_of(InputIterator first, InputIterator last, UnaryPredicate pred) {
+EASYSTL_CONSTEXPR14 bool all_of(InputIterator first, InputIterator last, UnaryPredicate pred) {
     while (first != last) {
         if (!pred(*first)) {
             return false;
@@ -29,7 +92,7 @@ bool all_of(InputIterator first, InputIterator last, UnaryPredicate pred) {
 ///@param pred unary predicate function that accepts an element in the range as argument
 ///@return true if pred return true for `any` of the elements in the range[first,last).
 template <typename InputIterator, typename UnaryPredicate>
-bool any_of(InputIterator first, InputIterator last, UnaryPredicate pred) {
+EASYSTL_CONSTEXPR14 bool any_of(InputIterator first, InputIterator last, UnaryPredicate pred) {
     while (first != last) {
         if (pred(*first)) {
             return true;
@@ -44,7 +107,7 @@ bool any_of(InputIterator first, InputIterator last, UnaryPredicate pred) {
 ///@param pred unary predicate function that accepts an element in the range as argument
 ///@return true if pred return true for `none` of the elements in the range[first,last).
 template <typename InputIterator, typename UnaryPredicate>
-bool none_of(InputIterator first, InputIterator last, UnaryPredicate pred) {
+EASYSTL_CONSTEXPR14 bool none_of(InputIterator first, InputIterator last, UnaryPredicate pred) {
     while (first != last) {
         if (pred(*first)) {
             return false;
@@ -60,7 +123,7 @@ bool none_of(InputIterator first, InputIterator last, UnaryPredicate pred) {
 ///@return fn
 ///@note if you want to modify the elements in the range, use reference as argument in fn
 template <typename InputIterator, typename Function>
-Function for_each(InputIterator first, InputIterator last, Function fn) {
+EASYSTL_CONSTEXPR14 Function for_each(InputIterator first, InputIterator last, Function fn) {
     while (first != last) {
         fn(*first);
         ++first;
@@ -75,7 +138,7 @@ Function for_each(InputIterator first, InputIterator last, Function fn) {
 ///@note  uses `operator==` to compare the individual elements to val.
 /// if T is a class, you shuold achieve `operator==`, and mark as const,beacuse val is const.
 template <typename InputIterator, typename T>
-InputIterator find(InputIterator first, InputIterator last, const T& val) {
+EASYSTL_CONSTEXPR14 InputIterator find(InputIterator first, InputIterator last, const T& val) {
     while (first != last) {
         if (val == *first) {
             return first;
@@ -90,7 +153,7 @@ InputIterator find(InputIterator first, InputIterator last, const T& val) {
 ///@param pred unary predicate function that accepts an element in the range as argument
 ///@return returns an iterator to the first element in the range[first,last) for which pred return `true`
 template <typename InputIterator, typename UnaryPredicate>
-InputIterator find_if(InputIterator first, InputIterator last, UnaryPredicate pred) {
+EASYSTL_CONSTEXPR14 InputIterator find_if(InputIterator first, InputIterator last, UnaryPredicate pred) {
     while (first != last) {
         if (pred(*first)) {
             return first;
@@ -105,7 +168,7 @@ InputIterator find_if(InputIterator first, InputIterator last, UnaryPredicate pr
 ///@param pred unary predicate function that accepts an element in the range as argument
 ///@return returns an iterator to the first element in the range[first,last) for which pred return `false`
 template <typename InputIterator, typename UnaryPredicate>
-InputIterator find_if_not(InputIterator first, InputIterator last, UnaryPredicate pred) {
+EASYSTL_CONSTEXPR14 InputIterator find_if_not(InputIterator first, InputIterator last, UnaryPredicate pred) {
     while (first != last) {
         if (!pred(*first)) {
             return first;
@@ -140,9 +203,9 @@ ForwardIterator adjacent_find(ForwardIterator first, ForwardIterator last,
 }
 
 template <typename InputIterator, typename T>
-typename std::iterator_traits<InputIterator>::difference_type cout(InputIterator first,
-                                                                   InputIterator last,
-                                                                   const T& val) {
+EASYSTL_CONSTEXPR14 typename std::iterator_traits<InputIterator>::difference_type cout(InputIterator first,
+                                                                                       InputIterator last,
+                                                                                       const T& val) {
     typename std::iterator_traits<InputIterator>::difference_type cnt = 0;
     while (first != last) {
         if (val == *first) {
@@ -154,9 +217,9 @@ typename std::iterator_traits<InputIterator>::difference_type cout(InputIterator
 }
 
 template <typename InputIterator, typename UnaryPredicate>
-typename std::iterator_traits<InputIterator>::difference_type cout(InputIterator first,
-                                                                   InputIterator last,
-                                                                   UnaryPredicate pred) {
+EASYSTL_CONSTEXPR14 typename std::iterator_traits<InputIterator>::difference_type cout(InputIterator first,
+                                                                                       InputIterator last,
+                                                                                       UnaryPredicate pred) {
     typename std::iterator_traits<InputIterator>::difference_type cnt = 0;
     while (first != last) {
         if (pred(*first)) {
@@ -178,8 +241,8 @@ std::pair<InputIterator1, InputIterator2> mismatch(InputIterator1 first1, InputI
 }
 
 template <typename InputIterator1, typename InputIterator2>
-bool equal(InputIterator1 first1, InputIterator1 last1,
-           InputIterator2 first2) {
+EASYSTL_CONSTEXPR14 bool _equal(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, std::false_type) {
     while (first1 != last1) {
         if (!(*first1 == *first2)) {
             return false;
@@ -190,11 +253,29 @@ bool equal(InputIterator1 first1, InputIterator1 last1,
     return true;
 }
 
+template <typename InputIterator1, typename InputIterator2>
+EASYSTL_CONSTEXPR14 bool _equal(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, std::true_type) {
+    if (nostd::is_constant_evaluated()) {
+        return nostd::_equal(first1, last1, first2, std::false_type());
+    }
+    const size_t n = static_cast<size_t>(last1 - first1);
+    return n == 0 || std::memcmp(nostd::to_address(first1), nostd::to_address(first2), n * sizeof(*first1)) == 0;
+}
+
+///@brief whether the elements in two ranges are equal
+///@note contiguous ranges of integers, enums or pointers are compared with memcmp
+template <typename InputIterator1, typename InputIterator2>
+EASYSTL_CONSTEXPR14 bool equal(InputIterator1 first1, InputIterator1 last1,
+                               InputIterator2 first2) {
+    return nostd::_equal(first1, last1, first2, _is_bitwise_equal_contiguous<InputIterator1, InputIterator2>());
+}
+
 template <typename InputIterator1, typename InputIterator2, typename BinaryPredicate>
-bool equal(InputIterator1 first1, InputIterator1 last1,
-           InputIterator2 first2, BinaryPredicate pred) {
+EASYSTL_CONSTEXPR14 bool equal(InputIterator1 first1, InputIterator1 last1,
+                               InputIterator2 first2, BinaryPredicate pred) {
     while (first1 != last1) {
-        if (!pred(first1, first2)) {
+        if (!pred(*first1, *first2)) {
             return false;
         }
         ++first1;
@@ -234,20 +315,86 @@ ForwardIterator search_n(ForwardIterator first, ForwardIterator last, Size count
 }
 
 //-------Modifying sequence operations-------//
-// copy
-template <class InputIterator, class OutputIterator>
-OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result) {
+// copy和move共用的实现，IsMove决定赋值时是否std::move
+template <class T>
+EASYSTL_CONSTEXPR14 T&& _copy_or_move(T&& x, std::false_type) {
+    return std::forward<T>(x);
+}
+
+template <class T>
+EASYSTL_CONSTEXPR14 typename std::remove_reference<T>::type&& _copy_or_move(T&& x, std::true_type) {
+    return std::move(x);
+}
+
+template <class InputIterator, class OutputIterator, class IsMove>
+EASYSTL_CONSTEXPR14 OutputIterator _copy_move_loop(InputIterator first, InputIterator last, OutputIterator result, IsMove is_move,
+                                                   std::false_type) {
     while (first != last) {
-        *result = *first;
+        *result = _copy_or_move(*first, is_move);
         ++first;
         ++result;
     }
     return result;
 }
 
+// 随机访问迭代器先算出个数，按4个一组展开，省掉每个元素一次的first != last比较
+template <class InputIterator, class OutputIterator, class IsMove>
+EASYSTL_CONSTEXPR14 OutputIterator _copy_move_loop(InputIterator first, InputIterator last, OutputIterator result, IsMove is_move,
+                                                   std::true_type) {
+    typename std::iterator_traits<InputIterator>::difference_type n = last - first;
+    for (; n >= 4; n -= 4) {
+        *result = _copy_or_move(*first, is_move);
+        ++first;
+        ++result;
+        *result = _copy_or_move(*first, is_move);
+        ++first;
+        ++result;
+        *result = _copy_or_move(*first, is_move);
+        ++first;
+        ++result;
+        *result = _copy_or_move(*first, is_move);
+        ++first;
+        ++result;
+    }
+    for (; n > 0; --n) {
+        *result = _copy_or_move(*first, is_move);
+        ++first;
+        ++result;
+    }
+    return result;
+}
+
+template <class InputIterator, class OutputIterator, class IsMove>
+EASYSTL_CONSTEXPR14 OutputIterator _copy_move(InputIterator first, InputIterator last, OutputIterator result, IsMove is_move,
+                                              std::false_type) {
+    return nostd::_copy_move_loop(first, last, result, is_move, _is_random_access_iter<InputIterator>());
+}
+
+// 可平凡复制的类型copy和move是一回事，直接memmove(允许区间重叠)
+template <class InputIterator, class OutputIterator, class IsMove>
+EASYSTL_CONSTEXPR14 OutputIterator _copy_move(InputIterator first, InputIterator last, OutputIterator result, IsMove is_move,
+                                              std::true_type) {
+    if (nostd::is_constant_evaluated()) {
+        return nostd::_copy_move_loop(first, last, result, is_move, std::true_type());
+    }
+    const size_t n = static_cast<size_t>(last - first);
+    if (n != 0) {
+        std::memmove(nostd::to_address(result), nostd::to_address(first), n * sizeof(*first));
+    }
+    return result + n;
+}
+
+// copy
+///@brief copy [first,last) to the range beginning at result
+///@note contiguous ranges of trivially copyable types are copied with memmove
+template <class InputIterator, class OutputIterator>
+EASYSTL_CONSTEXPR14 OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result) {
+    return nostd::_copy_move(first, last, result, std::false_type(), _is_trivial_copy_contiguous<InputIterator, OutputIterator>());
+}
+
 // copy_n
 template <class InputIterator, class Size, class OutputIterator>
-OutputIterator copy_n(InputIterator first, Size n, OutputIterator result) {
+EASYSTL_CONSTEXPR14 OutputIterator _copy_n(InputIterator first, Size n, OutputIterator result, std::false_type) {
     for (Size i = 0; i < n; ++i) {
         *result = *first;
         ++first;
@@ -256,9 +403,26 @@ OutputIterator copy_n(InputIterator first, Size n, OutputIterator result) {
     return result;
 }
 
+template <class InputIterator, class Size, class OutputIterator>
+EASYSTL_CONSTEXPR14 OutputIterator _copy_n(InputIterator first, Size n, OutputIterator result, std::true_type) {
+    if (n <= 0) {
+        return result;
+    }
+    if (nostd::is_constant_evaluated()) {
+        return nostd::_copy_n(first, n, result, std::false_type());
+    }
+    std::memmove(nostd::to_address(result), nostd::to_address(first), static_cast<size_t>(n) * sizeof(*first));
+    return result + n;
+}
+
+template <class InputIterator, class Size, class OutputIterator>
+EASYSTL_CONSTEXPR14 OutputIterator copy_n(InputIterator first, Size n, OutputIterator result) {
+    return nostd::_copy_n(first, n, result, _is_trivial_copy_contiguous<InputIterator, OutputIterator>());
+}
+
 // copy_if
 template <class InputIterator, class OutputIterator, class UnaryPredicate>
-OutputIterator copy_if(InputIterator first, InputIterator last, OutputIterator result, UnaryPredicate pred) {
+EASYSTL_CONSTEXPR14 OutputIterator copy_if(InputIterator first, InputIterator last, OutputIterator result, UnaryPredicate pred) {
     while (first != last) {
         if (pred(*first)) {
             *result = *first;
@@ -270,57 +434,75 @@ OutputIterator copy_if(InputIterator first, InputIterator last, OutputIterator r
 }
 
 // copy_backward
-template <class BidirectionalIterator1, class BidirectionalIterator2>
-BidirectionalIterator2 copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result) {
+template <class BidirectionalIterator1, class BidirectionalIterator2, class IsMove>
+EASYSTL_CONSTEXPR14 BidirectionalIterator2 _copy_move_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                               BidirectionalIterator2 result, IsMove is_move, std::false_type) {
     while (last != first) {
         --last;
         --result;
-        *result = *last;
+        *result = _copy_or_move(*last, is_move);
     }
     return result;
 }
 
+template <class BidirectionalIterator1, class BidirectionalIterator2, class IsMove>
+EASYSTL_CONSTEXPR14 BidirectionalIterator2 _copy_move_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                               BidirectionalIterator2 result, IsMove is_move, std::true_type) {
+    if (nostd::is_constant_evaluated()) {
+        return nostd::_copy_move_backward(first, last, result, is_move, std::false_type());
+    }
+    const size_t n = static_cast<size_t>(last - first);
+    if (n != 0) {
+        std::memmove(nostd::to_address(result) - n, nostd::to_address(first), n * sizeof(*first));
+    }
+    return result - n;
+}
+
+template <class BidirectionalIterator1, class BidirectionalIterator2>
+EASYSTL_CONSTEXPR14 BidirectionalIterator2 copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result) {
+    return nostd::_copy_move_backward(first, last, result, std::false_type(),
+                                      _is_trivial_copy_contiguous<BidirectionalIterator1, BidirectionalIterator2>());
+}
+
 // move
 template <class InputIterator, class OutputIterator>
-OutputIterator move(InputIterator first, InputIterator last, OutputIterator result) {
-    while (first != last) {
-        *result = std::move(*first);
-        ++first;
-        ++result;
-    }
-    return result;
+EASYSTL_CONSTEXPR14 OutputIterator move(InputIterator first, InputIterator last, OutputIterator result) {
+    return nostd::_copy_move(first, last, result, std::true_type(), _is_trivial_copy_contiguous<InputIterator, OutputIterator>());
 }
 
 // move_backward
 template <class BidirectionalIterator1, class BidirectionalIterator2>
-BidirectionalIterator2 move_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result) {
-    while (last != first) {
-        --last;
-        --result;
-        *result = std::move(*last);
+EASYSTL_CONSTEXPR14 BidirectionalIterator2 move_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result) {
+    return nostd::_copy_move_backward(first, last, result, std::true_type(),
+                                      _is_trivial_copy_contiguous<BidirectionalIterator1, BidirectionalIterator2>());
+}
+
+// iter_swap
+template <class ForwardIterator1, class ForwardIterator2>
+EASYSTL_CONSTEXPR14 void iter_swap(ForwardIterator1 a, ForwardIterator2 b) {
+    // std::iter_swap到C++20才是constexpr，编译期求值时直接用移动交换
+    if (nostd::is_constant_evaluated()) {
+        typename std::iterator_traits<ForwardIterator1>::value_type tmp = std::move(*a);
+        *a = std::move(*b);
+        *b = std::move(tmp);
+        return;
     }
-    return result;
+    std::iter_swap(a, b);
 }
 
 // swap
 template <class ForwardIterator1, class ForwardIterator2>
-void swap_ranges(ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2) {
+EASYSTL_CONSTEXPR14 void swap_ranges(ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2) {
     while (first1 != last1) {
-        iter_swap(first1, first2);
+        nostd::iter_swap(first1, first2);
         ++first1;
         ++first2;
     }
 }
 
-// iter_swap
-template <class ForwardIterator1, class ForwardIterator2>
-void iter_swap(ForwardIterator1 a, ForwardIterator2 b) {
-    std::iter_swap(a, b);
-}
-
 // transform
 template <class InputIterator, class OutputIterator, class UnaryOperation>
-OutputIterator transform(InputIterator first, InputIterator last, OutputIterator result, UnaryOperation op) {
+EASYSTL_CONSTEXPR14 OutputIterator transform(InputIterator first, InputIterator last, OutputIterator result, UnaryOperation op) {
     while (first != last) {
         *result = op(*first);
         ++first;
@@ -331,7 +513,7 @@ OutputIterator transform(InputIterator first, InputIterator last, OutputIterator
 
 // replace
 template <class ForwardIterator, class T>
-void replace(ForwardIterator first, ForwardIterator last, const T& old_value, const T& new_value) {
+EASYSTL_CONSTEXPR14 void replace(ForwardIterator first, ForwardIterator last, const T& old_value, const T& new_value) {
     while (first != last) {
         if (*first == old_value) {
             *first = new_value;
@@ -342,7 +524,7 @@ void replace(ForwardIterator first, ForwardIterator last, const T& old_value, co
 
 // replace_if
 template <class ForwardIterator, class UnaryPredicate, class T>
-void replace_if(ForwardIterator first, ForwardIterator last, UnaryPredicate pred, const T& new_value) {
+EASYSTL_CONSTEXPR14 void replace_if(ForwardIterator first, ForwardIterator last, UnaryPredicate pred, const T& new_value) {
     while (first != last) {
         if (pred(*first)) {
             *first = new_value;
@@ -353,7 +535,7 @@ void replace_if(ForwardIterator first, ForwardIterator last, UnaryPredicate pred
 
 // replace_copy
 template <class InputIterator, class OutputIterator, class T>
-OutputIterator replace_copy(InputIterator first, InputIterator last, OutputIterator result, const T& old_value, const T& new_value) {
+EASYSTL_CONSTEXPR14 OutputIterator replace_copy(InputIterator first, InputIterator last, OutputIterator result, const T& old_value, const T& new_value) {
     while (first != last) {
         if (*first == old_value) {
             *result = new_value;
@@ -368,7 +550,7 @@ OutputIterator replace_copy(InputIterator first, InputIterator last, OutputItera
 
 // replace_copy_if
 template <class InputIterator, class OutputIterator, class UnaryPredicate, class T>
-OutputIterator replace_copy_if(InputIterator first, InputIterator last, OutputIterator result, UnaryPredicate pred, const T& new_value) {
+EASYSTL_CONSTEXPR14 OutputIterator replace_copy_if(InputIterator first, InputIterator last, OutputIterator result, UnaryPredicate pred, const T& new_value) {
     while (first != last) {
         if (pred(*first)) {
             *result = new_value;
@@ -382,17 +564,75 @@ OutputIterator replace_copy_if(InputIterator first, InputIterator last, OutputIt
 }
 
 // fill
+// 标量的每个字节都相同时(0、-1、单字节类型)可以memset，byte返回那个字节
+template <class T>
+bool _fill_byte(const T& value, unsigned char& byte, std::true_type) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(std::addressof(value));
+    byte = p[0];
+    for (size_t i = 1; i < sizeof(T); ++i) {
+        if (p[i] != byte) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 结构体里有填充字节，不按字节判断
+template <class T>
+bool _fill_byte(const T&, unsigned char&, std::false_type) {
+    return false;
+}
+
+// 连续内存上的fill：能memset时memset，否则先把值复制一份再展开循环写，编译器可以向量化
+template <class T>
+T* _fill_ptr(T* first, size_t n, const T& value) {
+    unsigned char byte;
+    if (_fill_byte(value, byte, std::is_scalar<T>())) {
+        if (n != 0) {
+            std::memset(static_cast<void*>(first), byte, n * sizeof(T));
+        }
+        return first + n;
+    }
+    const T tmp = value;
+    for (; n >= 4; n -= 4, first += 4) {
+        first[0] = tmp;
+        first[1] = tmp;
+        first[2] = tmp;
+        first[3] = tmp;
+    }
+    for (; n > 0; --n, ++first) {
+        *first = tmp;
+    }
+    return first;
+}
+
 template <class ForwardIterator, class T>
-void fill(ForwardIterator first, ForwardIterator last, const T& value) {
+EASYSTL_CONSTEXPR14 void _fill(ForwardIterator first, ForwardIterator last, const T& value, std::false_type) {
     while (first != last) {
         *first = value;
         ++first;
     }
 }
 
+template <class ForwardIterator, class T>
+EASYSTL_CONSTEXPR14 void _fill(ForwardIterator first, ForwardIterator last, const T& value, std::true_type) {
+    if (nostd::is_constant_evaluated()) {
+        return nostd::_fill(first, last, value, std::false_type());
+    }
+    typedef typename _contiguous_element<ForwardIterator>::type value_type;
+    nostd::_fill_ptr(nostd::to_address(first), static_cast<size_t>(last - first), static_cast<value_type>(value));
+}
+
+///@brief assign value to every element in [first,last)
+///@note contiguous ranges of trivially copyable types use memset when every byte of value is the same
+template <class ForwardIterator, class T>
+EASYSTL_CONSTEXPR14 void fill(ForwardIterator first, ForwardIterator last, const T& value) {
+    nostd::_fill(first, last, value, _is_trivial_fill_contiguous<ForwardIterator>());
+}
+
 // fill_n
 template <class OutputIterator, class Size, class T>
-OutputIterator fill_n(OutputIterator first, Size n, const T& value) {
+EASYSTL_CONSTEXPR14 OutputIterator _fill_n(OutputIterator first, Size n, const T& value, std::false_type) {
     for (Size i = 0; i < n; ++i) {
         *first = value;
         ++first;
@@ -400,9 +640,27 @@ OutputIterator fill_n(OutputIterator first, Size n, const T& value) {
     return first;
 }
 
+template <class OutputIterator, class Size, class T>
+EASYSTL_CONSTEXPR14 OutputIterator _fill_n(OutputIterator first, Size n, const T& value, std::true_type) {
+    typedef typename _contiguous_element<OutputIterator>::type value_type;
+    if (n <= 0) {
+        return first;
+    }
+    if (nostd::is_constant_evaluated()) {
+        return nostd::_fill_n(first, n, value, std::false_type());
+    }
+    nostd::_fill_ptr(nostd::to_address(first), static_cast<size_t>(n), static_cast<value_type>(value));
+    return first + n;
+}
+
+template <class OutputIterator, class Size, class T>
+EASYSTL_CONSTEXPR14 OutputIterator fill_n(OutputIterator first, Size n, const T& value) {
+    return nostd::_fill_n(first, n, value, _is_trivial_fill_contiguous<OutputIterator>());
+}
+
 // generate
 template <class ForwardIterator, class Generator>
-void generate(ForwardIterator first, ForwardIterator last, Generator gen) {
+EASYSTL_CONSTEXPR14 void generate(ForwardIterator first, ForwardIterator last, Generator gen) {
     while (first != last) {
         *first = gen();
         ++first;
@@ -411,7 +669,7 @@ void generate(ForwardIterator first, ForwardIterator last, Generator gen) {
 
 // generate_n
 template <class OutputIterator, class Size, class Generator>
-OutputIterator generate_n(OutputIterator first, Size n, Generator gen) {
+EASYSTL_CONSTEXPR14 OutputIterator generate_n(OutputIterator first, Size n, Generator gen) {
     for (Size i = 0; i < n; ++i) {
         *first = gen();
         ++first;
@@ -421,7 +679,7 @@ OutputIterator generate_n(OutputIterator first, Size n, Generator gen) {
 
 // remove
 template <class ForwardIterator, class T>
-ForwardIterator remove(ForwardIterator first, ForwardIterator last, const T& value) {
+EASYSTL_CONSTEXPR14 ForwardIterator remove(ForwardIterator first, ForwardIterator last, const T& value) {
     ForwardIterator result = first;
     while (first != last) {
         if (!(*first == value)) {
@@ -435,7 +693,7 @@ ForwardIterator remove(ForwardIterator first, ForwardIterator last, const T& val
 
 // remove_if
 template <class ForwardIterator, class UnaryPredicate>
-ForwardIterator remove_if(ForwardIterator first, ForwardIterator last, UnaryPredicate pred) {
+EASYSTL_CONSTEXPR14 ForwardIterator remove_if(ForwardIterator first, ForwardIterator last, UnaryPredicate pred) {
     ForwardIterator result = first;
     while (first != last) {
         if (!pred(*first)) {
@@ -449,7 +707,7 @@ ForwardIterator remove_if(ForwardIterator first, ForwardIterator last, UnaryPred
 
 // remove_copy
 template <class InputIterator, class OutputIterator, class T>
-OutputIterator remove_copy(InputIterator first, InputIterator last, OutputIterator result, const T& value) {
+EASYSTL_CONSTEXPR14 OutputIterator remove_copy(InputIterator first, InputIterator last, OutputIterator result, const T& value) {
     while (first != last) {
         if (!(*first == value)) {
             *result = *first;
@@ -462,7 +720,7 @@ OutputIterator remove_copy(InputIterator first, InputIterator last, OutputIterat
 
 // remove_copy_if
 template <class InputIterator, class OutputIterator, class UnaryPredicate>
-OutputIterator remove_copy_if(InputIterator first, InputIterator last, OutputIterator result, UnaryPredicate pred) {
+EASYSTL_CONSTEXPR14 OutputIterator remove_copy_if(InputIterator first, InputIterator last, OutputIterator result, UnaryPredicate pred) {
     while (first != last) {
         if (!pred(*first)) {
             *result = *first;
@@ -475,7 +733,7 @@ OutputIterator remove_copy_if(InputIterator first, InputIterator last, OutputIte
 
 // unique
 template <class ForwardIterator>
-ForwardIterator unique(ForwardIterator first, ForwardIterator last) {
+EASYSTL_CONSTEXPR14 ForwardIterator unique(ForwardIterator first, ForwardIterator last) {
     if (first == last) {
         return last;
     }
@@ -493,7 +751,7 @@ ForwardIterator unique(ForwardIterator first, ForwardIterator last) {
 
 // unique_copy
 template <class InputIterator, class OutputIterator>
-OutputIterator unique_copy(InputIterator first, InputIterator last, OutputIterator result) {
+EASYSTL_CONSTEXPR14 OutputIterator unique_copy(InputIterator first, InputIterator last, OutputIterator result) {
     if (first == last) {
         return result;
     }
@@ -532,57 +790,342 @@ OutputIterator reverse_copy(BidirectionalIterator first, BidirectionalIterator l
 // partition_point
 
 //------------Sorting operations------------//
-// TODO
+// 内省排序：快排分到kSortThreshold以下的小段后整体做一次插入排序，递归过深时改用堆排序，保证O(nlogn)
+// 全部是constexpr的，C++14起可以在编译期排好查找表
+constexpr ptrdiff_t _kSortThreshold = 16;
+
+template <class RandomAccessIterator, class Compare>
+EASYSTL_CONSTEXPR14 void _insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    if (first == last) {
+        return;
+    }
+    for (RandomAccessIterator i = first + 1; i != last; ++i) {
+        value_type value = std::move(*i);
+        if (comp(value, *first)) {
+            nostd::move_backward(first, i, i + 1);
+            *first = std::move(value);
+        } else {
+            // *first不大于value，往前找的时候不用判断越界
+            RandomAccessIterator hole = i;
+            RandomAccessIterator prev = i - 1;
+            while (comp(value, *prev)) {
+                *hole = std::move(*prev);
+                hole = prev;
+                --prev;
+            }
+            *hole = std::move(value);
+        }
+    }
+}
+
+template <class RandomAccessIterator, class Distance, class T, class Compare>
+EASYSTL_CONSTEXPR14 void _sift_down(RandomAccessIterator first, Distance hole, Distance len, T value, Compare comp) {
+    Distance child = 2 * hole + 1;
+    while (child < len) {
+        if (child + 1 < len && comp(first[child], first[child + 1])) {
+            ++child;
+        }
+        if (!comp(value, first[child])) {
+            break;
+        }
+        first[hole] = std::move(first[child]);
+        hole = child;
+        child = 2 * hole + 1;
+    }
+    first[hole] = std::move(value);
+}
+
+template <class RandomAccessIterator, class Compare>
+EASYSTL_CONSTEXPR14 void _heap_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+    typedef typename std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    difference_type len = last - first;
+    for (difference_type i = len / 2; i > 0;) {
+        --i;
+        value_type value = std::move(first[i]);
+        nostd::_sift_down(first, i, len, std::move(value), comp);
+    }
+    for (difference_type n = len - 1; n > 0; --n) {
+        value_type value = std::move(first[n]);
+        first[n] = std::move(first[0]);
+        nostd::_sift_down(first, difference_type(0), n, std::move(value), comp);
+    }
+}
+
+// 把a、b、c的中位数换到result
+template <class RandomAccessIterator, class Compare>
+EASYSTL_CONSTEXPR14 void _move_median_to_first(RandomAccessIterator result, RandomAccessIterator a, RandomAccessIterator b,
+                                               RandomAccessIterator c, Compare comp) {
+    if (comp(*a, *b)) {
+        if (comp(*b, *c)) {
+            nostd::iter_swap(result, b);
+        } else if (comp(*a, *c)) {
+            nostd::iter_swap(result, c);
+        } else {
+            nostd::iter_swap(result, a);
+        }
+    } else if (comp(*a, *c)) {
+        nostd::iter_swap(result, a);
+    } else if (comp(*b, *c)) {
+        nostd::iter_swap(result, c);
+    } else {
+        nostd::iter_swap(result, b);
+    }
+}
+
+// 以*pivot为界划分[first,last)，三数取中保证两头都有哨兵，扫描时不用判断越界
+template <class RandomAccessIterator, class Compare>
+EASYSTL_CONSTEXPR14 RandomAccessIterator _unguarded_partition(RandomAccessIterator first, RandomAccessIterator last,
+                                                              RandomAccessIterator pivot, Compare comp) {
+    while (true) {
+        while (comp(*first, *pivot)) {
+            ++first;
+        }
+        --last;
+        while (comp(*pivot, *last)) {
+            --last;
+        }
+        if (!(first < last)) {
+            return first;
+        }
+        nostd::iter_swap(first, last);
+        ++first;
+    }
+}
+
+// 返回实际递归的最大深度，用于埋点
+template <class RandomAccessIterator, class Compare>
+EASYSTL_CONSTEXPR14 size_t _introsort_loop(RandomAccessIterator first, RandomAccessIterator last, size_t depth_limit,
+                                           Compare comp, size_t level) {
+    size_t deepest = level;
+    while (last - first > _kSortThreshold) {
+        if (depth_limit == 0) {
+            nostd::_heap_sort(first, last, comp);
+            return deepest;
+        }
+        --depth_limit;
+        RandomAccessIterator mid = first + (last - first) / 2;
+        nostd::_move_median_to_first(first, first + 1, mid, last - 1, comp);
+        RandomAccessIterator cut = nostd::_unguarded_partition(first + 1, last, first, comp);
+        size_t depth = nostd::_introsort_loop(cut, last, depth_limit, comp, level + 1);
+        deepest = depth > deepest ? depth : deepest;
+        last = cut;
+    }
+    return deepest;
+}
+
 // sort
+///@brief sort [first,last) in non-descending order, not stable
+///@param comp binary predicate, comp(a, b) returns true if a is ordered before b
+template <class RandomAccessIterator, class Compare>
+EASYSTL_CONSTEXPR14 void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+    if (last - first < 2) {
+        return;
+    }
+    size_t depth_limit = 0;
+    for (size_t n = static_cast<size_t>(last - first); n > 1; n >>= 1) {
+        depth_limit += 2;
+    }
+    size_t depth = nostd::_introsort_loop(first, last, depth_limit, comp, 0);
+    nostd::_insertion_sort(first, last, comp);
+    if (!nostd::is_constant_evaluated()) {
+        EASYSTL_TRACE_VALUE("sort::depth", depth);
+    }
+    (void)depth;
+}
+
+template <class RandomAccessIterator>
+EASYSTL_CONSTEXPR14 void sort(RandomAccessIterator first, RandomAccessIterator last) {
+    nostd::sort(first, last, _less_op());
+}
+
 // stable_sort
 // partial_sort
 // partial_sort_copy
-// is_sorted
+
 // is_sorted_until
+template <class ForwardIterator, class Compare>
+EASYSTL_CONSTEXPR14 ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last, Compare comp) {
+    if (first == last) {
+        return last;
+    }
+    ForwardIterator next = first;
+    while (++next != last) {
+        if (comp(*next, *first)) {
+            return next;
+        }
+        first = next;
+    }
+    return last;
+}
+
+template <class ForwardIterator>
+EASYSTL_CONSTEXPR14 ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last) {
+    return nostd::is_sorted_until(first, last, _less_op());
+}
+
+// is_sorted
+template <class ForwardIterator, class Compare>
+EASYSTL_CONSTEXPR14 bool is_sorted(ForwardIterator first, ForwardIterator last, Compare comp) {
+    return nostd::is_sorted_until(first, last, comp) == last;
+}
+
+template <class ForwardIterator>
+EASYSTL_CONSTEXPR14 bool is_sorted(ForwardIterator first, ForwardIterator last) {
+    return nostd::is_sorted_until(first, last) == last;
+}
+
 // nth_element
 
 // ----------Binary search (operating on partitioned/sorted ranges)----------//
-// lower_bound
-template <class ForwardIterator, class T>
-ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& value) {
-    while (first != last) {
-        ForwardIterator mid = std::next(first, std::distance(first, last) / 2);
-        if (*mid < value) {
-            first = std::next(mid);
+// 解引用得到的是左值时才能取地址预取，代理迭代器直接跳过
+template <class Iterator>
+EASYSTL_CONSTEXPR14 void _prefetch_at(Iterator it, std::true_type) {
+    if (!nostd::is_constant_evaluated()) {
+        EASYSTL_PREFETCH(std::addressof(*it));
+    }
+}
+
+template <class Iterator>
+EASYSTL_CONSTEXPR14 void _prefetch_at(Iterator, std::false_type) {}
+
+template <class ForwardIterator, class T, class Compare>
+EASYSTL_CONSTEXPR14 ForwardIterator _lower_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp, std::false_type) {
+    size_t len = 0;
+    for (ForwardIterator it = first; it != last; ++it) {
+        ++len;
+    }
+    while (len > 0) {
+        size_t half = len / 2;
+        ForwardIterator mid = first;
+        for (size_t i = 0; i < half; ++i) {
+            ++mid;
+        }
+        if (comp(*mid, value)) {
+            first = ++mid;
+            len -= half + 1;
         } else {
-            last = mid;
+            len = half;
         }
     }
     return first;
 }
 
-// upper_bound
-template <class ForwardIterator, class T>
-ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& value) {
-    while (first != last) {
-        ForwardIterator mid = std::next(first, std::distance(first, last) / 2);
-        if (value < *mid) {
-            last = mid;
+// 无分支的二分：循环次数只和长度有关，每轮一次比较加一次条件选择(编译为cmov)
+// 同时预取下一轮可能访问的两个位置，大数组上把访存延迟重叠起来
+// ref: Khuong & Morin, "Array Layouts for Comparison-Based Searching"
+template <class RandomAccessIterator, class T, class Compare>
+EASYSTL_CONSTEXPR14 RandomAccessIterator _lower_bound(RandomAccessIterator first, RandomAccessIterator last, const T& value, Compare comp,
+                                                      std::true_type) {
+    typedef typename std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+    typedef std::is_lvalue_reference<typename std::iterator_traits<RandomAccessIterator>::reference> prefetchable;
+    difference_type len = last - first;
+    if (len == 0) {
+        return first;
+    }
+    while (len > 1) {
+        difference_type half = len / 2;
+        difference_type next = (len - half) / 2;
+        _prefetch_at(first + next, prefetchable());
+        _prefetch_at(first + (half + next), prefetchable());
+        first = comp(first[half], value) ? first + half : first;
+        len -= half;
+    }
+    return first + static_cast<difference_type>(comp(*first, value));
+}
+
+template <class ForwardIterator, class T, class Compare>
+EASYSTL_CONSTEXPR14 ForwardIterator _upper_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp, std::false_type) {
+    size_t len = 0;
+    for (ForwardIterator it = first; it != last; ++it) {
+        ++len;
+    }
+    while (len > 0) {
+        size_t half = len / 2;
+        ForwardIterator mid = first;
+        for (size_t i = 0; i < half; ++i) {
+            ++mid;
+        }
+        if (!comp(value, *mid)) {
+            first = ++mid;
+            len -= half + 1;
         } else {
-            first = std::next(mid);
+            len = half;
         }
     }
     return first;
 }
 
-// equal_range
+template <class RandomAccessIterator, class T, class Compare>
+EASYSTL_CONSTEXPR14 RandomAccessIterator _upper_bound(RandomAccessIterator first, RandomAccessIterator last, const T& value, Compare comp,
+                                                      std::true_type) {
+    typedef typename std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+    typedef std::is_lvalue_reference<typename std::iterator_traits<RandomAccessIterator>::reference> prefetchable;
+    difference_type len = last - first;
+    if (len == 0) {
+        return first;
+    }
+    while (len > 1) {
+        difference_type half = len / 2;
+        difference_type next = (len - half) / 2;
+        _prefetch_at(first + next, prefetchable());
+        _prefetch_at(first + (half + next), prefetchable());
+        first = comp(value, first[half]) ? first : first + half;
+        len -= half;
+    }
+    return first + static_cast<difference_type>(!comp(value, *first));
+}
+
+// lower_bound
+///@brief first element in the sorted range that is not less than value
+///@param comp binary predicate, comp(element, value) returns true if element is ordered before value
+template <class ForwardIterator, class T, class Compare>
+EASYSTL_CONSTEXPR14 ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp) {
+    return nostd::_lower_bound(first, last, value, comp, _is_random_access_iter<ForwardIterator>());
+}
+
 template <class ForwardIterator, class T>
-std::pair<ForwardIterator, ForwardIterator> equal_range(ForwardIterator first, ForwardIterator last, const T& value) {
-    ForwardIterator lower = lower_bound(first, last, value);
-    ForwardIterator upper = upper_bound(first, last, value);
+EASYSTL_CONSTEXPR14 ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& value) {
+    return nostd::lower_bound(first, last, value, _less_op());
+}
+
+// upper_bound
+///@brief first element in the sorted range that is greater than value
+///@param comp binary predicate, comp(value, element) returns true if value is ordered before element
+template <class ForwardIterator, class T, class Compare>
+EASYSTL_CONSTEXPR14 ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp) {
+    return nostd::_upper_bound(first, last, value, comp, _is_random_access_iter<ForwardIterator>());
+}
+
+template <class ForwardIterator, class T>
+EASYSTL_CONSTEXPR14 ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& value) {
+    return nostd::upper_bound(first, last, value, _less_op());
+}
+
+// equal_range
+template <class ForwardIterator, class T, class Compare>
+EASYSTL_CONSTEXPR14 std::pair<ForwardIterator, ForwardIterator> equal_range(ForwardIterator first, ForwardIterator last, const T& value, Compare comp) {
+    ForwardIterator lower = nostd::lower_bound(first, last, value, comp);
+    ForwardIterator upper = nostd::upper_bound(lower, last, value, comp);
     return std::make_pair(lower, upper);
 }
 
+template <class ForwardIterator, class T>
+EASYSTL_CONSTEXPR14 std::pair<ForwardIterator, ForwardIterator> equal_range(ForwardIterator first, ForwardIterator last, const T& value) {
+    return nostd::equal_range(first, last, value, _less_op());
+}
+
 // binary_search
+template <class ForwardIterator, class T, class Compare>
+EASYSTL_CONSTEXPR14 bool binary_search(ForwardIterator first, ForwardIterator last, const T& value, Compare comp) {
+    ForwardIterator it = nostd::lower_bound(first, last, value, comp);
+    return (it != last && !comp(value, *it));
+}
+
 template <class ForwardIterator, class T>
-bool binary_search(ForwardIterator first, ForwardIterator last, const T& value) {
-    ForwardIterator it = lower_bound(first, last, value);
-    return (it != last && !(value < *it));
+EASYSTL_CONSTEXPR14 bool binary_search(ForwardIterator first, ForwardIterator last, const T& value) {
+    return nostd::binary_search(first, last, value, _less_op());
 }
 
 //-------------Merge (operating on sorted ranges)-------------//
@@ -592,16 +1135,16 @@ OutputIterator merge(InputIterator1 first1, InputIterator1 last1,
                      InputIterator2 first2, InputIterator2 last2,
                      OutputIterator result) {
     while (first1 != last1 && first2 != last2) {
-        if (*first1 < *first2) {
-            *result = *first1;
-            ++first1;
-        } else {
+        if (*first2 < *first1) {
             *result = *first2;
             ++first2;
+        } else {
+            *result = *first1;
+            ++first1;
         }
         ++result;
     }
-    return std::copy(first1, last1, std::copy(first2, last2, result));
+    return nostd::copy(first2, last2, nostd::copy(first1, last1, result));
 }
 
 // inplace_merge
@@ -627,11 +1170,226 @@ bool includes(InputIterator1 first1, InputIterator1 last1,
     return first2 == last2;
 }
 
+/*
+    有序整数区间的集合运算
+    两个输入都是指向同一种整数类型的连续迭代器(指针等)时走下面的特化实现，其余情况走通用的归并，结果完全一致
+    - 两边长度相差_kGallopRatio倍以上时，短区间的每个元素在长区间上做指数(galloping)查找，
+      复杂度O(m*log(n/m))，长区间中跳过的整段直接copy
+    - 长度接近时交集按块做全比较(ref: Lemire et al. "SIMD Compression and the Intersection of Sorted Integers")
+      32位整数需要SSE4.2，64位整数需要AVX2，每次4x4个元素，没有对应指令集时走无分支的标量归并
+    块比较要求元素严格递增，遇到重复元素时从一致的位置回退到标量归并
+*/
+template <class Iterator1, class Iterator2,
+          class T1 = typename std::remove_cv<typename _contiguous_element<Iterator1>::type>::type,
+          class T2 = typename std::remove_cv<typename _contiguous_element<Iterator2>::type>::type>
+struct _is_sorted_int_contiguous
+    : std::integral_constant<bool, is_contiguous_iterator<Iterator1>::value && is_contiguous_iterator<Iterator2>::value &&
+                                       std::is_same<T1, T2>::value && std::is_integral<T1>::value &&
+                                       !std::is_same<T1, bool>::value> {};
+
+constexpr size_t _kGallopRatio = 32;
+
+// 从first开始按1,2,4...的步长向后试探，确定区间后再二分
+template <class T>
+const T* _gallop_lower_bound(const T* first, const T* last, T value) {
+    if (first == last || !(*first < value)) {
+        return first;
+    }
+    size_t n = static_cast<size_t>(last - first);
+    size_t lo = 0;  // first[lo] < value
+    size_t hi = 1;
+    while (hi < n && first[hi] < value) {
+        lo = hi;
+        hi <<= 1;
+    }
+    if (hi > n) {
+        hi = n;
+    }
+    return nostd::lower_bound(first + lo + 1, first + hi, value);
+}
+
+template <class T, class OutputIterator>
+OutputIterator _intersect_scalar(const T* first1, const T* last1, const T* first2, const T* last2, OutputIterator result) {
+    while (first1 != last1 && first2 != last2) {
+        T a = *first1;
+        T b = *first2;
+        if (a == b) {
+            *result = a;
+            ++result;
+            ++first1;
+            ++first2;
+        } else {
+            first1 += (a < b);
+            first2 += (b < a);
+        }
+    }
+    return result;
+}
+
+template <class T, class OutputIterator>
+OutputIterator _intersect_gallop(const T* small, const T* small_last, const T* large, const T* large_last, OutputIterator result) {
+    while (small != small_last && large != large_last) {
+        large = _gallop_lower_bound(large, large_last, *small);
+        if (large != large_last && !(*small < *large)) {
+            *result = *small;
+            ++result;
+            ++large;
+        }
+        ++small;
+    }
+    return result;
+}
+
+#if defined(EASYSTL_HAS_SSE42)
+struct _u32x4_ops {
+    typedef __m128i vec;
+    static vec load(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+    // 所有lane都是第一个元素取反，作为第一块的"前一块"
+    static vec sentinel(vec v) { return _mm_xor_si128(_mm_shuffle_epi32(v, 0), _mm_set1_epi32(-1)); }
+    // a中在b里出现过的lane
+    static int match(vec a, vec b) {
+        vec m = _mm_cmpeq_epi32(a, b);
+        m = _mm_or_si128(m, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1))));
+        m = _mm_or_si128(m, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2))));
+        m = _mm_or_si128(m, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3))));
+        return _mm_movemask_ps(_mm_castsi128_ps(m));
+    }
+    // v和前一块的最后一个元素拼起来，是否有相邻相等的元素
+    static bool has_dup(vec v, vec prev) {
+        return _mm_movemask_epi8(_mm_cmpeq_epi32(v, _mm_alignr_epi8(v, prev, 12))) != 0;
+    }
+};
+#endif
+
+#if defined(EASYSTL_HAS_AVX2)
+struct _u64x4_ops {
+    typedef __m256i vec;
+    static vec load(const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+    static vec sentinel(vec v) { return _mm256_xor_si256(_mm256_permute4x64_epi64(v, 0), _mm256_set1_epi64x(-1)); }
+    static int match(vec a, vec b) {
+        vec m = _mm256_cmpeq_epi64(a, b);
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1))));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, _MM_SHUFFLE(1, 0, 3, 2))));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, _MM_SHUFFLE(2, 1, 0, 3))));
+        return _mm256_movemask_pd(_mm256_castsi256_pd(m));
+    }
+    static bool has_dup(vec v, vec prev) {
+        vec shifted = _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 1, 0, 3)),
+                                         _mm256_permute4x64_epi64(prev, _MM_SHUFFLE(3, 3, 3, 3)), 0x03);
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi64(v, shifted)) != 0;
+    }
+};
+#endif
+
+// 每次取两边各4个元素做全比较，块最大值较小的一边前进
+// 退出时所有<=bound的元素都已经处理完，且输出过的元素都<=bound，从bound处接着做标量归并
+template <class Ops, class T, class OutputIterator>
+OutputIterator _intersect_blocks(const T* first1, const T* last1, const T* first2, const T* last2, OutputIterator result) {
+    const ptrdiff_t kLanes = 4;
+    if (last1 - first1 < kLanes || last2 - first2 < kLanes) {
+        return _intersect_scalar(first1, last1, first2, last2, result);
+    }
+    typename Ops::vec va = Ops::load(first1);
+    typename Ops::vec vb = Ops::load(first2);
+    if (Ops::has_dup(va, Ops::sentinel(va)) || Ops::has_dup(vb, Ops::sentinel(vb))) {
+        return _intersect_scalar(first1, last1, first2, last2, result);
+    }
+    const T* begin1 = first1;
+    const T* begin2 = first2;
+    T bound;
+    T emitted = T();
+    bool any = false;
+    for (;;) {
+        int mask = Ops::match(va, vb);
+        while (mask != 0) {
+            emitted = first1[nostd::countr_zero(static_cast<uint64_t>(mask))];
+            *result = emitted;
+            ++result;
+            any = true;
+            mask &= mask - 1;
+        }
+        const T amax = first1[kLanes - 1];
+        const T bmax = first2[kLanes - 1];
+        bound = amax < bmax ? amax : bmax;
+        bool stop = false;
+        if (!(bmax < amax)) {
+            first1 += kLanes;
+            if (last1 - first1 < kLanes) {
+                stop = true;
+            } else {
+                typename Ops::vec prev = va;
+                va = Ops::load(first1);
+                stop = Ops::has_dup(va, prev);
+            }
+        }
+        if (!stop && !(amax < bmax)) {
+            first2 += kLanes;
+            if (last2 - first2 < kLanes) {
+                stop = true;
+            } else {
+                typename Ops::vec prev = vb;
+                vb = Ops::load(first2);
+                stop = Ops::has_dup(vb, prev);
+            }
+        }
+        if (stop) {
+            break;
+        }
+    }
+    first1 = nostd::lower_bound(begin1, last1, bound);
+    first2 = nostd::lower_bound(begin2, last2, bound);
+    if (any && emitted == bound) {
+        // bound已经输出过一次，两边各消耗掉一个
+        ++first1;
+        ++first2;
+    }
+    return _intersect_scalar(first1, last1, first2, last2, result);
+}
+
+template <class T, class OutputIterator, size_t N>
+OutputIterator _intersect_dense(const T* first1, const T* last1, const T* first2, const T* last2, OutputIterator result,
+                                std::integral_constant<size_t, N>) {
+    return _intersect_scalar(first1, last1, first2, last2, result);
+}
+
+#if defined(EASYSTL_HAS_SSE42)
+template <class T, class OutputIterator>
+OutputIterator _intersect_dense(const T* first1, const T* last1, const T* first2, const T* last2, OutputIterator result,
+                                std::integral_constant<size_t, 4>) {
+    return _intersect_blocks<_u32x4_ops>(first1, last1, first2, last2, result);
+}
+#endif
+
+#if defined(EASYSTL_HAS_AVX2)
+template <class T, class OutputIterator>
+OutputIterator _intersect_dense(const T* first1, const T* last1, const T* first2, const T* last2, OutputIterator result,
+                                std::integral_constant<size_t, 8>) {
+    return _intersect_blocks<_u64x4_ops>(first1, last1, first2, last2, result);
+}
+#endif
+
+// 长区间中小于当前元素的整段直接copy
+template <class T, class OutputIterator>
+OutputIterator _union_gallop(const T* small, const T* small_last, const T* large, const T* large_last, OutputIterator result) {
+    while (small != small_last) {
+        const T* pos = _gallop_lower_bound(large, large_last, *small);
+        result = nostd::copy(large, pos, result);
+        large = pos;
+        *result = *small;
+        ++result;
+        if (large != large_last && !(*small < *large)) {
+            ++large;
+        }
+        ++small;
+    }
+    return nostd::copy(large, large_last, result);
+}
+
 // set_union
 template <class InputIterator1, class InputIterator2, class OutputIterator>
-OutputIterator set_union(InputIterator1 first1, InputIterator1 last1,
-                         InputIterator2 first2, InputIterator2 last2,
-                         OutputIterator result) {
+OutputIterator _set_union(InputIterator1 first1, InputIterator1 last1,
+                          InputIterator2 first2, InputIterator2 last2,
+                          OutputIterator result, std::false_type) {
     while (first1 != last1 && first2 != last2) {
         if (*first1 < *first2) {
             *result = *first1;
@@ -646,14 +1404,41 @@ OutputIterator set_union(InputIterator1 first1, InputIterator1 last1,
         }
         ++result;
     }
-    return std::copy(first1, last1, std::copy(first2, last2, result));
+    return nostd::copy(first2, last2, nostd::copy(first1, last1, result));
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator>
+OutputIterator _set_union(InputIterator1 first1, InputIterator1 last1,
+                          InputIterator2 first2, InputIterator2 last2,
+                          OutputIterator result, std::true_type) {
+    typedef typename std::remove_cv<typename _contiguous_element<InputIterator1>::type>::type value_type;
+    const value_type* f1 = nostd::to_address(first1);
+    const value_type* l1 = nostd::to_address(last1);
+    const value_type* f2 = nostd::to_address(first2);
+    const value_type* l2 = nostd::to_address(last2);
+    size_t n1 = static_cast<size_t>(l1 - f1);
+    size_t n2 = static_cast<size_t>(l2 - f2);
+    if (n1 * _kGallopRatio < n2) {
+        return _union_gallop(f1, l1, f2, l2, result);
+    }
+    if (n2 * _kGallopRatio < n1) {
+        return _union_gallop(f2, l2, f1, l1, result);
+    }
+    return _set_union(f1, l1, f2, l2, result, std::false_type());
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator>
+OutputIterator set_union(InputIterator1 first1, InputIterator1 last1,
+                         InputIterator2 first2, InputIterator2 last2,
+                         OutputIterator result) {
+    return _set_union(first1, last1, first2, last2, result, _is_sorted_int_contiguous<InputIterator1, InputIterator2>());
 }
 
 // set_intersection
 template <class InputIterator1, class InputIterator2, class OutputIterator>
-OutputIterator set_intersection(InputIterator1 first1, InputIterator1 last1,
-                                InputIterator2 first2, InputIterator2 last2,
-                                OutputIterator result) {
+OutputIterator _set_intersection(InputIterator1 first1, InputIterator1 last1,
+                                 InputIterator2 first2, InputIterator2 last2,
+                                 OutputIterator result, std::false_type) {
     while (first1 != last1 && first2 != last2) {
         if (*first1 < *first2) {
             ++first1;
@@ -669,11 +1454,38 @@ OutputIterator set_intersection(InputIterator1 first1, InputIterator1 last1,
     return result;
 }
 
+template <class InputIterator1, class InputIterator2, class OutputIterator>
+OutputIterator _set_intersection(InputIterator1 first1, InputIterator1 last1,
+                                 InputIterator2 first2, InputIterator2 last2,
+                                 OutputIterator result, std::true_type) {
+    typedef typename std::remove_cv<typename _contiguous_element<InputIterator1>::type>::type value_type;
+    const value_type* f1 = nostd::to_address(first1);
+    const value_type* l1 = nostd::to_address(last1);
+    const value_type* f2 = nostd::to_address(first2);
+    const value_type* l2 = nostd::to_address(last2);
+    size_t n1 = static_cast<size_t>(l1 - f1);
+    size_t n2 = static_cast<size_t>(l2 - f2);
+    if (n1 * _kGallopRatio < n2) {
+        return _intersect_gallop(f1, l1, f2, l2, result);
+    }
+    if (n2 * _kGallopRatio < n1) {
+        return _intersect_gallop(f2, l2, f1, l1, result);
+    }
+    return _intersect_dense(f1, l1, f2, l2, result, std::integral_constant<size_t, sizeof(value_type)>());
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator>
+OutputIterator set_intersection(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result) {
+    return _set_intersection(first1, last1, first2, last2, result, _is_sorted_int_contiguous<InputIterator1, InputIterator2>());
+}
+
 // set_difference
 template <class InputIterator1, class InputIterator2, class OutputIterator>
-OutputIterator set_difference(InputIterator1 first1, InputIterator1 last1,
-                              InputIterator2 first2, InputIterator2 last2,
-                              OutputIterator result) {
+OutputIterator _set_difference(InputIterator1 first1, InputIterator1 last1,
+                               InputIterator2 first2, InputIterator2 last2,
+                               OutputIterator result, std::false_type) {
     while (first1 != last1 && first2 != last2) {
         if (*first1 < *first2) {
             *result = *first1;
@@ -686,7 +1498,55 @@ OutputIterator set_difference(InputIterator1 first1, InputIterator1 last1,
             ++first2;
         }
     }
-    return std::copy(first1, last1, result);
+    return nostd::copy(first1, last1, result);
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator>
+OutputIterator _set_difference(InputIterator1 first1, InputIterator1 last1,
+                               InputIterator2 first2, InputIterator2 last2,
+                               OutputIterator result, std::true_type) {
+    typedef typename std::remove_cv<typename _contiguous_element<InputIterator1>::type>::type value_type;
+    const value_type* f1 = nostd::to_address(first1);
+    const value_type* l1 = nostd::to_address(last1);
+    const value_type* f2 = nostd::to_address(first2);
+    const value_type* l2 = nostd::to_address(last2);
+    size_t n1 = static_cast<size_t>(l1 - f1);
+    size_t n2 = static_cast<size_t>(l2 - f2);
+    if (n1 * _kGallopRatio < n2) {
+        // 被减的区间很短：逐个在长区间上查找
+        while (f1 != l1 && f2 != l2) {
+            f2 = _gallop_lower_bound(f2, l2, *f1);
+            if (f2 != l2 && !(*f1 < *f2)) {
+                ++f2;
+            } else {
+                *result = *f1;
+                ++result;
+            }
+            ++f1;
+        }
+        return nostd::copy(f1, l1, result);
+    }
+    if (n2 * _kGallopRatio < n1) {
+        // 减去的区间很短：两个元素之间的整段直接copy
+        while (f1 != l1 && f2 != l2) {
+            const value_type* pos = _gallop_lower_bound(f1, l1, *f2);
+            result = nostd::copy(f1, pos, result);
+            f1 = pos;
+            if (f1 != l1 && !(*f2 < *f1)) {
+                ++f1;
+            }
+            ++f2;
+        }
+        return nostd::copy(f1, l1, result);
+    }
+    return _set_difference(f1, l1, f2, l2, result, std::false_type());
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator>
+OutputIterator set_difference(InputIterator1 first1, InputIterator1 last1,
+                              InputIterator2 first2, InputIterator2 last2,
+                              OutputIterator result) {
+    return _set_difference(first1, last1, first2, last2, result, _is_sorted_int_contiguous<InputIterator1, InputIterator2>());
 }
 
 // set_symmetric_difference
@@ -708,7 +1568,7 @@ OutputIterator set_symmetric_difference(InputIterator1 first1, InputIterator1 la
             ++first2;
         }
     }
-    return std::copy(first1, last1, std::copy(first2, last2, result));
+    return nostd::copy(first2, last2, nostd::copy(first1, last1, result));
 }
 
 //-----------Heap operations-----------//
@@ -720,7 +1580,7 @@ void push_heap(RandomAccessIterator first, RandomAccessIterator last) {
     difference_type hole = len - 1;
     difference_type parent = (hole - 1) / 2;
     while (hole > 0 && *(first + hole) > *(first + parent)) {
-        iter_swap(first + hole, first + parent);
+        nostd::iter_swap(first + hole, first + parent);
         hole = parent;
         parent = (hole - 1) / 2;
     }
@@ -731,7 +1591,7 @@ template <class RandomAccessIterator>
 void pop_heap(RandomAccessIterator first, RandomAccessIterator last) {
     typedef typename std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
     difference_type len = std::distance(first, last);
-    iter_swap(first, first + len - 1);
+    nostd::iter_swap(first, first + len - 1);
     difference_type hole = 0;
     difference_type child = 2 * hole + 1;
     while (child < len - 1) {
@@ -739,7 +1599,7 @@ void pop_heap(RandomAccessIterator first, RandomAccessIterator last) {
             ++child;
         }
         if (*(first + hole) < *(first + child)) {
-            iter_swap(first + hole, first + child);
+            nostd::iter_swap(first + hole, first + child);
             hole = child;
             child = 2 * hole + 1;
         } else {
@@ -751,6 +1611,7 @@ void pop_heap(RandomAccessIterator first, RandomAccessIterator last) {
 // make_heap
 template <class RandomAccessIterator>
 void make_heap(RandomAccessIterator first, RandomAccessIterator last) {
+    EASYSTL_TRACE_SCOPE("make_heap");
     typedef typename std::iterator_traits<RandomAccessIterator>::difference_type difference_type;
     difference_type len = std::distance(first, last);
     for (difference_type i = len / 2 - 1; i >= 0; --i) {
@@ -761,7 +1622,7 @@ void make_heap(RandomAccessIterator first, RandomAccessIterator last) {
                 ++child;
             }
             if (*(first + hole) < *(first + child)) {
-                iter_swap(first + hole, first + child);
+                nostd::iter_swap(first + hole, first + child);
                 hole = child;
                 child = 2 * hole + 1;
             } else {
@@ -774,8 +1635,9 @@ void make_heap(RandomAccessIterator first, RandomAccessIterator last) {
 // sort_heap
 template <class RandomAccessIterator>
 void sort_heap(RandomAccessIterator first, RandomAccessIterator last) {
+    EASYSTL_TRACE_SCOPE("sort_heap");
     while (first != last) {
-        pop_heap(first, last);
+        nostd::pop_heap(first, last);
         --last;
     }
 }
@@ -808,18 +1670,18 @@ RandomAccessIterator is_heap_until(RandomAccessIterator first, RandomAccessItera
 
 //-----------Min/max operations-----------//
 template <typename T>
-const T& min(const T& a, const T& b) {
+EASYSTL_CONSTEXPR14 const T& min(const T& a, const T& b) {
     return !(b < a) ? a : b;
 }
 
 template <typename T, typename Compare>
-const T& min(const T& a, const T& b, Compare cmp) {
+EASYSTL_CONSTEXPR14 const T& min(const T& a, const T& b, Compare cmp) {
     return !cmp(a < b) ? a : b;
 }
 
 // min_element
 template <class ForwardIterator>
-ForwardIterator min_element(ForwardIterator first, ForwardIterator last) {
+EASYSTL_CONSTEXPR14 ForwardIterator min_element(ForwardIterator first, ForwardIterator last) {
     if (first == last) {
         return last;
     }
@@ -836,7 +1698,7 @@ ForwardIterator min_element(ForwardIterator first, ForwardIterator last) {
 
 // max_element
 template <class ForwardIterator>
-ForwardIterator max_element(ForwardIterator first, ForwardIterator last) {
+EASYSTL_CONSTEXPR14 ForwardIterator max_element(ForwardIterator first, ForwardIterator last) {
     if (first == last) {
         return last;
     }
@@ -853,7 +1715,7 @@ ForwardIterator max_element(ForwardIterator first, ForwardIterator last) {
 
 // minmax_element
 template <class ForwardIterator>
-std::pair<ForwardIterator, ForwardIterator> minmax_element(ForwardIterator first, ForwardIterator last) {
+EASYSTL_CONSTEXPR14 std::pair<ForwardIterator, ForwardIterator> minmax_element(ForwardIterator first, ForwardIterator last) {
     if (first == last) {
         return std::make_pair(last, last);
     }
@@ -875,8 +1737,8 @@ std::pair<ForwardIterator, ForwardIterator> minmax_element(ForwardIterator first
 //-----------other operations-----------//
 // lexicographical_compare
 template <class InputIterator1, class InputIterator2>
-bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
-                             InputIterator2 first2, InputIterator2 last2) {
+EASYSTL_CONSTEXPR14 bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                                 InputIterator2 first2, InputIterator2 last2) {
     while (first1 != last1 && first2 != last2) {
         if (*first1 < *first2) {
             return true;
@@ -907,7 +1769,7 @@ bool next_permutation(BidirectionalIterator first, BidirectionalIterator last) {
             i2 = last;
             while (!(*i < *--i2)) {
             }
-            iter_swap(i, i2);
+            nostd::iter_swap(i, i2);
             reverse(i1, last);
             return true;
         }
@@ -935,7 +1797,7 @@ bool prev_permutation(BidirectionalIterator first, BidirectionalIterator last) {
             i2 = last;
             while (!(*--i2 < *i)) {
             }
-            iter_swap(i, i2);
+            nostd::iter_swap(i, i2);
             reverse(i1, last);
             return true;
         }
@@ -0,0 +1,73 @@
+/*
+    ref: https://zh.cppreference.com/w/cpp/header/bit
+
+    popcount        统计为1的位数
+    countr_zero     从最低位开始连续0的个数(ctz)
+    countl_zero     从最高位开始连续0的个数(clz)
+
+    GCC/Clang下使用内建函数，开启-mpopcnt/-mbmi后会直接生成popcnt/tzcnt指令
+*/
+#ifndef __BIT_H
+#define __BIT_H
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#endif
+
+namespace nostd {
+
+inline int popcount(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(x));
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// x为0时返回64
+inline int countr_zero(uint64_t x) noexcept {
+    if (x == 0) {
+        return 64;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return popcount((x & (0 - x)) - 1);
+#endif
+}
+
+// x为0时返回64
+inline int countl_zero(uint64_t x) noexcept {
+    if (x == 0) {
+        return 64;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return 63 - static_cast<int>(index);
+#else
+    int n = 0;
+    while (!(x & (uint64_t(1) << 63))) {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+}  // namespace nostd
+
+#endif  // !__BIT_H
@@ -0,0 +1,210 @@
+#ifndef __CHAR_TRAITS_H
+#define __CHAR_TRAITS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>  // For EOF.
+#include <cstring>
+#include <cwchar>
+#include <ios>
+
+#include "base/config.h"
+
+namespace nostd {
+
+// https://github.com/dwdwdw/stl/blob/master/llvm/include/string
+
+template <class CharType, class IntType>
+class char_traits_base {
+ public:
+    using char_type = CharType;       // char_type:The template parameter (charT)
+    using int_type = IntType;         // int_type: Integral type that can represent all charT values, as well as eof()
+    using off_type = std::streamoff;  // off_type: A type that behaves like streamoff
+    using pos_type = std::streampos;  // pos_type: A type that behaves like streampos
+    using state_type = mbstate_t;     // state_type: Multibyte transformation state type, such as mbstate_t
+ public:
+    // 字符比较
+    static constexpr bool eq(const char_type &c1, const char_type &c2) noexcept {
+        return c1 == c2;
+    }
+
+    // 字符大小比较
+    static constexpr bool lt(const char_type &c1, const char_type &c2) noexcept {
+        return c1 < c2;
+    }
+
+    // 字串长度
+    static EASYSTL_CONSTEXPR14 size_t length(const char_type *s) noexcept {
+        const char_type __nullchar = char_type(0);  // char()就是'\0'
+        size_t len = 0;
+        for (; !eq(*s, __nullchar); ++s) {
+            ++len;
+        }
+        return len;
+    }
+
+    // 字符赋值
+    static void assign(char_type &c1, const char_type &c2) noexcept { c1 = c2; }
+    // 字符串赋值
+    static char_type *assign(char_type *s, size_t n, char_type c) noexcept {
+        for (size_t i = 0; i < n; ++i)
+            s[i] = c;
+        return s;
+    }
+
+    // 字串比较
+    static EASYSTL_CONSTEXPR14 int compare(const char_type *s1, const char_type *s2, size_t n) noexcept {
+        for (size_t i = 0; i < n; ++i)
+            if (!eq(s1[i], s2[i]))
+                return s1[i] < s2[i] ? -1 : 1;
+        return 0;
+    }
+
+    // 在串中查找字符
+    static const char_type *find(const char_type *s, size_t n, const char_type &c) noexcept {
+        for (; n > 0; ++s, --n)
+            if (eq(*s, c))
+                return s;
+        return 0;
+    }
+
+    // 字符串移到另一字符串
+    static char_type *move(char_type *__s1, const char_type *__s2, size_t __n) noexcept {
+        char_type *__r = __s1;
+        if (__s1 < __s2) {
+            for (; __n; --__n, ++__s1, ++__s2)
+                assign(*__s1, *__s2);
+        } else if (__s2 < __s1) {
+            // 防止内存重叠导致覆盖
+            __s1 += __n;
+            __s2 += __n;
+            for (; __n; --__n)
+                assign(*--__s1, *--__s2);
+        }
+        return __r;
+    }
+
+    // 拷贝一字符串到另字符串
+    static char_type *copy(char_type *__s1, const char_type *__s2, size_t __n) noexcept {
+        char_type *__r = __s1;
+        for (; __n; --__n, ++__s1, ++__s2)
+            assign(*__s1, *__s2);
+        return __r;
+    }
+
+    // 返回结束整型值
+    static int_type eof() noexcept {
+        return int_type(EOF);
+    }
+
+    // 判断是否为结束符
+    static int_type not_eof(int_type c) noexcept {
+        return eq_int_type(c, eof()) ? ~eof() : c;
+    }
+
+    // int到char类型的转换
+    static char_type to_char_type(int_type c) noexcept {
+        return static_cast<char_type>(c);
+    }
+
+    // char到int类型的转换
+    static int_type to_int_type(char_type c) noexcept {
+        return static_cast<int_type>(c);
+    }
+
+    // 判断俩int类型是否相等
+    static bool eq_int_type(int_type c1, int_type c2) noexcept {
+        return c1 == c2;
+    }
+};
+
+// 灵活性：可以实现对不同的字符类型定制化字符特征
+template <class _CharT>
+class char_traits : public char_traits_base<_CharT, int> {};
+
+// Specialization for char.
+template <>
+class char_traits<char> : public char_traits_base<char, int> {
+ public:
+    static char_type to_char_type(const int_type &c) {
+        return static_cast<char_type>(static_cast<unsigned char>(c));
+    }
+    static int_type to_int_type(const char_type &c) {
+        return static_cast<unsigned char>(c);
+    }
+    // 编译期求值时不能调用memcmp/strlen，逐个字符按unsigned char比较，和memcmp的结果一致
+    static EASYSTL_CONSTEXPR14 int compare(const char *s1, const char *s2, size_t n) {
+        if (nostd::is_constant_evaluated()) {
+            for (size_t i = 0; i < n; ++i) {
+                if (s1[i] != s2[i]) {
+                    return static_cast<unsigned char>(s1[i]) < static_cast<unsigned char>(s2[i]) ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+        return n == 0 ? 0 : memcmp(s1, s2, n);
+    }
+    static char *copy(char *s1, const char *s2, size_t n) {
+        return n == 0 ? s1 : static_cast<char *>(memcpy(s1, s2, n));
+    }
+    static char *move(char *s1, const char *s2, size_t n) {
+        return n == 0 ? s1 : static_cast<char *>(memmove(s1, s2, n));
+    }
+    static const char *find(const char *s, size_t n, const char &c) {
+        return n == 0 ? nullptr : static_cast<const char *>(memchr(s, static_cast<unsigned char>(c), n));
+    }
+    static EASYSTL_CONSTEXPR14 size_t length(const char *s) {
+        return nostd::is_constant_evaluated() ? char_traits_base::length(s) : strlen(s);
+    }
+    static void assign(char &c1, const char &c2) { c1 = c2; }
+    static char *assign(char *s, size_t n, char c) {
+        memset(s, c, n);
+        return s;
+    }
+};
+
+// Specialization for wchar_t.
+template <>
+class char_traits<wchar_t> : public char_traits_base<wchar_t, wint_t> {
+ public:
+    static wchar_t to_char_type(const int_type &c) { return static_cast<wchar_t>(c); }
+    static int_type to_int_type(const wchar_t &c) { return static_cast<int_type>(c); }
+    static EASYSTL_CONSTEXPR14 int compare(const wchar_t *s1, const wchar_t *s2, size_t n) {
+        if (nostd::is_constant_evaluated()) {
+            return char_traits_base::compare(s1, s2, n);
+        }
+        return n == 0 ? 0 : wmemcmp(s1, s2, n);
+    }
+    static wchar_t *copy(wchar_t *s1, const wchar_t *s2, size_t n) {
+        return n == 0 ? s1 : wmemcpy(s1, s2, n);
+    }
+    static wchar_t *move(wchar_t *s1, const wchar_t *s2, size_t n) {
+        return n == 0 ? s1 : wmemmove(s1, s2, n);
+    }
+    static EASYSTL_CONSTEXPR14 size_t length(const wchar_t *s) {
+        return nostd::is_constant_evaluated() ? char_traits_base::length(s) : wcslen(s);
+    }
+    static void assign(wchar_t &c1, const wchar_t &c2) { c1 = c2; }
+    static wchar_t *assign(wchar_t *s, size_t n, wchar_t c) {
+        wmemset(s, c, n);
+        return s;
+    }
+};
+
+// Specialization for char16_t.
+template <>
+class char_traits<char16_t> : public char_traits_base<char16_t, uint_least16_t> {
+ public:
+    using pos_type = std::u16streampos;
+};
+
+// Specialization for char32_t.
+template <>
+class char_traits<char32_t> : public char_traits_base<char32_t, uint_least32_t> {
+ public:
+    using pos_type = std::u32streampos;
+};
+
+}  // namespace nostd
+
+#endif  // !__CHAR_TRAITS_H
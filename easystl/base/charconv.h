@@ -0,0 +1,1354 @@
+/*
+    ref: https://zh.cppreference.com/w/cpp/header/charconv
+
+    to_chars        整数/浮点数写成字符串，不依赖locale，不调用snprintf
+    from_chars      从字符串解析整数/浮点数
+
+    整数：十进制每次按两位从"00".."99"的表里取字符，先用位宽估算出位数，从后往前一次写完
+    浮点写出：Grisu2，输出能精确读回原值的十进制串；绝大多数是最短的，
+             约0.05%的double会比最短表示多一位(Grisu2没有Grisu3的精确回退)
+             ref: Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers"
+             格式和std::to_chars(first, last, value)一致：定点和科学计数法中取较短的，长度相同取定点
+    浮点解析：尾数不超过2^53且指数在±22以内时直接一次乘除(Clinger)；否则Eisel-Lemire，
+             用128位截断的10的幂做一次乘法得到结果；落在舍入边界上无法判定时，
+             用大整数精确比较，保证结果是正确舍入的
+             ref: Lemire, "Number Parsing at a Gigabyte per Second"
+
+    10的幂表(128位尾数)在第一次使用浮点转换时用大整数算出来，不占用源码里的大表
+*/
+#ifndef __CHARCONV_H
+#define __CHARCONV_H
+
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#include "base/bit.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#endif
+
+namespace nostd {
+
+struct to_chars_result {
+    char *ptr;
+    std::errc ec;
+};
+
+struct from_chars_result {
+    const char *ptr;
+    std::errc ec;
+};
+
+// 浮点数的写出格式；general在定点和科学计数法中选较短的一种(带精度时同printf的%g)
+enum class chars_format {
+    scientific = 1,
+    fixed = 2,
+    general = fixed | scientific,
+};
+
+namespace _charconv {
+
+/*****************************************************************************************/
+// 整数
+/*****************************************************************************************/
+
+inline const char *digits2(size_t i) noexcept {
+    static const char kTable[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+    return kTable + i * 2;
+}
+
+// 十进制位数：由二进制位数估算，再和10的幂比较修正一次
+inline int count_digits(uint64_t v) noexcept {
+    static const uint64_t kPow10[] = {
+        0,
+        10ULL,
+        100ULL,
+        1000ULL,
+        10000ULL,
+        100000ULL,
+        1000000ULL,
+        10000000ULL,
+        100000000ULL,
+        1000000000ULL,
+        10000000000ULL,
+        100000000000ULL,
+        1000000000000ULL,
+        10000000000000ULL,
+        100000000000000ULL,
+        1000000000000000ULL,
+        10000000000000000ULL,
+        100000000000000000ULL,
+        1000000000000000000ULL,
+        10000000000000000000ULL,
+    };
+    int t = ((64 - nostd::countl_zero(v | 1)) * 1233) >> 12;
+    return t + (v >= kPow10[t] ? 1 : 0);
+}
+
+// 把v写到[end - count_digits(v), end)
+inline void write_decimal(char *end, uint64_t v) noexcept {
+    while (v >= 100) {
+        const char *d = digits2(static_cast<size_t>(v % 100));
+        v /= 100;
+        *--end = d[1];
+        *--end = d[0];
+    }
+    if (v >= 10) {
+        const char *d = digits2(static_cast<size_t>(v));
+        *--end = d[1];
+        *--end = d[0];
+    } else {
+        *--end = static_cast<char>('0' + v);
+    }
+}
+
+inline to_chars_result write_unsigned(char *first, char *last, uint64_t v, int base) noexcept {
+    if (base == 10) {
+        int n = count_digits(v);
+        if (last - first < n) {
+            return {last, std::errc::value_too_large};
+        }
+        write_decimal(first + n, v);
+        return {first + n, std::errc()};
+    }
+    static const char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    char buf[64];
+    char *p = buf + sizeof(buf);
+    do {
+        *--p = kDigits[v % static_cast<unsigned>(base)];
+        v /= static_cast<unsigned>(base);
+    } while (v != 0);
+    size_t n = static_cast<size_t>(buf + sizeof(buf) - p);
+    if (static_cast<size_t>(last - first) < n) {
+        return {last, std::errc::value_too_large};
+    }
+    std::memcpy(first, p, n);
+    return {first + n, std::errc()};
+}
+
+inline int digit_value(char c) noexcept {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    unsigned char l = static_cast<unsigned char>(c | 0x20);
+    if (l >= 'a' && l <= 'z') {
+        return l - 'a' + 10;
+    }
+    return 99;
+}
+
+// 解析无符号的数字部分，溢出时仍然吃掉所有数字
+inline from_chars_result parse_unsigned(const char *first, const char *last, uint64_t max, uint64_t &out, int base) noexcept {
+    const char *p = first;
+    uint64_t v = 0;
+    bool overflow = false;
+    const uint64_t limit = max / static_cast<unsigned>(base);
+    for (; p != last; ++p) {
+        int d = digit_value(*p);
+        if (d >= base) {
+            break;
+        }
+        if (v > limit || (v == limit && static_cast<uint64_t>(d) > max - limit * static_cast<unsigned>(base))) {
+            overflow = true;
+        } else {
+            v = v * static_cast<unsigned>(base) + static_cast<unsigned>(d);
+        }
+    }
+    if (p == first) {
+        return {first, std::errc::invalid_argument};
+    }
+    if (overflow) {
+        return {p, std::errc::result_out_of_range};
+    }
+    out = v;
+    return {p, std::errc()};
+}
+
+// 整数解析，base不在[2, 36]之间时返回invalid_argument；
+// prefix为true时同strtol/strtoul：base为0按"0x"/"0"前缀推断进制，base为16时允许"0x"前缀，
+// 无符号类型也接受'-'，绝对值不超出范围时按无符号取反(strtoul("-1")是最大值)
+template <class T>
+from_chars_result integer_from_chars(const char *first, const char *last, T &value, int base, bool prefix) noexcept {
+    using U = typename std::make_unsigned<T>::type;
+    const char *p = first;
+    bool neg = false;
+    if ((std::is_signed<T>::value || prefix) && p != last && *p == '-') {
+        neg = true;
+        ++p;
+    }
+    if (prefix && (base == 0 || base == 16) && last - p > 2 && p[0] == '0' && (p[1] | 0x20) == 'x' && digit_value(p[2]) < 16) {
+        p += 2;
+        base = 16;
+    } else if (prefix && base == 0) {
+        base = p != last && *p == '0' ? 8 : 10;
+    }
+    if (base < 2 || base > 36) {
+        return {first, std::errc::invalid_argument};
+    }
+    uint64_t max = std::is_signed<T>::value ? static_cast<uint64_t>(std::numeric_limits<T>::max()) + (neg ? 1 : 0)
+                                            : static_cast<uint64_t>(std::numeric_limits<T>::max());
+    uint64_t u = 0;
+    from_chars_result r = parse_unsigned(p, last, max, u, base);
+    if (r.ec == std::errc::invalid_argument) {
+        return {first, r.ec};
+    }
+    if (r.ec == std::errc()) {
+        value = static_cast<T>(neg ? static_cast<U>(U(0) - static_cast<U>(u)) : static_cast<U>(u));
+    }
+    return r;
+}
+
+/*****************************************************************************************/
+// 浮点公共部分
+/*****************************************************************************************/
+
+inline uint64_t mul128(uint64_t a, uint64_t b, uint64_t &hi) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    hi = static_cast<uint64_t>(r >> 64);
+    return static_cast<uint64_t>(r);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, &hi);
+#else
+    uint64_t ha = a >> 32, la = a & 0xffffffffULL, hb = b >> 32, lb = b & 0xffffffffULL;
+    uint64_t p0 = la * lb, p1 = la * hb, p2 = ha * lb, p3 = ha * hb;
+    uint64_t mid = (p0 >> 32) + (p1 & 0xffffffffULL) + (p2 & 0xffffffffULL);
+    hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+    return (mid << 32) | (p0 & 0xffffffffULL);
+#endif
+}
+
+// floor(q * log2(10))，|q| <= 1233时准确
+inline int floor_log2_pow10(int q) noexcept { return (q * 217706) >> 16; }
+
+template <class T>
+struct float_info;
+
+template <>
+struct float_info<double> {
+    using bits_type = uint64_t;
+    static constexpr int kMantissaBits = 52;
+    static constexpr int kBias = 1023;
+    static constexpr int kMaxExpField = 0x7FF;
+    static constexpr int kMaxExact10 = 22;   // 10^22是最大的可以精确表示的10的幂
+    static constexpr int kMaxDecimal = 310;  // 十进制数量级超过它一定溢出
+    static constexpr int kMinDecimal = -342; // 十进制数量级低于它一定舍入为0
+};
+
+template <>
+struct float_info<float> {
+    using bits_type = uint32_t;
+    static constexpr int kMantissaBits = 23;
+    static constexpr int kBias = 127;
+    static constexpr int kMaxExpField = 0xFF;
+    static constexpr int kMaxExact10 = 10;
+    static constexpr int kMaxDecimal = 40;
+    static constexpr int kMinDecimal = -65;
+};
+
+template <class T>
+typename float_info<T>::bits_type to_bits(T v) noexcept {
+    typename float_info<T>::bits_type b;
+    std::memcpy(&b, &v, sizeof(b));
+    return b;
+}
+
+template <class T>
+T from_bits(typename float_info<T>::bits_type b) noexcept {
+    T v;
+    std::memcpy(&v, &b, sizeof(v));
+    return v;
+}
+
+// 浮点数bits(正数)表示成 m * 2^e
+template <class T>
+void decompose(uint64_t bits, uint64_t &m, int &e) noexcept {
+    using info = float_info<T>;
+    uint64_t exp_field = bits >> info::kMantissaBits;
+    uint64_t frac = bits & ((uint64_t(1) << info::kMantissaBits) - 1);
+    if (exp_field == 0) {
+        m = frac;
+        e = 1 - info::kBias - info::kMantissaBits;
+    } else {
+        // 无穷大按下一个二进制数量级的第一个数处理
+        m = frac | (uint64_t(1) << info::kMantissaBits);
+        e = static_cast<int>(exp_field) - info::kBias - info::kMantissaBits;
+    }
+}
+
+// 定长的大整数，只用于生成10的幂表、解析时的精确比较和带精度的格式化，最多约5000位
+class bigint {
+ public:
+    static constexpr int kLimbs = 160;
+
+    explicit bigint(uint64_t v = 0) noexcept {
+        m_limbs[0] = static_cast<uint32_t>(v);
+        m_limbs[1] = static_cast<uint32_t>(v >> 32);
+        m_size = m_limbs[1] != 0 ? 2 : (m_limbs[0] != 0 ? 1 : 0);
+    }
+
+    void mul_small(uint32_t m) noexcept {
+        uint64_t carry = 0;
+        for (int i = 0; i < m_size; ++i) {
+            uint64_t t = static_cast<uint64_t>(m_limbs[i]) * m + carry;
+            m_limbs[i] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+        if (carry != 0 && m_size < kLimbs) {
+            m_limbs[m_size++] = static_cast<uint32_t>(carry);
+        }
+    }
+
+    void add_small(uint32_t a) noexcept {
+        uint64_t carry = a;
+        for (int i = 0; carry != 0 && i < m_size; ++i) {
+            uint64_t t = static_cast<uint64_t>(m_limbs[i]) + carry;
+            m_limbs[i] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+        if (carry != 0 && m_size < kLimbs) {
+            m_limbs[m_size++] = static_cast<uint32_t>(carry);
+        }
+    }
+
+    void mul_u64(uint64_t m) noexcept {
+        uint32_t hi = static_cast<uint32_t>(m >> 32);
+        if (hi == 0) {
+            mul_small(static_cast<uint32_t>(m));
+            return;
+        }
+        bigint h(*this);
+        h.mul_small(hi);
+        h.shl(32);
+        mul_small(static_cast<uint32_t>(m));
+        add(h);
+    }
+
+    void mul_pow5(int n) noexcept {
+        static const uint32_t kPow5[] = {1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625, 48828125, 244140625, 1220703125};
+        for (; n >= 13; n -= 13) {
+            mul_small(kPow5[13]);
+        }
+        if (n > 0) {
+            mul_small(kPow5[n]);
+        }
+    }
+
+    void add(const bigint &b) noexcept {
+        uint64_t carry = 0;
+        int n = m_size > b.m_size ? m_size : b.m_size;
+        for (int i = 0; i < n; ++i) {
+            uint64_t t = carry + (i < m_size ? m_limbs[i] : 0) + (i < b.m_size ? b.m_limbs[i] : 0);
+            m_limbs[i] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+        m_size = n;
+        if (carry != 0 && m_size < kLimbs) {
+            m_limbs[m_size++] = static_cast<uint32_t>(carry);
+        }
+    }
+
+    // 要求*this >= b
+    void sub(const bigint &b) noexcept {
+        int64_t borrow = 0;
+        for (int i = 0; i < m_size; ++i) {
+            int64_t t = static_cast<int64_t>(m_limbs[i]) - (i < b.m_size ? b.m_limbs[i] : 0) - borrow;
+            borrow = t < 0 ? 1 : 0;
+            m_limbs[i] = static_cast<uint32_t>(t + (borrow << 32));
+        }
+        trim();
+    }
+
+    void shl(int n) noexcept {
+        if (m_size == 0 || n == 0) {
+            return;
+        }
+        int words = n / 32, bits = n % 32;
+        int size = m_size + words + 1;
+        if (size > kLimbs) {
+            size = kLimbs;
+        }
+        for (int i = size - 1; i >= 0; --i) {
+            int src = i - words;
+            uint32_t hi = src >= 0 && src < m_size ? m_limbs[src] : 0;
+            uint32_t lo = src - 1 >= 0 && src - 1 < m_size ? m_limbs[src - 1] : 0;
+            m_limbs[i] = bits == 0 ? hi : ((hi << bits) | (lo >> (32 - bits)));
+        }
+        m_size = size;
+        trim();
+    }
+
+    int bit_length() const noexcept {
+        return m_size == 0 ? 0 : m_size * 32 - (nostd::countl_zero(static_cast<uint64_t>(m_limbs[m_size - 1])) - 32);
+    }
+
+    bool bit(int k) const noexcept { return k >= 0 && k < m_size * 32 && ((m_limbs[k >> 5] >> (k & 31)) & 1u); }
+
+    // 从第pos位开始的64位，越界的位为0
+    uint64_t bits64(int pos) const noexcept {
+        uint64_t r = 0;
+        for (int i = 63; i >= 0; --i) {
+            r = (r << 1) | (bit(pos + i) ? 1u : 0u);
+        }
+        return r;
+    }
+
+    bool is_zero() const noexcept { return m_size == 0; }
+
+    void shr(int n) noexcept {
+        int words = n / 32, bits = n % 32;
+        if (words >= m_size) {
+            m_size = 0;
+            return;
+        }
+        for (int i = 0; i < m_size - words; ++i) {
+            uint32_t lo = m_limbs[i + words];
+            uint32_t hi = i + words + 1 < m_size ? m_limbs[i + words + 1] : 0;
+            m_limbs[i] = bits == 0 ? lo : ((lo >> bits) | (hi << (32 - bits)));
+        }
+        m_size -= words;
+        trim();
+    }
+
+    // 除以d，返回余数
+    uint32_t div_small(uint32_t d) noexcept {
+        uint64_t rem = 0;
+        for (int i = m_size - 1; i >= 0; --i) {
+            uint64_t cur = (rem << 32) | m_limbs[i];
+            m_limbs[i] = static_cast<uint32_t>(cur / d);
+            rem = cur % d;
+        }
+        trim();
+        return static_cast<uint32_t>(rem);
+    }
+
+    // 逐位的长除法，只在带精度格式化大数时用到
+    static void divide(const bigint &num, const bigint &den, bigint &q, bigint &r) noexcept {
+        q = bigint(0);
+        r = bigint(0);
+        for (int i = num.bit_length() - 1; i >= 0; --i) {
+            r.shl(1);
+            q.shl(1);
+            if (num.bit(i)) {
+                r.add_small(1);
+            }
+            if (compare(r, den) >= 0) {
+                r.sub(den);
+                q.add_small(1);
+            }
+        }
+    }
+
+    static int compare(const bigint &a, const bigint &b) noexcept {
+        if (a.m_size != b.m_size) {
+            return a.m_size < b.m_size ? -1 : 1;
+        }
+        for (int i = a.m_size - 1; i >= 0; --i) {
+            if (a.m_limbs[i] != b.m_limbs[i]) {
+                return a.m_limbs[i] < b.m_limbs[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+ private:
+    void trim() noexcept {
+        while (m_size > 0 && m_limbs[m_size - 1] == 0) {
+            --m_size;
+        }
+    }
+
+    uint32_t m_limbs[kLimbs];
+    int m_size;
+};
+
+// 10^q的128位规格化尾数(向下截断)，q在[kMinPow10, kMaxPow10]
+class pow10_table {
+ public:
+    static constexpr int kMinPow10 = -342;
+    static constexpr int kMaxPow10 = 324;
+
+    static const pow10_table &instance() {
+        static const pow10_table table;
+        return table;
+    }
+
+    uint64_t hi(int q) const noexcept { return m_hi[q - kMinPow10]; }
+    uint64_t lo(int q) const noexcept { return m_lo[q - kMinPow10]; }
+
+ private:
+    pow10_table() {
+        // q >= 0：5^q的最高128位
+        bigint p(1);
+        for (int q = 0; q <= kMaxPow10; ++q) {
+            int bl = p.bit_length();
+            m_hi[q - kMinPow10] = p.bits64(bl - 64);
+            m_lo[q - kMinPow10] = p.bits64(bl - 128);
+            p.mul_small(5);
+        }
+        // q < 0：floor(2^(bl - 1 + 128) / 5^-q)，逐位长除法
+        bigint d(1);
+        for (int q = -1; q >= kMinPow10; --q) {
+            d.mul_small(5);
+            int bl = d.bit_length();
+            bigint r(1);
+            r.shl(bl - 1);
+            uint64_t hi = 0, lo = 0;
+            for (int i = 0; i < 128; ++i) {
+                r.shl(1);
+                uint64_t b = 0;
+                if (bigint::compare(r, d) >= 0) {
+                    r.sub(d);
+                    b = 1;
+                }
+                hi = (hi << 1) | (lo >> 63);
+                lo = (lo << 1) | b;
+            }
+            m_hi[q - kMinPow10] = hi;
+            m_lo[q - kMinPow10] = lo;
+        }
+    }
+
+    uint64_t m_hi[kMaxPow10 - kMinPow10 + 1];
+    uint64_t m_lo[kMaxPow10 - kMinPow10 + 1];
+};
+
+/*****************************************************************************************/
+// Grisu2
+/*****************************************************************************************/
+
+struct diyfp {
+    uint64_t f;
+    int e;
+
+    static diyfp sub(diyfp x, diyfp y) noexcept { return {x.f - y.f, x.e}; }
+
+    // 乘积的高64位，按第63位舍入
+    static diyfp mul(diyfp x, diyfp y) noexcept {
+        uint64_t hi;
+        uint64_t lo = mul128(x.f, y.f, hi);
+        return {hi + (lo >> 63), x.e + y.e + 64};
+    }
+
+    static diyfp normalize(diyfp x) noexcept {
+        int s = nostd::countl_zero(x.f);
+        return {x.f << s, x.e - s};
+    }
+
+    static diyfp normalize_to(diyfp x, int e) noexcept { return {x.f << (x.e - e), e}; }
+};
+
+// 规格化后的v，以及v和相邻浮点数的中点m-、m+
+template <class T>
+void compute_boundaries(T value, diyfp &w, diyfp &minus, diyfp &plus) noexcept {
+    using info = float_info<T>;
+    const int kBias = info::kBias + info::kMantissaBits;
+    const uint64_t kHidden = uint64_t(1) << info::kMantissaBits;
+    uint64_t bits = to_bits(value);
+    uint64_t E = bits >> info::kMantissaBits;
+    uint64_t F = bits & (kHidden - 1);
+    diyfp v = E == 0 ? diyfp{F, 1 - kBias} : diyfp{F + kHidden, static_cast<int>(E) - kBias};
+    // 2的整数次幂的下邻居更近
+    bool lower_closer = F == 0 && E > 1;
+    diyfp m_plus{2 * v.f + 1, v.e - 1};
+    diyfp m_minus = lower_closer ? diyfp{4 * v.f - 1, v.e - 2} : diyfp{2 * v.f - 1, v.e - 1};
+    plus = diyfp::normalize(m_plus);
+    minus = diyfp::normalize_to(m_minus, plus.e);
+    w = diyfp::normalize(v);
+}
+
+inline void grisu2_round(char *buf, int len, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t ten_k) noexcept {
+    // 在安全区间内把最后一位往下调，使结果尽量接近w
+    while (rest < dist && delta - rest >= ten_k && (rest + ten_k < dist || dist - rest > rest + ten_k - dist)) {
+        --buf[len - 1];
+        rest += ten_k;
+    }
+}
+
+// 在(M-, M+)内生成最短的数字串，w是精确值
+inline void grisu2_digit_gen(char *buf, int &len, int &k, diyfp M_minus, diyfp w, diyfp M_plus) noexcept {
+    static const uint32_t kPow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    uint64_t delta = diyfp::sub(M_plus, M_minus).f;
+    uint64_t dist = diyfp::sub(M_plus, w).f;
+    const diyfp one{uint64_t(1) << -M_plus.e, M_plus.e};
+    uint32_t p1 = static_cast<uint32_t>(M_plus.f >> -one.e);
+    uint64_t p2 = M_plus.f & (one.f - 1);
+
+    // 整数部分
+    int n = count_digits(p1);
+    len = 0;
+    while (n > 0) {
+        uint32_t pow10 = kPow10[n - 1];
+        uint32_t d = p1 / pow10;
+        p1 %= pow10;
+        buf[len++] = static_cast<char>('0' + d);
+        --n;
+        uint64_t rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+        if (rest <= delta) {
+            k += n;
+            grisu2_round(buf, len, dist, delta, rest, static_cast<uint64_t>(pow10) << -one.e);
+            return;
+        }
+    }
+    // 小数部分
+    int m = 0;
+    for (;;) {
+        p2 *= 10;
+        buf[len++] = static_cast<char>('0' + (p2 >> -one.e));
+        p2 &= one.f - 1;
+        ++m;
+        delta *= 10;
+        dist *= 10;
+        if (p2 <= delta) {
+            break;
+        }
+    }
+    k -= m;
+    grisu2_round(buf, len, dist, delta, p2, one.f);
+}
+
+// value为有限正数，输出数字串和十进制指数：value ≈ buf * 10^k
+template <class T>
+void grisu2(char *buf, int &len, int &k, T value) noexcept {
+    const int kAlpha = -60;
+    diyfp w, m_minus, m_plus;
+    compute_boundaries(value, w, m_minus, m_plus);
+
+    // 选c = 10^q使 alpha <= e(c) + e(w) + 64 <= gamma(= -32)，q = ceil((alpha - e - 1) * log10(2))
+    int f = kAlpha - m_plus.e - 1;
+    int q = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+    const pow10_table &table = pow10_table::instance();
+    uint64_t cf = table.hi(q) + (table.lo(q) >> 63);
+    int ce = floor_log2_pow10(q) - 63;
+    if (cf == 0) {  // 进位溢出
+        cf = uint64_t(1) << 63;
+        ce += 1;
+    }
+    diyfp c{cf, ce};
+    diyfp W = diyfp::mul(w, c);
+    diyfp W_minus = diyfp::mul(m_minus, c);
+    diyfp W_plus = diyfp::mul(m_plus, c);
+    // 乘法各有最多1的误差，区间两端各收缩1
+    diyfp M_minus{W_minus.f + 1, W_minus.e};
+    diyfp M_plus{W_plus.f - 1, W_plus.e};
+    k = -q;
+    grisu2_digit_gen(buf, len, k, M_minus, W, M_plus);
+}
+
+inline char *write_exponent(char *p, int e) noexcept {
+    *p++ = 'e';
+    *p++ = e < 0 ? '-' : '+';
+    unsigned u = static_cast<unsigned>(e < 0 ? -e : e);
+    if (u >= 100) {
+        *p++ = static_cast<char>('0' + u / 100);
+        u %= 100;
+    }
+    const char *d = digits2(u);
+    *p++ = d[0];
+    *p++ = d[1];
+    return p;
+}
+
+// 数字串digits(len位) * 10^k，general时按定点/科学计数法中较短的一种写出
+inline to_chars_result format_shortest(char *first, char *last, bool neg, const char *digits, int len, int k,
+                                       chars_format fmt = chars_format::general) noexcept {
+    int n = len + k;  // 小数点相对于第一位数字的位置
+    int fixed = k >= 0 ? len + k : (n > 0 ? len + 1 : 2 - n + len);
+    int e = n - 1;
+    int ae = e < 0 ? -e : e;
+    int sci = len + (len > 1 ? 1 : 0) + 2 + (ae >= 100 ? 3 : 2);
+    bool use_fixed = fmt == chars_format::general ? fixed <= sci : fmt == chars_format::fixed;
+    int total = (use_fixed ? fixed : sci) + (neg ? 1 : 0);
+    if (last - first < total) {
+        return {last, std::errc::value_too_large};
+    }
+    char *p = first;
+    if (neg) {
+        *p++ = '-';
+    }
+    if (use_fixed) {
+        if (k >= 0) {
+            std::memcpy(p, digits, static_cast<size_t>(len));
+            std::memset(p + len, '0', static_cast<size_t>(k));
+            p += len + k;
+        } else if (n > 0) {
+            std::memcpy(p, digits, static_cast<size_t>(n));
+            p[n] = '.';
+            std::memcpy(p + n + 1, digits + n, static_cast<size_t>(len - n));
+            p += len + 1;
+        } else {
+            *p++ = '0';
+            *p++ = '.';
+            std::memset(p, '0', static_cast<size_t>(-n));
+            p += -n;
+            std::memcpy(p, digits, static_cast<size_t>(len));
+            p += len;
+        }
+    } else {
+        *p++ = digits[0];
+        if (len > 1) {
+            *p++ = '.';
+            std::memcpy(p, digits + 1, static_cast<size_t>(len - 1));
+            p += len - 1;
+        }
+        p = write_exponent(p, e);
+    }
+    return {p, std::errc()};
+}
+
+// inf/nan/0，不是这几种时返回false
+template <class T>
+bool write_special(char *&first, char *last, T value, to_chars_result &r) noexcept {
+    using info = float_info<T>;
+    using bits_type = typename info::bits_type;
+    bits_type bits = to_bits(value);
+    bool neg = (bits >> (sizeof(bits_type) * 8 - 1)) != 0;
+    bits_type exp_field = (bits >> info::kMantissaBits) & static_cast<bits_type>(info::kMaxExpField);
+    bits_type frac = bits & ((bits_type(1) << info::kMantissaBits) - 1);
+    const char *special = nullptr;
+    if (exp_field == static_cast<bits_type>(info::kMaxExpField)) {
+        special = frac != 0 ? "nan" : "inf";
+    } else if (exp_field == 0 && frac == 0) {
+        special = "0";
+    }
+    if (special == nullptr) {
+        return false;
+    }
+    size_t n = std::strlen(special) + (neg ? 1 : 0);
+    if (static_cast<size_t>(last - first) < n) {
+        r = {last, std::errc::value_too_large};
+        return true;
+    }
+    if (neg) {
+        *first++ = '-';
+    }
+    std::memcpy(first, special, n - (neg ? 1 : 0));
+    r = {first + n - (neg ? 1 : 0), std::errc()};
+    return true;
+}
+
+template <class T>
+to_chars_result float_to_chars(char *first, char *last, T value, chars_format fmt = chars_format::general) noexcept {
+    to_chars_result r;
+    if (write_special(first, last, value, r)) {
+        return r;
+    }
+    bool neg = value < 0;
+    char digits[20];
+    int len = 0, k = 0;
+    grisu2(digits, len, k, neg ? -value : value);
+    return format_shortest(first, last, neg, digits, len, k, fmt);
+}
+
+/*****************************************************************************************/
+// 指定精度：按精确值舍入(就近，平局取偶)，结果和glibc的printf一致
+/*****************************************************************************************/
+
+// 任何double的精确十进制展开最多1074位小数、767位有效数字，再往后都是0
+const int kMaxFixedPrecision = 1074;
+const int kMaxSignificant = 780;
+
+// q = round(m * 2^e * 10^s)
+inline void scale_round(uint64_t m, int e, int s, bigint &q) noexcept {
+    int sh = e + s;
+#if defined(__SIZEOF_INT128__)
+    // 常见情况(小精度、不太大的数)用128位整数算完
+    if (s >= 0 && s <= 27 && sh < 0 && sh > -128) {
+        __uint128_t prod = static_cast<__uint128_t>(m);
+        for (int i = 0; i < s; ++i) {
+            prod *= 5;
+        }
+        int rs = -sh;
+        __uint128_t v = prod >> rs;
+        __uint128_t rem = prod - (v << rs);
+        __uint128_t half = static_cast<__uint128_t>(1) << (rs - 1);
+        if (rem > half || (rem == half && (v & 1) != 0)) {
+            ++v;
+        }
+        q = bigint(static_cast<uint64_t>(v));
+        if ((v >> 64) != 0) {
+            bigint hi(static_cast<uint64_t>(v >> 64));
+            hi.shl(64);
+            q.add(hi);
+        }
+        return;
+    }
+#endif
+    bigint num(m);
+    if (s >= 0) {
+        num.mul_pow5(s);
+        if (sh >= 0) {
+            num.shl(sh);
+            q = num;
+            return;
+        }
+        // 除以2的幂：看被移出的最高位和其余位
+        bool half = num.bit(-sh - 1);
+        bool sticky = false;
+        for (int i = 0; i < -sh - 1 && !sticky; ++i) {
+            sticky = num.bit(i);
+        }
+        num.shr(-sh);
+        if (half && (sticky || num.bit(0))) {
+            num.add_small(1);
+        }
+        q = num;
+        return;
+    }
+    bigint den(1);
+    den.mul_pow5(-s);
+    if (sh >= 0) {
+        num.shl(sh);
+    } else {
+        den.shl(-sh);
+    }
+    bigint r;
+    bigint::divide(num, den, q, r);
+    r.shl(1);
+    int c = bigint::compare(r, den);
+    if (c > 0 || (c == 0 && q.bit(0))) {
+        q.add_small(1);
+    }
+}
+
+// 十进制数字写到buf，返回位数，q为0时写"0"
+inline int to_decimal(bigint q, char *buf) noexcept {
+    char tmp[1600];
+    char *p = tmp + sizeof(tmp);
+    do {
+        uint32_t chunk = q.div_small(1000000000);
+        for (int i = 0; i < 9; ++i) {
+            *--p = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+    } while (!q.is_zero());
+    while (p < tmp + sizeof(tmp) - 1 && *p == '0') {
+        ++p;
+    }
+    int len = static_cast<int>(tmp + sizeof(tmp) - p);
+    std::memcpy(buf, p, static_cast<size_t>(len));
+    return len;
+}
+
+// 科学计数法下的precision + 1位有效数字和十进制指数x：value ≈ d.ddd * 10^x
+inline int significant_digits(double value, uint64_t m, int e, int precision, char *digits, int &x) noexcept {
+    char shortest[20];
+    int len = 0, k = 0;
+    grisu2(shortest, len, k, value);
+    x = len + k - 1;
+    bigint q;
+    scale_round(m, e, precision - x, q);
+    int n = to_decimal(q, digits);
+    if (n != precision + 1) {
+        // 最短表示进位到了下一个数量级，或者舍入后进位
+        x += n > precision + 1 ? 1 : -1;
+        scale_round(m, e, precision - x, q);
+        n = to_decimal(q, digits);
+    }
+    return n;
+}
+
+inline to_chars_result fixed_precision(char *first, char *last, bool neg, uint64_t m, int e, int precision) noexcept {
+    int p = precision < kMaxFixedPrecision ? precision : kMaxFixedPrecision;
+    bigint q;
+    scale_round(m, e, p, q);
+    char digits[1600];
+    int len = to_decimal(q, digits);
+    int int_len = len > p ? len - p : 1;
+    size_t total = static_cast<size_t>((neg ? 1 : 0) + int_len + (precision > 0 ? 1 + precision : 0));
+    if (static_cast<size_t>(last - first) < total) {
+        return {last, std::errc::value_too_large};
+    }
+    char *o = first;
+    if (neg) {
+        *o++ = '-';
+    }
+    if (len > p) {
+        std::memcpy(o, digits, static_cast<size_t>(int_len));
+        o += int_len;
+    } else {
+        *o++ = '0';
+    }
+    if (precision > 0) {
+        *o++ = '.';
+        // 小数部分前面补0
+        int lead = len > p ? 0 : p - len;
+        std::memset(o, '0', static_cast<size_t>(lead));
+        o += lead;
+        std::memcpy(o, digits + (len > p ? int_len : 0), static_cast<size_t>(p - lead));
+        o += p - lead;
+        std::memset(o, '0', static_cast<size_t>(precision - p));
+        o += precision - p;
+    }
+    return {o, std::errc()};
+}
+
+inline to_chars_result scientific_precision(char *first, char *last, bool neg, double value, uint64_t m, int e,
+                                            int precision) noexcept {
+    int p = precision < kMaxSignificant ? precision : kMaxSignificant;
+    char digits[1600];
+    int x = 0;
+    if (m == 0) {
+        std::memset(digits, '0', static_cast<size_t>(p + 1));
+    } else {
+        significant_digits(value, m, e, p, digits, x);
+    }
+    int ax = x < 0 ? -x : x;
+    size_t total = static_cast<size_t>((neg ? 1 : 0) + 1 + (precision > 0 ? 1 + precision : 0) + 2 + (ax >= 100 ? 3 : 2));
+    if (static_cast<size_t>(last - first) < total) {
+        return {last, std::errc::value_too_large};
+    }
+    char *o = first;
+    if (neg) {
+        *o++ = '-';
+    }
+    *o++ = digits[0];
+    if (precision > 0) {
+        *o++ = '.';
+        std::memcpy(o, digits + 1, static_cast<size_t>(p));
+        o += p;
+        std::memset(o, '0', static_cast<size_t>(precision - p));
+        o += precision - p;
+    }
+    return {write_exponent(o, x), std::errc()};
+}
+
+// 同printf的%g：precision位有效数字，指数在[-4, precision)内用定点，去掉末尾的0
+inline to_chars_result general_precision(char *first, char *last, bool neg, double value, uint64_t m, int e,
+                                         int precision) noexcept {
+    int p = precision == 0 ? 1 : (precision < kMaxSignificant ? precision : kMaxSignificant);
+    char digits[1600];
+    int x = 0;
+    int len = 1;
+    digits[0] = '0';
+    if (m != 0) {
+        len = significant_digits(value, m, e, p - 1, digits, x);
+        while (len > 1 && digits[len - 1] == '0') {
+            --len;
+        }
+    }
+    bool use_fixed = x >= -4 && x < (precision == 0 ? 1 : precision);
+    return format_shortest(first, last, neg, digits, len, x - len + 1,
+                           use_fixed ? chars_format::fixed : chars_format::scientific);
+}
+
+template <class T>
+to_chars_result float_to_chars(char *first, char *last, T value, chars_format fmt, int precision) noexcept {
+    to_chars_result r;
+    if (precision < 0) {
+        precision = 6;
+    }
+    bool neg = value < 0 || (value == 0 && std::signbit(value));
+    uint64_t m = 0;
+    int e = 0;
+    double v = neg ? -static_cast<double>(value) : static_cast<double>(value);
+    if (value == 0) {
+        // 0也按格式输出，例如"0.000"
+    } else if (write_special(first, last, value, r)) {
+        return r;
+    } else {
+        decompose<double>(to_bits(v), m, e);
+    }
+    switch (fmt) {
+        case chars_format::fixed:
+            return fixed_precision(first, last, neg, m, e, precision);
+        case chars_format::scientific:
+            return scientific_precision(first, last, neg, v, m, e, precision);
+        default:
+            return general_precision(first, last, neg, v, m, e, precision);
+    }
+}
+
+/*****************************************************************************************/
+// 浮点解析
+/*****************************************************************************************/
+
+// 十进制数 w * 10^q 最接近的浮点数，无法判定时返回false
+template <class T>
+bool eisel_lemire(uint64_t w, int q, typename float_info<T>::bits_type &out) noexcept {
+    using info = float_info<T>;
+    const int kShift = 64 - info::kMantissaBits - 3;
+    const uint64_t kMask = (uint64_t(1) << kShift) - 1;
+    if (q < pow10_table::kMinPow10 || q > pow10_table::kMaxPow10) {
+        return false;
+    }
+    const pow10_table &table = pow10_table::instance();
+    int clz = nostd::countl_zero(w);
+    w <<= clz;
+    int64_t exp2 = static_cast<int64_t>(floor_log2_pow10(q)) + 64 + info::kBias - clz;
+    uint64_t x_hi;
+    uint64_t x_lo = mul128(w, table.hi(q), x_hi);
+    // 低位全是1时截断误差可能影响结果，补上128位表的低半部分再看
+    if ((x_hi & kMask) == kMask && x_lo + w < w) {
+        uint64_t y_hi;
+        uint64_t y_lo = mul128(w, table.lo(q), y_hi);
+        uint64_t merged_hi = x_hi, merged_lo = x_lo + y_hi;
+        if (merged_lo < x_lo) {
+            ++merged_hi;
+        }
+        if ((merged_hi & kMask) == kMask && merged_lo + 1 == 0 && y_lo + w < w) {
+            return false;
+        }
+        x_hi = merged_hi;
+        x_lo = merged_lo;
+    }
+    uint64_t msb = x_hi >> 63;
+    uint64_t mantissa = x_hi >> (msb + kShift);
+    exp2 -= static_cast<int64_t>(1 ^ msb);
+    // 正好在两个浮点数中间
+    if (x_lo == 0 && (x_hi & kMask) == 0 && (mantissa & 3) == 1) {
+        return false;
+    }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if ((mantissa >> (info::kMantissaBits + 1)) > 0) {
+        mantissa >>= 1;
+        exp2 += 1;
+    }
+    // 次正规数和溢出交给精确算法
+    if (exp2 <= 0 || exp2 >= info::kMaxExpField) {
+        return false;
+    }
+    out = static_cast<typename float_info<T>::bits_type>((static_cast<uint64_t>(exp2) << info::kMantissaBits) |
+                                                         (mantissa & ((uint64_t(1) << info::kMantissaBits) - 1)));
+    return true;
+}
+
+// 解析出的十进制数：整数部分和小数部分的原始字符，加上指数
+struct decimal_text {
+    const char *int_begin;
+    const char *int_end;
+    const char *frac_begin;
+    const char *frac_end;
+    int64_t exp;
+};
+
+// 精确算法：把全部有效数字放进大整数D，value = D * 10^e10
+// 在所有正浮点数的位模式上二分，找到正确舍入(就近，平局取偶)的结果
+template <class T>
+typename float_info<T>::bits_type slow_path(const decimal_text &t) noexcept {
+    using info = float_info<T>;
+    using bits_type = typename info::bits_type;
+    const int kMaxDigits = 800;  // 再往后的数字只需要知道是否非零
+
+    bigint D(0);
+    int64_t e10 = t.exp;
+    int nd = 0;
+    bool nonzero_tail = false;
+    uint32_t chunk = 0;
+    int chunk_len = 0;
+    static const uint32_t kPow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    for (int part = 0; part < 2; ++part) {
+        const char *p = part == 0 ? t.int_begin : t.frac_begin;
+        const char *end = part == 0 ? t.int_end : t.frac_end;
+        for (; p != end; ++p) {
+            uint32_t d = static_cast<uint32_t>(*p - '0');
+            if (nd == 0 && d == 0) {
+                e10 -= part;  // 前导0：小数部分的0移动指数
+                continue;
+            }
+            if (nd < kMaxDigits) {
+                chunk = chunk * 10 + d;
+                if (++chunk_len == 9) {
+                    D.mul_small(kPow10[9]);
+                    D.add_small(chunk);
+                    chunk = 0;
+                    chunk_len = 0;
+                }
+                ++nd;
+                e10 -= part;
+            } else {
+                nonzero_tail = nonzero_tail || d != 0;
+                e10 += 1 - part;
+            }
+        }
+    }
+    D.mul_small(kPow10[chunk_len]);
+    D.add_small(chunk);
+    if (nonzero_tail) {
+        // 追加一位1：比截断值大，比下一个截断值小，不会恰好落在中点上
+        D.mul_small(10);
+        D.add_small(1);
+        e10 -= 1;
+    }
+
+    // value = D * 10^e10；比较的两边分别乘上不依赖候选值的部分
+    bigint left(D), right_base(1);
+    if (e10 >= 0) {
+        left.mul_pow5(static_cast<int>(e10));
+    } else {
+        right_base.mul_pow5(static_cast<int>(-e10));
+    }
+
+    // value与 m * 2^e 比较
+    auto cmp = [&](uint64_t m, int e) {
+        bigint l(left), r(right_base);
+        r.mul_u64(m);
+        int64_t s = e10 - e;
+        if (s >= 0) {
+            l.shl(static_cast<int>(s));
+        } else {
+            r.shl(static_cast<int>(-s));
+        }
+        return bigint::compare(l, r);
+    };
+
+    // 第一个满足 value < mid(b, b+1)(平局时b为偶数)的b
+    const bits_type inf_bits = static_cast<bits_type>(static_cast<uint64_t>(info::kMaxExpField) << info::kMantissaBits);
+    bits_type lo = 0, hi = inf_bits;
+    while (lo < hi) {
+        bits_type b = lo + (hi - lo) / 2;
+        uint64_t m0, m1;
+        int e0, e1;
+        decompose<T>(b, m0, e0);
+        decompose<T>(b + 1, m1, e1);
+        int em = e0 < e1 ? e0 : e1;
+        uint64_t mid = (m0 << (e0 - em)) + (m1 << (e1 - em));
+        int c = cmp(mid, em - 1);
+        if (c < 0 || (c == 0 && (b & 1) == 0)) {
+            hi = b;
+        } else {
+            lo = b + 1;
+        }
+    }
+    return lo;
+}
+
+inline bool match_word(const char *&p, const char *last, const char *word) noexcept {
+    const char *q = p;
+    for (; *word != '\0'; ++word, ++q) {
+        if (q == last || (*q | 0x20) != *word) {
+            return false;
+        }
+    }
+    p = q;
+    return true;
+}
+
+template <class T>
+from_chars_result float_from_chars(const char *first, const char *last, T &value) noexcept {
+    using info = float_info<T>;
+    using bits_type = typename info::bits_type;
+    const char *p = first;
+    bool neg = false;
+    if (p != last && *p == '-') {
+        neg = true;
+        ++p;
+    }
+    const bits_type sign = neg ? static_cast<bits_type>(bits_type(1) << (sizeof(bits_type) * 8 - 1)) : 0;
+
+    // inf / infinity / nan / nan(chars)
+    if (p != last && ((*p | 0x20) == 'i' || (*p | 0x20) == 'n')) {
+        if (match_word(p, last, "inf")) {
+            match_word(p, last, "inity");
+            value = from_bits<T>(sign | static_cast<bits_type>(static_cast<uint64_t>(info::kMaxExpField) << info::kMantissaBits));
+            return {p, std::errc()};
+        }
+        if (match_word(p, last, "nan")) {
+            if (p != last && *p == '(') {
+                const char *q = p + 1;
+                while (q != last && (*q == '_' || digit_value(*q) < 36)) {
+                    ++q;
+                }
+                if (q != last && *q == ')') {
+                    p = q + 1;
+                }
+            }
+            value = from_bits<T>(sign | static_cast<bits_type>(
+                                            (static_cast<uint64_t>(info::kMaxExpField) << info::kMantissaBits) |
+                                            (uint64_t(1) << (info::kMantissaBits - 1))));
+            return {p, std::errc()};
+        }
+        return {first, std::errc::invalid_argument};
+    }
+
+    decimal_text t;
+    t.int_begin = p;
+    while (p != last && static_cast<unsigned>(*p - '0') < 10) {
+        ++p;
+    }
+    t.int_end = p;
+    t.frac_begin = t.frac_end = p;
+    if (p != last && *p == '.') {
+        ++p;
+        t.frac_begin = p;
+        while (p != last && static_cast<unsigned>(*p - '0') < 10) {
+            ++p;
+        }
+        t.frac_end = p;
+    }
+    if (t.int_begin == t.int_end && t.frac_begin == t.frac_end) {
+        return {first, std::errc::invalid_argument};
+    }
+    t.exp = 0;
+    if (p != last && (*p | 0x20) == 'e') {
+        const char *q = p + 1;
+        bool eneg = false;
+        if (q != last && (*q == '-' || *q == '+')) {
+            eneg = *q == '-';
+            ++q;
+        }
+        if (q != last && static_cast<unsigned>(*q - '0') < 10) {
+            int64_t e = 0;
+            for (; q != last && static_cast<unsigned>(*q - '0') < 10; ++q) {
+                if (e < 100000000) {
+                    e = e * 10 + (*q - '0');
+                }
+            }
+            t.exp = eneg ? -e : e;
+            p = q;
+        }
+    }
+
+    // 前19位有效数字放进w
+    uint64_t w = 0;
+    int nd = 0;
+    int64_t e10 = t.exp;
+    bool trunc = false;
+    for (int part = 0; part < 2; ++part) {
+        const char *s = part == 0 ? t.int_begin : t.frac_begin;
+        const char *end = part == 0 ? t.int_end : t.frac_end;
+        for (; s != end; ++s) {
+            unsigned d = static_cast<unsigned>(*s - '0');
+            if (nd == 0 && d == 0) {
+                e10 -= part;
+                continue;
+            }
+            if (nd < 19) {
+                w = w * 10 + d;
+                ++nd;
+                e10 -= part;
+            } else {
+                trunc = trunc || d != 0;
+                e10 += 1 - part;
+            }
+        }
+    }
+
+    bits_type bits = 0;
+    if (w == 0) {
+        value = from_bits<T>(sign);
+        return {p, std::errc()};
+    }
+    // 非零的数舍入成0按下溢处理，和上溢一样返回result_out_of_range
+    if (nd + e10 < info::kMinDecimal) {
+        return {p, std::errc::result_out_of_range};
+    }
+    if (nd + e10 > info::kMaxDecimal) {
+        return {p, std::errc::result_out_of_range};
+    }
+#if FLT_EVAL_METHOD == 0
+    // Clinger：w和10^|e10|都能精确表示时，一次乘除就是正确舍入的结果
+    static const T kExact10[] = {T(1e0), T(1e1), T(1e2), T(1e3), T(1e4), T(1e5), T(1e6), T(1e7),
+                                 T(1e8), T(1e9), T(1e10), T(1e11), T(1e12), T(1e13), T(1e14), T(1e15),
+                                 T(1e16), T(1e17), T(1e18), T(1e19), T(1e20), T(1e21), T(1e22)};
+    if (!trunc && w <= (uint64_t(1) << (info::kMantissaBits + 1)) && e10 >= -info::kMaxExact10 && e10 <= info::kMaxExact10) {
+        T v = static_cast<T>(w);
+        v = e10 < 0 ? v / kExact10[-e10] : v * kExact10[e10];
+        value = neg ? -v : v;
+        return {p, std::errc()};
+    }
+#endif
+    bool ok = eisel_lemire<T>(w, static_cast<int>(e10), bits);
+    if (ok && trunc) {
+        // 被截掉的数字让真实值落在[w, w+1) * 10^e10之间，两端结果相同才可信
+        bits_type up = 0;
+        ok = eisel_lemire<T>(w + 1, static_cast<int>(e10), up) && up == bits;
+    }
+    if (!ok) {
+        bits = slow_path<T>(t);
+    }
+    if (bits == 0 || (bits >> info::kMantissaBits) >= static_cast<bits_type>(info::kMaxExpField)) {
+        return {p, std::errc::result_out_of_range};
+    }
+    value = from_bits<T>(sign | bits);
+    return {p, std::errc()};
+}
+
+}  // namespace _charconv
+
+/*****************************************************************************************/
+// to_chars
+/*****************************************************************************************/
+
+// 整数，base在[2, 36]之间
+template <class T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type * = nullptr>
+to_chars_result to_chars(char *first, char *last, T value, int base = 10) noexcept {
+    using U = typename std::make_unsigned<T>::type;
+    U u = static_cast<U>(value);
+    if (std::is_signed<T>::value && value < 0) {
+        if (first == last) {
+            return {last, std::errc::value_too_large};
+        }
+        *first++ = '-';
+        u = static_cast<U>(U(0) - u);
+    }
+    return _charconv::write_unsigned(first, last, static_cast<uint64_t>(u), base);
+}
+
+// 能精确读回原值的(接近)最短表示，见文件头关于Grisu2的说明
+inline to_chars_result to_chars(char *first, char *last, double value) noexcept {
+    return _charconv::float_to_chars(first, last, value);
+}
+
+inline to_chars_result to_chars(char *first, char *last, float value) noexcept {
+    return _charconv::float_to_chars(first, last, value);
+}
+
+// (接近)最短表示，fixed/scientific时强制使用对应的写法
+inline to_chars_result to_chars(char *first, char *last, double value, chars_format fmt) noexcept {
+    return _charconv::float_to_chars(first, last, value, fmt);
+}
+
+inline to_chars_result to_chars(char *first, char *last, float value, chars_format fmt) noexcept {
+    return _charconv::float_to_chars(first, last, value, fmt);
+}
+
+// 指定精度，含义同printf的%f/%e/%g，precision为负数时取6
+inline to_chars_result to_chars(char *first, char *last, double value, chars_format fmt, int precision) noexcept {
+    return _charconv::float_to_chars(first, last, value, fmt, precision);
+}
+
+inline to_chars_result to_chars(char *first, char *last, float value, chars_format fmt, int precision) noexcept {
+    return _charconv::float_to_chars(first, last, value, fmt, precision);
+}
+
+/*****************************************************************************************/
+// from_chars
+// 和std::from_chars一致：不跳过空白，不接受'+'和"0x"前缀，base不在[2, 36]之间时返回invalid_argument；
+// 失败时value不变，ec为invalid_argument(没有数字)或result_out_of_range(超出范围，非零的浮点数下溢成0也算)
+/*****************************************************************************************/
+
+template <class T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type * = nullptr>
+from_chars_result from_chars(const char *first, const char *last, T &value, int base = 10) noexcept {
+    return _charconv::integer_from_chars(first, last, value, base, false);
+}
+
+inline from_chars_result from_chars(const char *first, const char *last, double &value) noexcept {
+    return _charconv::float_from_chars(first, last, value);
+}
+
+inline from_chars_result from_chars(const char *first, const char *last, float &value) noexcept {
+    return _charconv::float_from_chars(first, last, value);
+}
+
+}  // namespace nostd
+
+#endif  // !__CHARCONV_H
@@ -0,0 +1,60 @@
+/*
+    语言标准相关的配置
+    库本身按C++11写，更高的标准下把能在编译期求值的算法和容器标成constexpr
+    CMake中通过 -DEASYSTL_CXX_STANDARD=17 / 20 切换标准
+
+    EASYSTL_CPLUSPLUS          当前的语言标准(MSVC上取_MSVC_LANG)
+    EASYSTL_CONSTEXPR14        C++14起为constexpr(函数体里可以有循环、局部变量)，C++11下为空
+    EASYSTL_CONSTEXPR20        C++20起为constexpr(可以有try块、平凡默认初始化的成员)，之前为空
+    EASYSTL_HAS_CONSTANT_EVALUATED  编译器能区分编译期求值和运行期执行时为1
+
+    nostd::is_constant_evaluated()  编译期求值时返回true，算法据此绕开memmove/memset等不能在编译期调用的快速路径
+                                    编译器不支持时总是返回false，这时走快速路径的调用不能用在常量表达式里
+*/
+#ifndef __CONFIG_H
+#define __CONFIG_H
+
+#if defined(_MSVC_LANG)
+#    define EASYSTL_CPLUSPLUS _MSVC_LANG
+#else
+#    define EASYSTL_CPLUSPLUS __cplusplus
+#endif
+
+#if EASYSTL_CPLUSPLUS >= 201402L
+#    define EASYSTL_CONSTEXPR14 constexpr
+#else
+#    define EASYSTL_CONSTEXPR14
+#endif
+
+#if EASYSTL_CPLUSPLUS >= 202002L
+#    define EASYSTL_CONSTEXPR20 constexpr
+#else
+#    define EASYSTL_CONSTEXPR20
+#endif
+
+#if defined(__has_builtin)
+#    if __has_builtin(__builtin_is_constant_evaluated)
+#        define EASYSTL_HAS_CONSTANT_EVALUATED 1
+#    endif
+#endif
+#if !defined(EASYSTL_HAS_CONSTANT_EVALUATED) && \
+    ((defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925))
+#    define EASYSTL_HAS_CONSTANT_EVALUATED 1
+#endif
+#if !defined(EASYSTL_HAS_CONSTANT_EVALUATED)
+#    define EASYSTL_HAS_CONSTANT_EVALUATED 0
+#endif
+
+namespace nostd {
+///@brief whether the call happens during constant evaluation
+///@note gcc/clang/msvc expose the builtin in every language mode, so it works under C++14/17 too
+constexpr bool is_constant_evaluated() noexcept {
+#if EASYSTL_HAS_CONSTANT_EVALUATED
+    return __builtin_is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+}  // namespace nostd
+
+#endif  // !__CONFIG_H
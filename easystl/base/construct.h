@@ -4,6 +4,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "config.h"
 #include "iterator.h"
 
 namespace nostd {
@@ -29,7 +30,7 @@ void construct(T *ptr, Args &&...args) {
 //-=========================
 // 析构
 template <typename T>
-void _destroy(T *ptr, std::true_type) {
+EASYSTL_CONSTEXPR14 void _destroy(T *ptr, std::true_type) {
     // trivial 无需析构
 }
 
@@ -41,7 +42,7 @@ void _destroy(T *ptr, std::false_type) {
 }
 
 template <typename T>
-void destroy(T *ptr) {
+EASYSTL_CONSTEXPR14 void destroy(T *ptr) {
     _destroy(ptr, std::is_trivially_destructible<T>());
 }
 //-=========================
@@ -56,11 +57,11 @@ void __destroy_category(T first, T last, std::false_type) {
 }
 
 template <typename T>
-void __destroy_category(T first, T last, std::true_type) {
+EASYSTL_CONSTEXPR14 void __destroy_category(T first, T last, std::true_type) {
 }
 
 template <typename T>
-void destroy(T first, T last) {
+EASYSTL_CONSTEXPR14 void destroy(T first, T last) {
     __destroy_category(first, last, std::is_trivially_destructible<typename nostd::iterator_traits<T>::value_type>());
 }
 //-=========================
@@ -0,0 +1,111 @@
+/*
+    字节串哈希
+
+    hash_bytes      任意字节串的64位哈希，按8字节一组读入，用64x64->128位乘法混合(思路同wyhash)
+    hash_mix        两个64位数混合成一个，C++14起可以在编译期求值(static_map在编译期建表要用)
+
+    不是加密哈希，只用于哈希表；相同输入和seed在同一平台上结果固定
+*/
+#ifndef __HASH_H
+#define __HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "base/config.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#endif
+
+namespace nostd {
+
+namespace _hash {
+
+// 没有128位整数时拆成四个32x32->64位乘法
+EASYSTL_CONSTEXPR14 inline uint64_t mix_portable(uint64_t a, uint64_t b) noexcept {
+    uint64_t ha = a >> 32, la = a & 0xffffffffULL, hb = b >> 32, lb = b & 0xffffffffULL;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    return lo ^ hi;
+}
+
+}  // namespace _hash
+
+// 128位乘积的高低两半异或
+EASYSTL_CONSTEXPR14 inline uint64_t hash_mix(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    if (!nostd::is_constant_evaluated()) {
+        uint64_t hi = 0;
+        uint64_t lo = _umul128(a, b, &hi);
+        return lo ^ hi;
+    }
+    return _hash::mix_portable(a, b);
+#else
+    return _hash::mix_portable(a, b);
+#endif
+}
+
+namespace _hash {
+
+constexpr uint64_t kSecret0 = 0xa0761d6478bd642fULL;
+constexpr uint64_t kSecret1 = 0xe7037ed1a0b428dbULL;
+constexpr uint64_t kSecret2 = 0x8ebc6af09c88c6e3ULL;
+
+inline uint64_t read64(const unsigned char *p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t read32(const unsigned char *p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// 1~3个字节：首、中、尾三个字节拼起来
+inline uint64_t read_small(const unsigned char *p, size_t n) noexcept {
+    return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[n >> 1]) << 8) | p[n - 1];
+}
+
+}  // namespace _hash
+
+inline uint64_t hash_bytes(const void *data, size_t n, uint64_t seed = 0) noexcept {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    seed ^= _hash::kSecret0;
+    uint64_t a = 0, b = 0;
+    if (n <= 16) {
+        if (n >= 4) {
+            // 4~16个字节：前后各取两个可能重叠的4字节
+            size_t mid = (n >> 3) << 2;
+            a = (_hash::read32(p) << 32) | _hash::read32(p + mid);
+            b = (_hash::read32(p + n - 4) << 32) | _hash::read32(p + n - 4 - mid);
+        } else if (n > 0) {
+            a = _hash::read_small(p, n);
+        }
+    } else {
+        size_t i = n;
+        while (i > 16) {
+            seed = hash_mix(_hash::read64(p) ^ _hash::kSecret1, _hash::read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        // 最后16个字节从尾部往回读，和前面的分组可能重叠
+        a = _hash::read64(p + i - 16);
+        b = _hash::read64(p + i - 8);
+    }
+    return hash_mix(_hash::kSecret1 ^ n, hash_mix(a ^ _hash::kSecret1, b ^ seed ^ _hash::kSecret2));
+}
+
+}  // namespace nostd
+
+#endif  // !__HASH_H
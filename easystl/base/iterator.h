@@ -9,6 +9,7 @@
     forward_iterator_tag	    Forward iterator category (class)
     bidirectional_iterator_tag	Bidirectional iterator category (class)
     random_access_iterator_tag	Random-access iterator category (class)
+    contiguous_iterator_tag     Contiguous iterator category (class)，元素在内存中连续存放，指针属于这一类
 
     //-=---------------------------
     //functions:
@@ -24,12 +25,14 @@
     front_inserter	    Constructs front insert iterator (function template)
     inserter	        Construct insert iterator (function template)
     make_move_iterator	Construct move iterator (function template)
+    to_address          连续迭代器指向的元素地址(function template)
 
     //-=---------------------------
     //class:
     //-=---------------------------
     iterartor
     iterator_traits
+    is_contiguous_iterator  迭代器是否指向连续内存，算法据此对包装过的迭代器也走memmove/memcmp等快速路径
 
     reverse_iterator	    Reverse iterator (class template)
     move_iterator	        Move iterator (class template)
@@ -46,6 +49,11 @@
 #define __ITERATOR_H
 
 #include <cstddef>  //ptrdiff_t定义
+#include <iterator>
+#include <memory>  // std::to_address
+#include <type_traits>
+
+#include "base/config.h"
 
 namespace nostd {
 
@@ -55,6 +63,7 @@ struct output_iterator_tag {};
 struct forward_iterator_tag : public input_iterator_tag {};
 struct bidirectional_iterator_tag : public forward_iterator_tag {};
 struct random_access_iterator_tag : public bidirectional_iterator_tag {};
+struct contiguous_iterator_tag : public random_access_iterator_tag {};
 
 //-=========================iterartor
 template <typename Category, typename T, typename Distance = ptrdiff_t, typename Pointer = T *, typename Reference = T &>
@@ -67,9 +76,59 @@ struct iterator {
 };
 
 //-=========================traits
+// std的标签换成对应的nostd标签，std容器的迭代器也能走nostd按类别分派的实现
+template <typename Category>
+struct _from_std_category {
+    using type = Category;
+};
+template <>
+struct _from_std_category<std::input_iterator_tag> {
+    using type = input_iterator_tag;
+};
+template <>
+struct _from_std_category<std::output_iterator_tag> {
+    using type = output_iterator_tag;
+};
+template <>
+struct _from_std_category<std::forward_iterator_tag> {
+    using type = forward_iterator_tag;
+};
+template <>
+struct _from_std_category<std::bidirectional_iterator_tag> {
+    using type = bidirectional_iterator_tag;
+};
+template <>
+struct _from_std_category<std::random_access_iterator_tag> {
+    using type = random_access_iterator_tag;
+};
+#if EASYSTL_CPLUSPLUS >= 202002L && defined(__cpp_lib_concepts)
+template <>
+struct _from_std_category<std::contiguous_iterator_tag> {
+    using type = contiguous_iterator_tag;
+};
+
+// C++20起std容器的迭代器在iterator_concept里标明连续(iterator_category仍是随机访问)，用std::contiguous_iterator识别
+template <typename Iterator>
+struct _category_of {
+    using type = typename std::conditional<std::contiguous_iterator<Iterator>, contiguous_iterator_tag,
+                                           typename _from_std_category<typename Iterator::iterator_category>::type>::type;
+};
+#else
+template <typename Iterator>
+struct _category_of {
+    using type = typename _from_std_category<typename Iterator::iterator_category>::type;
+};
+#endif
+
+// 改变元素排列方式的适配器(反向、变换、配对)最多是随机访问
+template <typename Category>
+using _at_most_random_access_t =
+    typename std::conditional<std::is_base_of<contiguous_iterator_tag, Category>::value, random_access_iterator_tag,
+                              Category>::type;
+
 template <typename Iterator>
 struct iterator_traits {
-    using iterator_category = typename Iterator::iterator_category;
+    using iterator_category = typename _category_of<Iterator>::type;
     using value_type = typename Iterator::value_type;
     using difference_type = typename Iterator::difference_type;
     using pointer = typename Iterator::pointer;
@@ -77,7 +136,7 @@ struct iterator_traits {
 };
 template <typename T>
 struct iterator_traits<T *> {
-    using iterator_category = random_access_iterator_tag;
+    using iterator_category = contiguous_iterator_tag;
     using value_type = T;
     using difference_type = ptrdiff_t;
     using pointer = T *;
@@ -85,7 +144,7 @@ struct iterator_traits<T *> {
 };
 template <typename T>
 struct iterator_traits<const T *> {
-    using iterator_category = random_access_iterator_tag;
+    using iterator_category = contiguous_iterator_tag;
     using value_type = T;
     using difference_type = ptrdiff_t;
     using pointer = const T *;
@@ -108,6 +167,36 @@ using pointer_t = typename iterator_traits<Iterator>::pointer;
 template <typename Iterator>
 using reference_t = typename iterator_traits<Iterator>::reference;
 
+//-=========================contiguous
+// 没有iterator_category成员的类型只有指针算连续，其余看迭代器类别是否派生自contiguous_iterator_tag
+template <typename...>
+struct _make_void {
+    using type = void;
+};
+
+template <typename Iterator, typename = void>
+struct is_contiguous_iterator : std::is_pointer<Iterator> {};
+
+template <typename Iterator>
+struct is_contiguous_iterator<Iterator, typename _make_void<typename Iterator::iterator_category>::type>
+    : std::is_base_of<contiguous_iterator_tag, typename _category_of<Iterator>::type> {};
+
+///@brief address of the element a contiguous iterator refers to, also valid for the end iterator
+///@note class iterators go through std::to_address in C++20, otherwise through their operator->
+template <typename T>
+constexpr T *to_address(T *p) noexcept {
+    return p;
+}
+
+template <typename Iterator>
+constexpr auto to_address(const Iterator &it) noexcept -> decltype(it.operator->()) {
+#if EASYSTL_CPLUSPLUS >= 202002L && defined(__cpp_lib_concepts)
+    return std::to_address(it);
+#else
+    return it.operator->();
+#endif
+}
+
 //-=========================class
 // reserve_iterator
 /*
@@ -135,7 +224,7 @@ class reverse_iterator {
     Iterator current;  // 与之对应的正向迭代器
 
  public:
-    using iterator_category = iterator_category_t<Iterator>;
+    using iterator_category = _at_most_random_access_t<iterator_category_t<Iterator>>;  // 反向后不再连续
     using value_type = value_type_t<Iterator>;
     using difference_type = difference_type_t<Iterator>;
     using pointer = pointer_t<Iterator>;
@@ -148,7 +237,7 @@ class reverse_iterator {
     explicit reverse_iterator(iterator_type value)
         : current(value) {}
 
-    explicit reverse_iterator(const self &value)
+    reverse_iterator(const self &value)
         : current(value.current) {}
 
     iterator_type base() const { return current; }
@@ -242,7 +331,7 @@ inline reverse_iterator<Iterator> operator+(typename reverse_iterator<Iterator>:
 //-=========================functions
 // distance
 template <typename Input>
-inline difference_type_t<Input> _distance(Input first, Input last, input_iterator_tag) {
+EASYSTL_CONSTEXPR14 difference_type_t<Input> _distance(Input first, Input last, input_iterator_tag) {
     difference_type_t<Input> n = 0;
     while (first != last)
         ++first, ++n;
@@ -250,24 +339,39 @@ inline difference_type_t<Input> _distance(Input first, Input last, input_iterato
 }
 
 template <typename Input>
-inline difference_type_t<Input> _distance(Input first, Input last, random_access_iterator_tag) {
+EASYSTL_CONSTEXPR14 difference_type_t<Input> _distance(Input first, Input last, random_access_iterator_tag) {
+    return last - first;
+}
+
+// 带std标签的迭代器(包括指针)交给std::distance，能用上标准库针对具体迭代器的实现(例如std::list整段求长度)
+template <typename Input>
+inline difference_type_t<Input> _distance(Input first, Input last, std::input_iterator_tag) {
+    return std::distance(first, last);
+}
+
+// std::distance到C++17才是constexpr，随机访问的直接相减，编译期也能用
+template <typename Input>
+EASYSTL_CONSTEXPR14 difference_type_t<Input> _distance(Input first, Input last, std::random_access_iterator_tag) {
     return last - first;
 }
 
 template <typename Input>
-inline difference_type_t<Input> distance(Input first, Input last) {
-    return _distance(first, last, iterator_category_t<Input>());
+EASYSTL_CONSTEXPR14 difference_type_t<Input> distance(Input first, Input last) {
+    using std_category = typename std::iterator_traits<Input>::iterator_category;
+    return _distance(first, last,
+                     typename std::conditional<std::is_base_of<std::input_iterator_tag, std_category>::value, std_category,
+                                               iterator_category_t<Input>>::type());
 }
 
 // advance
 template <typename Input, typename Distance>
-inline void _advance(Input &i, Distance n, input_iterator_tag) {
+EASYSTL_CONSTEXPR14 void _advance(Input &i, Distance n, input_iterator_tag) {
     while (n--)
         ++i;
 }
 
 template <typename Input, typename Distance>
-inline void _advance(Input &i, Distance n, bidirectional_iterator_tag) {
+EASYSTL_CONSTEXPR14 void _advance(Input &i, Distance n, bidirectional_iterator_tag) {
     if (n >= 0)
         while (n--)
             ++i;
@@ -277,12 +381,12 @@ inline void _advance(Input &i, Distance n, bidirectional_iterator_tag) {
 }
 
 template <typename Input, typename Distance>
-inline void _advance(Input &i, Distance n, random_access_iterator_tag) {
+EASYSTL_CONSTEXPR14 void _advance(Input &i, Distance n, random_access_iterator_tag) {
     i += n;
 }
 
 template <typename Input, typename Distance>
-inline void advance(Input &i, Distance n) {
+EASYSTL_CONSTEXPR14 void advance(Input &i, Distance n) {
     _advance(i, n, iterator_category_t<Input>());
 }
 
@@ -1,40 +1,87 @@
 #ifndef __MEMORY_H
 #define __MEMORY_H
 
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 #include "algo/algorithm.h"
+#include "base/config.h"
 #include "base/construct.h"
+#include "base/iterator.h"
+
+/*
+    在未初始化的内存上构造对象，所有容器都建立在这一层上
+
+    - 可平凡复制的类型直接走nostd::copy/fill(连续内存上是memmove/memset)
+    - 其余类型逐个构造，中途抛出异常时析构已经构造好的对象再重新抛出，
+      要么全部构造成功，要么目标区间保持未初始化
+    - 可平凡复制的类型的路径在C++14起是constexpr的，static_vector可以在编译期构造元素
+*/
 
 namespace nostd {
 
+/*****************************************************************************************/
+// default_init_t
+// 容器构造/resize时传入default_init，新元素只做默认初始化：平凡类型不清零，值不确定
+// 用于随后会被整体覆盖写入的缓冲区(read、解码)，省掉一遍内存写
+/*****************************************************************************************/
+struct default_init_t {
+    explicit default_init_t() = default;
+};
+constexpr default_init_t default_init{};
+
+/*****************************************************************************************/
+// is_trivially_relocatable
+// 把对象按字节搬到新地址、并且不再析构旧对象，效果等同于移动构造+析构旧对象
+// 默认只有可平凡复制的类型满足，持有自身地址之外资源的类型(如vector、unique_ptr)可以特化为true
+/*****************************************************************************************/
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// 源和目标是同一种可平凡复制构造的类型时，构造等价于按字节复制
+template <class InputIter, class ForwardIter,
+          class T1 = typename std::remove_cv<typename nostd::iterator_traits<InputIter>::value_type>::type,
+          class T2 = typename nostd::iterator_traits<ForwardIter>::value_type>
+struct _is_trivial_uninit_copy
+    : std::integral_constant<bool, std::is_same<T1, T2>::value && std::is_trivially_copyable<T2>::value &&
+                                       std::is_trivially_copy_constructible<T2>::value &&
+                                       std::is_copy_assignable<T2>::value> {};
+
+template <class ForwardIter, class T, class V = typename nostd::iterator_traits<ForwardIter>::value_type>
+struct _is_trivial_uninit_fill
+    : std::integral_constant<bool, std::is_trivially_copyable<V>::value &&
+                                       std::is_trivially_copy_constructible<V>::value &&
+                                       std::is_assignable<V &, const T &>::value> {};
+
 /*****************************************************************************************/
 // uninitialized_copy
 // 把 [first, last) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
 /*****************************************************************************************/
 template <class InputIter, class ForwardIter>
-ForwardIter unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter result, std::true_type) {
+EASYSTL_CONSTEXPR14 ForwardIter unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter result, std::true_type) {
     return nostd::copy(first, last, result);
 }
 
 template <class InputIter, class ForwardIter>
 ForwardIter unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter result, std::false_type) {
-    auto cur = result;
+    ForwardIter cur = result;
     try {
         for (; first != last; ++first, ++cur) {
-            nostd::construct(&*cur, *first);
+            nostd::construct(std::addressof(*cur), *first);
         }
     } catch (...) {
-        for (; result != cur; --cur)
-            nostd::destroy(&*cur);
+        nostd::destroy(result, cur);
+        throw;
     }
     return cur;
 }
 
 template <class InputIter, class ForwardIter>
-ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result) {
-    return nostd::unchecked_uninit_copy(first, last, result,
-                                        std::is_trivially_copy_assignable<
-                                            typename nostd::iterator_traits<ForwardIter>::
-                                                value_type>{});
+EASYSTL_CONSTEXPR14 ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result) {
+    return nostd::unchecked_uninit_copy(first, last, result, _is_trivial_uninit_copy<InputIter, ForwardIter>());
 }
 
 /*****************************************************************************************/
@@ -42,30 +89,27 @@ ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter resu
 // 把 [first, first + n) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
 /*****************************************************************************************/
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result, std::true_type) {
-    return nostd::copy_n(first, n, result).second;
+EASYSTL_CONSTEXPR14 ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result, std::true_type) {
+    return nostd::copy_n(first, n, result);
 }
 
 template <class InputIter, class Size, class ForwardIter>
 ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result, std::false_type) {
-    auto cur = result;
+    ForwardIter cur = result;
     try {
         for (; n > 0; --n, ++cur, ++first) {
-            nostd::construct(&*cur, *first);
+            nostd::construct(std::addressof(*cur), *first);
         }
     } catch (...) {
-        for (; result != cur; --cur)
-            nostd::destroy(&*cur);
+        nostd::destroy(result, cur);
+        throw;
     }
     return cur;
 }
 
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result) {
-    return nostd::unchecked_uninit_copy_n(first, n, result,
-                                          std::is_trivially_copy_assignable<
-                                              typename nostd::iterator_traits<InputIter>::
-                                                  value_type>{});
+EASYSTL_CONSTEXPR14 ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result) {
+    return nostd::unchecked_uninit_copy_n(first, n, result, _is_trivial_uninit_copy<InputIter, ForwardIter>());
 }
 
 /*****************************************************************************************/
@@ -73,29 +117,26 @@ ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result) {
 // 在 [first, last) 区间内填充元素值
 /*****************************************************************************************/
 template <class ForwardIter, class T>
-void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::true_type) {
+EASYSTL_CONSTEXPR14 void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::true_type) {
     nostd::fill(first, last, value);
 }
 
 template <class ForwardIter, class T>
 void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::false_type) {
-    auto cur = first;
+    ForwardIter cur = first;
     try {
         for (; cur != last; ++cur) {
-            nostd::construct(&*cur, value);
+            nostd::construct(std::addressof(*cur), value);
         }
     } catch (...) {
-        for (; first != cur; ++first)
-            nostd::destroy(&*first);
+        nostd::destroy(first, cur);
+        throw;
     }
 }
 
 template <class ForwardIter, class T>
-void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
-    nostd::unchecked_uninit_fill(first, last, value,
-                                 std::is_trivially_copy_assignable<
-                                     typename nostd::iterator_traits<ForwardIter>::
-                                         value_type>{});
+EASYSTL_CONSTEXPR14 void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
+    nostd::unchecked_uninit_fill(first, last, value, _is_trivial_uninit_fill<ForwardIter, T>());
 }
 
 /*****************************************************************************************/
@@ -103,7 +144,7 @@ void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
 // 从 first 位置开始，填充 n 个元素值，返回填充结束的位置
 /*****************************************************************************************/
 template <class ForwardIter, class Size, class T>
-ForwardIter
+EASYSTL_CONSTEXPR14 ForwardIter
 unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::true_type) {
     return nostd::fill_n(first, n, value);
 }
@@ -111,24 +152,21 @@ unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::true_typ
 template <class ForwardIter, class Size, class T>
 ForwardIter
 unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::false_type) {
-    auto cur = first;
+    ForwardIter cur = first;
     try {
         for (; n > 0; --n, ++cur) {
-            nostd::construct(&*cur, value);
+            nostd::construct(std::addressof(*cur), value);
         }
     } catch (...) {
-        for (; first != cur; ++first)
-            nostd::destroy(&*first);
+        nostd::destroy(first, cur);
+        throw;
     }
     return cur;
 }
 
 template <class ForwardIter, class Size, class T>
-ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
-    return nostd::unchecked_uninit_fill_n(first, n, value,
-                                          std::is_trivially_copy_assignable<
-                                              typename nostd::iterator_traits<ForwardIter>::
-                                                  value_type>{});
+EASYSTL_CONSTEXPR14 ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
+    return nostd::unchecked_uninit_fill_n(first, n, value, _is_trivial_uninit_fill<ForwardIter, T>());
 }
 
 /*****************************************************************************************/
@@ -136,9 +174,9 @@ ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
 // 把[first, last)上的内容移动到以 result 为起始处的空间，返回移动结束的位置
 /*****************************************************************************************/
 template <class InputIter, class ForwardIter>
-ForwardIter
+EASYSTL_CONSTEXPR14 ForwardIter
 unchecked_uninit_move(InputIter first, InputIter last, ForwardIter result, std::true_type) {
-    return nostd::move(first, last, result);
+    return nostd::copy(first, last, result);
 }
 
 template <class InputIter, class ForwardIter>
@@ -147,20 +185,18 @@ unchecked_uninit_move(InputIter first, InputIter last, ForwardIter result, std::
     ForwardIter cur = result;
     try {
         for (; first != last; ++first, ++cur) {
-            nostd::construct(&*cur, nostd::move(*first));
+            nostd::construct(std::addressof(*cur), std::move(*first));
         }
     } catch (...) {
         nostd::destroy(result, cur);
+        throw;
     }
     return cur;
 }
 
 template <class InputIter, class ForwardIter>
-ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result) {
-    return nostd::unchecked_uninit_move(first, last, result,
-                                        std::is_trivially_move_assignable<
-                                            typename nostd::iterator_traits<InputIter>::
-                                                value_type>{});
+EASYSTL_CONSTEXPR14 ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result) {
+    return nostd::unchecked_uninit_move(first, last, result, _is_trivial_uninit_copy<InputIter, ForwardIter>());
 }
 
 /*****************************************************************************************/
@@ -168,33 +204,155 @@ ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter resu
 // 把[first, first + n)上的内容移动到以 result 为起始处的空间，返回移动结束的位置
 /*****************************************************************************************/
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter
+EASYSTL_CONSTEXPR14 ForwardIter
 unchecked_uninit_move_n(InputIter first, Size n, ForwardIter result, std::true_type) {
-    return nostd::move(first, first + n, result);
+    return nostd::copy_n(first, n, result);
 }
 
 template <class InputIter, class Size, class ForwardIter>
 ForwardIter
 unchecked_uninit_move_n(InputIter first, Size n, ForwardIter result, std::false_type) {
-    auto cur = result;
+    ForwardIter cur = result;
     try {
         for (; n > 0; --n, ++first, ++cur) {
-            nostd::construct(&*cur, nostd::move(*first));
+            nostd::construct(std::addressof(*cur), std::move(*first));
         }
     } catch (...) {
-        for (; result != cur; ++result)
-            nostd::destroy(&*result);
+        nostd::destroy(result, cur);
         throw;
     }
     return cur;
 }
 
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
-    return nostd::unchecked_uninit_move_n(first, n, result,
-                                          std::is_trivially_move_assignable<
-                                              typename nostd::iterator_traits<InputIter>::
-                                                  value_type>{});
+EASYSTL_CONSTEXPR14 ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
+    return nostd::unchecked_uninit_move_n(first, n, result, _is_trivial_uninit_copy<InputIter, ForwardIter>());
+}
+
+/*****************************************************************************************/
+// uninitialized_value_construct
+// 在 [first, last) 上值初始化(T())，可平凡复制的类型直接按T()填充(标量为memset 0)
+/*****************************************************************************************/
+template <class ForwardIter>
+EASYSTL_CONSTEXPR14 void unchecked_uninit_value_construct(ForwardIter first, ForwardIter last, std::true_type) {
+    typedef typename nostd::iterator_traits<ForwardIter>::value_type value_type;
+    nostd::fill(first, last, value_type());
+}
+
+template <class ForwardIter>
+void unchecked_uninit_value_construct(ForwardIter first, ForwardIter last, std::false_type) {
+    ForwardIter cur = first;
+    try {
+        for (; cur != last; ++cur) {
+            nostd::construct(std::addressof(*cur));
+        }
+    } catch (...) {
+        nostd::destroy(first, cur);
+        throw;
+    }
+}
+
+template <class ForwardIter>
+EASYSTL_CONSTEXPR14 void uninitialized_value_construct(ForwardIter first, ForwardIter last) {
+    typedef typename nostd::iterator_traits<ForwardIter>::value_type value_type;
+    nostd::unchecked_uninit_value_construct(first, last, _is_trivial_uninit_fill<ForwardIter, value_type>());
+}
+
+template <class ForwardIter, class Size>
+EASYSTL_CONSTEXPR14 ForwardIter uninitialized_value_construct_n(ForwardIter first, Size n) {
+    ForwardIter last = first;
+    for (; n > 0; --n) {
+        ++last;
+    }
+    nostd::uninitialized_value_construct(first, last);
+    return last;
+}
+
+/*****************************************************************************************/
+// uninitialized_default_construct
+// 在 [first, last) 上默认初始化(new T)，平凡类型什么都不做，不会清零
+/*****************************************************************************************/
+template <class ForwardIter>
+EASYSTL_CONSTEXPR14 void unchecked_uninit_default_construct(ForwardIter, ForwardIter, std::true_type) {}
+
+template <class ForwardIter>
+void unchecked_uninit_default_construct(ForwardIter first, ForwardIter last, std::false_type) {
+    typedef typename nostd::iterator_traits<ForwardIter>::value_type value_type;
+    ForwardIter cur = first;
+    try {
+        for (; cur != last; ++cur) {
+            ::new (static_cast<void*>(std::addressof(*cur))) value_type;
+        }
+    } catch (...) {
+        nostd::destroy(first, cur);
+        throw;
+    }
+}
+
+template <class ForwardIter>
+EASYSTL_CONSTEXPR14 void uninitialized_default_construct(ForwardIter first, ForwardIter last) {
+    typedef typename nostd::iterator_traits<ForwardIter>::value_type value_type;
+    nostd::unchecked_uninit_default_construct(first, last, std::is_trivially_default_constructible<value_type>());
+}
+
+template <class ForwardIter, class Size>
+EASYSTL_CONSTEXPR14 ForwardIter uninitialized_default_construct_n(ForwardIter first, Size n) {
+    ForwardIter last = first;
+    for (; n > 0; --n) {
+        ++last;
+    }
+    nostd::uninitialized_default_construct(first, last);
+    return last;
+}
+
+/*****************************************************************************************/
+// uninitialized_relocate
+// 把 [first, last) 上的对象搬到以 result 为起始处的未初始化空间，源区间的对象被析构，返回搬移结束的位置
+// 两边都是连续迭代器且类型可平凡搬移时直接memcpy；其余类型移动构造可能抛异常时退化为复制构造，
+// 全部构造成功后才析构源对象，中途抛异常时源区间保持不变
+/*****************************************************************************************/
+template <class InputIter, class ForwardIter>
+ForwardIter unchecked_uninit_relocate(InputIter first, InputIter last, ForwardIter result, std::true_type) {
+    const size_t n = static_cast<size_t>(last - first);
+    if (n != 0) {
+        std::memcpy(static_cast<void*>(nostd::to_address(result)), static_cast<const void*>(nostd::to_address(first)),
+                    n * sizeof(*first));
+    }
+    return result + n;
+}
+
+template <class InputIter, class ForwardIter>
+ForwardIter unchecked_uninit_relocate(InputIter first, InputIter last, ForwardIter result, std::false_type) {
+    ForwardIter cur = result;
+    try {
+        for (InputIter it = first; it != last; ++it, ++cur) {
+            nostd::construct(std::addressof(*cur), std::move_if_noexcept(*it));
+        }
+    } catch (...) {
+        nostd::destroy(result, cur);
+        throw;
+    }
+    nostd::destroy(first, last);
+    return cur;
+}
+
+template <class InputIter, class ForwardIter>
+ForwardIter uninitialized_relocate(InputIter first, InputIter last, ForwardIter result) {
+    typedef typename nostd::iterator_traits<ForwardIter>::value_type value_type;
+    return nostd::unchecked_uninit_relocate(
+        first, last, result,
+        std::integral_constant<bool, is_contiguous_iterator<InputIter>::value && is_contiguous_iterator<ForwardIter>::value &&
+                                         std::is_same<typename nostd::iterator_traits<InputIter>::value_type, value_type>::value &&
+                                         is_trivially_relocatable<value_type>::value>());
+}
+
+template <class InputIter, class Size, class ForwardIter>
+ForwardIter uninitialized_relocate_n(InputIter first, Size n, ForwardIter result) {
+    InputIter last = first;
+    for (; n > 0; --n) {
+        ++last;
+    }
+    return nostd::uninitialized_relocate(first, last, result);
 }
 
 }  // namespace nostd
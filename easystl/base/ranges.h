@@ -0,0 +1,800 @@
+/*
+    ref: https://en.cppreference.com/w/cpp/ranges
+
+    惰性的range适配器：不复制元素、不分配内存，迭代时才计算，多个步骤串起来只遍历一遍
+    按C++11写，没有concepts，range就是能用std::begin/std::end取到迭代器的东西(容器、数组、view)
+
+    //-=---------------------------
+    //views:                                                         迭代器类别
+    //-=---------------------------
+    views::all(r)           容器左值包装成iterator_range，view原样复制
+    views::filter(pred)     只保留pred(x)为true的元素                  最多双向
+    views::transform(f)     元素换成f(x)                               同底层
+    views::take(n)          前n个元素                                  随机访问保持，否则最多前向
+    views::drop(n)          跳过前n个元素                              同底层
+    views::zip(r1, r2)      按位置配对成std::pair，长度取短的一个        两者中较弱的
+    views::enumerate        std::pair<下标, 元素>                      同底层
+    views::chunk(n)         每n个一组，每组是一个iterator_range         随机访问保持，否则最多前向
+    views::stride(n)        从第一个开始每隔n个取一个                   随机访问保持，否则最多前向
+
+    用法：
+    for (auto &x : v | views::filter(is_valid) | views::take(10)) ...
+    auto pipeline = views::transform(parse) | views::stride(2);    适配器之间可以先组合
+    auto r = v | pipeline;
+    nostd::copy(r.begin(), r.end(), out);                           迭代器使用nostd的类别标签，直接交给nostd算法
+
+    注意：
+    - 容器按迭代器保存，容器要比view活得长；对临时容器建view编译报错
+    - view里的函数对象由迭代器通过指针访问，view要比它的迭代器活得长
+    - filter的begin()每次都从头找第一个满足条件的元素
+    - transform/zip/enumerate解引用返回临时值，可以读，不能用来原地排序
+*/
+#ifndef __RANGES_H
+#define __RANGES_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "base/iterator.h"
+
+namespace nostd {
+
+//-=========================helpers
+// view都从view_base派生，views::all据此区分view和容器
+struct view_base {};
+
+template <class R>
+auto _range_begin(R &r) -> decltype(std::begin(r)) {
+    return std::begin(r);
+}
+
+template <class R>
+auto _range_end(R &r) -> decltype(std::end(r)) {
+    return std::end(r);
+}
+
+template <class R>
+using _range_iterator_t = decltype(nostd::_range_begin(std::declval<R &>()));
+
+template <class It>
+using _is_random_access = std::is_base_of<random_access_iterator_tag, iterator_category_t<It>>;
+
+// 两个类别中较弱的一个
+template <class C1, class C2>
+using _weaker_category_t = typename std::conditional<std::is_base_of<C1, C2>::value, C1, C2>::type;
+
+// 最多前进n步，不越过last，返回实际前进的步数
+template <class It>
+difference_type_t<It> _advance_bounded(It &it, difference_type_t<It> n, It last, input_iterator_tag) {
+    difference_type_t<It> moved = 0;
+    for (; moved < n && it != last; ++moved) {
+        ++it;
+    }
+    return moved;
+}
+
+template <class It>
+difference_type_t<It> _advance_bounded(It &it, difference_type_t<It> n, It last, random_access_iterator_tag) {
+    difference_type_t<It> left = last - it;
+    difference_type_t<It> moved = n < left ? n : left;
+    it += moved;
+    return moved;
+}
+
+template <class It>
+difference_type_t<It> _advance_bounded(It &it, difference_type_t<It> n, It last) {
+    return nostd::_advance_bounded(it, n, last, iterator_category_t<It>());
+}
+
+/*
+    view迭代器的公共部分：派生类实现
+    deref() inc() equal(o)              所有类别
+    dec()                               双向
+    advance(n) distance_to(o)           随机访问，distance_to(o)返回o - *this
+    其余运算符在这里统一生成；只有用到时才实例化，前向迭代器不实现dec()也没关系
+*/
+template <class Derived, class Category, class Value, class Reference, class Difference>
+class _view_iterator {
+ public:
+    using iterator_category = Category;
+    using value_type = Value;
+    using difference_type = Difference;
+    using pointer = void;
+    using reference = Reference;
+
+ public:
+    reference operator*() const { return _self().deref(); }
+    reference operator[](difference_type n) const { return (_self() + n).deref(); }
+
+    Derived &operator++() {
+        _self().inc();
+        return _self();
+    }
+    Derived operator++(int) {
+        Derived tmp = _self();
+        _self().inc();
+        return tmp;
+    }
+    Derived &operator--() {
+        _self().dec();
+        return _self();
+    }
+    Derived operator--(int) {
+        Derived tmp = _self();
+        _self().dec();
+        return tmp;
+    }
+    Derived &operator+=(difference_type n) {
+        _self().advance(n);
+        return _self();
+    }
+    Derived &operator-=(difference_type n) {
+        _self().advance(-n);
+        return _self();
+    }
+
+    friend Derived operator+(Derived it, difference_type n) { return it += n; }
+    friend Derived operator+(difference_type n, Derived it) { return it += n; }
+    friend Derived operator-(Derived it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const Derived &lhs, const Derived &rhs) { return _distance(rhs, lhs); }
+
+    friend bool operator==(const Derived &lhs, const Derived &rhs) { return _equal(lhs, rhs); }
+    friend bool operator!=(const Derived &lhs, const Derived &rhs) { return !_equal(lhs, rhs); }
+    friend bool operator<(const Derived &lhs, const Derived &rhs) { return _distance(lhs, rhs) > 0; }
+    friend bool operator>(const Derived &lhs, const Derived &rhs) { return rhs < lhs; }
+    friend bool operator<=(const Derived &lhs, const Derived &rhs) { return !(rhs < lhs); }
+    friend bool operator>=(const Derived &lhs, const Derived &rhs) { return !(lhs < rhs); }
+
+ private:
+    // 派生类把_view_iterator声明为友元，友元函数经由这两个静态成员访问派生类的私有实现
+    static bool _equal(const Derived &lhs, const Derived &rhs) { return lhs.equal(rhs); }
+    static difference_type _distance(const Derived &from, const Derived &to) { return from.distance_to(to); }
+
+    Derived &_self() { return static_cast<Derived &>(*this); }
+    const Derived &_self() const { return static_cast<const Derived &>(*this); }
+};
+
+//-=========================iterator_range
+// 一对迭代器，views::all对容器的包装，也是chunk的元素类型
+template <class It>
+class iterator_range : public view_base {
+ public:
+    using iterator = It;
+    using difference_type = difference_type_t<It>;
+
+    iterator_range() = default;
+    iterator_range(It first, It last)
+        : m_first(first), m_last(last) {}
+
+    It begin() const { return m_first; }
+    It end() const { return m_last; }
+    bool empty() const { return m_first == m_last; }
+    difference_type size() const { return nostd::distance(m_first, m_last); }
+
+ private:
+    It m_first = It();
+    It m_last = It();
+};
+
+// view按值保存，容器左值转成iterator_range
+template <class R>
+using _all_t = typename std::conditional<std::is_base_of<view_base, typename std::decay<R>::type>::value,
+                                         typename std::decay<R>::type, iterator_range<_range_iterator_t<R>>>::type;
+
+template <class R>
+_all_t<R> _view_all(R &&r, std::true_type) {
+    return std::forward<R>(r);
+}
+
+template <class R>
+_all_t<R> _view_all(R &&r, std::false_type) {
+    static_assert(std::is_lvalue_reference<R>::value, "views: a view of a temporary container would dangle");
+    return _all_t<R>(nostd::_range_begin(r), nostd::_range_end(r));
+}
+
+template <class R>
+_all_t<R> _view_all(R &&r) {
+    return nostd::_view_all(std::forward<R>(r), std::is_base_of<view_base, typename std::decay<R>::type>());
+}
+
+//-=========================filter
+template <class V, class Pred>
+class filter_view : public view_base {
+    using _base_iter = _range_iterator_t<const V>;
+
+ public:
+    class iterator : public _view_iterator<iterator, _weaker_category_t<iterator_category_t<_base_iter>, bidirectional_iterator_tag>,
+                                           value_type_t<_base_iter>, reference_t<_base_iter>, difference_type_t<_base_iter>> {
+        friend class filter_view;
+        friend class _view_iterator<iterator, _weaker_category_t<iterator_category_t<_base_iter>, bidirectional_iterator_tag>,
+                                    value_type_t<_base_iter>, reference_t<_base_iter>, difference_type_t<_base_iter>>;
+
+     public:
+        iterator() = default;
+        _base_iter base() const { return m_it; }
+
+     private:
+        iterator(_base_iter it, _base_iter last, const Pred *pred)
+            : m_it(it), m_last(last), m_pred(pred) {}
+
+        reference_t<_base_iter> deref() const { return *m_it; }
+        void inc() {
+            ++m_it;
+            _skip();
+        }
+        void dec() {
+            do {
+                --m_it;
+            } while (!(*m_pred)(*m_it));
+        }
+        bool equal(const iterator &o) const { return m_it == o.m_it; }
+        void _skip() {
+            while (m_it != m_last && !(*m_pred)(*m_it)) {
+                ++m_it;
+            }
+        }
+
+        _base_iter m_it = _base_iter();
+        _base_iter m_last = _base_iter();
+        const Pred *m_pred = nullptr;
+    };
+
+    filter_view(V base, Pred pred)
+        : m_base(std::move(base)), m_pred(std::move(pred)) {}
+
+    iterator begin() const {
+        iterator it(nostd::_range_begin(m_base), nostd::_range_end(m_base), &m_pred);
+        it._skip();
+        return it;
+    }
+    iterator end() const { return iterator(nostd::_range_end(m_base), nostd::_range_end(m_base), &m_pred); }
+    V base() const { return m_base; }
+
+ private:
+    V m_base;
+    Pred m_pred;
+};
+
+//-=========================transform
+template <class V, class F>
+class transform_view : public view_base {
+    using _base_iter = _range_iterator_t<const V>;
+    using _result = decltype(std::declval<const F &>()(*std::declval<_base_iter>()));
+    using _category = _at_most_random_access_t<iterator_category_t<_base_iter>>;
+
+ public:
+    class iterator : public _view_iterator<iterator, _category, typename std::decay<_result>::type,
+                                           _result, difference_type_t<_base_iter>> {
+        friend class transform_view;
+        friend class _view_iterator<iterator, _category, typename std::decay<_result>::type, _result,
+                                    difference_type_t<_base_iter>>;
+
+     public:
+        iterator() = default;
+        _base_iter base() const { return m_it; }
+
+     private:
+        iterator(_base_iter it, const F *fn)
+            : m_it(it), m_fn(fn) {}
+
+        _result deref() const { return (*m_fn)(*m_it); }
+        void inc() { ++m_it; }
+        void dec() { --m_it; }
+        void advance(difference_type_t<_base_iter> n) { m_it += n; }
+        difference_type_t<_base_iter> distance_to(const iterator &o) const { return o.m_it - m_it; }
+        bool equal(const iterator &o) const { return m_it == o.m_it; }
+
+        _base_iter m_it = _base_iter();
+        const F *m_fn = nullptr;
+    };
+
+    transform_view(V base, F fn)
+        : m_base(std::move(base)), m_fn(std::move(fn)) {}
+
+    iterator begin() const { return iterator(nostd::_range_begin(m_base), &m_fn); }
+    iterator end() const { return iterator(nostd::_range_end(m_base), &m_fn); }
+    V base() const { return m_base; }
+
+ private:
+    V m_base;
+    F m_fn;
+};
+
+//-=========================take
+// 非随机访问时迭代器带着剩余个数，剩余个数相同或者底层迭代器相同都表示同一个位置
+template <class It>
+class _counted_iterator
+    : public _view_iterator<_counted_iterator<It>, _weaker_category_t<iterator_category_t<It>, forward_iterator_tag>,
+                            value_type_t<It>, reference_t<It>, difference_type_t<It>> {
+    friend class _view_iterator<_counted_iterator<It>, _weaker_category_t<iterator_category_t<It>, forward_iterator_tag>,
+                                value_type_t<It>, reference_t<It>, difference_type_t<It>>;
+
+ public:
+    _counted_iterator() = default;
+    _counted_iterator(It it, difference_type_t<It> n)
+        : m_it(it), m_left(n) {}
+    It base() const { return m_it; }
+
+ private:
+    reference_t<It> deref() const { return *m_it; }
+    void inc() {
+        ++m_it;
+        --m_left;
+    }
+    bool equal(const _counted_iterator &o) const { return m_left == o.m_left || m_it == o.m_it; }
+
+    It m_it = It();
+    difference_type_t<It> m_left = 0;
+};
+
+template <class V>
+class take_view : public view_base {
+    using _base_iter = _range_iterator_t<const V>;
+    using _ra = _is_random_access<_base_iter>;
+
+ public:
+    // 随机访问时直接用底层迭代器
+    using iterator = typename std::conditional<_ra::value, _base_iter, _counted_iterator<_base_iter>>::type;
+
+    take_view(V base, difference_type_t<_base_iter> n)
+        : m_base(std::move(base)), m_n(n < 0 ? 0 : n) {}
+
+    iterator begin() const { return _begin(_ra()); }
+    iterator end() const { return _end(_ra()); }
+    V base() const { return m_base; }
+
+ private:
+    iterator _begin(std::true_type) const { return nostd::_range_begin(m_base); }
+    iterator _begin(std::false_type) const { return iterator(nostd::_range_begin(m_base), m_n); }
+    iterator _end(std::true_type) const {
+        _base_iter it = nostd::_range_begin(m_base);
+        nostd::_advance_bounded(it, m_n, nostd::_range_end(m_base));
+        return it;
+    }
+    iterator _end(std::false_type) const { return iterator(nostd::_range_end(m_base), 0); }
+
+    V m_base;
+    difference_type_t<_base_iter> m_n;
+};
+
+//-=========================drop
+template <class V>
+class drop_view : public view_base {
+    using _base_iter = _range_iterator_t<const V>;
+
+ public:
+    using iterator = _base_iter;
+
+    drop_view(V base, difference_type_t<_base_iter> n)
+        : m_base(std::move(base)), m_n(n < 0 ? 0 : n) {}
+
+    iterator begin() const {
+        _base_iter it = nostd::_range_begin(m_base);
+        nostd::_advance_bounded(it, m_n, nostd::_range_end(m_base));
+        return it;
+    }
+    iterator end() const { return nostd::_range_end(m_base); }
+    V base() const { return m_base; }
+
+ private:
+    V m_base;
+    difference_type_t<_base_iter> m_n;
+};
+
+//-=========================zip
+// 任何一边到头就结束：两边都是随机访问时end是按较短的长度算出来的位置，否则任一底层迭代器相等即相等
+template <class V1, class V2>
+class zip_view : public view_base {
+    using _iter1 = _range_iterator_t<const V1>;
+    using _iter2 = _range_iterator_t<const V2>;
+    using _category =
+        _at_most_random_access_t<_weaker_category_t<iterator_category_t<_iter1>, iterator_category_t<_iter2>>>;
+    using _ra = std::is_base_of<random_access_iterator_tag, _category>;
+    using _reference = std::pair<reference_t<_iter1>, reference_t<_iter2>>;
+    using _value = std::pair<value_type_t<_iter1>, value_type_t<_iter2>>;
+    using _difference = difference_type_t<_iter1>;
+
+ public:
+    class iterator : public _view_iterator<iterator, _category, _value, _reference, _difference> {
+        friend class zip_view;
+        friend class _view_iterator<iterator, _category, _value, _reference, _difference>;
+
+     public:
+        iterator() = default;
+
+     private:
+        iterator(_iter1 it1, _iter2 it2)
+            : m_it1(it1), m_it2(it2) {}
+
+        _reference deref() const { return _reference(*m_it1, *m_it2); }
+        void inc() {
+            ++m_it1;
+            ++m_it2;
+        }
+        void dec() {
+            --m_it1;
+            --m_it2;
+        }
+        void advance(_difference n) {
+            m_it1 += n;
+            m_it2 += n;
+        }
+        _difference distance_to(const iterator &o) const { return o.m_it1 - m_it1; }
+        bool equal(const iterator &o) const { return m_it1 == o.m_it1 || m_it2 == o.m_it2; }
+
+        _iter1 m_it1 = _iter1();
+        _iter2 m_it2 = _iter2();
+    };
+
+    zip_view(V1 base1, V2 base2)
+        : m_base1(std::move(base1)), m_base2(std::move(base2)) {}
+
+    iterator begin() const { return iterator(nostd::_range_begin(m_base1), nostd::_range_begin(m_base2)); }
+    iterator end() const { return _end(_ra()); }
+
+ private:
+    iterator _end(std::true_type) const {
+        _difference n1 = nostd::_range_end(m_base1) - nostd::_range_begin(m_base1);
+        _difference n2 = nostd::_range_end(m_base2) - nostd::_range_begin(m_base2);
+        _difference n = n1 < n2 ? n1 : n2;
+        return iterator(nostd::_range_begin(m_base1) + n, nostd::_range_begin(m_base2) + n);
+    }
+    iterator _end(std::false_type) const { return iterator(nostd::_range_end(m_base1), nostd::_range_end(m_base2)); }
+
+    V1 m_base1;
+    V2 m_base2;
+};
+
+//-=========================enumerate
+template <class V>
+class enumerate_view : public view_base {
+    using _base_iter = _range_iterator_t<const V>;
+    using _difference = difference_type_t<_base_iter>;
+    using _reference = std::pair<_difference, reference_t<_base_iter>>;
+    using _value = std::pair<_difference, value_type_t<_base_iter>>;
+    using _category = _at_most_random_access_t<iterator_category_t<_base_iter>>;
+
+ public:
+    class iterator : public _view_iterator<iterator, _category, _value, _reference, _difference> {
+        friend class enumerate_view;
+        friend class _view_iterator<iterator, _category, _value, _reference, _difference>;
+
+     public:
+        iterator() = default;
+        _base_iter base() const { return m_it; }
+        _difference index() const { return m_index; }
+
+     private:
+        iterator(_base_iter it, _difference index)
+            : m_it(it), m_index(index) {}
+
+        _reference deref() const { return _reference(m_index, *m_it); }
+        void inc() {
+            ++m_it;
+            ++m_index;
+        }
+        void dec() {
+            --m_it;
+            --m_index;
+        }
+        void advance(_difference n) {
+            m_it += n;
+            m_index += n;
+        }
+        _difference distance_to(const iterator &o) const { return o.m_index - m_index; }
+        bool equal(const iterator &o) const { return m_it == o.m_it; }
+
+        _base_iter m_it = _base_iter();
+        _difference m_index = 0;
+    };
+
+    explicit enumerate_view(V base)
+        : m_base(std::move(base)) {}
+
+    iterator begin() const { return iterator(nostd::_range_begin(m_base), 0); }
+    // 非随机访问时end的下标用不到(比较只看底层迭代器)
+    iterator end() const { return _end(_is_random_access<_base_iter>()); }
+    V base() const { return m_base; }
+
+ private:
+    iterator _end(std::true_type) const {
+        return iterator(nostd::_range_end(m_base), nostd::_range_end(m_base) - nostd::_range_begin(m_base));
+    }
+    iterator _end(std::false_type) const { return iterator(nostd::_range_end(m_base), 0); }
+
+    V m_base;
+};
+
+//-=========================chunk / stride
+// 随机访问时用下标表示位置：pos是n的整数倍，或者等于size(末尾)；第pos/n(向上取整)个元素
+template <class It>
+struct _strided_pos {
+    using difference_type = difference_type_t<It>;
+
+    It first;
+    difference_type pos;
+    difference_type size;
+    difference_type n;
+
+    difference_type index() const { return (pos + n - 1) / n; }
+    void advance(difference_type k) {
+        difference_type p = (index() + k) * n;
+        pos = p < size ? p : size;
+    }
+};
+
+template <class It, bool RandomAccess = _is_random_access<It>::value>
+class _chunk_iterator;
+
+template <class It>
+class _chunk_iterator<It, true>
+    : public _view_iterator<_chunk_iterator<It, true>, random_access_iterator_tag, iterator_range<It>, iterator_range<It>,
+                            difference_type_t<It>> {
+    friend class _view_iterator<_chunk_iterator<It, true>, random_access_iterator_tag, iterator_range<It>,
+                                iterator_range<It>, difference_type_t<It>>;
+    using _difference = difference_type_t<It>;
+
+ public:
+    _chunk_iterator() = default;
+    _chunk_iterator(It first, _difference pos, _difference size, _difference n)
+        : m_pos{first, pos, size, n} {}
+
+ private:
+    iterator_range<It> deref() const {
+        _difference last = m_pos.size - m_pos.pos < m_pos.n ? m_pos.size : m_pos.pos + m_pos.n;
+        return iterator_range<It>(m_pos.first + m_pos.pos, m_pos.first + last);
+    }
+    void inc() { m_pos.advance(1); }
+    void dec() { m_pos.advance(-1); }
+    void advance(_difference k) { m_pos.advance(k); }
+    _difference distance_to(const _chunk_iterator &o) const { return o.m_pos.index() - m_pos.index(); }
+    bool equal(const _chunk_iterator &o) const { return m_pos.pos == o.m_pos.pos; }
+
+    _strided_pos<It> m_pos = _strided_pos<It>{It(), 0, 0, 1};
+};
+
+// 前向：缓存这一组的结尾，++时再往后找下一组
+template <class It>
+class _chunk_iterator<It, false>
+    : public _view_iterator<_chunk_iterator<It, false>, forward_iterator_tag, iterator_range<It>, iterator_range<It>,
+                            difference_type_t<It>> {
+    friend class _view_iterator<_chunk_iterator<It, false>, forward_iterator_tag, iterator_range<It>, iterator_range<It>,
+                                difference_type_t<It>>;
+    using _difference = difference_type_t<It>;
+
+ public:
+    _chunk_iterator() = default;
+    _chunk_iterator(It cur, It last, _difference n)
+        : m_cur(cur), m_next(cur), m_last(last), m_n(n) {
+        nostd::_advance_bounded(m_next, m_n, m_last);
+    }
+
+ private:
+    iterator_range<It> deref() const { return iterator_range<It>(m_cur, m_next); }
+    void inc() {
+        m_cur = m_next;
+        nostd::_advance_bounded(m_next, m_n, m_last);
+    }
+    bool equal(const _chunk_iterator &o) const { return m_cur == o.m_cur; }
+
+    It m_cur = It();
+    It m_next = It();
+    It m_last = It();
+    _difference m_n = 1;
+};
+
+template <class It, bool RandomAccess = _is_random_access<It>::value>
+class _stride_iterator;
+
+template <class It>
+class _stride_iterator<It, true> : public _view_iterator<_stride_iterator<It, true>, random_access_iterator_tag,
+                                                         value_type_t<It>, reference_t<It>, difference_type_t<It>> {
+    friend class _view_iterator<_stride_iterator<It, true>, random_access_iterator_tag, value_type_t<It>, reference_t<It>,
+                                difference_type_t<It>>;
+    using _difference = difference_type_t<It>;
+
+ public:
+    _stride_iterator() = default;
+    _stride_iterator(It first, _difference pos, _difference size, _difference n)
+        : m_pos{first, pos, size, n} {}
+
+ private:
+    reference_t<It> deref() const { return m_pos.first[m_pos.pos]; }
+    void inc() { m_pos.advance(1); }
+    void dec() { m_pos.advance(-1); }
+    void advance(_difference k) { m_pos.advance(k); }
+    _difference distance_to(const _stride_iterator &o) const { return o.m_pos.index() - m_pos.index(); }
+    bool equal(const _stride_iterator &o) const { return m_pos.pos == o.m_pos.pos; }
+
+    _strided_pos<It> m_pos = _strided_pos<It>{It(), 0, 0, 1};
+};
+
+template <class It>
+class _stride_iterator<It, false>
+    : public _view_iterator<_stride_iterator<It, false>, _weaker_category_t<iterator_category_t<It>, forward_iterator_tag>,
+                            value_type_t<It>, reference_t<It>, difference_type_t<It>> {
+    friend class _view_iterator<_stride_iterator<It, false>,
+                                _weaker_category_t<iterator_category_t<It>, forward_iterator_tag>, value_type_t<It>,
+                                reference_t<It>, difference_type_t<It>>;
+    using _difference = difference_type_t<It>;
+
+ public:
+    _stride_iterator() = default;
+    _stride_iterator(It cur, It last, _difference n)
+        : m_cur(cur), m_last(last), m_n(n) {}
+
+ private:
+    reference_t<It> deref() const { return *m_cur; }
+    void inc() { nostd::_advance_bounded(m_cur, m_n, m_last); }
+    bool equal(const _stride_iterator &o) const { return m_cur == o.m_cur; }
+
+    It m_cur = It();
+    It m_last = It();
+    _difference m_n = 1;
+};
+
+// chunk和stride的view只差在迭代器上
+template <class V, template <class, bool> class Iter>
+class _strided_view : public view_base {
+    using _base_iter = _range_iterator_t<const V>;
+    using _difference = difference_type_t<_base_iter>;
+    using _ra = _is_random_access<_base_iter>;
+
+ public:
+    using iterator = Iter<_base_iter, _ra::value>;
+
+    _strided_view(V base, _difference n)
+        : m_base(std::move(base)), m_n(n < 1 ? 1 : n) {}
+
+    iterator begin() const { return _begin(_ra()); }
+    iterator end() const { return _end(_ra()); }
+    V base() const { return m_base; }
+
+ private:
+    _difference _size() const { return nostd::_range_end(m_base) - nostd::_range_begin(m_base); }
+    iterator _begin(std::true_type) const { return iterator(nostd::_range_begin(m_base), 0, _size(), m_n); }
+    iterator _begin(std::false_type) const {
+        return iterator(nostd::_range_begin(m_base), nostd::_range_end(m_base), m_n);
+    }
+    iterator _end(std::true_type) const { return iterator(nostd::_range_begin(m_base), _size(), _size(), m_n); }
+    iterator _end(std::false_type) const { return iterator(nostd::_range_end(m_base), nostd::_range_end(m_base), m_n); }
+
+    V m_base;
+    _difference m_n;
+};
+
+template <class V>
+class chunk_view : public _strided_view<V, _chunk_iterator> {
+ public:
+    using _strided_view<V, _chunk_iterator>::_strided_view;
+};
+
+template <class V>
+class stride_view : public _strided_view<V, _stride_iterator> {
+ public:
+    using _strided_view<V, _stride_iterator>::_strided_view;
+};
+
+//-=========================adaptors
+// 能放在|右边的对象都从_range_adaptor派生，operator()(range)返回view
+struct _range_adaptor {};
+
+template <class T>
+using _is_range_adaptor = std::is_base_of<_range_adaptor, typename std::decay<T>::type>;
+
+// 两个适配器先组合：(r | a) | b
+template <class A, class B>
+struct _composed_adaptor : _range_adaptor {
+    A m_a;
+    B m_b;
+
+    _composed_adaptor(A a, B b)
+        : m_a(std::move(a)), m_b(std::move(b)) {}
+
+    template <class R>
+    auto operator()(R &&r) const -> decltype(m_b(m_a(std::forward<R>(r)))) {
+        return m_b(m_a(std::forward<R>(r)));
+    }
+};
+
+template <class R, class A,
+          class = typename std::enable_if<!_is_range_adaptor<R>::value && _is_range_adaptor<A>::value>::type>
+auto operator|(R &&r, const A &a) -> decltype(a(std::forward<R>(r))) {
+    return a(std::forward<R>(r));
+}
+
+template <class A, class B,
+          class = typename std::enable_if<_is_range_adaptor<A>::value && _is_range_adaptor<B>::value>::type>
+_composed_adaptor<typename std::decay<A>::type, typename std::decay<B>::type> operator|(A &&a, B &&b) {
+    return _composed_adaptor<typename std::decay<A>::type, typename std::decay<B>::type>(std::forward<A>(a),
+                                                                                        std::forward<B>(b));
+}
+
+// 带一个函数对象参数的适配器：filter、transform
+template <template <class, class> class View, class F>
+struct _fn_closure : _range_adaptor {
+    F m_fn;
+
+    explicit _fn_closure(F fn)
+        : m_fn(std::move(fn)) {}
+
+    template <class R>
+    View<_all_t<R>, F> operator()(R &&r) const {
+        return View<_all_t<R>, F>(nostd::_view_all(std::forward<R>(r)), m_fn);
+    }
+};
+
+template <template <class, class> class View>
+struct _fn_adaptor {
+    template <class F>
+    _fn_closure<View, F> operator()(F fn) const {
+        return _fn_closure<View, F>(std::move(fn));
+    }
+    template <class R, class F>
+    View<_all_t<R>, F> operator()(R &&r, F fn) const {
+        return View<_all_t<R>, F>(nostd::_view_all(std::forward<R>(r)), std::move(fn));
+    }
+};
+
+// 带一个个数参数的适配器：take、drop、chunk、stride
+template <template <class> class View>
+struct _count_closure : _range_adaptor {
+    ptrdiff_t m_n;
+
+    explicit _count_closure(ptrdiff_t n)
+        : m_n(n) {}
+
+    template <class R>
+    View<_all_t<R>> operator()(R &&r) const {
+        return View<_all_t<R>>(nostd::_view_all(std::forward<R>(r)), m_n);
+    }
+};
+
+template <template <class> class View>
+struct _count_adaptor {
+    _count_closure<View> operator()(ptrdiff_t n) const { return _count_closure<View>(n); }
+    template <class R>
+    View<_all_t<R>> operator()(R &&r, ptrdiff_t n) const {
+        return View<_all_t<R>>(nostd::_view_all(std::forward<R>(r)), n);
+    }
+};
+
+struct _all_adaptor : _range_adaptor {
+    template <class R>
+    _all_t<R> operator()(R &&r) const {
+        return nostd::_view_all(std::forward<R>(r));
+    }
+};
+
+struct _enumerate_adaptor : _range_adaptor {
+    template <class R>
+    enumerate_view<_all_t<R>> operator()(R &&r) const {
+        return enumerate_view<_all_t<R>>(nostd::_view_all(std::forward<R>(r)));
+    }
+};
+
+struct _zip_adaptor {
+    template <class R1, class R2>
+    zip_view<_all_t<R1>, _all_t<R2>> operator()(R1 &&r1, R2 &&r2) const {
+        return zip_view<_all_t<R1>, _all_t<R2>>(nostd::_view_all(std::forward<R1>(r1)),
+                                                nostd::_view_all(std::forward<R2>(r2)));
+    }
+};
+
+namespace views {
+constexpr _all_adaptor all{};
+constexpr _fn_adaptor<filter_view> filter{};
+constexpr _fn_adaptor<transform_view> transform{};
+constexpr _count_adaptor<take_view> take{};
+constexpr _count_adaptor<drop_view> drop{};
+constexpr _zip_adaptor zip{};
+constexpr _enumerate_adaptor enumerate{};
+constexpr _count_adaptor<chunk_view> chunk{};
+constexpr _count_adaptor<stride_view> stride{};
+}  // namespace views
+
+}  // namespace nostd
+
+#endif  // !__RANGES_H
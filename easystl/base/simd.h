@@ -0,0 +1,38 @@
+/*
+    SIMD指令集检测
+    只做编译期检测：编译时打开了对应的指令集(-mavx2 / -msse4.2 / -march=native)才会走向量化的实现
+    CMake中通过 -DEASYSTL_ENABLE_AVX2=ON 打开
+
+    EASYSTL_HAS_SSE2
+    EASYSTL_HAS_SSE42
+    EASYSTL_HAS_AVX2
+
+    EASYSTL_PREFETCH(addr)  预取addr所在的cache line到L1，不支持的编译器上为空操作
+*/
+#ifndef __SIMD_H
+#define __SIMD_H
+
+#if defined(__SSE2__) || defined(_M_X64)
+#    define EASYSTL_HAS_SSE2 1
+#    include <emmintrin.h>
+#endif
+
+#if defined(__SSE4_2__)
+#    define EASYSTL_HAS_SSE42 1
+#    include <nmmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#    define EASYSTL_HAS_AVX2 1
+#    include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#    define EASYSTL_PREFETCH(addr) __builtin_prefetch(static_cast<const void *>(addr))
+#elif defined(EASYSTL_HAS_SSE2)
+#    define EASYSTL_PREFETCH(addr) _mm_prefetch(reinterpret_cast<const char *>(addr), _MM_HINT_T0)
+#else
+#    define EASYSTL_PREFETCH(addr) ((void)0)
+#endif
+
+#endif  // !__SIMD_H
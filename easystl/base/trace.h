@@ -0,0 +1,403 @@
+/*
+ * 热点路径追踪
+ *
+ * 定义了EASYSTL_TRACE(cmake -DEASYSTL_ENABLE_TRACE=ON，Debug构建时默认打开)后，容器和算法里的埋点生效：
+ *   EASYSTL_TRACE_SCOPE(name)       统计所在作用域的执行次数和耗时(周期数)，录制打开时同时记一个事件
+ *   EASYSTL_TRACE_COUNT(name, n)    计数，统计次数和累计值
+ *   EASYSTL_TRACE_VALUE(name, v)    记录一个取值(例如递归深度)，统计次数、总和与最大值，录制打开时同时记一个计数事件
+ * 没有定义EASYSTL_TRACE时这些宏展开为空语句，不产生任何代码，也不引入任何头文件
+ *
+ * trace_registry::instance()        全局注册表：snapshot/dump/reset
+ *   start()/stop()                  开关事件录制，默认只计数不录制
+ *   write_chrome_trace(FILE*)       导出Chrome trace格式的JSON，可以用chrome://tracing或ui.perfetto.dev打开
+ *
+ * name必须是字符串字面量(导出时不做转义)，同名的埋点(例如模板的不同实例)汇总时合并
+ * 耗时用rdtsc(x86)或steady_clock的纳秒计，事件的时间戳统一用steady_clock的微秒
+ * 事件按线程缓存，每个线程最多保留kMaxEvents个，超出后丢弃并计数
+ */
+#ifndef __TRACE_H
+#define __TRACE_H
+
+#if defined(EASYSTL_DEBUG) && !defined(EASYSTL_TRACE)
+#    define EASYSTL_TRACE 1
+#endif
+
+#ifndef EASYSTL_TRACE
+
+#    define EASYSTL_TRACE_SCOPE(name) ((void)0)
+#    define EASYSTL_TRACE_COUNT(name, n) ((void)0)
+#    define EASYSTL_TRACE_VALUE(name, v) ((void)0)
+
+#else
+
+#    include <algorithm>
+#    include <atomic>
+#    include <chrono>
+#    include <cinttypes>
+#    include <cstddef>
+#    include <cstdint>
+#    include <cstdio>
+#    include <cstring>
+#    include <mutex>
+#    include <vector>
+
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    elif defined(__x86_64__) || defined(__i386__)
+#        include <x86intrin.h>
+#    endif
+
+#    define EASYSTL_TRACE_CAT_(a, b) a##b
+#    define EASYSTL_TRACE_CAT(a, b) EASYSTL_TRACE_CAT_(a, b)
+#    define EASYSTL_TRACE_POINT(name, kind)                   \
+        ([]() -> ::nostd::trace_point & {                     \
+            static ::nostd::trace_point p(name, kind);        \
+            return p;                                         \
+        }())
+
+#    define EASYSTL_TRACE_SCOPE(name) \
+        ::nostd::trace_scope EASYSTL_TRACE_CAT(_easystl_trace_, __LINE__)(EASYSTL_TRACE_POINT(name, ::nostd::trace_kind::scope))
+#    define EASYSTL_TRACE_COUNT(name, n) EASYSTL_TRACE_POINT(name, ::nostd::trace_kind::counter).add(static_cast<uint64_t>(n))
+#    define EASYSTL_TRACE_VALUE(name, v) EASYSTL_TRACE_POINT(name, ::nostd::trace_kind::value).record(static_cast<uint64_t>(v))
+
+namespace nostd {
+
+enum class trace_kind { scope, counter, value };
+
+struct trace_stats {
+    const char *name = nullptr;
+    trace_kind kind = trace_kind::counter;
+    uint64_t count = 0;  // 次数
+    uint64_t total = 0;  // scope为总周期数，counter为累计值，value为取值之和
+    uint64_t max = 0;    // 单次的最大值
+};
+
+class trace_point;
+class trace_registry;
+
+namespace _trace {
+
+const size_t kMaxEvents = size_t(1) << 20;
+
+inline uint64_t now_ns() noexcept {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline uint64_t cycles() noexcept {
+#    if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#    else
+    return now_ns();
+#    endif
+}
+
+// 常量初始化，读的时候没有静态变量的初始化检查
+inline std::atomic<bool> &recording() noexcept {
+    static std::atomic<bool> on(false);
+    return on;
+}
+
+inline void update_max(std::atomic<uint64_t> &m, uint64_t v) noexcept {
+    uint64_t cur = m.load(std::memory_order_relaxed);
+    while (v > cur && !m.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {
+    }
+}
+
+struct event {
+    const char *name;
+    uint64_t ts;     // 纳秒
+    uint64_t value;  // 'X'为持续时间(纳秒)，'C'为取值
+    uint32_t tid;
+    char ph;
+};
+
+// 每个线程一份事件缓存，导出时加锁读
+struct buffer {
+    std::mutex m_mutex;
+    std::vector<event> m_events;
+    uint64_t m_dropped = 0;
+    uint32_t m_tid = 0;
+    buffer *m_prev = nullptr;
+    buffer *m_next = nullptr;
+
+    buffer();
+    ~buffer();
+
+    void push(const char *name, uint64_t ts, uint64_t value, char ph) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_events.size() < kMaxEvents) {
+            event e = {name, ts, value, m_tid, ph};
+            m_events.push_back(e);
+        } else {
+            ++m_dropped;
+        }
+    }
+
+    static buffer &local() {
+        static thread_local buffer b;
+        return b;
+    }
+};
+
+}  // namespace _trace
+
+/*****************************************************************************************/
+// trace_point：一个埋点的计数
+/*****************************************************************************************/
+class trace_point {
+    friend class trace_registry;
+
+ public:
+    trace_point(const char *name, trace_kind kind);
+    trace_point(const trace_point &) = delete;
+    trace_point &operator=(const trace_point &) = delete;
+
+    const char *name() const noexcept { return m_name; }
+    trace_kind kind() const noexcept { return m_kind; }
+
+    void add(uint64_t n) noexcept {
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_total.fetch_add(n, std::memory_order_relaxed);
+        _trace::update_max(m_max, n);
+    }
+
+    void record(uint64_t v) {
+        add(v);
+        if (_trace::recording().load(std::memory_order_relaxed)) {
+            _trace::buffer::local().push(m_name, _trace::now_ns(), v, 'C');
+        }
+    }
+
+    trace_stats stats() const noexcept {
+        trace_stats st;
+        st.name = m_name;
+        st.kind = m_kind;
+        st.count = m_count.load(std::memory_order_relaxed);
+        st.total = m_total.load(std::memory_order_relaxed);
+        st.max = m_max.load(std::memory_order_relaxed);
+        return st;
+    }
+
+ private:
+    const char *m_name;
+    trace_kind m_kind;
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_total;
+    std::atomic<uint64_t> m_max;
+    trace_point *m_next = nullptr;
+};
+
+/*****************************************************************************************/
+// trace_scope：统计一个作用域
+/*****************************************************************************************/
+class trace_scope {
+ public:
+    explicit trace_scope(trace_point &p) noexcept
+        : m_point(p),
+          m_ts(_trace::recording().load(std::memory_order_relaxed) ? _trace::now_ns() : 0),
+          m_begin(_trace::cycles()) {}
+    trace_scope(const trace_scope &) = delete;
+    trace_scope &operator=(const trace_scope &) = delete;
+
+    ~trace_scope() {
+        m_point.add(_trace::cycles() - m_begin);
+        if (m_ts != 0) {
+            _trace::buffer::local().push(m_point.name(), m_ts, _trace::now_ns() - m_ts, 'X');
+        }
+    }
+
+ private:
+    trace_point &m_point;
+    uint64_t m_ts;
+    uint64_t m_begin;
+};
+
+/*****************************************************************************************/
+// trace_registry：所有埋点和所有线程事件缓存的注册表
+/*****************************************************************************************/
+class trace_registry {
+    friend class trace_point;
+    friend struct _trace::buffer;
+
+ public:
+    // 有意不析构：其它线程的thread_local缓存可能在静态对象析构之后才退出
+    static trace_registry &instance() {
+        static trace_registry *r = new trace_registry();
+        return *r;
+    }
+
+    void start() noexcept { _trace::recording().store(true, std::memory_order_relaxed); }
+    void stop() noexcept { _trace::recording().store(false, std::memory_order_relaxed); }
+    bool recording() const noexcept { return _trace::recording().load(std::memory_order_relaxed); }
+
+    // 按名字合并后的统计，按名字排序
+    std::vector<trace_stats> snapshot() const {
+        std::vector<trace_stats> out;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const trace_point *p = m_points; p != nullptr; p = p->m_next) {
+            trace_stats st = p->stats();
+            std::vector<trace_stats>::iterator it =
+                std::find_if(out.begin(), out.end(), [&st](const trace_stats &s) { return std::strcmp(s.name, st.name) == 0; });
+            if (it == out.end()) {
+                out.push_back(st);
+            } else {
+                it->count += st.count;
+                it->total += st.total;
+                it->max = std::max(it->max, st.max);
+            }
+        }
+        std::sort(out.begin(), out.end(),
+                  [](const trace_stats &a, const trace_stats &b) { return std::strcmp(a.name, b.name) < 0; });
+        return out;
+    }
+
+    trace_stats snapshot(const char *name) const {
+        trace_stats st;
+        st.name = name;
+        for (const trace_stats &s : snapshot()) {
+            if (std::strcmp(s.name, name) == 0) {
+                st = s;
+            }
+        }
+        return st;
+    }
+
+    // 已缓存的事件数和丢弃的事件数
+    size_t event_count() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t n = m_retired.size();
+        for (_trace::buffer *b = m_buffers; b != nullptr; b = b->m_next) {
+            std::lock_guard<std::mutex> block(b->m_mutex);
+            n += b->m_events.size();
+        }
+        return n;
+    }
+
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint64_t n = m_dropped;
+        for (_trace::buffer *b = m_buffers; b != nullptr; b = b->m_next) {
+            std::lock_guard<std::mutex> block(b->m_mutex);
+            n += b->m_dropped;
+        }
+        return n;
+    }
+
+    // 计数清零，丢掉已缓存的事件
+    void reset() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (trace_point *p = m_points; p != nullptr; p = p->m_next) {
+            p->m_count.store(0, std::memory_order_relaxed);
+            p->m_total.store(0, std::memory_order_relaxed);
+            p->m_max.store(0, std::memory_order_relaxed);
+        }
+        for (_trace::buffer *b = m_buffers; b != nullptr; b = b->m_next) {
+            std::lock_guard<std::mutex> block(b->m_mutex);
+            b->m_events.clear();
+            b->m_dropped = 0;
+        }
+        m_retired.clear();
+        m_dropped = 0;
+    }
+
+    void dump(std::FILE *out = stderr) const {
+        static const char *const kinds[] = {"scope", "counter", "value"};
+        std::fprintf(out, "%-32s %-8s %12s %16s %12s %12s\n", "name", "kind", "count", "total", "avg", "max");
+        for (const trace_stats &st : snapshot()) {
+            std::fprintf(out, "%-32s %-8s %12" PRIu64 " %16" PRIu64 " %12.1f %12" PRIu64 "\n", st.name,
+                         kinds[static_cast<int>(st.kind)], st.count, st.total,
+                         st.count == 0 ? 0.0 : static_cast<double>(st.total) / static_cast<double>(st.count), st.max);
+        }
+    }
+
+    // {"traceEvents":[...],"otherData":{...}}，scope为"X"事件，value为"C"事件，汇总的统计放在otherData里
+    void write_chrome_trace(std::FILE *out) const {
+        std::vector<_trace::event> events;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            events = m_retired;
+            for (_trace::buffer *b = m_buffers; b != nullptr; b = b->m_next) {
+                std::lock_guard<std::mutex> block(b->m_mutex);
+                events.insert(events.end(), b->m_events.begin(), b->m_events.end());
+            }
+        }
+        std::sort(events.begin(), events.end(), [](const _trace::event &a, const _trace::event &b) { return a.ts < b.ts; });
+        std::fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+        for (size_t i = 0; i < events.size(); ++i) {
+            const _trace::event &e = events[i];
+            double ts = static_cast<double>(e.ts - m_epoch) / 1000.0;
+            std::fprintf(out, "%s\n{\"name\":\"%s\",\"cat\":\"easystl\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,",
+                         i == 0 ? "" : ",", e.name, e.ph, ts, e.tid);
+            if (e.ph == 'X') {
+                std::fprintf(out, "\"dur\":%.3f}", static_cast<double>(e.value) / 1000.0);
+            } else {
+                std::fprintf(out, "\"args\":{\"value\":%" PRIu64 "}}", e.value);
+            }
+        }
+        std::fprintf(out, "\n],\"otherData\":{");
+        std::vector<trace_stats> stats = snapshot();
+        for (size_t i = 0; i < stats.size(); ++i) {
+            std::fprintf(out, "%s\"%s\":\"count=%" PRIu64 " total=%" PRIu64 " max=%" PRIu64 "\"", i == 0 ? "" : ",",
+                         stats[i].name, stats[i].count, stats[i].total, stats[i].max);
+        }
+        std::fprintf(out, "}}\n");
+    }
+
+ private:
+    trace_registry() : m_epoch(_trace::now_ns()) {}
+
+    void add_point(trace_point *p) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        p->m_next = m_points;
+        m_points = p;
+    }
+
+    void add_buffer(_trace::buffer *b) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        b->m_tid = ++m_next_tid;
+        b->m_next = m_buffers;
+        if (m_buffers != nullptr) {
+            m_buffers->m_prev = b;
+        }
+        m_buffers = b;
+    }
+
+    // 线程退出：事件并入m_retired
+    void remove_buffer(_trace::buffer *b) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_retired.insert(m_retired.end(), b->m_events.begin(), b->m_events.end());
+        m_dropped += b->m_dropped;
+        (b->m_prev != nullptr ? b->m_prev->m_next : m_buffers) = b->m_next;
+        if (b->m_next != nullptr) {
+            b->m_next->m_prev = b->m_prev;
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    uint64_t m_epoch;
+    trace_point *m_points = nullptr;
+    _trace::buffer *m_buffers = nullptr;
+    uint32_t m_next_tid = 0;
+    std::vector<_trace::event> m_retired;
+    uint64_t m_dropped = 0;
+};
+
+inline trace_point::trace_point(const char *name, trace_kind kind)
+    : m_name(name), m_kind(kind), m_count(0), m_total(0), m_max(0) {
+    trace_registry::instance().add_point(this);
+}
+
+namespace _trace {
+
+inline buffer::buffer() { trace_registry::instance().add_buffer(this); }
+
+inline buffer::~buffer() { trace_registry::instance().remove_buffer(this); }
+
+}  // namespace _trace
+
+}  // namespace nostd
+
+#endif  // EASYSTL_TRACE
+
+#endif  // !__TRACE_H
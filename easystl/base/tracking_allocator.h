@@ -0,0 +1,434 @@
+/*
+ * 分配统计
+ *
+ * tracking_allocator<T, Inner, Site>  包装Inner(默认nostd::allocator<T>)，每次分配/释放都计入统计，
+ *                                     接口和nostd::allocator一样是静态函数，可以直接作为容器的Alloc参数
+ * EASYSTL_ALLOC_SITE(name)            声明一个调用点标记类型，作为Site参数；不指定时归到"default"
+ * alloc_registry::instance()          全局注册表：snapshot/for_each/dump/reset
+ *
+ * 每个(调用点, 元素类型)对应一个alloc_site，统计分配/释放次数、字节数、扩容次数、
+ * 当前和峰值占用，以及按2的幂分桶的分配尺寸直方图
+ *
+ * 次数、字节数和直方图写在线程局部的计数器里，只有所在线程写(relaxed的load+store，没有带锁前缀的指令)；
+ * live/peak需要全局的值，用原子量。读统计时加锁汇总所有线程，线程退出时它的计数并入alloc_site
+ *
+ * 扩容的判定：同一线程在同一个site上分配了新块，紧接着释放了一个更小的块，
+ * 即vector/string扩容时"申请新空间-搬移-释放旧空间"的模式
+ * 只有带大小的deallocate(p, n)能准确记录释放的字节数，deallocate(p)按1个元素计
+ */
+#ifndef __TRACKING_ALLOCATOR_H
+#define __TRACKING_ALLOCATOR_H
+
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+#include "allocator.h"
+#include "bit.h"
+
+#define EASYSTL_ALLOC_SITE(tag)                              \
+    struct tag {                                             \
+        static const char *name() noexcept { return #tag; } \
+    }
+
+namespace nostd {
+
+struct alloc_stats {
+    // 第i个桶统计大小在(2^(i-1), 2^i]字节的分配，最后一个桶包含所有更大的
+    static constexpr size_t kBuckets = 32;
+
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t reallocations = 0;
+    uint64_t bytes_allocated = 0;
+    uint64_t bytes_freed = 0;
+    int64_t live_bytes = 0;
+    uint64_t peak_live_bytes = 0;
+    uint64_t histogram[kBuckets] = {};
+
+    static size_t bucket_of(size_t bytes) noexcept {
+        size_t b = bytes <= 1 ? 0 : static_cast<size_t>(64 - nostd::countl_zero(static_cast<uint64_t>(bytes - 1)));
+        return b < kBuckets ? b : kBuckets - 1;
+    }
+};
+
+class alloc_site;
+class alloc_registry;
+
+namespace _alloc {
+
+const size_t kMaxSites = 1024;
+
+inline void bump(std::atomic<uint64_t> &c, uint64_t n) noexcept {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// 一个线程在一个site上的计数
+struct counters {
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> deallocations;
+    std::atomic<uint64_t> reallocations;
+    std::atomic<uint64_t> bytes_allocated;
+    std::atomic<uint64_t> bytes_freed;
+    std::atomic<uint64_t> histogram[alloc_stats::kBuckets];
+
+    counters() noexcept
+        : allocations(0), deallocations(0), reallocations(0), bytes_allocated(0), bytes_freed(0) {
+        for (size_t i = 0; i < alloc_stats::kBuckets; ++i) {
+            histogram[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void add_to(alloc_stats &s) const noexcept {
+        s.allocations += allocations.load(std::memory_order_relaxed);
+        s.deallocations += deallocations.load(std::memory_order_relaxed);
+        s.reallocations += reallocations.load(std::memory_order_relaxed);
+        s.bytes_allocated += bytes_allocated.load(std::memory_order_relaxed);
+        s.bytes_freed += bytes_freed.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < alloc_stats::kBuckets; ++i) {
+            s.histogram[i] += histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    void add(const counters &o) noexcept {
+        bump(allocations, o.allocations.load(std::memory_order_relaxed));
+        bump(deallocations, o.deallocations.load(std::memory_order_relaxed));
+        bump(reallocations, o.reallocations.load(std::memory_order_relaxed));
+        bump(bytes_allocated, o.bytes_allocated.load(std::memory_order_relaxed));
+        bump(bytes_freed, o.bytes_freed.load(std::memory_order_relaxed));
+        for (size_t i = 0; i < alloc_stats::kBuckets; ++i) {
+            bump(histogram[i], o.histogram[i].load(std::memory_order_relaxed));
+        }
+    }
+};
+
+// 每个线程一份，按site的id索引，用到时才分配
+struct shard {
+    std::atomic<counters *> m_sites[kMaxSites];
+    shard *m_prev = nullptr;
+    shard *m_next = nullptr;
+    // 最近一次分配，用于判定扩容
+    bool m_pending = false;
+    size_t m_pending_site = 0;
+    size_t m_pending_bytes = 0;
+
+    shard();
+    ~shard();
+
+    counters &at(size_t id) {
+        counters *c = m_sites[id].load(std::memory_order_relaxed);
+        if (c == nullptr) {
+            c = new counters();
+            m_sites[id].store(c, std::memory_order_release);
+        }
+        return *c;
+    }
+
+    static shard &local() {
+        static thread_local shard s;
+        return s;
+    }
+};
+
+template <class T>
+const char *type_name() {
+    static const char *name = [] {
+        const char *raw = typeid(T).name();
+#if defined(__GNUG__)
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(raw, nullptr, nullptr, &status);
+        return status == 0 && demangled != nullptr ? static_cast<const char *>(demangled) : raw;
+#else
+        return raw;
+#endif
+    }();
+    return name;
+}
+
+template <class Site>
+struct site_name {
+    static const char *get() noexcept { return Site::name(); }
+};
+
+template <>
+struct site_name<void> {
+    static const char *get() noexcept { return "default"; }
+};
+
+}  // namespace _alloc
+
+/*****************************************************************************************/
+// alloc_site：一个(调用点, 元素类型)的统计
+/*****************************************************************************************/
+class alloc_site {
+    friend class alloc_registry;
+    friend struct _alloc::shard;
+
+ public:
+    alloc_site(const char *name, const char *type_name);
+    alloc_site(const alloc_site &) = delete;
+    alloc_site &operator=(const alloc_site &) = delete;
+
+    const char *name() const noexcept { return m_name; }
+    const char *type_name() const noexcept { return m_type_name; }
+    alloc_stats stats() const;
+
+    void on_allocate(size_t bytes) noexcept {
+        _alloc::shard &sh = _alloc::shard::local();
+        _alloc::counters &c = sh.at(m_id);
+        _alloc::bump(c.allocations, 1);
+        _alloc::bump(c.bytes_allocated, bytes);
+        _alloc::bump(c.histogram[alloc_stats::bucket_of(bytes)], 1);
+        int64_t live = m_live.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) + static_cast<int64_t>(bytes);
+        uint64_t peak = m_peak.load(std::memory_order_relaxed);
+        while (live > static_cast<int64_t>(peak) &&
+               !m_peak.compare_exchange_weak(peak, static_cast<uint64_t>(live), std::memory_order_relaxed)) {
+        }
+        sh.m_pending = true;
+        sh.m_pending_site = m_id;
+        sh.m_pending_bytes = bytes;
+    }
+
+    void on_deallocate(size_t bytes) noexcept {
+        _alloc::shard &sh = _alloc::shard::local();
+        _alloc::counters &c = sh.at(m_id);
+        _alloc::bump(c.deallocations, 1);
+        _alloc::bump(c.bytes_freed, bytes);
+        m_live.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+        if (sh.m_pending && sh.m_pending_site == m_id && bytes < sh.m_pending_bytes) {
+            _alloc::bump(c.reallocations, 1);
+        }
+        sh.m_pending = false;
+    }
+
+ private:
+    const char *m_name;
+    const char *m_type_name;
+    size_t m_id;
+    std::atomic<int64_t> m_live;
+    std::atomic<uint64_t> m_peak;
+    _alloc::counters m_retired;  // 已退出线程的计数，持有注册表的锁时访问
+    alloc_stats m_baseline;      // reset()时的快照，之后的统计都减去它
+};
+
+/*****************************************************************************************/
+// alloc_registry：所有site和所有线程计数器的注册表
+/*****************************************************************************************/
+class alloc_registry {
+    friend class alloc_site;
+    friend struct _alloc::shard;
+
+ public:
+    // 有意不析构：其它线程的thread_local计数器可能在静态对象析构之后才退出
+    static alloc_registry &instance() {
+        static alloc_registry *r = new alloc_registry();
+        return *r;
+    }
+
+    alloc_stats snapshot(const alloc_site &s) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return snapshot_locked(s);
+    }
+
+    size_t site_count() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_site_count;
+    }
+
+    // f(const alloc_site &, const alloc_stats &)，持有注册表的锁时调用，f里不能再分配被统计的内存
+    template <class F>
+    void for_each(F f) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < m_site_count; ++i) {
+            f(*m_sites[i], snapshot_locked(*m_sites[i]));
+        }
+    }
+
+    // 把当前的计数记为基线；峰值重置为当前占用
+    void reset() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < m_site_count; ++i) {
+            alloc_site &s = *m_sites[i];
+            s.m_baseline = alloc_stats();
+            s.m_baseline = snapshot_locked(s);
+            s.m_peak.store(static_cast<uint64_t>(s.m_live.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+        }
+    }
+
+    void dump(std::FILE *out = stderr) const {
+        std::fprintf(out, "%-20s %-32s %10s %10s %10s %14s %14s %14s\n", "site", "type", "allocs", "frees", "reallocs",
+                     "bytes", "live", "peak");
+        for_each([out](const alloc_site &s, const alloc_stats &st) {
+            std::fprintf(out, "%-20s %-32s %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %14" PRIu64 " %14" PRId64 " %14" PRIu64 "\n",
+                         s.name(), s.type_name(), st.allocations, st.deallocations, st.reallocations, st.bytes_allocated,
+                         st.live_bytes, st.peak_live_bytes);
+            std::fprintf(out, "  sizes:");
+            for (size_t i = 0; i < alloc_stats::kBuckets; ++i) {
+                if (st.histogram[i] != 0) {
+                    std::fprintf(out, " <=%" PRIu64 ":%" PRIu64, uint64_t(1) << i, st.histogram[i]);
+                }
+            }
+            std::fprintf(out, "\n");
+        });
+    }
+
+ private:
+    alloc_registry() = default;
+
+    size_t add_site(alloc_site *s) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_site_count == _alloc::kMaxSites) {
+            throw std::length_error("alloc_registry: too many sites");
+        }
+        m_sites[m_site_count] = s;
+        return m_site_count++;
+    }
+
+    void add_shard(_alloc::shard *sh) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        sh->m_next = m_shards;
+        if (m_shards != nullptr) {
+            m_shards->m_prev = sh;
+        }
+        m_shards = sh;
+    }
+
+    // 线程退出：计数并入各site后释放
+    void remove_shard(_alloc::shard *sh) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < m_site_count; ++i) {
+            _alloc::counters *c = sh->m_sites[i].load(std::memory_order_acquire);
+            if (c != nullptr) {
+                m_sites[i]->m_retired.add(*c);
+                delete c;
+            }
+        }
+        (sh->m_prev != nullptr ? sh->m_prev->m_next : m_shards) = sh->m_next;
+        if (sh->m_next != nullptr) {
+            sh->m_next->m_prev = sh->m_prev;
+        }
+    }
+
+    alloc_stats snapshot_locked(const alloc_site &s) const {
+        alloc_stats st;
+        s.m_retired.add_to(st);
+        for (const _alloc::shard *sh = m_shards; sh != nullptr; sh = sh->m_next) {
+            const _alloc::counters *c = sh->m_sites[s.m_id].load(std::memory_order_acquire);
+            if (c != nullptr) {
+                c->add_to(st);
+            }
+        }
+        const alloc_stats &b = s.m_baseline;
+        st.allocations -= b.allocations;
+        st.deallocations -= b.deallocations;
+        st.reallocations -= b.reallocations;
+        st.bytes_allocated -= b.bytes_allocated;
+        st.bytes_freed -= b.bytes_freed;
+        for (size_t i = 0; i < alloc_stats::kBuckets; ++i) {
+            st.histogram[i] -= b.histogram[i];
+        }
+        st.live_bytes = s.m_live.load(std::memory_order_relaxed);
+        st.peak_live_bytes = s.m_peak.load(std::memory_order_relaxed);
+        return st;
+    }
+
+    mutable std::mutex m_mutex;
+    alloc_site *m_sites[_alloc::kMaxSites] = {};
+    size_t m_site_count = 0;
+    _alloc::shard *m_shards = nullptr;
+};
+
+inline alloc_site::alloc_site(const char *name, const char *type_name)
+    : m_name(name), m_type_name(type_name), m_id(0), m_live(0), m_peak(0) {
+    m_id = alloc_registry::instance().add_site(this);
+}
+
+inline alloc_stats alloc_site::stats() const { return alloc_registry::instance().snapshot(*this); }
+
+namespace _alloc {
+
+inline shard::shard() {
+    for (size_t i = 0; i < kMaxSites; ++i) {
+        m_sites[i].store(nullptr, std::memory_order_relaxed);
+    }
+    alloc_registry::instance().add_shard(this);
+}
+
+inline shard::~shard() { alloc_registry::instance().remove_shard(this); }
+
+}  // namespace _alloc
+
+/*****************************************************************************************/
+// tracking_allocator
+/*****************************************************************************************/
+template <class T, class Inner = nostd::allocator<T>, class Site = void>
+class tracking_allocator {
+ public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+ public:
+    // 和注册表一样有意不析构
+    static alloc_site &site() {
+        static alloc_site *s = new alloc_site(_alloc::site_name<Site>::get(), _alloc::type_name<T>());
+        return *s;
+    }
+
+    static alloc_stats stats() { return site().stats(); }
+
+    static T *allocate() {
+        T *p = Inner::allocate();
+        site().on_allocate(sizeof(T));
+        return p;
+    }
+
+    static T *allocate(size_type n) {
+        T *p = Inner::allocate(n);
+        if (p != nullptr) {
+            site().on_allocate(n * sizeof(T));
+        }
+        return p;
+    }
+
+    static void deallocate(T *ptr) {
+        if (ptr != nullptr) {
+            site().on_deallocate(sizeof(T));
+            Inner::deallocate(ptr);
+        }
+    }
+
+    static void deallocate(T *ptr, size_type n) {
+        if (ptr != nullptr) {
+            site().on_deallocate(n * sizeof(T));
+            Inner::deallocate(ptr, n);
+        }
+    }
+
+    template <class... Args>
+    static void construct(T *ptr, Args &&...args) {
+        Inner::construct(ptr, std::forward<Args>(args)...);
+    }
+
+    static void destroy(T *ptr) { Inner::destroy(ptr); }
+    static void destroy(T *first, T *last) { Inner::destroy(first, last); }
+};
+
+}  // namespace nostd
+
+#endif  // !__TRACKING_ALLOCATOR_H
@@ -0,0 +1,997 @@
+/*
+    UTF-8 / UTF-16 / UTF-32 校验与互相转换
+
+    validate_utf8 / validate_utf16 / validate_utf32                      是否合法
+    validate_utf8_with_errors ...                                       第一个错误的位置和类型
+    convert_utf8_to_utf16 ...                                           校验并转换
+    convert_valid_utf8_to_utf16 ...                                     输入已知合法时直接转换
+    utf16_length_from_utf8 ...                                          转换后的长度
+
+    utf8_stream_validator               分段输入的校验，多字节序列可以跨段
+    utf8_stream_converter<charT>        分段输入的UTF-8 -> UTF-16/UTF-32
+    utf16_stream_converter              分段输入的UTF-16 -> UTF-8，代理对可以跨段
+
+    UTF-8校验：打开SSE4.2/AVX2时每次处理16/32字节，用三次查表判断相邻两个字节的组合是否合法，
+    再单独检查3、4字节序列的后续字节个数，没有分支
+    ref: Keiser, Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte"
+    转换：整块都是ASCII(或都不含代理)时用SSE2整块展开/压缩，其余按码点逐个处理
+
+    出错时utf_result::count是输入中出错的位置(单元下标)，成功时是输出的单元数
+*/
+#ifndef __UTF_H
+#define __UTF_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "base/bit.h"
+#include "base/simd.h"
+
+namespace nostd {
+
+enum class utf_error {
+    ok,
+    header_bits,  // 0xF8~0xFF不能作为首字节
+    too_short,    // 首字节后面的后续字节不够
+    too_long,     // 多余的后续字节(10xxxxxx)
+    overlong,     // 用了比需要更长的编码
+    too_large,    // 超过U+10FFFF
+    surrogate,    // UTF-8/UTF-32中出现了代理区码点，或UTF-16中的代理不成对
+};
+
+struct utf_result {
+    utf_error error;
+    size_t count;
+};
+
+namespace _utf {
+
+/*****************************************************************************************/
+// 标量实现
+/*****************************************************************************************/
+
+// 按首字节得到序列长度，后续字节和非法首字节返回0
+inline int sequence_length(unsigned char c) noexcept {
+    return c < 0x80 ? 1 : c < 0xC0 ? 0 : c < 0xE0 ? 2 : c < 0xF0 ? 3 : c < 0xF8 ? 4 : 0;
+}
+
+inline bool is_continuation(unsigned char c) noexcept { return (c & 0xC0) == 0x80; }
+
+// 解码s开头的一个码点并校验
+inline utf_error decode_utf8(const unsigned char *s, size_t n, char32_t &cp, size_t &len) noexcept {
+    unsigned char c = s[0];
+    if (c < 0x80) {
+        cp = c;
+        len = 1;
+        return utf_error::ok;
+    }
+    char32_t min;
+    if (c < 0xC0) {
+        return utf_error::too_long;
+    } else if (c < 0xE0) {
+        len = 2;
+        cp = c & 0x1F;
+        min = 0x80;
+    } else if (c < 0xF0) {
+        len = 3;
+        cp = c & 0x0F;
+        min = 0x800;
+    } else if (c < 0xF8) {
+        len = 4;
+        cp = c & 0x07;
+        min = 0x10000;
+    } else {
+        return utf_error::header_bits;
+    }
+    if (n < len) {
+        return utf_error::too_short;
+    }
+    for (size_t k = 1; k < len; ++k) {
+        if (!is_continuation(s[k])) {
+            return utf_error::too_short;
+        }
+        cp = (cp << 6) | (s[k] & 0x3F);
+    }
+    if (cp < min) {
+        return utf_error::overlong;
+    }
+    if (cp > 0x10FFFF) {
+        return utf_error::too_large;
+    }
+    if (cp >= 0xD800 && cp <= 0xDFFF) {
+        return utf_error::surrogate;
+    }
+    return utf_error::ok;
+}
+
+// 已知合法时解码，返回序列长度
+inline size_t decode_valid_utf8(const unsigned char *s, char32_t &cp) noexcept {
+    unsigned char c = s[0];
+    if (c < 0x80) {
+        cp = c;
+        return 1;
+    } else if (c < 0xE0) {
+        cp = (static_cast<char32_t>(c & 0x1F) << 6) | (s[1] & 0x3F);
+        return 2;
+    } else if (c < 0xF0) {
+        cp = (static_cast<char32_t>(c & 0x0F) << 12) | (static_cast<char32_t>(s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+        return 3;
+    }
+    cp = (static_cast<char32_t>(c & 0x07) << 18) | (static_cast<char32_t>(s[1] & 0x3F) << 12) |
+         (static_cast<char32_t>(s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+    return 4;
+}
+
+inline char *encode_utf8(char32_t cp, char *out) noexcept {
+    if (cp < 0x80) {
+        *out++ = static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (cp >> 6));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (cp >> 12));
+        *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (cp >> 18));
+        *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return out;
+}
+
+inline char16_t *put(char32_t cp, char16_t *out) noexcept {
+    if (cp < 0x10000) {
+        *out++ = static_cast<char16_t>(cp);
+    } else {
+        cp -= 0x10000;
+        *out++ = static_cast<char16_t>(0xD800 + (cp >> 10));
+        *out++ = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+    }
+    return out;
+}
+
+inline char32_t *put(char32_t cp, char32_t *out) noexcept {
+    *out++ = cp;
+    return out;
+}
+
+inline bool is_high_surrogate(char16_t u) noexcept { return (u & 0xFC00) == 0xD800; }
+inline bool is_low_surrogate(char16_t u) noexcept { return (u & 0xFC00) == 0xDC00; }
+inline bool is_surrogate(char16_t u) noexcept { return (u & 0xF800) == 0xD800; }
+
+inline char32_t combine_surrogates(char16_t hi, char16_t lo) noexcept {
+    return 0x10000 + ((static_cast<char32_t>(hi) - 0xD800) << 10) + (static_cast<char32_t>(lo) - 0xDC00);
+}
+
+// s开头连续的ASCII字节数
+inline size_t ascii_prefix(const char *s, size_t n) noexcept {
+    size_t i = 0;
+#if defined(EASYSTL_HAS_SSE2)
+    for (; i + 16 <= n; i += 16) {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)));
+        if (mask != 0) {
+            return i + static_cast<size_t>(nostd::countr_zero(static_cast<uint64_t>(mask)));
+        }
+    }
+#endif
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, s + i, sizeof(w));
+        if ((w & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+    while (i < n && static_cast<unsigned char>(s[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+inline utf_result validate_utf8_scalar(const char *s, size_t n, size_t i = 0) noexcept {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+    while (i < n) {
+        if (p[i] < 0x80) {
+            i += ascii_prefix(s + i, n - i);
+            continue;
+        }
+        char32_t cp;
+        size_t len;
+        utf_error e = decode_utf8(p + i, n - i, cp, len);
+        if (e != utf_error::ok) {
+            return {e, i};
+        }
+        i += len;
+    }
+    return {utf_error::ok, n};
+}
+
+/*****************************************************************************************/
+// 向量化的UTF-8校验
+// 每个字节和它前面的一个字节组成一对，按(前一字节高4位, 前一字节低4位, 当前字节高4位)
+// 查三张表，三个结果按位与，非0的位就是这一对违反的规则；3、4字节序列的第3、4个字节
+// 不能只看相邻两个字节，单独用前2、3个字节判断这里是否必须是后续字节
+/*****************************************************************************************/
+
+#if defined(EASYSTL_HAS_SSE42) || defined(EASYSTL_HAS_AVX2)
+const uint8_t kTooShort = 1 << 0;
+const uint8_t kTooLong = 1 << 1;
+const uint8_t kOverlong3 = 1 << 2;
+const uint8_t kTooLarge = 1 << 3;
+const uint8_t kSurrogate = 1 << 4;
+const uint8_t kOverlong2 = 1 << 5;
+const uint8_t kTooLarge1000 = 1 << 6;
+const uint8_t kOverlong4 = 1 << 6;
+const uint8_t kTwoConts = 1 << 7;
+const uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+// 前一个字节的高4位
+alignas(16) const uint8_t kByte1High[16] = {
+    kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+    kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+    kTooShort | kOverlong2,
+    kTooShort,
+    kTooShort | kOverlong3 | kSurrogate,
+    kTooShort | kTooLarge | kTooLarge1000 | kOverlong4,
+};
+
+// 前一个字节的低4位
+alignas(16) const uint8_t kByte1Low[16] = {
+    kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+    kCarry | kOverlong2,
+    kCarry,
+    kCarry,
+    kCarry | kTooLarge,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+};
+
+// 当前字节的高4位
+alignas(16) const uint8_t kByte2High[16] = {
+    kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooShort, kTooShort, kTooShort, kTooShort,
+};
+#endif
+
+#if defined(EASYSTL_HAS_SSE42)
+struct u8x16_ops {
+    typedef __m128i vec;
+    static const size_t kWidth = 16;
+    static vec load(const void *p) { return _mm_loadu_si128(static_cast<const __m128i *>(p)); }
+    static vec table(const uint8_t *t) { return _mm_load_si128(reinterpret_cast<const __m128i *>(t)); }
+    static vec zero() { return _mm_setzero_si128(); }
+    static vec set1(uint8_t c) { return _mm_set1_epi8(static_cast<char>(c)); }
+    static vec lookup(vec t, vec idx) { return _mm_shuffle_epi8(t, idx); }
+    static vec high_nibble(vec v) { return _mm_and_si128(_mm_srli_epi16(v, 4), set1(0x0F)); }
+    static vec low_nibble(vec v) { return _mm_and_si128(v, set1(0x0F)); }
+    static vec and_(vec a, vec b) { return _mm_and_si128(a, b); }
+    static vec or_(vec a, vec b) { return _mm_or_si128(a, b); }
+    static vec xor_(vec a, vec b) { return _mm_xor_si128(a, b); }
+    static vec subs(vec a, vec b) { return _mm_subs_epu8(a, b); }
+    // 把前一块的最后N个字节拼到前面，得到每个字节前面第N个字节
+    template <int N>
+    static vec prev(vec cur, vec before) { return _mm_alignr_epi8(cur, before, 16 - N); }
+    static bool any(vec v) { return _mm_testz_si128(v, v) == 0; }
+    static bool is_ascii(vec v) { return _mm_movemask_epi8(v) == 0; }
+    // 最后3个字节里出现对应长度的首字节时序列一定没有结束
+    static vec incomplete_max() {
+        return _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xF0 - 1),
+                             static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    }
+};
+#endif
+
+#if defined(EASYSTL_HAS_AVX2)
+struct u8x32_ops {
+    typedef __m256i vec;
+    static const size_t kWidth = 32;
+    static vec load(const void *p) { return _mm256_loadu_si256(static_cast<const __m256i *>(p)); }
+    static vec table(const uint8_t *t) { return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(t))); }
+    static vec zero() { return _mm256_setzero_si256(); }
+    static vec set1(uint8_t c) { return _mm256_set1_epi8(static_cast<char>(c)); }
+    // vpshufb在两个128位lane内各自查表，表已经复制到两个lane
+    static vec lookup(vec t, vec idx) { return _mm256_shuffle_epi8(t, idx); }
+    static vec high_nibble(vec v) { return _mm256_and_si256(_mm256_srli_epi16(v, 4), set1(0x0F)); }
+    static vec low_nibble(vec v) { return _mm256_and_si256(v, set1(0x0F)); }
+    static vec and_(vec a, vec b) { return _mm256_and_si256(a, b); }
+    static vec or_(vec a, vec b) { return _mm256_or_si256(a, b); }
+    static vec xor_(vec a, vec b) { return _mm256_xor_si256(a, b); }
+    static vec subs(vec a, vec b) { return _mm256_subs_epu8(a, b); }
+    template <int N>
+    static vec prev(vec cur, vec before) {
+        return _mm256_alignr_epi8(cur, _mm256_permute2x128_si256(before, cur, 0x21), 16 - N);
+    }
+    static bool any(vec v) { return _mm256_testz_si256(v, v) == 0; }
+    static bool is_ascii(vec v) { return _mm256_movemask_epi8(v) == 0; }
+    static vec incomplete_max() {
+        return _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xF0 - 1),
+                                static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    }
+};
+#endif
+
+#if defined(EASYSTL_HAS_SSE42) || defined(EASYSTL_HAS_AVX2)
+template <class Ops>
+class utf8_checker {
+    typedef typename Ops::vec vec;
+
+ public:
+    utf8_checker()
+        : m_error(Ops::zero()),
+          m_prev_input(Ops::zero()),
+          m_prev_incomplete(Ops::zero()) {}
+
+    void check(vec input) {
+        if (Ops::is_ascii(input)) {
+            // 上一块末尾的序列没有结束
+            m_error = Ops::or_(m_error, m_prev_incomplete);
+        } else {
+            vec prev1 = Ops::template prev<1>(input, m_prev_input);
+            vec special = Ops::and_(Ops::and_(Ops::lookup(Ops::table(kByte1High), Ops::high_nibble(prev1)),
+                                              Ops::lookup(Ops::table(kByte1Low), Ops::low_nibble(prev1))),
+                                    Ops::lookup(Ops::table(kByte2High), Ops::high_nibble(input)));
+            // 前面第2个字节>=0xE0或第3个字节>=0xF0时，这里必须是后续字节
+            vec prev2 = Ops::template prev<2>(input, m_prev_input);
+            vec prev3 = Ops::template prev<3>(input, m_prev_input);
+            vec must23 = Ops::or_(Ops::subs(prev2, Ops::set1(0xE0 - 0x80)), Ops::subs(prev3, Ops::set1(0xF0 - 0x80)));
+            m_error = Ops::or_(m_error, Ops::xor_(Ops::and_(must23, Ops::set1(0x80)), special));
+            m_prev_incomplete = Ops::subs(input, Ops::incomplete_max());
+        }
+        m_prev_input = input;
+    }
+
+    bool has_error() const { return Ops::any(m_error); }
+
+ private:
+    vec m_error;
+    vec m_prev_input;
+    vec m_prev_incomplete;
+};
+
+// 返回n表示合法，否则返回出错的块的起点(错误可能在它前面3个字节之内)，一定小于n
+template <class Ops>
+size_t validate_utf8_blocks(const char *s, size_t n) {
+    utf8_checker<Ops> checker;
+    size_t i = 0;
+    for (; i + Ops::kWidth <= n; i += Ops::kWidth) {
+        checker.check(Ops::load(s + i));
+        if (checker.has_error()) {
+            return i;
+        }
+    }
+    // 剩下的字节补0凑成一块，补的0也顺带检查了最后一个序列是否完整
+    alignas(32) char tail[Ops::kWidth] = {};
+    std::memcpy(tail, s + i, n - i);
+    checker.check(Ops::load(tail));
+    if (!checker.has_error()) {
+        return n;
+    }
+    // 没有剩余字节时错误是最后一个序列不完整，位置不能等于n
+    return i < n ? i : n - 1;
+}
+#endif
+
+inline size_t validate_utf8_fast(const char *s, size_t n) noexcept {
+#if defined(EASYSTL_HAS_AVX2)
+    return validate_utf8_blocks<u8x32_ops>(s, n);
+#elif defined(EASYSTL_HAS_SSE42)
+    return validate_utf8_blocks<u8x16_ops>(s, n);
+#else
+    utf_result r = validate_utf8_scalar(s, n);
+    return r.error == utf_error::ok ? n : r.count;
+#endif
+}
+
+// 非后续字节的个数，以及其中4字节序列首字节的个数
+inline void count_utf8(const char *s, size_t n, size_t &leads, size_t &fours) noexcept {
+    size_t i = 0;
+    leads = 0;
+    fours = 0;
+#if defined(EASYSTL_HAS_SSE2)
+    const __m128i kContMax = _mm_set1_epi8(static_cast<char>(0xBF));
+    const __m128i kFourMin = _mm_set1_epi8(static_cast<char>(0xF0));
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        // 有符号比较：后续字节0x80~0xBF是-128~-65
+        int lead = _mm_movemask_epi8(_mm_cmpgt_epi8(v, kContMax));
+        int four = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, kFourMin), v));
+        leads += static_cast<size_t>(nostd::popcount(static_cast<uint64_t>(lead)));
+        fours += static_cast<size_t>(nostd::popcount(static_cast<uint64_t>(four)));
+    }
+#endif
+    for (; i < n; ++i) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        leads += is_continuation(c) ? 0 : 1;
+        fours += c >= 0xF0 ? 1 : 0;
+    }
+}
+
+/*****************************************************************************************/
+// UTF-8 -> UTF-16/UTF-32
+/*****************************************************************************************/
+
+#if defined(EASYSTL_HAS_SSE2)
+inline void widen_ascii16(__m128i v, char16_t *out) noexcept {
+    __m128i zero = _mm_setzero_si128();
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi8(v, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpackhi_epi8(v, zero));
+}
+
+inline void widen_ascii16(__m128i v, char32_t *out) noexcept {
+    __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_unpacklo_epi8(v, zero);
+    __m128i hi = _mm_unpackhi_epi8(v, zero);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4), _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 12), _mm_unpackhi_epi16(hi, zero));
+}
+#endif
+
+template <class charT>
+size_t convert_valid_utf8(const char *s, size_t n, charT *out) noexcept {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+    charT *o = out;
+    size_t i = 0;
+    while (i < n) {
+#if defined(EASYSTL_HAS_SSE2)
+        if (i + 16 <= n) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            int mask = _mm_movemask_epi8(v);
+            if (mask == 0) {
+                widen_ascii16(v, o);
+                i += 16;
+                o += 16;
+                continue;
+            }
+            // 非ASCII字节之前的部分逐个复制
+            for (size_t k = static_cast<size_t>(nostd::countr_zero(static_cast<uint64_t>(mask))); k > 0; --k) {
+                *o++ = static_cast<charT>(p[i++]);
+            }
+        }
+#endif
+        char32_t cp;
+        i += decode_valid_utf8(p + i, cp);
+        o = put(cp, o);
+    }
+    return static_cast<size_t>(o - out);
+}
+
+/*****************************************************************************************/
+// UTF-16
+/*****************************************************************************************/
+
+#if defined(EASYSTL_HAS_SSE2)
+// 8个单元中有没有代理
+inline bool has_surrogate8(const char16_t *s) noexcept {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+    __m128i m = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(static_cast<short>(0xF800))), _mm_set1_epi16(static_cast<short>(0xD800)));
+    return _mm_movemask_epi8(m) != 0;
+}
+#endif
+
+inline utf_result validate_utf16_scalar(const char16_t *s, size_t n) noexcept {
+    size_t i = 0;
+    while (i < n) {
+#if defined(EASYSTL_HAS_SSE2)
+        if (i + 8 <= n && !has_surrogate8(s + i)) {
+            i += 8;
+            continue;
+        }
+#endif
+        char16_t u = s[i];
+        if (!is_surrogate(u)) {
+            ++i;
+        } else if (is_high_surrogate(u) && i + 1 < n && is_low_surrogate(s[i + 1])) {
+            i += 2;
+        } else {
+            return {utf_error::surrogate, i};
+        }
+    }
+    return {utf_error::ok, n};
+}
+
+inline size_t convert_valid_utf16_to_utf8(const char16_t *s, size_t n, char *out) noexcept {
+    char *o = out;
+    size_t i = 0;
+    while (i < n) {
+#if defined(EASYSTL_HAS_SSE2)
+        if (i + 8 <= n) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(static_cast<short>(0xFF80))), _mm_setzero_si128())) == 0xFFFF) {
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(o), _mm_packus_epi16(v, v));
+                i += 8;
+                o += 8;
+                continue;
+            }
+        }
+#endif
+        char16_t u = s[i];
+        if (u < 0x80) {
+            *o++ = static_cast<char>(u);
+            ++i;
+        } else if (is_high_surrogate(u)) {
+            o = encode_utf8(combine_surrogates(u, s[i + 1]), o);
+            i += 2;
+        } else {
+            o = encode_utf8(u, o);
+            ++i;
+        }
+    }
+    return static_cast<size_t>(o - out);
+}
+
+inline size_t convert_valid_utf16_to_utf32(const char16_t *s, size_t n, char32_t *out) noexcept {
+    char32_t *o = out;
+    size_t i = 0;
+    while (i < n) {
+#if defined(EASYSTL_HAS_SSE2)
+        if (i + 8 <= n && !has_surrogate8(s + i)) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(o), _mm_unpacklo_epi16(v, _mm_setzero_si128()));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(o + 4), _mm_unpackhi_epi16(v, _mm_setzero_si128()));
+            i += 8;
+            o += 8;
+            continue;
+        }
+#endif
+        char16_t u = s[i];
+        if (is_high_surrogate(u)) {
+            *o++ = combine_surrogates(u, s[i + 1]);
+            i += 2;
+        } else {
+            *o++ = u;
+            ++i;
+        }
+    }
+    return static_cast<size_t>(o - out);
+}
+
+/*****************************************************************************************/
+// UTF-32
+/*****************************************************************************************/
+
+#if defined(EASYSTL_HAS_SSE2)
+// 4个码点是否都合法(<=0x10FFFF且不在代理区)
+inline bool valid_utf32x4(__m128i v) noexcept {
+    const __m128i kFlip = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    __m128i too_large = _mm_cmpgt_epi32(_mm_xor_si128(v, kFlip), _mm_set1_epi32(static_cast<int>(0x8010FFFFu)));
+    __m128i surrogate = _mm_cmpeq_epi32(_mm_and_si128(v, _mm_set1_epi32(static_cast<int>(0xFFFFF800u))), _mm_set1_epi32(0xD800));
+    return _mm_movemask_epi8(_mm_or_si128(too_large, surrogate)) == 0;
+}
+#endif
+
+inline utf_result validate_utf32_scalar(const char32_t *s, size_t n) noexcept {
+    size_t i = 0;
+#if defined(EASYSTL_HAS_SSE2)
+    for (; i + 4 <= n; i += 4) {
+        if (!valid_utf32x4(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)))) {
+            break;
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (s[i] > 0x10FFFF) {
+            return {utf_error::too_large, i};
+        }
+        if (s[i] >= 0xD800 && s[i] <= 0xDFFF) {
+            return {utf_error::surrogate, i};
+        }
+    }
+    return {utf_error::ok, n};
+}
+
+inline size_t convert_valid_utf32_to_utf8(const char32_t *s, size_t n, char *out) noexcept {
+    char *o = out;
+    size_t i = 0;
+    while (i < n) {
+#if defined(EASYSTL_HAS_SSE2)
+        if (i + 8 <= n) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 4));
+            __m128i high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi32(static_cast<int>(0xFFFFFF80u)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) == 0xFFFF) {
+                __m128i w = _mm_packs_epi32(a, b);
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(o), _mm_packus_epi16(w, w));
+                i += 8;
+                o += 8;
+                continue;
+            }
+        }
+#endif
+        o = encode_utf8(s[i++], o);
+    }
+    return static_cast<size_t>(o - out);
+}
+
+inline size_t convert_valid_utf32_to_utf16(const char32_t *s, size_t n, char16_t *out) noexcept {
+    char16_t *o = out;
+    size_t i = 0;
+    while (i < n) {
+#if defined(EASYSTL_HAS_SSE2)
+        if (i + 4 <= n) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            // 都在BMP内(合法输入中BMP码点不会是代理)
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(v, 16), _mm_setzero_si128())) == 0xFFFF) {
+                // packs是有符号饱和，先减0x8000移到有符号范围，压缩后再加回来
+                __m128i bias = _mm_set1_epi32(0x8000);
+                __m128i w = _mm_packs_epi32(_mm_sub_epi32(v, bias), _mm_setzero_si128());
+                w = _mm_add_epi16(w, _mm_set1_epi16(static_cast<short>(0x8000)));
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(o), w);
+                i += 4;
+                o += 4;
+                continue;
+            }
+        }
+#endif
+        o = put(s[i++], o);
+    }
+    return static_cast<size_t>(o - out);
+}
+
+}  // namespace _utf
+
+/*****************************************************************************************/
+// 校验
+/*****************************************************************************************/
+
+inline bool validate_utf8(const char *s, size_t n) noexcept { return _utf::validate_utf8_fast(s, n) == n; }
+
+inline utf_result validate_utf8_with_errors(const char *s, size_t n) noexcept {
+    size_t pos = _utf::validate_utf8_fast(s, n);
+    if (pos == n) {
+        return {utf_error::ok, n};
+    }
+    // 错误可能属于前一块末尾没结束的序列，退回到那个序列的首字节再逐个检查
+    size_t start = pos > 3 ? pos - 3 : 0;
+    while (start > 0 && _utf::is_continuation(static_cast<unsigned char>(s[start]))) {
+        --start;
+    }
+    return _utf::validate_utf8_scalar(s, n, start);
+}
+
+inline bool validate_utf16(const char16_t *s, size_t n) noexcept {
+    return _utf::validate_utf16_scalar(s, n).error == utf_error::ok;
+}
+
+inline utf_result validate_utf16_with_errors(const char16_t *s, size_t n) noexcept {
+    return _utf::validate_utf16_scalar(s, n);
+}
+
+inline bool validate_utf32(const char32_t *s, size_t n) noexcept {
+    return _utf::validate_utf32_scalar(s, n).error == utf_error::ok;
+}
+
+inline utf_result validate_utf32_with_errors(const char32_t *s, size_t n) noexcept {
+    return _utf::validate_utf32_scalar(s, n);
+}
+
+/*****************************************************************************************/
+// 长度：输入必须合法
+/*****************************************************************************************/
+
+inline size_t utf16_length_from_utf8(const char *s, size_t n) noexcept {
+    size_t leads, fours;
+    _utf::count_utf8(s, n, leads, fours);
+    return leads + fours;
+}
+
+inline size_t utf32_length_from_utf8(const char *s, size_t n) noexcept {
+    size_t leads, fours;
+    _utf::count_utf8(s, n, leads, fours);
+    return leads;
+}
+
+inline size_t utf8_length_from_utf16(const char16_t *s, size_t n) noexcept {
+    size_t len = 0;
+    for (size_t i = 0; i < n; ++i) {
+        char16_t u = s[i];
+        // 代理对两个单元各算2字节
+        len += u < 0x80 ? 1 : u < 0x800 ? 2 : _utf::is_surrogate(u) ? 2 : 3;
+    }
+    return len;
+}
+
+inline size_t utf32_length_from_utf16(const char16_t *s, size_t n) noexcept {
+    size_t len = n;
+    for (size_t i = 0; i < n; ++i) {
+        len -= _utf::is_low_surrogate(s[i]) ? 1 : 0;
+    }
+    return len;
+}
+
+inline size_t utf8_length_from_utf32(const char32_t *s, size_t n) noexcept {
+    size_t len = 0;
+    for (size_t i = 0; i < n; ++i) {
+        char32_t c = s[i];
+        len += c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+    }
+    return len;
+}
+
+inline size_t utf16_length_from_utf32(const char32_t *s, size_t n) noexcept {
+    size_t len = n;
+    for (size_t i = 0; i < n; ++i) {
+        len += s[i] > 0xFFFF ? 1 : 0;
+    }
+    return len;
+}
+
+/*****************************************************************************************/
+// 转换
+// convert_valid_*：输入必须合法；convert_*：先校验，不合法时不写输出
+// out需要有对应*_length_from_*的空间
+/*****************************************************************************************/
+
+inline size_t convert_valid_utf8_to_utf16(const char *s, size_t n, char16_t *out) noexcept {
+    return _utf::convert_valid_utf8(s, n, out);
+}
+
+inline size_t convert_valid_utf8_to_utf32(const char *s, size_t n, char32_t *out) noexcept {
+    return _utf::convert_valid_utf8(s, n, out);
+}
+
+inline size_t convert_valid_utf16_to_utf8(const char16_t *s, size_t n, char *out) noexcept {
+    return _utf::convert_valid_utf16_to_utf8(s, n, out);
+}
+
+inline size_t convert_valid_utf16_to_utf32(const char16_t *s, size_t n, char32_t *out) noexcept {
+    return _utf::convert_valid_utf16_to_utf32(s, n, out);
+}
+
+inline size_t convert_valid_utf32_to_utf8(const char32_t *s, size_t n, char *out) noexcept {
+    return _utf::convert_valid_utf32_to_utf8(s, n, out);
+}
+
+inline size_t convert_valid_utf32_to_utf16(const char32_t *s, size_t n, char16_t *out) noexcept {
+    return _utf::convert_valid_utf32_to_utf16(s, n, out);
+}
+
+inline utf_result convert_utf8_to_utf16(const char *s, size_t n, char16_t *out) noexcept {
+    utf_result r = validate_utf8_with_errors(s, n);
+    return r.error != utf_error::ok ? r : utf_result{utf_error::ok, convert_valid_utf8_to_utf16(s, n, out)};
+}
+
+inline utf_result convert_utf8_to_utf32(const char *s, size_t n, char32_t *out) noexcept {
+    utf_result r = validate_utf8_with_errors(s, n);
+    return r.error != utf_error::ok ? r : utf_result{utf_error::ok, convert_valid_utf8_to_utf32(s, n, out)};
+}
+
+inline utf_result convert_utf16_to_utf8(const char16_t *s, size_t n, char *out) noexcept {
+    utf_result r = validate_utf16_with_errors(s, n);
+    return r.error != utf_error::ok ? r : utf_result{utf_error::ok, convert_valid_utf16_to_utf8(s, n, out)};
+}
+
+inline utf_result convert_utf16_to_utf32(const char16_t *s, size_t n, char32_t *out) noexcept {
+    utf_result r = validate_utf16_with_errors(s, n);
+    return r.error != utf_error::ok ? r : utf_result{utf_error::ok, convert_valid_utf16_to_utf32(s, n, out)};
+}
+
+inline utf_result convert_utf32_to_utf8(const char32_t *s, size_t n, char *out) noexcept {
+    utf_result r = validate_utf32_with_errors(s, n);
+    return r.error != utf_error::ok ? r : utf_result{utf_error::ok, convert_valid_utf32_to_utf8(s, n, out)};
+}
+
+inline utf_result convert_utf32_to_utf16(const char32_t *s, size_t n, char16_t *out) noexcept {
+    utf_result r = validate_utf32_with_errors(s, n);
+    return r.error != utf_error::ok ? r : utf_result{utf_error::ok, convert_valid_utf32_to_utf16(s, n, out)};
+}
+
+/*****************************************************************************************/
+// 分段输入
+/*****************************************************************************************/
+
+namespace _utf {
+
+// s末尾没有结束的序列的字节数(最多3个)，这部分留到下一段
+inline size_t incomplete_tail(const char *s, size_t n) noexcept {
+    for (size_t j = 1; j <= 3 && j <= n; ++j) {
+        unsigned char c = static_cast<unsigned char>(s[n - j]);
+        if (is_continuation(c)) {
+            continue;
+        }
+        int len = sequence_length(c);
+        return len > static_cast<int>(j) ? j : 0;
+    }
+    return 0;
+}
+
+// 上一段留下的不完整序列加上本段开头的字节。返回从s中取走的字节数；
+// 凑齐之后解码结果放在cp里并清空pending，凑不齐时pending保留
+inline size_t complete_pending(unsigned char *pending, size_t &pending_size, const char *s, size_t n, char32_t &cp,
+                               utf_error &err) noexcept {
+    size_t need = static_cast<size_t>(sequence_length(pending[0]));
+    size_t taken = 0;
+    while (pending_size < need && taken < n) {
+        unsigned char c = static_cast<unsigned char>(s[taken]);
+        if (!is_continuation(c)) {
+            break;
+        }
+        pending[pending_size++] = c;
+        ++taken;
+    }
+    if (pending_size < need && taken == n) {
+        err = utf_error::ok;
+        return taken;
+    }
+    size_t len;
+    err = decode_utf8(pending, pending_size, cp, len);
+    pending_size = 0;
+    return taken;
+}
+
+}  // namespace _utf
+
+class utf8_stream_validator {
+ public:
+    // 输入下一段，返回到目前为止有没有发现错误
+    bool feed(const char *s, size_t n) noexcept {
+        if (!m_ok) {
+            return false;
+        }
+        size_t i = 0;
+        if (m_pending_size != 0) {
+            char32_t cp;
+            utf_error err;
+            i = _utf::complete_pending(m_pending, m_pending_size, s, n, cp, err);
+            if (err != utf_error::ok) {
+                m_ok = false;
+                return false;
+            }
+        }
+        if (m_pending_size == 0 && i < n) {
+            size_t tail = _utf::incomplete_tail(s + i, n - i);
+            m_ok = validate_utf8(s + i, n - i - tail);
+            std::memcpy(m_pending, s + n - tail, tail);
+            m_pending_size = tail;
+        }
+        return m_ok;
+    }
+
+    // 输入结束：没有错误，并且最后一个序列是完整的
+    bool finish() const noexcept { return m_ok && m_pending_size == 0; }
+
+    void reset() noexcept {
+        m_ok = true;
+        m_pending_size = 0;
+    }
+
+ private:
+    unsigned char m_pending[4];
+    size_t m_pending_size = 0;
+    bool m_ok = true;
+};
+
+// charT为char16_t或char32_t
+template <class charT>
+class utf8_stream_converter {
+ public:
+    // 一段n字节的输入最多写出的单元数
+    static size_t max_output(size_t n) noexcept { return n + 3; }
+
+    // 转换下一段，out至少要有max_output(n)的空间
+    // 成功时count为写出的单元数；出错时count为错误在本段中的位置，此后不再接受输入
+    utf_result convert(const char *s, size_t n, charT *out) noexcept {
+        if (m_error != utf_error::ok) {
+            return {m_error, 0};
+        }
+        size_t i = 0;
+        charT *o = out;
+        if (m_pending_size != 0) {
+            char32_t cp;
+            utf_error err;
+            i = _utf::complete_pending(m_pending, m_pending_size, s, n, cp, err);
+            if (err != utf_error::ok) {
+                m_error = err;
+                return {err, 0};
+            }
+            if (m_pending_size == 0) {
+                o = _utf::put(cp, o);
+            }
+        }
+        if (m_pending_size == 0 && i < n) {
+            size_t tail = _utf::incomplete_tail(s + i, n - i);
+            utf_result r = validate_utf8_with_errors(s + i, n - i - tail);
+            if (r.error != utf_error::ok) {
+                m_error = r.error;
+                return {r.error, i + r.count};
+            }
+            o += _utf::convert_valid_utf8(s + i, n - i - tail, o);
+            std::memcpy(m_pending, s + n - tail, tail);
+            m_pending_size = tail;
+        }
+        return {utf_error::ok, static_cast<size_t>(o - out)};
+    }
+
+    // 输入结束，最后一个序列不完整时返回too_short
+    utf_result finish() const noexcept {
+        if (m_error != utf_error::ok) {
+            return {m_error, 0};
+        }
+        return {m_pending_size != 0 ? utf_error::too_short : utf_error::ok, 0};
+    }
+
+    void reset() noexcept {
+        m_error = utf_error::ok;
+        m_pending_size = 0;
+    }
+
+ private:
+    unsigned char m_pending[4];
+    size_t m_pending_size = 0;
+    utf_error m_error = utf_error::ok;
+};
+
+class utf16_stream_converter {
+ public:
+    // 一段n个单元的输入最多写出的字节数(上一段留下的高代理和本段第一个单元合成4字节)
+    static size_t max_output(size_t n) noexcept { return 3 * n + 1; }
+
+    // 转换下一段，out至少要有max_output(n)的空间，返回值含义同utf8_stream_converter
+    utf_result convert(const char16_t *s, size_t n, char *out) noexcept {
+        if (m_error != utf_error::ok) {
+            return {m_error, 0};
+        }
+        size_t i = 0;
+        char *o = out;
+        if (m_pending != 0 && n != 0) {
+            if (!_utf::is_low_surrogate(s[0])) {
+                m_error = utf_error::surrogate;
+                return {m_error, 0};
+            }
+            o = _utf::encode_utf8(_utf::combine_surrogates(m_pending, s[0]), o);
+            m_pending = 0;
+            i = 1;
+        }
+        size_t end = n;
+        if (end > i && _utf::is_high_surrogate(s[end - 1])) {
+            --end;
+        }
+        utf_result r = validate_utf16_with_errors(s + i, end - i);
+        if (r.error != utf_error::ok) {
+            m_error = r.error;
+            return {r.error, i + r.count};
+        }
+        o += convert_valid_utf16_to_utf8(s + i, end - i, o);
+        if (end != n) {
+            m_pending = s[end];
+        }
+        return {utf_error::ok, static_cast<size_t>(o - out)};
+    }
+
+    utf_result finish() const noexcept {
+        if (m_error != utf_error::ok) {
+            return {m_error, 0};
+        }
+        return {m_pending != 0 ? utf_error::surrogate : utf_error::ok, 0};
+    }
+
+    void reset() noexcept {
+        m_error = utf_error::ok;
+        m_pending = 0;
+    }
+
+ private:
+    char16_t m_pending = 0;  // 上一段末尾的高代理
+    utf_error m_error = utf_error::ok;
+};
+
+}  // namespace nostd
+
+#endif  // !__UTF_H
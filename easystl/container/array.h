@@ -0,0 +1,178 @@
+/*
+ * https://en.cppreference.com/w/cpp/container/array
+ *
+ * array是对内置数组的包装，元素直接存放在对象里，没有额外的空间开销
+ * 是聚合类型，可以用 nostd::array<int, 3> a = {1, 2, 3}; 初始化
+ *
+ * 除了反向迭代器，所有操作都是constexpr的：C++11下只有const的访问是constexpr，
+ * C++14起修改元素、fill、swap也可以在编译期求值，配合algorithm.h中的sort、copy等在编译期生成查找表
+ */
+#ifndef __ARRAY_H
+#define __ARRAY_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "algo/algorithm.h"
+#include "base/config.h"
+#include "base/iterator.h"
+#include "base/memory.h"
+
+namespace nostd {
+
+// N为0时没有元素，存一个空结构体，data()返回nullptr
+template <class T, size_t N>
+struct _array_storage {
+    typedef T type[N];
+    static constexpr T &ref(const type &t, size_t n) noexcept { return const_cast<T &>(t[n]); }
+    static constexpr T *ptr(const type &t) noexcept { return const_cast<T *>(t); }
+};
+
+template <class T>
+struct _array_storage<T, 0> {
+    struct type {};
+    static constexpr T &ref(const type &, size_t) noexcept { return *static_cast<T *>(nullptr); }
+    static constexpr T *ptr(const type &) noexcept { return nullptr; }
+};
+
+template <class T, size_t N>
+struct array {
+ public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = nostd::reverse_iterator<iterator>;
+    using const_reverse_iterator = nostd::reverse_iterator<const_iterator>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+ public:  //-=========iterators
+    EASYSTL_CONSTEXPR14 iterator begin() noexcept { return data(); }
+    constexpr const_iterator begin() const noexcept { return data(); }
+    EASYSTL_CONSTEXPR14 iterator end() noexcept { return data() + N; }
+    constexpr const_iterator end() const noexcept { return data() + N; }
+    constexpr const_iterator cbegin() const noexcept { return data(); }
+    constexpr const_iterator cend() const noexcept { return data() + N; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+ public:  //-=========Capacity
+    constexpr size_type size() const noexcept { return N; }
+    constexpr size_type max_size() const noexcept { return N; }
+    constexpr bool empty() const noexcept { return N == 0; }
+
+ public:  //-=========Element access
+    EASYSTL_CONSTEXPR14 reference operator[](size_type n) noexcept { return _storage::ref(m_elems, n); }
+    constexpr const_reference operator[](size_type n) const noexcept { return _storage::ref(m_elems, n); }
+    EASYSTL_CONSTEXPR14 reference at(size_type n) {
+        if (n >= N) {
+            throw std::out_of_range("array");
+        }
+        return _storage::ref(m_elems, n);
+    }
+    constexpr const_reference at(size_type n) const {
+        return n < N ? _storage::ref(m_elems, n) : (throw std::out_of_range("array"), _storage::ref(m_elems, 0));
+    }
+    EASYSTL_CONSTEXPR14 reference front() noexcept { return _storage::ref(m_elems, 0); }
+    constexpr const_reference front() const noexcept { return _storage::ref(m_elems, 0); }
+    EASYSTL_CONSTEXPR14 reference back() noexcept { return _storage::ref(m_elems, N - 1); }
+    constexpr const_reference back() const noexcept { return _storage::ref(m_elems, N - 1); }
+    EASYSTL_CONSTEXPR14 pointer data() noexcept { return _storage::ptr(m_elems); }
+    constexpr const_pointer data() const noexcept { return _storage::ptr(m_elems); }
+
+ public:  //-=========Modifiers
+    EASYSTL_CONSTEXPR14 void fill(const T &value) { nostd::fill_n(begin(), N, value); }
+    EASYSTL_CONSTEXPR14 void swap(array &other) { nostd::swap_ranges(begin(), end(), other.begin()); }
+
+ private:
+    using _storage = _array_storage<T, N>;
+
+ public:
+    // 聚合初始化要求成员是public的，不要直接访问
+    typename _storage::type m_elems;
+};
+
+// 元素可以按字节搬动时整个array也可以
+template <class T, size_t N>
+struct is_trivially_relocatable<array<T, N>> : is_trivially_relocatable<T> {};
+
+//-=========Non-member functions
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator==(const array<T, N> &lhs, const array<T, N> &rhs) {
+    return nostd::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator!=(const array<T, N> &lhs, const array<T, N> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator<(const array<T, N> &lhs, const array<T, N> &rhs) {
+    return nostd::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator>(const array<T, N> &lhs, const array<T, N> &rhs) {
+    return rhs < lhs;
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator<=(const array<T, N> &lhs, const array<T, N> &rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator>=(const array<T, N> &lhs, const array<T, N> &rhs) {
+    return !(lhs < rhs);
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 void swap(array<T, N> &lhs, array<T, N> &rhs) {
+    lhs.swap(rhs);
+}
+
+template <size_t I, class T, size_t N>
+EASYSTL_CONSTEXPR14 T &get(array<T, N> &a) noexcept {
+    static_assert(I < N, "array index out of bounds");
+    return a[I];
+}
+
+template <size_t I, class T, size_t N>
+EASYSTL_CONSTEXPR14 T &&get(array<T, N> &&a) noexcept {
+    static_assert(I < N, "array index out of bounds");
+    return std::move(a[I]);
+}
+
+template <size_t I, class T, size_t N>
+constexpr const T &get(const array<T, N> &a) noexcept {
+    static_assert(I < N, "array index out of bounds");
+    return a[I];
+}
+
+}  // namespace nostd
+
+// tuple_size/tuple_element，C++17起可以用结构化绑定(通过ADL找到nostd::get)
+namespace std {
+template <class T, size_t N>
+struct tuple_size<nostd::array<T, N>> : std::integral_constant<size_t, N> {};
+
+template <size_t I, class T, size_t N>
+struct tuple_element<I, nostd::array<T, N>> {
+    static_assert(I < N, "array index out of bounds");
+    using type = T;
+};
+}  // namespace std
+
+#endif  // !__ARRAY_H
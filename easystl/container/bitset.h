@@ -0,0 +1,730 @@
+/*
+ * https://cplusplus.com/reference/bitset/bitset/
+ * https://www.boost.org/doc/libs/release/libs/dynamic_bitset/dynamic_bitset.html
+ *
+ * bitset<N>       定长位集合，存储在栈上
+ * dynamic_bitset  变长位集合，底层是nostd::vector<uint64_t>
+ * bit_vector      dynamic_bitset的别名，作为按位压缩的vector<bool>使用
+ *
+ * 和std::bitset/std::vector<bool>不同，这里不提供代理引用(proxy reference):
+ * operator[]只读返回bool，修改统一走set/reset/flip，迭代器解引用也直接返回bool，
+ * 避免auto推导出代理对象、引用悬空等问题
+ *
+ * 按位运算、计数都是按64位字批量处理的，打开AVX2后大集合走向量化内核
+ */
+#ifndef __BITSET_H
+#define __BITSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "base/bit.h"
+#include "base/iterator.h"
+#include "base/simd.h"
+#include "container/vector.h"
+
+namespace nostd {
+
+//-=========================按字处理的位运算内核
+// 所有函数都作用于n个uint64_t，dst与src可以是同一块内存
+inline void _bits_and(uint64_t *dst, const uint64_t *src, size_t n) noexcept {
+    size_t i = 0;
+#if defined(EASYSTL_HAS_AVX2)
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_and_si256(a, b));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] &= src[i];
+    }
+}
+
+inline void _bits_or(uint64_t *dst, const uint64_t *src, size_t n) noexcept {
+    size_t i = 0;
+#if defined(EASYSTL_HAS_AVX2)
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_or_si256(a, b));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] |= src[i];
+    }
+}
+
+inline void _bits_xor(uint64_t *dst, const uint64_t *src, size_t n) noexcept {
+    size_t i = 0;
+#if defined(EASYSTL_HAS_AVX2)
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_xor_si256(a, b));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] ^= src[i];
+    }
+}
+
+// dst = dst & ~src
+inline void _bits_andnot(uint64_t *dst, const uint64_t *src, size_t n) noexcept {
+    size_t i = 0;
+#if defined(EASYSTL_HAS_AVX2)
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        // _mm256_andnot_si256(b, a) 计算的是 ~b & a
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_andnot_si256(b, a));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] &= ~src[i];
+    }
+}
+
+inline void _bits_not(uint64_t *dst, size_t n) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = ~dst[i];
+    }
+}
+
+// 统计n个字中为1的位数
+// AVX2下用4bit查表(vpshufb)+vpsadbw横向求和，见 Mula et al. "Faster Population Counts Using AVX2 Instructions"
+inline size_t _bits_count(const uint64_t *src, size_t n) noexcept {
+    size_t total = 0;
+    size_t i = 0;
+#if defined(EASYSTL_HAS_AVX2)
+    if (n >= 8) {
+        const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low_mask = _mm256_set1_epi8(0x0f);
+        __m256i acc = _mm256_setzero_si256();
+        for (; i + 4 <= n; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            __m256i lo = _mm256_and_si256(v, low_mask);
+            __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+            __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+        }
+        total += static_cast<size_t>(_mm256_extract_epi64(acc, 0)) + static_cast<size_t>(_mm256_extract_epi64(acc, 1)) +
+                 static_cast<size_t>(_mm256_extract_epi64(acc, 2)) + static_cast<size_t>(_mm256_extract_epi64(acc, 3));
+    }
+#endif
+    for (; i < n; ++i) {
+        total += nostd::popcount(src[i]);
+    }
+    return total;
+}
+
+// 统计 a & b 中为1的位数，不产生中间结果
+inline size_t _bits_count_and(const uint64_t *a, const uint64_t *b, size_t n) noexcept {
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        total += nostd::popcount(a[i] & b[i]);
+    }
+    return total;
+}
+
+inline bool _bits_any(const uint64_t *src, size_t n) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        if (src[i] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool _bits_intersects(const uint64_t *a, const uint64_t *b, size_t n) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        if ((a[i] & b[i]) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 从第pos位(含)开始查找第一个为1的位，找不到返回nbits
+inline size_t _bits_find_from(const uint64_t *src, size_t nbits, size_t pos) noexcept {
+    if (pos >= nbits) {
+        return nbits;
+    }
+    size_t nwords = (nbits + 63) / 64;
+    size_t w = pos / 64;
+    uint64_t word = src[w] & (~uint64_t(0) << (pos % 64));
+    while (word == 0) {
+        if (++w == nwords) {
+            return nbits;
+        }
+        word = src[w];
+    }
+    size_t found = w * 64 + nostd::countr_zero(word);
+    return found < nbits ? found : nbits;
+}
+
+// 整体左移shift位(低位向高位)，高出nwords的部分丢弃
+inline void _bits_shl(uint64_t *words, size_t nwords, size_t shift) noexcept {
+    if (nwords == 0) {
+        return;
+    }
+    const size_t word_shift = shift / 64;
+    const unsigned bit_shift = shift % 64;
+    if (word_shift >= nwords) {
+        memset(words, 0, nwords * sizeof(uint64_t));
+        return;
+    }
+    for (size_t i = nwords; i-- > word_shift;) {
+        uint64_t v = words[i - word_shift] << bit_shift;
+        if (bit_shift != 0 && i > word_shift) {
+            v |= words[i - word_shift - 1] >> (64 - bit_shift);
+        }
+        words[i] = v;
+    }
+    memset(words, 0, word_shift * sizeof(uint64_t));
+}
+
+// 整体右移shift位(高位向低位)
+inline void _bits_shr(uint64_t *words, size_t nwords, size_t shift) noexcept {
+    if (nwords == 0) {
+        return;
+    }
+    const size_t word_shift = shift / 64;
+    const unsigned bit_shift = shift % 64;
+    if (word_shift >= nwords) {
+        memset(words, 0, nwords * sizeof(uint64_t));
+        return;
+    }
+    const size_t keep = nwords - word_shift;
+    for (size_t i = 0; i < keep; ++i) {
+        uint64_t v = words[i + word_shift] >> bit_shift;
+        if (bit_shift != 0 && i + word_shift + 1 < nwords) {
+            v |= words[i + word_shift + 1] << (64 - bit_shift);
+        }
+        words[i] = v;
+    }
+    memset(words + keep, 0, word_shift * sizeof(uint64_t));
+}
+
+// 最后一个字中超出nbits的位的掩码，nbits是64的整数倍时全为1
+inline uint64_t _bits_tail_mask(size_t nbits) noexcept {
+    return nbits % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (nbits % 64)) - 1;
+}
+
+//-=========================bitset
+template <size_t N>
+class bitset {
+ public:
+    using size_type = size_t;
+    using word_type = uint64_t;
+
+    static constexpr size_type bits_per_word = 64;
+    static constexpr size_type word_count = N == 0 ? 1 : (N + bits_per_word - 1) / bits_per_word;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+ public:
+    bitset() noexcept
+        : m_words() {}
+
+    bitset(unsigned long long val) noexcept
+        : m_words() {
+        m_words[0] = static_cast<word_type>(val);
+        trim();
+    }
+
+ public:  //-=========Bit access
+    bool operator[](size_type pos) const noexcept {
+        return (m_words[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+    }
+    bool test(size_type pos) const {
+        if (pos >= N) {
+            throw std::out_of_range("bitset");
+        }
+        return (*this)[pos];
+    }
+    size_type count() const noexcept {
+        return nostd::_bits_count(m_words, word_count);
+    }
+    constexpr size_type size() const noexcept {
+        return N;
+    }
+    bool any() const noexcept {
+        return nostd::_bits_any(m_words, word_count);
+    }
+    bool none() const noexcept {
+        return !any();
+    }
+    bool all() const noexcept {
+        return count() == N;
+    }
+
+    // 第一个为1的位，没有则返回npos
+    size_type find_first() const noexcept {
+        return find_next_from(0);
+    }
+    // pos之后(不含pos)第一个为1的位，没有则返回npos
+    size_type find_next(size_type pos) const noexcept {
+        return pos + 1 >= N ? size_type(npos) : find_next_from(pos + 1);
+    }
+
+ public:  //-=========Bit operations
+    bitset &set() noexcept {
+        memset(m_words, 0xff, sizeof(m_words));
+        trim();
+        return *this;
+    }
+    bitset &set(size_type pos, bool val = true) {
+        if (pos >= N) {
+            throw std::out_of_range("bitset");
+        }
+        word_type mask = word_type(1) << (pos % bits_per_word);
+        if (val) {
+            m_words[pos / bits_per_word] |= mask;
+        } else {
+            m_words[pos / bits_per_word] &= ~mask;
+        }
+        return *this;
+    }
+    bitset &reset() noexcept {
+        memset(m_words, 0, sizeof(m_words));
+        return *this;
+    }
+    bitset &reset(size_type pos) {
+        return set(pos, false);
+    }
+    bitset &flip() noexcept {
+        nostd::_bits_not(m_words, word_count);
+        trim();
+        return *this;
+    }
+    bitset &flip(size_type pos) {
+        if (pos >= N) {
+            throw std::out_of_range("bitset");
+        }
+        m_words[pos / bits_per_word] ^= word_type(1) << (pos % bits_per_word);
+        return *this;
+    }
+
+    bitset &operator&=(const bitset &rhs) noexcept {
+        nostd::_bits_and(m_words, rhs.m_words, word_count);
+        return *this;
+    }
+    bitset &operator|=(const bitset &rhs) noexcept {
+        nostd::_bits_or(m_words, rhs.m_words, word_count);
+        return *this;
+    }
+    bitset &operator^=(const bitset &rhs) noexcept {
+        nostd::_bits_xor(m_words, rhs.m_words, word_count);
+        return *this;
+    }
+    // *this &= ~rhs
+    bitset &andnot(const bitset &rhs) noexcept {
+        nostd::_bits_andnot(m_words, rhs.m_words, word_count);
+        return *this;
+    }
+    bitset &operator<<=(size_type shift) noexcept {
+        nostd::_bits_shl(m_words, word_count, shift);
+        trim();
+        return *this;
+    }
+    bitset &operator>>=(size_type shift) noexcept {
+        nostd::_bits_shr(m_words, word_count, shift);
+        return *this;
+    }
+    bitset operator~() const noexcept {
+        return bitset(*this).flip();
+    }
+    bitset operator<<(size_type shift) const noexcept {
+        return bitset(*this) <<= shift;
+    }
+    bitset operator>>(size_type shift) const noexcept {
+        return bitset(*this) >>= shift;
+    }
+
+    bool operator==(const bitset &rhs) const noexcept {
+        return memcmp(m_words, rhs.m_words, sizeof(m_words)) == 0;
+    }
+    bool operator!=(const bitset &rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+    // 和rhs是否有公共的1位
+    bool intersects(const bitset &rhs) const noexcept {
+        return nostd::_bits_intersects(m_words, rhs.m_words, word_count);
+    }
+
+ public:  //-=========Word access
+    word_type *data() noexcept { return m_words; }
+    const word_type *data() const noexcept { return m_words; }
+    constexpr size_type num_words() const noexcept { return word_count; }
+
+ private:
+    // 保证最后一个字里超出N的位始终为0，count/==等操作才不需要额外处理
+    void trim() noexcept {
+        m_words[word_count - 1] &= nostd::_bits_tail_mask(N);
+        if (N == 0) {
+            m_words[0] = 0;
+        }
+    }
+
+    size_type find_next_from(size_type pos) const noexcept {
+        size_type found = nostd::_bits_find_from(m_words, N, pos);
+        return found == N ? size_type(npos) : found;
+    }
+
+ private:
+    word_type m_words[word_count];
+};
+
+template <size_t N>
+bitset<N> operator&(const bitset<N> &lhs, const bitset<N> &rhs) noexcept {
+    return bitset<N>(lhs) &= rhs;
+}
+
+template <size_t N>
+bitset<N> operator|(const bitset<N> &lhs, const bitset<N> &rhs) noexcept {
+    return bitset<N>(lhs) |= rhs;
+}
+
+template <size_t N>
+bitset<N> operator^(const bitset<N> &lhs, const bitset<N> &rhs) noexcept {
+    return bitset<N>(lhs) ^= rhs;
+}
+
+//-=========================dynamic_bitset
+class dynamic_bitset {
+ public:
+    using size_type = size_t;
+    using word_type = uint64_t;
+
+    static constexpr size_type bits_per_word = 64;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // 只读的随机访问迭代器，解引用返回bool值而不是代理对象
+    class const_iterator : public nostd::iterator<nostd::random_access_iterator_tag, bool, ptrdiff_t, void, bool> {
+     public:
+        const_iterator() = default;
+        const_iterator(const dynamic_bitset *owner, size_type pos)
+            : m_owner(owner), m_pos(pos) {}
+
+        bool operator*() const { return (*m_owner)[m_pos]; }
+        bool operator[](ptrdiff_t n) const { return (*m_owner)[m_pos + n]; }
+
+        const_iterator &operator++() {
+            ++m_pos;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++m_pos;
+            return tmp;
+        }
+        const_iterator &operator--() {
+            --m_pos;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --m_pos;
+            return tmp;
+        }
+        const_iterator &operator+=(ptrdiff_t n) {
+            m_pos += n;
+            return *this;
+        }
+        const_iterator &operator-=(ptrdiff_t n) {
+            m_pos -= n;
+            return *this;
+        }
+        const_iterator operator+(ptrdiff_t n) const { return const_iterator(m_owner, m_pos + n); }
+        const_iterator operator-(ptrdiff_t n) const { return const_iterator(m_owner, m_pos - n); }
+        ptrdiff_t operator-(const const_iterator &rhs) const { return static_cast<ptrdiff_t>(m_pos) - static_cast<ptrdiff_t>(rhs.m_pos); }
+
+        bool operator==(const const_iterator &rhs) const { return m_pos == rhs.m_pos; }
+        bool operator!=(const const_iterator &rhs) const { return m_pos != rhs.m_pos; }
+        bool operator<(const const_iterator &rhs) const { return m_pos < rhs.m_pos; }
+        bool operator>(const const_iterator &rhs) const { return m_pos > rhs.m_pos; }
+        bool operator<=(const const_iterator &rhs) const { return m_pos <= rhs.m_pos; }
+        bool operator>=(const const_iterator &rhs) const { return m_pos >= rhs.m_pos; }
+
+     private:
+        const dynamic_bitset *m_owner = nullptr;
+        size_type m_pos = 0;
+    };
+    using iterator = const_iterator;
+
+ public:
+    dynamic_bitset()
+        : m_words(size_type(0)), m_size(0) {}
+
+    explicit dynamic_bitset(size_type n, bool val = false)
+        : m_words(word_count_of(n), val ? ~word_type(0) : word_type(0)), m_size(n) {
+        trim();
+    }
+
+    dynamic_bitset(const dynamic_bitset &other) = default;
+
+    dynamic_bitset(dynamic_bitset &&other) noexcept
+        : m_words(size_type(0)), m_size(0) {
+        swap(other);
+    }
+
+    dynamic_bitset &operator=(const dynamic_bitset &other) {
+        if (this != &other) {
+            dynamic_bitset tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    dynamic_bitset &operator=(dynamic_bitset &&other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+ public:  //-=========Iterators
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, m_size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+ public:  //-=========Capacity
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+    size_type num_words() const noexcept { return m_words.size(); }
+    size_type capacity() const noexcept { return m_words.capacity() * bits_per_word; }
+    void reserve(size_type nbits) {
+        m_words.reserve(word_count_of(nbits));
+    }
+
+    void resize(size_type n, bool val = false) {
+        const size_type old_size = m_size;
+        const size_type words = word_count_of(n);
+        if (n > old_size && val && old_size % bits_per_word != 0) {
+            // 补齐原来最后一个字里的高位
+            m_words.back() |= ~nostd::_bits_tail_mask(old_size);
+        }
+        if (words > m_words.size()) {
+            m_words.reserve(words);
+            const word_type fill = val ? ~word_type(0) : word_type(0);
+            while (m_words.size() < words) {
+                m_words.push_back(fill);
+            }
+        } else {
+            while (m_words.size() > words) {
+                m_words.pop_back();
+            }
+        }
+        m_size = n;
+        trim();
+    }
+
+    void clear() noexcept {
+        while (!m_words.empty()) {
+            m_words.pop_back();
+        }
+        m_size = 0;
+    }
+
+ public:  //-=========Element access
+    bool operator[](size_type pos) const noexcept {
+        return (m_words[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+    }
+    bool test(size_type pos) const {
+        if (pos >= m_size) {
+            throw std::out_of_range("dynamic_bitset");
+        }
+        return (*this)[pos];
+    }
+    bool front() const { return (*this)[0]; }
+    bool back() const { return (*this)[m_size - 1]; }
+
+    word_type *data() noexcept { return m_words.data(); }
+    const word_type *data() const noexcept { return m_words.data(); }
+
+ public:  //-=========Modifiers
+    void push_back(bool val) {
+        if (m_size % bits_per_word == 0) {
+            m_words.push_back(0);
+        }
+        ++m_size;
+        assign_bit(m_size - 1, val);
+    }
+    void pop_back() {
+        --m_size;
+        if (m_size % bits_per_word == 0) {
+            m_words.pop_back();
+        } else {
+            assign_bit(m_size, false);
+        }
+    }
+
+    dynamic_bitset &set() noexcept {
+        if (!m_words.empty()) {
+            memset(m_words.data(), 0xff, m_words.size() * sizeof(word_type));
+        }
+        trim();
+        return *this;
+    }
+    dynamic_bitset &set(size_type pos, bool val = true) {
+        if (pos >= m_size) {
+            throw std::out_of_range("dynamic_bitset");
+        }
+        assign_bit(pos, val);
+        return *this;
+    }
+    dynamic_bitset &reset() noexcept {
+        if (!m_words.empty()) {
+            memset(m_words.data(), 0, m_words.size() * sizeof(word_type));
+        }
+        return *this;
+    }
+    dynamic_bitset &reset(size_type pos) {
+        return set(pos, false);
+    }
+    dynamic_bitset &flip() noexcept {
+        nostd::_bits_not(m_words.data(), m_words.size());
+        trim();
+        return *this;
+    }
+    dynamic_bitset &flip(size_type pos) {
+        if (pos >= m_size) {
+            throw std::out_of_range("dynamic_bitset");
+        }
+        m_words[pos / bits_per_word] ^= word_type(1) << (pos % bits_per_word);
+        return *this;
+    }
+
+    // 两个操作数的位数必须相同
+    dynamic_bitset &operator&=(const dynamic_bitset &rhs) {
+        check_same_size(rhs);
+        nostd::_bits_and(m_words.data(), rhs.m_words.data(), m_words.size());
+        return *this;
+    }
+    dynamic_bitset &operator|=(const dynamic_bitset &rhs) {
+        check_same_size(rhs);
+        nostd::_bits_or(m_words.data(), rhs.m_words.data(), m_words.size());
+        return *this;
+    }
+    dynamic_bitset &operator^=(const dynamic_bitset &rhs) {
+        check_same_size(rhs);
+        nostd::_bits_xor(m_words.data(), rhs.m_words.data(), m_words.size());
+        return *this;
+    }
+    // *this &= ~rhs
+    dynamic_bitset &andnot(const dynamic_bitset &rhs) {
+        check_same_size(rhs);
+        nostd::_bits_andnot(m_words.data(), rhs.m_words.data(), m_words.size());
+        return *this;
+    }
+    dynamic_bitset &operator<<=(size_type shift) noexcept {
+        nostd::_bits_shl(m_words.data(), m_words.size(), shift);
+        trim();
+        return *this;
+    }
+    dynamic_bitset &operator>>=(size_type shift) noexcept {
+        nostd::_bits_shr(m_words.data(), m_words.size(), shift);
+        return *this;
+    }
+    dynamic_bitset operator~() const {
+        return dynamic_bitset(*this).flip();
+    }
+
+    void swap(dynamic_bitset &other) noexcept {
+        m_words.swap(other.m_words);
+        std::swap(m_size, other.m_size);
+    }
+
+ public:  //-=========Bit queries
+    size_type count() const noexcept {
+        return nostd::_bits_count(m_words.data(), m_words.size());
+    }
+    bool any() const noexcept {
+        return nostd::_bits_any(m_words.data(), m_words.size());
+    }
+    bool none() const noexcept {
+        return !any();
+    }
+    bool all() const noexcept {
+        return count() == m_size;
+    }
+    bool intersects(const dynamic_bitset &rhs) const {
+        check_same_size(rhs);
+        return nostd::_bits_intersects(m_words.data(), rhs.m_words.data(), m_words.size());
+    }
+    // 第一个为1的位，没有则返回npos
+    size_type find_first() const noexcept {
+        return find_next_from(0);
+    }
+    // pos之后(不含pos)第一个为1的位，没有则返回npos
+    size_type find_next(size_type pos) const noexcept {
+        return pos + 1 >= m_size ? size_type(npos) : find_next_from(pos + 1);
+    }
+
+    bool operator==(const dynamic_bitset &rhs) const noexcept {
+        return m_size == rhs.m_size &&
+               (m_words.empty() || memcmp(m_words.data(), rhs.m_words.data(), m_words.size() * sizeof(word_type)) == 0);
+    }
+    bool operator!=(const dynamic_bitset &rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+ private:
+    static size_type word_count_of(size_type nbits) noexcept {
+        return (nbits + bits_per_word - 1) / bits_per_word;
+    }
+
+    void assign_bit(size_type pos, bool val) noexcept {
+        word_type mask = word_type(1) << (pos % bits_per_word);
+        word_type &w = m_words[pos / bits_per_word];
+        w = val ? (w | mask) : (w & ~mask);
+    }
+
+    // 保证最后一个字里超出m_size的位始终为0
+    void trim() noexcept {
+        if (!m_words.empty()) {
+            m_words.back() &= nostd::_bits_tail_mask(m_size);
+        }
+    }
+
+    void check_same_size(const dynamic_bitset &rhs) const {
+        if (m_size != rhs.m_size) {
+            throw std::invalid_argument("dynamic_bitset size mismatch");
+        }
+    }
+
+    size_type find_next_from(size_type pos) const noexcept {
+        size_type found = nostd::_bits_find_from(m_words.data(), m_size, pos);
+        return found == m_size ? size_type(npos) : found;
+    }
+
+ private:
+    nostd::vector<word_type> m_words;
+    size_type m_size;  // 位数
+};
+
+inline dynamic_bitset operator&(const dynamic_bitset &lhs, const dynamic_bitset &rhs) {
+    return dynamic_bitset(lhs) &= rhs;
+}
+
+inline dynamic_bitset operator|(const dynamic_bitset &lhs, const dynamic_bitset &rhs) {
+    return dynamic_bitset(lhs) |= rhs;
+}
+
+inline dynamic_bitset operator^(const dynamic_bitset &lhs, const dynamic_bitset &rhs) {
+    return dynamic_bitset(lhs) ^= rhs;
+}
+
+inline void swap(dynamic_bitset &x, dynamic_bitset &y) noexcept {
+    x.swap(y);
+}
+
+// 按位压缩存储的vector<bool>替代品
+using bit_vector = dynamic_bitset;
+
+}  // namespace nostd
+
+#endif  // !__BITSET_H
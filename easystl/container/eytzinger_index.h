@@ -0,0 +1,121 @@
+/*
+ * Eytzinger(BFS)布局的静态有序表
+ * ref: Khuong & Morin, "Array Layouts for Comparison-Based Searching"
+ *
+ * 把有序数组按完全二叉树的层序重新排列：m_data[1]是根，m_data[k]的左右孩子是m_data[2k]和m_data[2k+1]
+ * 查找路径上的下标单调增长，树的上面几层总是留在cache里；k的第d代后代在数组中是连续的，
+ * 每轮预取k往下几层的那一个cache line，访存延迟可以和比较重叠起来
+ * 大表上比在有序数组上二分快数倍，适合构建一次、查询很多次的静态表
+ *
+ * 查询返回指向表中元素的指针，没有满足条件的元素时返回nullptr
+ * 需要携带数据时把数据和key放在同一个T里，用只比较key的Compare构建
+ */
+#ifndef __EYTZINGER_INDEX_H
+#define __EYTZINGER_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "base/bit.h"
+#include "base/simd.h"
+#include "container/vector.h"
+
+namespace nostd {
+
+template <typename T, typename Compare = std::less<T>>
+class eytzinger_index {
+ public:
+    using value_type = T;
+    using size_type = size_t;
+    using value_compare = Compare;
+    using const_pointer = const T *;
+
+ private:
+    // 一个cache line(64字节)里放得下的元素个数向下取2的幂，k往下这么多层的后代正好挨在一起
+    static constexpr size_type kPrefetchStride = sizeof(T) >= 64 ? 1 : sizeof(T) >= 32 ? 2
+                                                                   : sizeof(T) >= 16   ? 4
+                                                                   : sizeof(T) >= 8    ? 8
+                                                                                       : 16;
+
+ public:
+    explicit eytzinger_index(const Compare &comp = Compare())
+        : m_comp(comp) {}
+
+    // sorted必须已经按comp升序排好
+    explicit eytzinger_index(const nostd::vector<T> &sorted, const Compare &comp = Compare())
+        : m_size(sorted.size()), m_comp(comp) {
+        if (m_size > 0) {
+            m_data.resize(m_size + 1, sorted[0]);
+            size_type i = 0;
+            build(sorted, i, 1);
+        }
+    }
+
+ public:
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    // 第一个不小于key的元素
+    template <typename K>
+    const_pointer lower_bound(const K &key) const {
+        const T *base = m_data.begin();
+        size_type k = 1;
+        while (k <= m_size) {
+            if (k * kPrefetchStride <= m_size) {
+                EASYSTL_PREFETCH(base + k * kPrefetchStride);
+            }
+            k = 2 * k + static_cast<size_type>(m_comp(base[k], key));
+        }
+        // 去掉最后连续向右走的那几步，剩下的就是最后一次向左走的节点
+        k >>= nostd::countr_zero(~static_cast<uint64_t>(k)) + 1;
+        return k == 0 ? nullptr : base + k;
+    }
+
+    // 第一个大于key的元素
+    template <typename K>
+    const_pointer upper_bound(const K &key) const {
+        const T *base = m_data.begin();
+        size_type k = 1;
+        while (k <= m_size) {
+            if (k * kPrefetchStride <= m_size) {
+                EASYSTL_PREFETCH(base + k * kPrefetchStride);
+            }
+            k = 2 * k + static_cast<size_type>(!m_comp(key, base[k]));
+        }
+        k >>= nostd::countr_zero(~static_cast<uint64_t>(k)) + 1;
+        return k == 0 ? nullptr : base + k;
+    }
+
+    // 和key等价的元素，没有时返回nullptr
+    template <typename K>
+    const_pointer find(const K &key) const {
+        const_pointer p = lower_bound(key);
+        return (p != nullptr && !m_comp(key, *p)) ? p : nullptr;
+    }
+
+    template <typename K>
+    bool contains(const K &key) const {
+        return find(key) != nullptr;
+    }
+
+ private:
+    // 中序遍历BFS编号的树，依次填入有序数组的元素
+    void build(const nostd::vector<T> &sorted, size_type &i, size_type k) {
+        if (k > m_size) {
+            return;
+        }
+        build(sorted, i, 2 * k);
+        m_data[k] = sorted[i++];
+        build(sorted, i, 2 * k + 1);
+    }
+
+ private:
+    nostd::vector<T> m_data;  // m_data[0]不使用
+    size_type m_size = 0;
+    Compare m_comp;
+};
+
+}  // namespace nostd
+
+#endif  // !__EYTZINGER_INDEX_H
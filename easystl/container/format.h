@@ -0,0 +1,850 @@
+/*
+ * 格式化
+ *
+ * format_to(out, "x = {}, y = {:.3f}", x, y)  追加到out的末尾
+ * format("...", args...)                      返回新的string
+ * string_builder                              可以反复追加的缓冲区，format/operator<</append直接写进去
+ *
+ * 格式串语法是std::format的子集：{[index][:[[fill]align][sign][#][0][width][.precision][type]]}
+ *   align  < > ^            sign  + - 空格            宽度按字节计算
+ *   整数   d x X b B o c    浮点  f F e E g G(不写type时为接近最短的表示)
+ *   字符串 s(precision截断)  bool  s或整数的type       指针  p
+ * 自定义类型特化formatter<T>，提供 static void format(string_builder &, const T &, const format_spec &)
+ *
+ * 格式串在C++20下由consteval构造函数在编译期检查(替换域与参数个数、括号配对)，
+ * 更早的标准只能在格式化时检查，出错抛std::invalid_argument；运行期的格式串用runtime_format包一层
+ * 格式化前按格式串长度和各参数的估计长度一次预留空间，整数和浮点数用to_chars直接写进预留区，
+ * 不经过iostream/snprintf，也不产生临时字符串
+ */
+#ifndef __FORMAT_H
+#define __FORMAT_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "base/charconv.h"
+#include "container/string.h"
+#include "container/string_view.h"
+
+namespace nostd {
+
+class string_builder;
+
+struct format_spec {
+    char fill = ' ';
+    char align = 0;  // 0/'<'/'>'/'^'，0表示按类型默认：数字右对齐，其余左对齐
+    char sign = 0;   // 0/'+'/'-'/' '
+    bool alt = false;
+    bool zero = false;
+    int width = 0;
+    int precision = -1;
+    char type = 0;
+};
+
+// 自定义类型的格式化：特化formatter<T>并实现static void format(string_builder &, const T &, const format_spec &)
+template <class T>
+struct formatter;
+
+namespace _format {
+
+template <class T>
+struct identity {
+    using type = T;
+};
+
+enum class arg_type : unsigned char {
+    int_type,
+    uint_type,
+    bool_type,
+    char_type,
+    double_type,
+    float_type,
+    string_type,
+    pointer_type,
+    custom_type,
+};
+
+struct string_value {
+    const char *data;
+    size_t size;
+};
+
+struct custom_value {
+    const void *obj;
+    void (*fn)(string_builder &, const void *, const format_spec &);
+};
+
+// 参数的类型擦除表示，只保存值或指针，不拷贝字符串
+struct arg {
+    arg_type type;
+    union {
+        long long i;
+        unsigned long long u;
+        bool b;
+        char c;
+        double d;
+        float f;
+        string_value s;
+        const void *p;
+        custom_value custom;
+    };
+
+    // 格式化后长度的估计值，用来一次预留空间
+    size_t estimate() const noexcept {
+        switch (type) {
+            case arg_type::int_type:
+            case arg_type::uint_type:
+                return 20;
+            case arg_type::bool_type:
+                return 5;
+            case arg_type::char_type:
+                return 1;
+            case arg_type::double_type:
+            case arg_type::float_type:
+                return 24;
+            case arg_type::string_type:
+                return s.size;
+            case arg_type::pointer_type:
+                return 18;
+            default:
+                return 16;
+        }
+    }
+};
+
+template <class T>
+void format_custom(string_builder &b, const void *obj, const format_spec &spec) {
+    formatter<T>::format(b, *static_cast<const T *>(obj), spec);
+}
+
+template <class T, class = void>
+struct arg_maker {
+    static arg make(const T &v) noexcept {
+        arg a;
+        a.type = arg_type::custom_type;
+        a.custom.obj = &v;
+        a.custom.fn = &format_custom<T>;
+        return a;
+    }
+};
+
+template <class T>
+struct arg_maker<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                                            !std::is_same<T, char>::value>::type> {
+    static arg make(T v) noexcept {
+        arg a;
+        if (std::is_signed<T>::value) {
+            a.type = arg_type::int_type;
+            a.i = static_cast<long long>(v);
+        } else {
+            a.type = arg_type::uint_type;
+            a.u = static_cast<unsigned long long>(v);
+        }
+        return a;
+    }
+};
+
+template <>
+struct arg_maker<bool> {
+    static arg make(bool v) noexcept {
+        arg a;
+        a.type = arg_type::bool_type;
+        a.b = v;
+        return a;
+    }
+};
+
+template <>
+struct arg_maker<char> {
+    static arg make(char v) noexcept {
+        arg a;
+        a.type = arg_type::char_type;
+        a.c = v;
+        return a;
+    }
+};
+
+template <class T>
+struct arg_maker<T, typename std::enable_if<std::is_floating_point<T>::value && !std::is_same<T, float>::value>::type> {
+    static arg make(T v) noexcept {
+        arg a;
+        a.type = arg_type::double_type;
+        a.d = static_cast<double>(v);
+        return a;
+    }
+};
+
+template <>
+struct arg_maker<float> {
+    static arg make(float v) noexcept {
+        arg a;
+        a.type = arg_type::float_type;
+        a.f = v;
+        return a;
+    }
+};
+
+inline arg make_string_arg(const char *s, size_t n) noexcept {
+    arg a;
+    a.type = arg_type::string_type;
+    a.s.data = s;
+    a.s.size = n;
+    return a;
+}
+
+template <>
+struct arg_maker<const char *> {
+    static arg make(const char *s) noexcept { return make_string_arg(s, std::strlen(s)); }
+};
+
+template <>
+struct arg_maker<char *> {
+    static arg make(const char *s) noexcept { return make_string_arg(s, std::strlen(s)); }
+};
+
+template <size_t N>
+struct arg_maker<char[N]> {
+    static arg make(const char *s) noexcept { return make_string_arg(s, std::strlen(s)); }
+};
+
+template <>
+struct arg_maker<string> {
+    static arg make(const string &s) noexcept { return make_string_arg(s.data(), s.size()); }
+};
+
+template <>
+struct arg_maker<string_view> {
+    static arg make(string_view s) noexcept { return make_string_arg(s.data(), s.size()); }
+};
+
+template <class T>
+struct arg_maker<T *, typename std::enable_if<!std::is_same<typename std::remove_cv<T>::type, char>::value>::type> {
+    static arg make(const T *p) noexcept {
+        arg a;
+        a.type = arg_type::pointer_type;
+        a.p = static_cast<const void *>(p);
+        return a;
+    }
+};
+
+template <>
+struct arg_maker<std::nullptr_t> {
+    static arg make(std::nullptr_t) noexcept {
+        arg a;
+        a.type = arg_type::pointer_type;
+        a.p = nullptr;
+        return a;
+    }
+};
+
+template <class T>
+arg make_arg(const T &v) noexcept {
+    return arg_maker<T>::make(v);
+}
+
+inline void vformat(string_builder &b, const char *fmt, size_t n, const arg *args, size_t nargs);
+inline void write_arg(string_builder &b, const arg &a, const format_spec &spec);
+inline void write_arg(string_builder &b, const arg &a);
+
+#if defined(__cpp_consteval)
+// 不是constexpr函数：常量求值中走到这里就是编译错误，报错信息里能看到参数
+inline void format_string_error(const char *) {}
+
+constexpr void check_format(const char *s, size_t n, size_t nargs) {
+    size_t next = 0;
+    bool manual = false, automatic = false;
+    for (size_t i = 0; i < n; ++i) {
+        if (s[i] == '{') {
+            if (i + 1 < n && s[i + 1] == '{') {
+                ++i;
+                continue;
+            }
+            ++i;
+            size_t index = 0;
+            bool has_index = false;
+            for (; i < n && s[i] >= '0' && s[i] <= '9'; ++i) {
+                index = index * 10 + static_cast<size_t>(s[i] - '0');
+                has_index = true;
+            }
+            if (has_index) {
+                manual = true;
+            } else {
+                automatic = true;
+                index = next++;
+            }
+            if (manual && automatic) {
+                format_string_error("format: cannot mix automatic and manual indexing");
+            }
+            if (index >= nargs) {
+                format_string_error("format: argument index out of range");
+            }
+            while (i < n && s[i] != '}' && s[i] != '{') {
+                ++i;
+            }
+            if (i >= n || s[i] != '}') {
+                format_string_error("format: invalid format string");
+            }
+        } else if (s[i] == '}') {
+            if (i + 1 < n && s[i + 1] == '}') {
+                ++i;
+                continue;
+            }
+            format_string_error("format: unmatched '}'");
+        }
+    }
+}
+#endif
+
+}  // namespace _format
+
+struct runtime_format_string {
+    string_view str;
+};
+
+// 运行期才知道的格式串，跳过编译期检查
+inline runtime_format_string runtime_format(string_view s) noexcept { return runtime_format_string{s}; }
+
+template <class... Args>
+class format_string {
+ public:
+#if defined(__cpp_consteval)
+    template <size_t N>
+    consteval format_string(const char (&s)[N])
+        : m_data(s), m_size(N - 1) {
+        _format::check_format(s, N - 1, sizeof...(Args));
+    }
+#else
+    template <size_t N>
+    constexpr format_string(const char (&s)[N])
+        : m_data(s), m_size(N - 1) {}
+#endif
+    format_string(runtime_format_string s) noexcept
+        : m_data(s.str.data()), m_size(s.str.size()) {}
+
+    constexpr const char *data() const noexcept { return m_data; }
+    constexpr size_t size() const noexcept { return m_size; }
+    constexpr string_view get() const noexcept { return string_view(m_data, m_size); }
+
+ private:
+    const char *m_data;
+    size_t m_size;
+};
+
+/*****************************************************************************************/
+// string_builder
+/*****************************************************************************************/
+
+class string_builder {
+ public:
+    using size_type = size_t;
+
+ public:
+    string_builder() = default;
+    explicit string_builder(size_type capacity) { m_str.reserve(capacity); }
+    // 接着已有的字符串往后写
+    explicit string_builder(string &&s) noexcept
+        : m_str(std::move(s)) {}
+
+ public:  //-=========Capacity
+    size_type size() const noexcept { return m_str.size(); }
+    bool empty() const noexcept { return m_str.empty(); }
+    size_type capacity() const noexcept { return m_str.capacity(); }
+    void reserve(size_type n) { m_str.reserve(n); }
+    void clear() noexcept { m_str.clear(); }
+
+ public:  //-=========Access
+    char *data() noexcept { return m_str.data(); }
+    const char *data() const noexcept { return m_str.data(); }
+    string_view view() const noexcept { return string_view(m_str.data(), m_str.size()); }
+    const string &str() const noexcept { return m_str; }
+    // 取走结果，builder变为空
+    string release() noexcept {
+        string ret(std::move(m_str));
+        m_str = string();
+        return ret;
+    }
+
+ public:  //-=========Modifiers
+    // 保证末尾至少有n个字符的可写空间，写完后用commit提交实际写入的长度
+    char *prepare(size_type n) {
+        size_type need = m_str.size() + n;
+        if (need > m_str.capacity()) {
+            size_type cap = m_str.capacity() * 2;
+            m_str.reserve(cap > need ? cap : need);
+        }
+        return m_str.data() + m_str.size();
+    }
+
+    void commit(size_type n) {
+        m_str.resize_and_overwrite(m_str.size() + n, [](char *, size_type len) { return len; });
+    }
+
+    string_builder &append(const char *s, size_type n) {
+        std::memcpy(prepare(n), s, n);
+        commit(n);
+        return *this;
+    }
+    string_builder &append(string_view s) { return append(s.data(), s.size()); }
+    string_builder &append(const char *s) { return append(s, std::strlen(s)); }
+    string_builder &append(size_type n, char c) {
+        std::memset(prepare(n), c, n);
+        commit(n);
+        return *this;
+    }
+    string_builder &push_back(char c) {
+        *prepare(1) = c;
+        commit(1);
+        return *this;
+    }
+
+    template <class T, typename std::enable_if<(std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                                                !std::is_same<T, char>::value) ||
+                                               std::is_same<T, float>::value || std::is_same<T, double>::value>::type * = nullptr>
+    string_builder &append(T v) {
+        char *p = prepare(kNumberBuffer);
+        to_chars_result r = to_chars(p, p + kNumberBuffer, v);
+        commit(static_cast<size_type>(r.ptr - p));
+        return *this;
+    }
+
+    template <class... Args>
+    string_builder &format(format_string<typename _format::identity<Args>::type...> fmt, const Args &...args) {
+        _format::arg list[sizeof...(Args) + 1] = {_format::make_arg(args)...};
+        size_type estimate = fmt.size();
+        for (size_type i = 0; i < sizeof...(Args); ++i) {
+            estimate += list[i].estimate();
+        }
+        prepare(estimate);
+        _format::vformat(*this, fmt.data(), fmt.size(), list, sizeof...(Args));
+        return *this;
+    }
+
+    // 按默认格式("{}")追加任意可格式化的值
+    template <class T>
+    string_builder &operator<<(const T &v) {
+        _format::write_arg(*this, _format::make_arg(v));
+        return *this;
+    }
+
+ private:
+    // 最长的数字：-1.7976931348623157e+308 或 18446744073709551615
+    static constexpr size_type kNumberBuffer = 32;
+
+    string m_str;
+};
+
+/*****************************************************************************************/
+// 格式化实现
+/*****************************************************************************************/
+
+namespace _format {
+
+[[noreturn]] inline void format_error(const char *msg) { throw std::invalid_argument(msg); }
+
+inline int parse_int(const char *s, size_t n, size_t &i) {
+    int v = 0;
+    for (; i < n && s[i] >= '0' && s[i] <= '9'; ++i) {
+        v = v * 10 + (s[i] - '0');
+        if (v > 1000000) {
+            format_error("format: width or precision too large");
+        }
+    }
+    return v;
+}
+
+inline bool is_align(char c) noexcept { return c == '<' || c == '>' || c == '^'; }
+
+// s[i]是':'后面的第一个字符，解析到'}'为止(不含)
+inline void parse_spec(const char *s, size_t n, size_t &i, format_spec &spec) {
+    if (i + 1 < n && is_align(s[i + 1]) && s[i] != '{' && s[i] != '}') {
+        spec.fill = s[i];
+        spec.align = s[i + 1];
+        i += 2;
+    } else if (i < n && is_align(s[i])) {
+        spec.align = s[i++];
+    }
+    if (i < n && (s[i] == '+' || s[i] == '-' || s[i] == ' ')) {
+        spec.sign = s[i++];
+    }
+    if (i < n && s[i] == '#') {
+        spec.alt = true;
+        ++i;
+    }
+    if (i < n && s[i] == '0') {
+        spec.zero = true;
+        ++i;
+    }
+    spec.width = parse_int(s, n, i);
+    if (i < n && s[i] == '.') {
+        ++i;
+        if (i >= n || s[i] < '0' || s[i] > '9') {
+            format_error("format: missing precision");
+        }
+        spec.precision = parse_int(s, n, i);
+    }
+    if (i < n && s[i] != '}') {
+        spec.type = s[i++];
+    }
+}
+
+// [start, size())是刚写入的内容，其中前prefix个字符是符号和进制前缀，按width补齐
+inline void pad(string_builder &b, size_t start, size_t prefix, const format_spec &spec, char default_align,
+                bool numeric) {
+    size_t len = b.size() - start;
+    if (static_cast<size_t>(spec.width) <= len) {
+        return;
+    }
+    size_t fill = static_cast<size_t>(spec.width) - len;
+    b.prepare(fill);
+    char *base = b.data() + start;
+    if (numeric && spec.zero && spec.align == 0) {
+        std::memmove(base + prefix + fill, base + prefix, len - prefix);
+        std::memset(base + prefix, '0', fill);
+    } else {
+        char align = spec.align != 0 ? spec.align : default_align;
+        size_t left = align == '>' ? fill : (align == '^' ? fill / 2 : 0);
+        std::memmove(base + left, base, len);
+        std::memset(base, spec.fill, left);
+        std::memset(base + left + len, spec.fill, fill - left);
+    }
+    b.commit(fill);
+}
+
+inline void write_string(string_builder &b, const char *s, size_t n, const format_spec &spec) {
+    if (spec.type != 0 && spec.type != 's') {
+        format_error("format: invalid type for string");
+    }
+    if (spec.precision >= 0 && static_cast<size_t>(spec.precision) < n) {
+        n = static_cast<size_t>(spec.precision);
+    }
+    size_t start = b.size();
+    b.append(s, n);
+    pad(b, start, 0, spec, '<', false);
+}
+
+inline void write_integer(string_builder &b, unsigned long long abs, bool neg, const format_spec &spec) {
+    int base = 10;
+    const char *prefix = "";
+    switch (spec.type) {
+        case 0:
+        case 'd':
+            break;
+        case 'x':
+            base = 16;
+            prefix = "0x";
+            break;
+        case 'X':
+            base = 16;
+            prefix = "0X";
+            break;
+        case 'b':
+            base = 2;
+            prefix = "0b";
+            break;
+        case 'B':
+            base = 2;
+            prefix = "0B";
+            break;
+        case 'o':
+            base = 8;
+            prefix = abs != 0 ? "0" : "";
+            break;
+        case 'c': {
+            if (neg || abs > 0xFF) {
+                format_error("format: integer out of range for char");
+            }
+            size_t start = b.size();
+            b.push_back(static_cast<char>(abs));
+            pad(b, start, 0, spec, '<', false);
+            return;
+        }
+        default:
+            format_error("format: invalid type for integer");
+    }
+    size_t start = b.size();
+    char *p = b.prepare(2 + 2 + 64);
+    char *o = p;
+    if (neg) {
+        *o++ = '-';
+    } else if (spec.sign == '+' || spec.sign == ' ') {
+        *o++ = spec.sign;
+    }
+    if (spec.alt) {
+        for (; *prefix != '\0'; ++prefix) {
+            *o++ = *prefix;
+        }
+    }
+    size_t prefix_len = static_cast<size_t>(o - p);
+    char *digits = o;
+    o = to_chars(o, p + 2 + 2 + 64, abs, base).ptr;
+    if (spec.type == 'X' || spec.type == 'B') {
+        for (char *q = digits; q != o; ++q) {
+            *q = (*q >= 'a' && *q <= 'z') ? static_cast<char>(*q - 'a' + 'A') : *q;
+        }
+    }
+    b.commit(static_cast<size_t>(o - p));
+    pad(b, start, prefix_len, spec, '>', true);
+}
+
+// '#'：没有小数点时在尾数后面补一个，"12" -> "12."，"1e+01" -> "1.e+01"
+inline char *force_decimal_point(char *first, char *last) {
+    char *e = first;
+    for (; e != last && *e != 'e'; ++e) {
+        if (*e == '.') {
+            return last;
+        }
+    }
+    std::memmove(e + 1, e, static_cast<size_t>(last - e));
+    *e = '.';
+    return last + 1;
+}
+
+// '#'的g格式同printf的%#g：按precision位有效数字在定点和科学计数法中选择，保留末尾的0
+template <class T>
+char *write_general_alt(char *first, char *last, T v, int precision) {
+    int digits = precision < 0 ? 6 : (precision == 0 ? 1 : precision);
+    char *o = to_chars(first, last, v, chars_format::scientific, digits - 1).ptr;
+    const char *e = first;
+    while (*e != 'e') {
+        ++e;
+    }
+    int x = 0;
+    from_chars(e + (e[1] == '+' ? 2 : 1), o, x);
+    if (x < -4 || x >= digits) {
+        return o;
+    }
+    return to_chars(first, last, v, chars_format::fixed, digits - 1 - x).ptr;
+}
+
+template <class T>
+void write_float(string_builder &b, T v, const format_spec &spec) {
+    chars_format fmt = chars_format::general;
+    bool upper = false;
+    switch (spec.type) {
+        case 0:
+            break;
+        case 'F':
+            upper = true;
+            fmt = chars_format::fixed;
+            break;
+        case 'f':
+            fmt = chars_format::fixed;
+            break;
+        case 'E':
+            upper = true;
+            fmt = chars_format::scientific;
+            break;
+        case 'e':
+            fmt = chars_format::scientific;
+            break;
+        case 'G':
+            upper = true;
+            break;
+        case 'g':
+            break;
+        default:
+            format_error("format: invalid type for floating point");
+    }
+    size_t start = b.size();
+    // 定点写法最长：符号 + 309位整数 + 小数点 + precision位小数，'#'可能再补一个小数点
+    size_t cap = 2 + 331 + static_cast<size_t>(spec.precision > 0 ? spec.precision : 0);
+    char *p = b.prepare(cap);
+    char *o = p;
+    if (!std::signbit(v) && (spec.sign == '+' || spec.sign == ' ')) {
+        *o++ = spec.sign;
+    }
+    const bool alt = spec.alt && std::isfinite(v);
+    if (spec.type == 0 && spec.precision < 0) {
+        o = to_chars(o, p + cap, v).ptr;
+    } else if (alt && fmt == chars_format::general) {
+        o = write_general_alt(o, p + cap, v, spec.precision);
+    } else {
+        o = to_chars(o, p + cap, v, fmt, spec.precision).ptr;
+    }
+    if (alt) {
+        o = force_decimal_point(p, o);
+    }
+    if (upper) {
+        for (char *q = p; q != o; ++q) {
+            *q = (*q >= 'a' && *q <= 'z') ? static_cast<char>(*q - 'a' + 'A') : *q;
+        }
+    }
+    b.commit(static_cast<size_t>(o - p));
+    // inf/nan不补0
+    format_spec s = spec;
+    s.zero = s.zero && std::isfinite(v);
+    pad(b, start, o != p && (*p == '-' || *p == '+' || *p == ' ') ? 1 : 0, s, '>', true);
+}
+
+inline void write_pointer(string_builder &b, const void *ptr, const format_spec &spec) {
+    if (spec.type != 0 && spec.type != 'p') {
+        format_error("format: invalid type for pointer");
+    }
+    format_spec s = spec;
+    s.type = 'x';
+    s.alt = true;
+    write_integer(b, static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(ptr)), false, s);
+}
+
+inline void write_arg(string_builder &b, const arg &a, const format_spec &spec) {
+    switch (a.type) {
+        case arg_type::int_type:
+            write_integer(b, a.i < 0 ? 0ull - static_cast<unsigned long long>(a.i) : static_cast<unsigned long long>(a.i),
+                          a.i < 0, spec);
+            break;
+        case arg_type::uint_type:
+            write_integer(b, a.u, false, spec);
+            break;
+        case arg_type::bool_type:
+            if (spec.type == 0 || spec.type == 's') {
+                write_string(b, a.b ? "true" : "false", a.b ? 4 : 5, spec);
+            } else {
+                write_integer(b, a.b ? 1 : 0, false, spec);
+            }
+            break;
+        case arg_type::char_type:
+            if (spec.type == 0 || spec.type == 'c') {
+                format_spec s = spec;
+                s.type = 0;
+                write_string(b, &a.c, 1, s);
+            } else {
+                write_integer(b, static_cast<unsigned char>(a.c), false, spec);
+            }
+            break;
+        case arg_type::double_type:
+            write_float(b, a.d, spec);
+            break;
+        case arg_type::float_type:
+            write_float(b, a.f, spec);
+            break;
+        case arg_type::string_type:
+            write_string(b, a.s.data, a.s.size, spec);
+            break;
+        case arg_type::pointer_type:
+            write_pointer(b, a.p, spec);
+            break;
+        case arg_type::custom_type: {
+            size_t start = b.size();
+            a.custom.fn(b, a.custom.obj, spec);
+            pad(b, start, 0, spec, '<', false);
+            break;
+        }
+    }
+}
+
+// 默认格式的快速路径
+inline void write_arg(string_builder &b, const arg &a) {
+    switch (a.type) {
+        case arg_type::int_type:
+            b.append(a.i);
+            break;
+        case arg_type::uint_type:
+            b.append(a.u);
+            break;
+        case arg_type::double_type:
+            b.append(a.d);
+            break;
+        case arg_type::float_type:
+            b.append(a.f);
+            break;
+        case arg_type::string_type:
+            b.append(a.s.data, a.s.size);
+            break;
+        case arg_type::char_type:
+            b.push_back(a.c);
+            break;
+        default:
+            write_arg(b, a, format_spec());
+            break;
+    }
+}
+
+inline void vformat(string_builder &b, const char *fmt, size_t n, const arg *args, size_t nargs) {
+    size_t next = 0;
+    bool manual = false, automatic = false;
+    size_t literal = 0;
+    size_t i = 0;
+    while (i < n) {
+        char c = fmt[i];
+        if (c != '{' && c != '}') {
+            ++i;
+            continue;
+        }
+        // "{{"和"}}"输出一个括号
+        if (i + 1 < n && fmt[i + 1] == c) {
+            b.append(fmt + literal, i + 1 - literal);
+            i += 2;
+            literal = i;
+            continue;
+        }
+        if (c == '}') {
+            format_error("format: unmatched '}'");
+        }
+        b.append(fmt + literal, i - literal);
+        ++i;
+        size_t index = 0;
+        if (i < n && fmt[i] >= '0' && fmt[i] <= '9') {
+            index = static_cast<size_t>(parse_int(fmt, n, i));
+            manual = true;
+        } else {
+            index = next++;
+            automatic = true;
+        }
+        if (manual && automatic) {
+            format_error("format: cannot mix automatic and manual indexing");
+        }
+        if (index >= nargs) {
+            format_error("format: argument index out of range");
+        }
+        if (i < n && fmt[i] == '}') {
+            write_arg(b, args[index]);
+        } else {
+            format_spec spec;
+            if (i >= n || fmt[i] != ':') {
+                format_error("format: invalid format string");
+            }
+            ++i;
+            parse_spec(fmt, n, i, spec);
+            if (i >= n || fmt[i] != '}') {
+                format_error("format: invalid format spec");
+            }
+            write_arg(b, args[index], spec);
+        }
+        ++i;
+        literal = i;
+    }
+    b.append(fmt + literal, n - literal);
+}
+
+}  // namespace _format
+
+// 追加到out的末尾；抛异常时out恢复原来的内容
+template <class... Args>
+void format_to(string &out, format_string<typename _format::identity<Args>::type...> fmt, const Args &...args) {
+    size_t old_size = out.size();
+    string_builder b(std::move(out));
+    try {
+        b.format(fmt, args...);
+    } catch (...) {
+        out = b.release();
+        out.resize(old_size);
+        throw;
+    }
+    out = b.release();
+}
+
+template <class... Args>
+string format(format_string<typename _format::identity<Args>::type...> fmt, const Args &...args) {
+    string_builder b;
+    b.format(fmt, args...);
+    return b.release();
+}
+
+}  // namespace nostd
+
+#endif  // !__FORMAT_H
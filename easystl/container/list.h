@@ -8,6 +8,58 @@
 #include "base/iterator.h"
 
 namespace nostd {
+// 双向链表的节点基类，只负责prev/next链接，不关心节点上挂的数据
+// list以及需要侵入式链表的容器(如timer_wheel的桶)都基于它
+// 作为哨兵头节点使用时，空链表的prev/next都指向自己
+struct list_node_base {
+    list_node_base *m_prev = nullptr;
+    list_node_base *m_next = nullptr;
+
+    // 初始化为空的环形链表(哨兵头节点)
+    void init() noexcept {
+        m_prev = m_next = this;
+    }
+
+    // 哨兵头节点: 链表是否为空
+    bool empty() const noexcept {
+        return m_next == this;
+    }
+
+    // 普通节点: 是否挂在某个链表上
+    bool linked() const noexcept {
+        return m_next != nullptr;
+    }
+
+    // 把当前节点插入到pos之前
+    void hook(list_node_base *pos) noexcept {
+        m_next = pos;
+        m_prev = pos->m_prev;
+        pos->m_prev->m_next = this;
+        pos->m_prev = this;
+    }
+
+    // 把当前节点从所在链表上摘下来
+    void unhook() noexcept {
+        m_prev->m_next = m_next;
+        m_next->m_prev = m_prev;
+        m_prev = m_next = nullptr;
+    }
+
+    // 哨兵头节点: 把other上的所有节点整体转移过来，other变为空链表，O(1)
+    // 要求当前链表为空
+    void take(list_node_base &other) noexcept {
+        if (other.empty()) {
+            init();
+            return;
+        }
+        m_next = other.m_next;
+        m_prev = other.m_prev;
+        m_next->m_prev = this;
+        m_prev->m_next = this;
+        other.init();
+    }
+};
+
 template <typename T>
 class list_iterator_t : public std::iterator<std::bidirectional_iterator_tag, T> {
 };
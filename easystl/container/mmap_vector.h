@@ -0,0 +1,419 @@
+/*
+ * 基于mmap的文件映射数组
+ *
+ * mmap_vector<const T>  只读映射(PROT_READ + MAP_SHARED)，多个进程映射同一个文件时共享物理页
+ * mmap_vector<T>        私有映射(MAP_PRIVATE)，写入时按页写时复制，不会改动文件
+ * file_vector<T>        可增长的文件数组(MAP_SHARED)，写入直接落到文件，容量不够时ftruncate+mremap
+ *
+ * 接口和vector一致：迭代器是裸指针，有data()/size()，nostd::lower_bound等算法可以直接用
+ * 打开时只建立映射，不读文件内容，页面在第一次访问时才载入
+ * 元素按字节存放在文件里，所以T必须是可平凡复制的类型；打开/映射失败时抛出std::system_error
+ *
+ * 只支持POSIX系统
+ */
+#ifndef __MMAP_VECTOR_H
+#define __MMAP_VECTOR_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "base/iterator.h"
+
+namespace nostd {
+
+namespace _mmap {
+
+[[noreturn]] inline void throw_errno(const char *what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+inline size_t file_size(int fd) {
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        throw_errno("fstat");
+    }
+    return static_cast<size_t>(st.st_size);
+}
+
+// bytes为0时返回nullptr，mmap不接受长度为0的映射
+inline void *map(int fd, size_t bytes, int prot, int flags) {
+    if (bytes == 0) {
+        return nullptr;
+    }
+    void *p = ::mmap(nullptr, bytes, prot, flags, fd, 0);
+    if (p == MAP_FAILED) {
+        throw_errno("mmap");
+    }
+    return p;
+}
+
+inline void unmap(void *p, size_t bytes) noexcept {
+    if (p != nullptr) {
+        ::munmap(p, bytes);
+    }
+}
+
+}  // namespace _mmap
+
+/*****************************************************************************************/
+// mmap_vector
+// 把整个文件映射成一个定长数组，文件长度必须是sizeof(T)的整数倍
+/*****************************************************************************************/
+template <typename T>
+class mmap_vector {
+ public:
+    using value_type = typename std::remove_const<T>::type;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = T *;
+    using const_pointer = const value_type *;
+    using reference = T &;
+    using const_reference = const value_type &;
+    using iterator = T *;
+    using const_iterator = const value_type *;
+    using reverse_iterator = nostd::reverse_iterator<iterator>;
+    using const_reverse_iterator = nostd::reverse_iterator<const_iterator>;
+
+    static_assert(std::is_trivially_copyable<value_type>::value, "mmap_vector element must be trivially copyable");
+
+ public:
+    mmap_vector() = default;
+
+    explicit mmap_vector(const char *path) { open(path); }
+    explicit mmap_vector(const std::string &path) { open(path.c_str()); }
+
+    mmap_vector(const mmap_vector &) = delete;
+    mmap_vector &operator=(const mmap_vector &) = delete;
+
+    mmap_vector(mmap_vector &&other) noexcept
+        : m_data(other.m_data), m_size(other.m_size), m_bytes(other.m_bytes) {
+        other.m_data = nullptr;
+        other.m_size = other.m_bytes = 0;
+    }
+
+    mmap_vector &operator=(mmap_vector &&other) noexcept {
+        mmap_vector tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    ~mmap_vector() { close(); }
+
+ public:
+    // T为const时只读共享映射，否则私有的写时复制映射
+    void open(const char *path) {
+        close();
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            _mmap::throw_errno(path);
+        }
+        try {
+            size_t bytes = _mmap::file_size(fd);
+            if (bytes % sizeof(value_type) != 0) {
+                throw std::invalid_argument("mmap_vector: file size is not a multiple of sizeof(T)");
+            }
+            int prot = std::is_const<T>::value ? PROT_READ : (PROT_READ | PROT_WRITE);
+            int flags = std::is_const<T>::value ? MAP_SHARED : MAP_PRIVATE;
+            m_data = static_cast<pointer>(_mmap::map(fd, bytes, prot, flags));
+            m_bytes = bytes;
+            m_size = bytes / sizeof(value_type);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        // 映射建立后文件描述符就不再需要了
+        ::close(fd);
+    }
+
+    void close() noexcept {
+        _mmap::unmap(const_cast<value_type *>(m_data), m_bytes);
+        m_data = nullptr;
+        m_size = m_bytes = 0;
+    }
+
+    bool is_open() const noexcept { return m_data != nullptr; }
+
+    void swap(mmap_vector &other) noexcept {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_bytes, other.m_bytes);
+    }
+
+ public:  //-=========iterators
+    iterator begin() noexcept { return m_data; }
+    const_iterator begin() const noexcept { return m_data; }
+    iterator end() noexcept { return m_data + m_size; }
+    const_iterator end() const noexcept { return m_data + m_size; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+ public:  //-=========Capacity
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+ public:  //-=========Element access
+    reference operator[](size_type n) { return m_data[n]; }
+    const_reference operator[](size_type n) const { return m_data[n]; }
+    reference at(size_type n) {
+        if (n >= m_size) {
+            throw std::out_of_range("mmap_vector");
+        }
+        return m_data[n];
+    }
+    const_reference at(size_type n) const {
+        if (n >= m_size) {
+            throw std::out_of_range("mmap_vector");
+        }
+        return m_data[n];
+    }
+    reference front() { return m_data[0]; }
+    const_reference front() const { return m_data[0]; }
+    reference back() { return m_data[m_size - 1]; }
+    const_reference back() const { return m_data[m_size - 1]; }
+    pointer data() noexcept { return m_data; }
+    const_pointer data() const noexcept { return m_data; }
+
+ private:
+    pointer m_data = nullptr;
+    size_type m_size = 0;
+    size_t m_bytes = 0;  // 映射的字节数
+};
+
+/*****************************************************************************************/
+// file_vector
+// 以文件为存储的vector，只支持尾部增删。容量按两倍增长，文件先被ftruncate到容量大小，
+// 关闭时再截断到size()*sizeof(T)。进程崩溃时文件末尾可能多出未使用的容量
+/*****************************************************************************************/
+template <typename T>
+class file_vector {
+ public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = nostd::reverse_iterator<iterator>;
+    using const_reverse_iterator = nostd::reverse_iterator<const_iterator>;
+
+    static_assert(std::is_trivially_copyable<T>::value, "file_vector element must be trivially copyable");
+
+ public:
+    file_vector() = default;
+
+    // 文件不存在时创建，已有内容作为初始元素
+    explicit file_vector(const char *path) { open(path); }
+    explicit file_vector(const std::string &path) { open(path.c_str()); }
+
+    file_vector(const file_vector &) = delete;
+    file_vector &operator=(const file_vector &) = delete;
+
+    file_vector(file_vector &&other) noexcept
+        : m_fd(other.m_fd), m_data(other.m_data), m_size(other.m_size), m_cap(other.m_cap) {
+        other.m_fd = -1;
+        other.m_data = nullptr;
+        other.m_size = other.m_cap = 0;
+    }
+
+    file_vector &operator=(file_vector &&other) noexcept {
+        file_vector tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    ~file_vector() { close(); }
+
+ public:
+    void open(const char *path) {
+        close();
+        int fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            _mmap::throw_errno(path);
+        }
+        try {
+            size_t bytes = _mmap::file_size(fd);
+            if (bytes % sizeof(T) != 0) {
+                throw std::invalid_argument("file_vector: file size is not a multiple of sizeof(T)");
+            }
+            m_data = static_cast<pointer>(_mmap::map(fd, bytes, PROT_READ | PROT_WRITE, MAP_SHARED));
+            m_size = m_cap = bytes / sizeof(T);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        m_fd = fd;
+    }
+
+    // 把文件截断到实际长度后关闭
+    void close() noexcept {
+        if (m_fd < 0) {
+            return;
+        }
+        _mmap::unmap(m_data, m_cap * sizeof(T));
+        if (::ftruncate(m_fd, static_cast<off_t>(m_size * sizeof(T))) != 0) {
+            // 析构路径上无法报告错误，文件末尾保留未使用的容量
+        }
+        ::close(m_fd);
+        m_fd = -1;
+        m_data = nullptr;
+        m_size = m_cap = 0;
+    }
+
+    bool is_open() const noexcept { return m_fd >= 0; }
+
+    // 把脏页写回文件
+    void sync() {
+        if (m_data != nullptr && ::msync(m_data, m_cap * sizeof(T), MS_SYNC) != 0) {
+            _mmap::throw_errno("msync");
+        }
+    }
+
+    void swap(file_vector &other) noexcept {
+        std::swap(m_fd, other.m_fd);
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_cap, other.m_cap);
+    }
+
+ public:  //-=========iterators
+    iterator begin() noexcept { return m_data; }
+    const_iterator begin() const noexcept { return m_data; }
+    iterator end() noexcept { return m_data + m_size; }
+    const_iterator end() const noexcept { return m_data + m_size; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+ public:  //-=========Capacity
+    size_type size() const noexcept { return m_size; }
+    size_type capacity() const noexcept { return m_cap; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    void reserve(size_type n) {
+        if (n > m_cap) {
+            remap(n);
+        }
+    }
+
+    // 新增的元素都是0：[size, capacity)里可能还留着之前缩小时的旧数据，先清零，
+    // 超出容量的部分是文件扩展出来的0字节
+    void resize(size_type n) {
+        size_type stale = n < m_cap ? n : m_cap;
+        if (stale > m_size) {
+            std::memset(static_cast<void *>(m_data + m_size), 0, (stale - m_size) * sizeof(T));
+        }
+        if (n > m_cap) {
+            remap(n);
+        }
+        m_size = n;
+    }
+
+    void shrink_to_fit() {
+        if (m_size < m_cap) {
+            remap(m_size);
+        }
+    }
+
+ public:  //-=========Element access
+    reference operator[](size_type n) { return m_data[n]; }
+    const_reference operator[](size_type n) const { return m_data[n]; }
+    reference at(size_type n) {
+        if (n >= m_size) {
+            throw std::out_of_range("file_vector");
+        }
+        return m_data[n];
+    }
+    const_reference at(size_type n) const {
+        if (n >= m_size) {
+            throw std::out_of_range("file_vector");
+        }
+        return m_data[n];
+    }
+    reference front() { return m_data[0]; }
+    const_reference front() const { return m_data[0]; }
+    reference back() { return m_data[m_size - 1]; }
+    const_reference back() const { return m_data[m_size - 1]; }
+    pointer data() noexcept { return m_data; }
+    const_pointer data() const noexcept { return m_data; }
+
+ public:  //-=========Modifiers
+    void push_back(const T &val) {
+        if (m_size == m_cap) {
+            // val可能是自己的元素，mremap可能把映射挪到新地址，先复制出来
+            T tmp(val);
+            remap(m_cap == 0 ? size_type(kMinCapacity) : m_cap * 2);
+            m_data[m_size++] = tmp;
+            return;
+        }
+        m_data[m_size++] = val;
+    }
+    void pop_back() { --m_size; }
+    void clear() noexcept { m_size = 0; }
+
+ private:
+    static constexpr size_type kMinCapacity = 4096 / sizeof(T) > 0 ? 4096 / sizeof(T) : 1;
+
+    // 把文件和映射都调整到cap个元素
+    void remap(size_type cap) {
+        if (m_fd < 0) {
+            throw std::logic_error("file_vector is not open");
+        }
+        size_t old_bytes = m_cap * sizeof(T);
+        size_t new_bytes = cap * sizeof(T);
+        if (::ftruncate(m_fd, static_cast<off_t>(new_bytes)) != 0) {
+            _mmap::throw_errno("ftruncate");
+        }
+        void *p = nullptr;
+        if (m_data == nullptr || new_bytes == 0) {
+            _mmap::unmap(m_data, old_bytes);
+            p = _mmap::map(m_fd, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED);
+        } else {
+#if defined(__linux__)
+            // 原地扩展不了时由内核挪到新地址，不需要复制页面
+            p = ::mremap(m_data, old_bytes, new_bytes, MREMAP_MAYMOVE);
+            if (p == MAP_FAILED) {
+                _mmap::throw_errno("mremap");
+            }
+#else
+            p = _mmap::map(m_fd, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED);
+            _mmap::unmap(m_data, old_bytes);
+#endif
+        }
+        m_data = static_cast<pointer>(p);
+        m_cap = cap;
+        if (m_size > cap) {
+            m_size = cap;
+        }
+    }
+
+ private:
+    int m_fd = -1;
+    pointer m_data = nullptr;
+    size_type m_size = 0;
+    size_type m_cap = 0;
+};
+
+}  // namespace nostd
+
+#endif  // !__MMAP_VECTOR_H
@@ -0,0 +1,1040 @@
+/*
+ * 压缩位图(roaring bitmap)，用于存放稀疏的32位id集合
+ * ref: https://roaringbitmap.org/
+ *      https://github.com/RoaringBitmap/RoaringFormatSpec
+ *
+ * 32位id按高16位分桶，每个桶(container)存放低16位，按基数选择三种表示中的一种:
+ *   array   有序的uint16_t数组，基数 <= 4096
+ *   bitmap  65536位的位图(1024个uint64_t)，基数 > 4096
+ *   run     (起点, 长度-1)对组成的有序区间列表，由run_optimize()按体积择优转换
+ *
+ * array之间的并/交直接复用nostd::set_union/set_intersection，
+ * bitmap之间的运算复用bitset.h中按字处理的内核；run参与运算时先展开成array或bitmap
+ *
+ * 序列化格式与RoaringFormatSpec一致(小端)，可以和其它语言的实现互通
+ */
+#ifndef __ROARING_BITMAP_H
+#define __ROARING_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "algo/algorithm.h"
+#include "base/bit.h"
+#include "base/iterator.h"
+#include "container/bitset.h"
+#include "container/vector.h"
+
+namespace nostd {
+
+class roaring_bitmap {
+ public:
+    using value_type = uint32_t;
+    using size_type = size_t;
+
+ private:
+    enum container_type : uint8_t {
+        kArray = 1,
+        kBitmap = 2,
+        kRun = 3,
+    };
+
+    static constexpr uint32_t kArrayMax = 4096;   // array容器的最大基数
+    static constexpr uint32_t kBitmapWords = 1024;  // 65536位
+    static constexpr uint32_t kCookieNoRun = 12346;
+    static constexpr uint32_t kCookieRun = 12347;
+    static constexpr uint32_t kNoOffsetThreshold = 4;
+
+    // 一个桶，存放高16位相同的所有id的低16位
+    struct container {
+        container_type m_type = kArray;
+        uint32_t m_card = 0;
+        nostd::vector<uint16_t> m_values;  // array: 有序的值; run: (起点, 长度-1)交替存放
+        nostd::vector<uint64_t> m_words;   // bitmap: 1024个字
+
+        container()
+            : m_values(size_type(0)), m_words(size_type(0)) {}
+        container(const container &other) = default;
+        container(container &&other) noexcept
+            : container() {
+            swap(other);
+        }
+        container &operator=(const container &other) {
+            if (this != &other) {
+                container tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+        container &operator=(container &&other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        void swap(container &other) noexcept {
+            std::swap(m_type, other.m_type);
+            std::swap(m_card, other.m_card);
+            m_values.swap(other.m_values);
+            m_words.swap(other.m_words);
+        }
+
+        size_type run_pairs() const noexcept { return m_values.size() / 2; }
+        uint16_t run_start(size_type i) const noexcept { return m_values[2 * i]; }
+        uint32_t run_last(size_type i) const noexcept { return uint32_t(m_values[2 * i]) + m_values[2 * i + 1]; }
+
+        bool contains(uint16_t v) const {
+            switch (m_type) {
+                case kArray: {
+                    const uint16_t *it = nostd::lower_bound(m_values.begin(), m_values.end(), v);
+                    return it != m_values.end() && *it == v;
+                }
+                case kBitmap:
+                    return (m_words[v / 64] >> (v % 64)) & 1;
+                default: {
+                    // 找到最后一个起点 <= v 的区间
+                    size_type lo = 0;
+                    size_type hi = run_pairs();
+                    while (lo < hi) {
+                        size_type mid = lo + (hi - lo) / 2;
+                        if (run_start(mid) <= v) {
+                            lo = mid + 1;
+                        } else {
+                            hi = mid;
+                        }
+                    }
+                    return lo > 0 && v <= run_last(lo - 1);
+                }
+            }
+        }
+
+        // 插入成功返回true
+        bool add(uint16_t v) {
+            if (m_type == kRun) {
+                if (contains(v)) {
+                    return false;
+                }
+                materialize();
+            }
+            if (m_type == kBitmap) {
+                uint64_t &w = m_words[v / 64];
+                uint64_t mask = uint64_t(1) << (v % 64);
+                if (w & mask) {
+                    return false;
+                }
+                w |= mask;
+                ++m_card;
+                return true;
+            }
+            size_type idx = nostd::lower_bound(m_values.begin(), m_values.end(), v) - m_values.begin();
+            if (idx < m_values.size() && m_values[idx] == v) {
+                return false;
+            }
+            if (m_card == kArrayMax) {
+                to_bitmap();
+                return add(v);
+            }
+            m_values.push_back(v);
+            nostd::copy_backward(m_values.begin() + idx, m_values.end() - 1, m_values.end());
+            m_values[idx] = v;
+            ++m_card;
+            return true;
+        }
+
+        // 删除成功返回true
+        bool remove(uint16_t v) {
+            if (m_type == kRun) {
+                if (!contains(v)) {
+                    return false;
+                }
+                materialize();
+            }
+            if (m_type == kBitmap) {
+                uint64_t &w = m_words[v / 64];
+                uint64_t mask = uint64_t(1) << (v % 64);
+                if (!(w & mask)) {
+                    return false;
+                }
+                w &= ~mask;
+                if (--m_card <= kArrayMax) {
+                    to_array();
+                }
+                return true;
+            }
+            uint16_t *it = nostd::lower_bound(m_values.begin(), m_values.end(), v);
+            if (it == m_values.end() || *it != v) {
+                return false;
+            }
+            nostd::copy(it + 1, m_values.end(), it);
+            m_values.pop_back();
+            --m_card;
+            return true;
+        }
+
+        // array/run -> bitmap
+        void to_bitmap() {
+            nostd::vector<uint64_t> words(size_type(kBitmapWords), uint64_t(0));
+            if (m_type == kArray) {
+                for (size_type i = 0; i < m_values.size(); ++i) {
+                    words[m_values[i] / 64] |= uint64_t(1) << (m_values[i] % 64);
+                }
+            } else if (m_type == kRun) {
+                for (size_type i = 0; i < run_pairs(); ++i) {
+                    set_range(words.data(), run_start(i), run_last(i));
+                }
+            }
+            m_words.swap(words);
+            nostd::vector<uint16_t>(size_type(0)).swap(m_values);
+            m_type = kBitmap;
+        }
+
+        // bitmap/run -> array，要求基数 <= kArrayMax
+        void to_array() {
+            nostd::vector<uint16_t> values(size_type(0));
+            values.reserve(m_card);
+            for_each(0, [&values](uint32_t v) {
+                values.push_back(static_cast<uint16_t>(v));
+            });
+            m_values.swap(values);
+            nostd::vector<uint64_t>(size_type(0)).swap(m_words);
+            m_type = kArray;
+        }
+
+        // run -> 按基数选择array或bitmap
+        void materialize() {
+            if (m_type != kRun) {
+                return;
+            }
+            if (m_card <= kArrayMax) {
+                to_array();
+            } else {
+                to_bitmap();
+            }
+        }
+
+        // 按区间表示时需要多少个区间
+        size_type count_runs() const {
+            switch (m_type) {
+                case kRun:
+                    return run_pairs();
+                case kArray: {
+                    size_type runs = m_values.empty() ? 0 : 1;
+                    for (size_type i = 1; i < m_values.size(); ++i) {
+                        runs += m_values[i] != m_values[i - 1] + 1;
+                    }
+                    return runs;
+                }
+                default: {
+                    // 统计0->1的跳变次数
+                    size_type runs = 0;
+                    uint64_t carry = 0;
+                    for (uint32_t i = 0; i < kBitmapWords; ++i) {
+                        uint64_t w = m_words[i];
+                        runs += nostd::popcount(w & ~((w << 1) | carry));
+                        carry = w >> 63;
+                    }
+                    return runs;
+                }
+            }
+        }
+
+        // 转成序列化体积最小的表示
+        void optimize() {
+            size_type runs = count_runs();
+            size_type run_bytes = 2 + 4 * runs;
+            size_type plain_bytes = m_card <= kArrayMax ? 2 * size_type(m_card) : 8 * size_type(kBitmapWords);
+            if (run_bytes < plain_bytes) {
+                if (m_type == kRun) {
+                    return;
+                }
+                nostd::vector<uint16_t> pairs(size_type(0));
+                pairs.reserve(2 * runs);
+                bool open = false;
+                uint32_t start = 0;
+                uint32_t last = 0;
+                for_each(0, [&](uint32_t v) {
+                    if (open && v == last + 1) {
+                        last = v;
+                        return;
+                    }
+                    if (open) {
+                        pairs.push_back(static_cast<uint16_t>(start));
+                        pairs.push_back(static_cast<uint16_t>(last - start));
+                    }
+                    open = true;
+                    start = last = v;
+                });
+                if (open) {
+                    pairs.push_back(static_cast<uint16_t>(start));
+                    pairs.push_back(static_cast<uint16_t>(last - start));
+                }
+                m_values.swap(pairs);
+                nostd::vector<uint64_t>(size_type(0)).swap(m_words);
+                m_type = kRun;
+            } else {
+                materialize();
+            }
+        }
+
+        // 按升序对每个值调用fn(high | low)
+        template <typename Function>
+        void for_each(uint32_t high, Function fn) const {
+            switch (m_type) {
+                case kArray:
+                    for (size_type i = 0; i < m_values.size(); ++i) {
+                        fn(high | m_values[i]);
+                    }
+                    break;
+                case kBitmap:
+                    for (uint32_t i = 0; i < kBitmapWords; ++i) {
+                        uint64_t w = m_words[i];
+                        while (w != 0) {
+                            fn(high | (i * 64 + nostd::countr_zero(w)));
+                            w &= w - 1;
+                        }
+                    }
+                    break;
+                default:
+                    for (size_type i = 0; i < run_pairs(); ++i) {
+                        for (uint32_t v = run_start(i); v <= run_last(i); ++v) {
+                            fn(high | v);
+                        }
+                    }
+                    break;
+            }
+        }
+
+        // 把[first, last]区间内的位置1
+        static void set_range(uint64_t *words, uint32_t first, uint32_t last) {
+            uint32_t fw = first / 64;
+            uint32_t lw = last / 64;
+            uint64_t head = ~uint64_t(0) << (first % 64);
+            uint64_t tail = ~uint64_t(0) >> (63 - last % 64);
+            if (fw == lw) {
+                words[fw] |= head & tail;
+                return;
+            }
+            words[fw] |= head;
+            for (uint32_t i = fw + 1; i < lw; ++i) {
+                words[i] = ~uint64_t(0);
+            }
+            words[lw] |= tail;
+        }
+
+        // run容器参与运算时先展开，返回展开后的副本或原对象
+        static const container &plain(const container &c, container &scratch) {
+            if (c.m_type != kRun) {
+                return c;
+            }
+            scratch = c;
+            scratch.materialize();
+            return scratch;
+        }
+
+        static container make_union(const container &lhs, const container &rhs) {
+            container sa, sb;
+            const container &a = plain(lhs, sa);
+            const container &b = plain(rhs, sb);
+            container out;
+            if (a.m_type == kArray && b.m_type == kArray) {
+                if (a.m_card + b.m_card <= kArrayMax) {
+                    out.m_values.resize(a.m_card + b.m_card);
+                    uint16_t *last = nostd::set_union(a.m_values.begin(), a.m_values.end(),
+                                                      b.m_values.begin(), b.m_values.end(),
+                                                      out.m_values.begin());
+                    out.m_values.resize(last - out.m_values.begin());
+                    out.m_card = static_cast<uint32_t>(out.m_values.size());
+                    return out;
+                }
+                // 结果可能超过array的上限，直接在位图上合并
+                out = a;
+                out.to_bitmap();
+                for (size_type i = 0; i < b.m_values.size(); ++i) {
+                    out.m_words[b.m_values[i] / 64] |= uint64_t(1) << (b.m_values[i] % 64);
+                }
+            } else if (a.m_type == kBitmap && b.m_type == kBitmap) {
+                out = a;
+                nostd::_bits_or(out.m_words.data(), b.m_words.data(), kBitmapWords);
+            } else {
+                const container &bits = a.m_type == kBitmap ? a : b;
+                const container &arr = a.m_type == kBitmap ? b : a;
+                out = bits;
+                for (size_type i = 0; i < arr.m_values.size(); ++i) {
+                    out.m_words[arr.m_values[i] / 64] |= uint64_t(1) << (arr.m_values[i] % 64);
+                }
+            }
+            out.m_card = static_cast<uint32_t>(nostd::_bits_count(out.m_words.data(), kBitmapWords));
+            if (out.m_card <= kArrayMax) {
+                out.to_array();
+            }
+            return out;
+        }
+
+        static container make_intersection(const container &lhs, const container &rhs) {
+            container sa, sb;
+            const container &a = plain(lhs, sa);
+            const container &b = plain(rhs, sb);
+            container out;
+            if (a.m_type == kArray && b.m_type == kArray) {
+                out.m_values.resize(nostd::min(a.m_card, b.m_card));
+                uint16_t *last = nostd::set_intersection(a.m_values.begin(), a.m_values.end(),
+                                                         b.m_values.begin(), b.m_values.end(),
+                                                         out.m_values.begin());
+                out.m_values.resize(last - out.m_values.begin());
+                out.m_card = static_cast<uint32_t>(out.m_values.size());
+            } else if (a.m_type == kBitmap && b.m_type == kBitmap) {
+                out = a;
+                nostd::_bits_and(out.m_words.data(), b.m_words.data(), kBitmapWords);
+                out.m_card = static_cast<uint32_t>(nostd::_bits_count(out.m_words.data(), kBitmapWords));
+                if (out.m_card <= kArrayMax) {
+                    out.to_array();
+                }
+            } else {
+                // array中逐个查位图
+                const container &bits = a.m_type == kBitmap ? a : b;
+                const container &arr = a.m_type == kBitmap ? b : a;
+                out.m_values.reserve(arr.m_card);
+                for (size_type i = 0; i < arr.m_values.size(); ++i) {
+                    uint16_t v = arr.m_values[i];
+                    if ((bits.m_words[v / 64] >> (v % 64)) & 1) {
+                        out.m_values.push_back(v);
+                    }
+                }
+                out.m_card = static_cast<uint32_t>(out.m_values.size());
+            }
+            return out;
+        }
+
+        static container make_difference(const container &lhs, const container &rhs) {
+            container sa, sb;
+            const container &a = plain(lhs, sa);
+            const container &b = plain(rhs, sb);
+            container out;
+            if (a.m_type == kArray) {
+                out.m_values.resize(a.m_card);
+                uint16_t *last = out.m_values.begin();
+                for (size_type i = 0; i < a.m_values.size(); ++i) {
+                    if (!b.contains(a.m_values[i])) {
+                        *last++ = a.m_values[i];
+                    }
+                }
+                out.m_values.resize(last - out.m_values.begin());
+                out.m_card = static_cast<uint32_t>(out.m_values.size());
+                return out;
+            }
+            out = a;
+            if (b.m_type == kBitmap) {
+                nostd::_bits_andnot(out.m_words.data(), b.m_words.data(), kBitmapWords);
+            } else {
+                for (size_type i = 0; i < b.m_values.size(); ++i) {
+                    out.m_words[b.m_values[i] / 64] &= ~(uint64_t(1) << (b.m_values[i] % 64));
+                }
+            }
+            out.m_card = static_cast<uint32_t>(nostd::_bits_count(out.m_words.data(), kBitmapWords));
+            if (out.m_card <= kArrayMax) {
+                out.to_array();
+            }
+            return out;
+        }
+    };
+
+ public:
+    // 按升序遍历所有id的只读前向迭代器
+    class const_iterator : public nostd::iterator<nostd::forward_iterator_tag, uint32_t, ptrdiff_t, const uint32_t *, uint32_t> {
+     public:
+        const_iterator() = default;
+
+        uint32_t operator*() const { return m_value; }
+
+        const_iterator &operator++() {
+            advance();
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            advance();
+            return tmp;
+        }
+
+        bool operator==(const const_iterator &rhs) const {
+            return m_index == rhs.m_index && m_pos == rhs.m_pos && m_run == rhs.m_run;
+        }
+        bool operator!=(const const_iterator &rhs) const {
+            return !(*this == rhs);
+        }
+
+     private:
+        friend class roaring_bitmap;
+
+        const_iterator(const roaring_bitmap *owner, size_type index)
+            : m_owner(owner), m_index(index) {
+            seek();
+        }
+
+        // 从当前容器的m_pos开始找下一个值，当前容器遍历完就换下一个容器
+        void seek() {
+            for (; m_index < m_owner->m_containers.size(); ++m_index, m_pos = 0) {
+                const container &c = m_owner->m_containers[m_index];
+                uint32_t high = uint32_t(m_owner->m_keys[m_index]) << 16;
+                if (c.m_type == kArray) {
+                    if (m_pos < c.m_values.size()) {
+                        m_value = high | c.m_values[m_pos];
+                        return;
+                    }
+                } else if (c.m_type == kBitmap) {
+                    if (m_pos < 65536) {
+                        size_t next = nostd::_bits_find_from(c.m_words.data(), 65536, m_pos);
+                        if (next < 65536) {
+                            m_pos = static_cast<uint32_t>(next);
+                            m_value = high | m_pos;
+                            return;
+                        }
+                    }
+                } else {
+                    for (; m_run < c.run_pairs(); ++m_run, m_pos = 0) {
+                        if (m_pos <= c.m_values[2 * m_run + 1]) {
+                            m_value = high | (c.run_start(m_run) + m_pos);
+                            return;
+                        }
+                    }
+                }
+                m_run = 0;
+            }
+            m_pos = 0;
+        }
+
+        void advance() {
+            ++m_pos;
+            seek();
+        }
+
+        const roaring_bitmap *m_owner = nullptr;
+        size_type m_index = 0;  // 容器下标
+        uint32_t m_pos = 0;     // 容器内的位置: array下标/bitmap位号/run区间内的偏移
+        size_type m_run = 0;    // run容器当前所在的区间
+        uint32_t m_value = 0;
+    };
+    using iterator = const_iterator;
+
+ public:
+    roaring_bitmap()
+        : m_keys(size_type(0)), m_containers(size_type(0)) {}
+
+    roaring_bitmap(std::initializer_list<uint32_t> il)
+        : roaring_bitmap() {
+        for (uint32_t v : il) {
+            add(v);
+        }
+    }
+
+    roaring_bitmap(const roaring_bitmap &other) = default;
+
+    roaring_bitmap(roaring_bitmap &&other) noexcept
+        : roaring_bitmap() {
+        swap(other);
+    }
+
+    roaring_bitmap &operator=(const roaring_bitmap &other) {
+        if (this != &other) {
+            roaring_bitmap tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    roaring_bitmap &operator=(roaring_bitmap &&other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    // 从有序或无序的id序列构造
+    template <typename InputIterator>
+    roaring_bitmap(InputIterator first, InputIterator last)
+        : roaring_bitmap() {
+        for (; first != last; ++first) {
+            add(static_cast<uint32_t>(*first));
+        }
+    }
+
+ public:  //-=========Iterators
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_containers.size()); }
+
+ public:  //-=========Capacity
+    // 集合中id的个数
+    uint64_t cardinality() const noexcept {
+        uint64_t total = 0;
+        for (size_type i = 0; i < m_containers.size(); ++i) {
+            total += m_containers[i].m_card;
+        }
+        return total;
+    }
+    bool empty() const noexcept {
+        return m_containers.empty();
+    }
+    // 容器(桶)个数
+    size_type container_count() const noexcept {
+        return m_containers.size();
+    }
+
+ public:  //-=========Modifiers
+    // 插入成功返回true
+    bool add(uint32_t v) {
+        uint16_t key = static_cast<uint16_t>(v >> 16);
+        size_type idx = find_or_insert(key);
+        return m_containers[idx].add(static_cast<uint16_t>(v & 0xffff));
+    }
+
+    // 插入[first, last)区间内的所有id，last超过2^32时截到2^32
+    void add_range(uint64_t first, uint64_t last) {
+        last = nostd::min(last, uint64_t(1) << 32);
+        for (uint64_t v = first; v < last;) {
+            uint16_t key = static_cast<uint16_t>(v >> 16);
+            uint64_t chunk_end = nostd::min((v | 0xffff) + 1, last);
+            container &c = m_containers[find_or_insert(key)];
+            c.materialize();
+            if (c.m_type == kArray && c.m_card + (chunk_end - v) > kArrayMax) {
+                c.to_bitmap();
+            }
+            if (c.m_type == kBitmap) {
+                container::set_range(c.m_words.data(), static_cast<uint32_t>(v & 0xffff),
+                                     static_cast<uint32_t>((chunk_end - 1) & 0xffff));
+                c.m_card = static_cast<uint32_t>(nostd::_bits_count(c.m_words.data(), kBitmapWords));
+                // 上面按"原基数 + 区间长度"估计，和已有的值重叠时实际基数可能没有超过kArrayMax
+                if (c.m_card <= kArrayMax) {
+                    c.to_array();
+                }
+            } else {
+                for (uint64_t x = v; x < chunk_end; ++x) {
+                    c.add(static_cast<uint16_t>(x & 0xffff));
+                }
+            }
+            v = chunk_end;
+        }
+    }
+
+    // 删除成功返回true
+    bool remove(uint32_t v) {
+        uint16_t key = static_cast<uint16_t>(v >> 16);
+        size_type idx = find(key);
+        if (idx == npos_index) {
+            return false;
+        }
+        bool removed = m_containers[idx].remove(static_cast<uint16_t>(v & 0xffff));
+        if (m_containers[idx].m_card == 0) {
+            erase_at(idx);
+        }
+        return removed;
+    }
+
+    void clear() {
+        roaring_bitmap().swap(*this);
+    }
+
+    // 把每个容器转换为体积最小的表示(连续的id会被压缩为区间)
+    void run_optimize() {
+        for (size_type i = 0; i < m_containers.size(); ++i) {
+            m_containers[i].optimize();
+        }
+    }
+
+    void swap(roaring_bitmap &other) noexcept {
+        m_keys.swap(other.m_keys);
+        m_containers.swap(other.m_containers);
+    }
+
+ public:  //-=========Lookup
+    bool contains(uint32_t v) const {
+        size_type idx = find(static_cast<uint16_t>(v >> 16));
+        return idx != npos_index && m_containers[idx].contains(static_cast<uint16_t>(v & 0xffff));
+    }
+
+    // 最小/最大的id，集合为空时行为未定义
+    uint32_t minimum() const {
+        return *begin();
+    }
+    uint32_t maximum() const {
+        const container &c = m_containers.back();
+        uint32_t high = uint32_t(m_keys.back()) << 16;
+        if (c.m_type == kArray) {
+            return high | c.m_values.back();
+        }
+        if (c.m_type == kRun) {
+            return high | c.run_last(c.run_pairs() - 1);
+        }
+        for (uint32_t i = kBitmapWords; i-- > 0;) {
+            if (c.m_words[i] != 0) {
+                return high | (i * 64 + 63 - nostd::countl_zero(c.m_words[i]));
+            }
+        }
+        return high;
+    }
+
+ public:  //-=========Set operations
+    friend roaring_bitmap operator|(const roaring_bitmap &lhs, const roaring_bitmap &rhs) {
+        return merge(lhs, rhs, kUnion);
+    }
+    friend roaring_bitmap operator&(const roaring_bitmap &lhs, const roaring_bitmap &rhs) {
+        return merge(lhs, rhs, kIntersection);
+    }
+    friend roaring_bitmap operator-(const roaring_bitmap &lhs, const roaring_bitmap &rhs) {
+        return merge(lhs, rhs, kDifference);
+    }
+
+    roaring_bitmap &operator|=(const roaring_bitmap &rhs) {
+        roaring_bitmap tmp = merge(*this, rhs, kUnion);
+        swap(tmp);
+        return *this;
+    }
+    roaring_bitmap &operator&=(const roaring_bitmap &rhs) {
+        roaring_bitmap tmp = merge(*this, rhs, kIntersection);
+        swap(tmp);
+        return *this;
+    }
+    roaring_bitmap &operator-=(const roaring_bitmap &rhs) {
+        roaring_bitmap tmp = merge(*this, rhs, kDifference);
+        swap(tmp);
+        return *this;
+    }
+
+    bool operator==(const roaring_bitmap &rhs) const {
+        if (m_keys.size() != rhs.m_keys.size() || !nostd::equal(m_keys.begin(), m_keys.end(), rhs.m_keys.begin())) {
+            return false;
+        }
+        for (size_type i = 0; i < m_containers.size(); ++i) {
+            if (m_containers[i].m_card != rhs.m_containers[i].m_card) {
+                return false;
+            }
+        }
+        return nostd::equal(begin(), end(), rhs.begin());
+    }
+    bool operator!=(const roaring_bitmap &rhs) const {
+        return !(*this == rhs);
+    }
+
+ public:  //-=========Serialization
+    // 序列化后的字节数
+    size_type serialized_size() const {
+        const size_type n = m_containers.size();
+        const bool has_run = has_run_container();
+        size_type bytes = 4;  // cookie
+        if (has_run) {
+            bytes += (n + 7) / 8;
+        } else {
+            bytes += 4;  // 容器个数
+        }
+        bytes += 4 * n;  // key + 基数-1
+        if (!has_run || n >= kNoOffsetThreshold) {
+            bytes += 4 * n;  // 偏移表
+        }
+        for (size_type i = 0; i < n; ++i) {
+            bytes += container_bytes(m_containers[i]);
+        }
+        return bytes;
+    }
+
+    // 写入到buf中，buf至少要有serialized_size()个字节，返回写入的字节数
+    size_type serialize(char *buf) const {
+        const size_type n = m_containers.size();
+        const bool has_run = has_run_container();
+        char *p = buf;
+        if (has_run) {
+            p = put_u32(p, kCookieRun | (static_cast<uint32_t>(n - 1) << 16));
+            memset(p, 0, (n + 7) / 8);
+            for (size_type i = 0; i < n; ++i) {
+                if (m_containers[i].m_type == kRun) {
+                    p[i / 8] = static_cast<char>(p[i / 8] | (1 << (i % 8)));
+                }
+            }
+            p += (n + 7) / 8;
+        } else {
+            p = put_u32(p, kCookieNoRun);
+            p = put_u32(p, static_cast<uint32_t>(n));
+        }
+        for (size_type i = 0; i < n; ++i) {
+            p = put_u16(p, m_keys[i]);
+            p = put_u16(p, static_cast<uint16_t>(m_containers[i].m_card - 1));
+        }
+        if (!has_run || n >= kNoOffsetThreshold) {
+            uint32_t offset = static_cast<uint32_t>((p - buf) + 4 * n);
+            for (size_type i = 0; i < n; ++i) {
+                p = put_u32(p, offset);
+                offset += static_cast<uint32_t>(container_bytes(m_containers[i]));
+            }
+        }
+        for (size_type i = 0; i < n; ++i) {
+            const container &c = m_containers[i];
+            if (c.m_type == kRun) {
+                p = put_u16(p, static_cast<uint16_t>(c.run_pairs()));
+                for (size_type j = 0; j < c.m_values.size(); ++j) {
+                    p = put_u16(p, c.m_values[j]);
+                }
+            } else if (c.m_type == kArray) {
+                for (size_type j = 0; j < c.m_values.size(); ++j) {
+                    p = put_u16(p, c.m_values[j]);
+                }
+            } else {
+                for (uint32_t j = 0; j < kBitmapWords; ++j) {
+                    p = put_u64(p, c.m_words[j]);
+                }
+            }
+        }
+        return static_cast<size_type>(p - buf);
+    }
+
+    nostd::vector<char> serialize() const {
+        nostd::vector<char> out(serialized_size());
+        serialize(out.data());
+        return out;
+    }
+
+    // 从buf中反序列化，数据不合法时抛出std::invalid_argument
+    static roaring_bitmap deserialize(const char *buf, size_type len) {
+        reader in{buf, buf + len};
+        roaring_bitmap result;
+        uint32_t cookie = in.u32();
+        size_type n = 0;
+        const char *run_flags = nullptr;
+        bool has_run = false;
+        if ((cookie & 0xffff) == kCookieRun) {
+            has_run = true;
+            n = (cookie >> 16) + 1;
+            run_flags = in.skip((n + 7) / 8);
+        } else if (cookie == kCookieNoRun) {
+            n = in.u32();
+        } else {
+            throw std::invalid_argument("roaring_bitmap: bad cookie");
+        }
+        if (n > 65536) {
+            throw std::invalid_argument("roaring_bitmap: too many containers");
+        }
+        const char *header = in.skip(4 * n);
+        if (!has_run || n >= kNoOffsetThreshold) {
+            in.skip(4 * n);  // 容器按顺序紧密排列，偏移表只做校验用，这里直接跳过
+        }
+        result.m_keys.reserve(n);
+        result.m_containers.reserve(n);
+        for (size_type i = 0; i < n; ++i) {
+            reader h{header + 4 * i, header + 4 * i + 4};
+            uint16_t key = h.u16();
+            uint32_t card = uint32_t(h.u16()) + 1;
+            if (i > 0 && key <= result.m_keys.back()) {
+                throw std::invalid_argument("roaring_bitmap: keys not sorted");
+            }
+            container c;
+            c.m_card = card;
+            if (has_run && ((run_flags[i / 8] >> (i % 8)) & 1)) {
+                c.m_type = kRun;
+                uint16_t pairs = in.u16();
+                c.m_values.reserve(2 * size_type(pairs));
+                uint32_t total = 0;
+                uint32_t next = 0;  // 下一个区间最小的起点
+                for (uint16_t j = 0; j < pairs; ++j) {
+                    uint16_t start = in.u16();
+                    uint16_t length = in.u16();
+                    if (start < next || uint32_t(start) + length > 0xffff) {
+                        throw std::invalid_argument("roaring_bitmap: runs overlap or out of range");
+                    }
+                    next = uint32_t(start) + length + 1;
+                    c.m_values.push_back(start);
+                    c.m_values.push_back(length);
+                    total += uint32_t(length) + 1;
+                }
+                if (total != card) {
+                    throw std::invalid_argument("roaring_bitmap: run cardinality mismatch");
+                }
+            } else if (card <= kArrayMax) {
+                c.m_type = kArray;
+                c.m_values.reserve(card);
+                for (uint32_t j = 0; j < card; ++j) {
+                    uint16_t v = in.u16();
+                    if (j > 0 && v <= c.m_values.back()) {
+                        throw std::invalid_argument("roaring_bitmap: array not sorted");
+                    }
+                    c.m_values.push_back(v);
+                }
+            } else {
+                c.m_type = kBitmap;
+                c.m_words.reserve(kBitmapWords);
+                for (uint32_t j = 0; j < kBitmapWords; ++j) {
+                    c.m_words.push_back(in.u64());
+                }
+                if (nostd::_bits_count(c.m_words.data(), kBitmapWords) != card) {
+                    throw std::invalid_argument("roaring_bitmap: bitmap cardinality mismatch");
+                }
+            }
+            result.m_keys.push_back(key);
+            result.m_containers.push_back(std::move(c));
+        }
+        return result;
+    }
+
+ private:
+    enum merge_op {
+        kUnion,
+        kIntersection,
+        kDifference,
+    };
+
+    static constexpr size_type npos_index = static_cast<size_type>(-1);
+
+    // 按key归并两个bitmap的容器列表
+    static roaring_bitmap merge(const roaring_bitmap &lhs, const roaring_bitmap &rhs, merge_op op) {
+        roaring_bitmap out;
+        size_type i = 0;
+        size_type j = 0;
+        const size_type n1 = lhs.m_keys.size();
+        const size_type n2 = rhs.m_keys.size();
+        while (i < n1 && j < n2) {
+            uint16_t k1 = lhs.m_keys[i];
+            uint16_t k2 = rhs.m_keys[j];
+            if (k1 < k2) {
+                if (op != kIntersection) {
+                    out.append(k1, container(lhs.m_containers[i]));
+                }
+                ++i;
+            } else if (k2 < k1) {
+                if (op == kUnion) {
+                    out.append(k2, container(rhs.m_containers[j]));
+                }
+                ++j;
+            } else {
+                if (op == kUnion) {
+                    out.append(k1, container::make_union(lhs.m_containers[i], rhs.m_containers[j]));
+                } else if (op == kIntersection) {
+                    out.append(k1, container::make_intersection(lhs.m_containers[i], rhs.m_containers[j]));
+                } else {
+                    out.append(k1, container::make_difference(lhs.m_containers[i], rhs.m_containers[j]));
+                }
+                ++i;
+                ++j;
+            }
+        }
+        if (op != kIntersection) {
+            for (; i < n1; ++i) {
+                out.append(lhs.m_keys[i], container(lhs.m_containers[i]));
+            }
+        }
+        if (op == kUnion) {
+            for (; j < n2; ++j) {
+                out.append(rhs.m_keys[j], container(rhs.m_containers[j]));
+            }
+        }
+        return out;
+    }
+
+    // 在末尾追加一个容器，空容器直接丢弃
+    void append(uint16_t key, container &&c) {
+        if (c.m_card == 0) {
+            return;
+        }
+        m_keys.push_back(key);
+        m_containers.push_back(std::move(c));
+    }
+
+    size_type find(uint16_t key) const {
+        const uint16_t *it = nostd::lower_bound(m_keys.begin(), m_keys.end(), key);
+        if (it == m_keys.end() || *it != key) {
+            return npos_index;
+        }
+        return static_cast<size_type>(it - m_keys.begin());
+    }
+
+    // 查找key对应的容器，不存在时在有序位置插入一个空容器
+    size_type find_or_insert(uint16_t key) {
+        size_type idx = nostd::lower_bound(m_keys.begin(), m_keys.end(), key) - m_keys.begin();
+        if (idx < m_keys.size() && m_keys[idx] == key) {
+            return idx;
+        }
+        m_keys.push_back(key);
+        m_containers.push_back(container());
+        for (size_type i = m_keys.size() - 1; i > idx; --i) {
+            std::swap(m_keys[i], m_keys[i - 1]);
+            m_containers[i].swap(m_containers[i - 1]);
+        }
+        return idx;
+    }
+
+    void erase_at(size_type idx) {
+        for (size_type i = idx; i + 1 < m_keys.size(); ++i) {
+            std::swap(m_keys[i], m_keys[i + 1]);
+            m_containers[i].swap(m_containers[i + 1]);
+        }
+        m_keys.pop_back();
+        m_containers.pop_back();
+    }
+
+    bool has_run_container() const {
+        for (size_type i = 0; i < m_containers.size(); ++i) {
+            if (m_containers[i].m_type == kRun) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static size_type container_bytes(const container &c) {
+        switch (c.m_type) {
+            case kArray:
+                return 2 * size_type(c.m_card);
+            case kBitmap:
+                return 8 * size_type(kBitmapWords);
+            default:
+                return 2 + 2 * c.m_values.size();
+        }
+    }
+
+    // 小端读写，不依赖本机字节序
+    static char *put_u16(char *p, uint16_t v) {
+        p[0] = static_cast<char>(v & 0xff);
+        p[1] = static_cast<char>(v >> 8);
+        return p + 2;
+    }
+    static char *put_u32(char *p, uint32_t v) {
+        return put_u16(put_u16(p, static_cast<uint16_t>(v & 0xffff)), static_cast<uint16_t>(v >> 16));
+    }
+    static char *put_u64(char *p, uint64_t v) {
+        return put_u32(put_u32(p, static_cast<uint32_t>(v & 0xffffffffu)), static_cast<uint32_t>(v >> 32));
+    }
+
+    struct reader {
+        const char *m_cur;
+        const char *m_end;
+
+        const char *skip(size_type n) {
+            if (static_cast<size_type>(m_end - m_cur) < n) {
+                throw std::invalid_argument("roaring_bitmap: truncated input");
+            }
+            const char *p = m_cur;
+            m_cur += n;
+            return p;
+        }
+        uint16_t u16() {
+            const unsigned char *p = reinterpret_cast<const unsigned char *>(skip(2));
+            return static_cast<uint16_t>(p[0] | (p[1] << 8));
+        }
+        uint32_t u32() {
+            uint32_t lo = u16();
+            return lo | (uint32_t(u16()) << 16);
+        }
+        uint64_t u64() {
+            uint64_t lo = u32();
+            return lo | (uint64_t(u32()) << 32);
+        }
+    };
+
+ private:
+    nostd::vector<uint16_t> m_keys;         // 每个容器的高16位，升序
+    nostd::vector<container> m_containers;  // 与m_keys一一对应
+};
+
+inline void swap(roaring_bitmap &x, roaring_bitmap &y) noexcept {
+    x.swap(y);
+}
+
+}  // namespace nostd
+
+#endif  // !__ROARING_BITMAP_H
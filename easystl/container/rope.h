@@ -0,0 +1,505 @@
+/*
+ * rope：由不可变、引用计数的字符块组成的平衡二叉树
+ * ref: Boehm, Atkinson & Plass, "Ropes: an Alternative to Strings"
+ *
+ * 叶子节点指向一段共享的字符缓冲区(起始指针+长度)，内部节点只记录左右子树和总长度
+ * 树按AVL的高度差约束保持平衡，concat/insert/erase/substr都由join和split组合而成，O(log n)
+ * 节点创建后不再修改，复制rope只是增加根节点的引用计数，修改时只重建从根到修改点的路径
+ *
+ * 两个相邻的小叶子在join时合并成一个不超过kLeafMax的叶子，逐字符append也不会退化成很深的树
+ * chunks()按顺序给出每个叶子的string_view，不复制字符
+ */
+#ifndef __ROPE_H
+#define __ROPE_H
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "base/char_traits.h"
+#include "base/iterator.h"
+#include "base/trace.h"
+#include "container/string.h"
+#include "container/string_view.h"
+
+namespace nostd {
+
+template <class charT, class traits = nostd::char_traits<charT>>
+class basic_rope {
+ public:
+    using traits_type = traits;
+    using value_type = charT;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using view_type = basic_string_view<charT, traits>;
+    using string_type = basic_string<charT, traits>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+ private:
+    static constexpr size_type kLeafMax = 512;  // 叶子的最大长度，同时也是长串切块的大小
+
+    struct node;
+    using node_ptr = std::shared_ptr<const node>;
+
+    struct node {
+        size_type m_size = 0;
+        int m_height = 1;  // 叶子为1
+        node_ptr m_left;   // 为空时是叶子
+        node_ptr m_right;
+        std::shared_ptr<const charT> m_chunk;  // 叶子引用的缓冲区
+        const charT *m_data = nullptr;         // 叶子内容在缓冲区中的起点
+
+        bool is_leaf() const noexcept { return m_left == nullptr; }
+    };
+
+ public:
+    // 按顺序遍历字符，每次跨叶子时从根重新定位，均摊开销很小
+    class const_iterator {
+        friend class basic_rope;
+
+     public:
+        using iterator_category = nostd::bidirectional_iterator_tag;
+        using value_type = charT;
+        using difference_type = ptrdiff_t;
+        using pointer = const charT *;
+        using reference = const charT &;
+
+        const_iterator() = default;
+
+        reference operator*() const { return m_leaf->m_data[m_pos - m_leaf_begin]; }
+        pointer operator->() const { return &**this; }
+
+        const_iterator &operator++() {
+            if (++m_pos - m_leaf_begin == m_leaf->m_size && m_pos < m_root->m_size) {
+                seek();
+            }
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        const_iterator &operator--() {
+            if (m_pos-- == m_leaf_begin || m_leaf == nullptr) {
+                seek();
+            }
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        // 在同一个rope上比较位置
+        bool operator==(const const_iterator &rhs) const noexcept { return m_pos == rhs.m_pos; }
+        bool operator!=(const const_iterator &rhs) const noexcept { return m_pos != rhs.m_pos; }
+
+        size_type index() const noexcept { return m_pos; }
+
+     private:
+        const_iterator(const node *root, size_type pos)
+            : m_root(root), m_pos(pos) {
+            if (m_root != nullptr && m_pos < m_root->m_size) {
+                seek();
+            }
+        }
+
+        void seek() { m_leaf = basic_rope::locate(m_root, m_pos, m_leaf_begin); }
+
+        const node *m_root = nullptr;
+        const node *m_leaf = nullptr;
+        size_type m_leaf_begin = 0;  // 当前叶子第一个字符的下标
+        size_type m_pos = 0;
+    };
+    using iterator = const_iterator;
+
+    // 逐个叶子遍历，解引用得到叶子内容的view
+    class chunk_iterator {
+        friend class basic_rope;
+
+     public:
+        using iterator_category = nostd::forward_iterator_tag;
+        using value_type = view_type;
+        using difference_type = ptrdiff_t;
+        using pointer = const view_type *;
+        using reference = view_type;
+
+        chunk_iterator() = default;
+
+        view_type operator*() const { return view_type(m_leaf->m_data, m_leaf->m_size); }
+
+        chunk_iterator &operator++() {
+            m_pos += m_leaf->m_size;
+            m_leaf = m_pos < m_root->m_size ? basic_rope::locate(m_root, m_pos, m_pos) : nullptr;
+            return *this;
+        }
+        chunk_iterator operator++(int) {
+            chunk_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const chunk_iterator &rhs) const noexcept { return m_leaf == rhs.m_leaf; }
+        bool operator!=(const chunk_iterator &rhs) const noexcept { return m_leaf != rhs.m_leaf; }
+
+     private:
+        explicit chunk_iterator(const node *root)
+            : m_root(root) {
+            if (m_root != nullptr && m_root->m_size > 0) {
+                m_leaf = basic_rope::locate(m_root, 0, m_pos);
+            }
+        }
+
+        const node *m_root = nullptr;
+        const node *m_leaf = nullptr;
+        size_type m_pos = 0;
+    };
+
+    class chunk_range {
+     public:
+        explicit chunk_range(const node *root)
+            : m_root(root) {}
+        chunk_iterator begin() const { return chunk_iterator(m_root); }
+        chunk_iterator end() const { return chunk_iterator(); }
+
+     private:
+        const node *m_root;
+    };
+
+ public:
+    basic_rope() = default;
+    basic_rope(const charT *s)
+        : m_root(from_chars(s, traits_type::length(s))) {}
+    basic_rope(const charT *s, size_type n)
+        : m_root(from_chars(s, n)) {}
+    explicit basic_rope(view_type sv)
+        : m_root(from_chars(sv.data(), sv.size())) {}
+    explicit basic_rope(const string_type &str)
+        : m_root(from_chars(str.data(), str.size())) {}
+
+    // 复制只共享根节点
+    basic_rope(const basic_rope &) = default;
+    basic_rope(basic_rope &&) noexcept = default;
+    basic_rope &operator=(const basic_rope &) = default;
+    basic_rope &operator=(basic_rope &&) noexcept = default;
+
+ public:  //-=========iterators
+    const_iterator begin() const { return const_iterator(m_root.get(), 0); }
+    const_iterator end() const { return const_iterator(m_root.get(), size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    chunk_range chunks() const { return chunk_range(m_root.get()); }
+
+ public:  //-=========Capacity
+    size_type size() const noexcept { return m_root ? m_root->m_size : 0; }
+    size_type length() const noexcept { return size(); }
+    bool empty() const noexcept { return size() == 0; }
+    // 树高，叶子为1，空树为0
+    int height() const noexcept { return height(m_root); }
+
+ public:  //-=========Element access
+    // O(log n)
+    charT operator[](size_type pos) const {
+        size_type begin = 0;
+        const node *leaf = locate(m_root.get(), pos, begin);
+        return leaf->m_data[pos - begin];
+    }
+    charT at(size_type pos) const {
+        if (pos >= size()) {
+            throw std::out_of_range("rope");
+        }
+        return (*this)[pos];
+    }
+
+ public:  //-=========Modifiers
+    basic_rope &append(const basic_rope &r) {
+        m_root = join(m_root, r.m_root);
+        return *this;
+    }
+    basic_rope &append(view_type sv) {
+        m_root = join(m_root, from_chars(sv.data(), sv.size()));
+        return *this;
+    }
+    basic_rope &append(const charT *s, size_type n) { return append(view_type(s, n)); }
+    basic_rope &append(const charT *s) { return append(view_type(s)); }
+    basic_rope &operator+=(const basic_rope &r) { return append(r); }
+    basic_rope &operator+=(view_type sv) { return append(sv); }
+    basic_rope &operator+=(const charT *s) { return append(s); }
+    basic_rope &operator+=(charT c) { return append(&c, 1); }
+    void push_back(charT c) { append(&c, 1); }
+
+    basic_rope &insert(size_type pos, const basic_rope &r) {
+        check_pos(pos);
+        std::pair<node_ptr, node_ptr> parts = split(m_root, pos);
+        m_root = join(join(parts.first, r.m_root), parts.second);
+        return *this;
+    }
+    basic_rope &insert(size_type pos, view_type sv) { return insert(pos, basic_rope(sv)); }
+    basic_rope &insert(size_type pos, const charT *s) { return insert(pos, basic_rope(s)); }
+
+    basic_rope &erase(size_type pos = 0, size_type len = npos) {
+        check_pos(pos);
+        size_type rest = size() - pos;
+        if (len > rest) {
+            len = rest;
+        }
+        std::pair<node_ptr, node_ptr> head = split(m_root, pos);
+        std::pair<node_ptr, node_ptr> tail = split(head.second, len);
+        m_root = join(head.first, tail.second);
+        return *this;
+    }
+
+    void clear() noexcept { m_root.reset(); }
+    void swap(basic_rope &r) noexcept { m_root.swap(r.m_root); }
+
+ public:  //-=========String operations
+    // 结果和原rope共享所有完整的叶子
+    basic_rope substr(size_type pos = 0, size_type len = npos) const {
+        check_pos(pos);
+        std::pair<node_ptr, node_ptr> head = split(m_root, pos);
+        if (len < size() - pos) {
+            head.second = split(head.second, len).first;
+        }
+        basic_rope ret;
+        ret.m_root = std::move(head.second);
+        return ret;
+    }
+
+    // 把内容复制到[s, s + min(n, size() - pos))
+    size_type copy(charT *s, size_type n, size_type pos = 0) const {
+        check_pos(pos);
+        size_type rest = size() - pos;
+        if (n > rest) {
+            n = rest;
+        }
+        size_type done = 0;
+        while (done < n) {
+            size_type begin = 0;
+            const node *leaf = locate(m_root.get(), pos + done, begin);
+            size_type off = pos + done - begin;
+            size_type len = leaf->m_size - off < n - done ? leaf->m_size - off : n - done;
+            traits_type::copy(s + done, leaf->m_data + off, len);
+            done += len;
+        }
+        return n;
+    }
+
+    string_type str() const {
+        string_type ret(size(), nostd::default_init);
+        copy(ret.data(), size());
+        return ret;
+    }
+
+    int compare(const basic_rope &r) const {
+        chunk_iterator a = chunks().begin(), b = r.chunks().begin(), last;
+        view_type va, vb;
+        while (true) {
+            if (va.empty() && a != last) {
+                va = *a++;
+            }
+            if (vb.empty() && b != last) {
+                vb = *b++;
+            }
+            if (va.empty() || vb.empty()) {
+                return va.empty() ? (vb.empty() ? 0 : -1) : 1;
+            }
+            size_type n = va.size() < vb.size() ? va.size() : vb.size();
+            int c = traits_type::compare(va.data(), vb.data(), n);
+            if (c != 0) {
+                return c;
+            }
+            va.remove_prefix(n);
+            vb.remove_prefix(n);
+        }
+    }
+
+ private:
+    static int height(const node_ptr &t) noexcept { return t ? t->m_height : 0; }
+
+    static void check_pos_of(size_type pos, size_type size) {
+        if (pos > size) {
+            throw std::out_of_range("rope");
+        }
+    }
+    void check_pos(size_type pos) const { check_pos_of(pos, size()); }
+
+    // 找到包含下标pos的叶子，begin返回叶子第一个字符的下标
+    static const node *locate(const node *t, size_type pos, size_type &begin) {
+        begin = 0;
+        while (!t->is_leaf()) {
+            size_type left = t->m_left->m_size;
+            if (pos < left) {
+                t = t->m_left.get();
+            } else {
+                pos -= left;
+                begin += left;
+                t = t->m_right.get();
+            }
+        }
+        return t;
+    }
+
+    static node_ptr make_leaf(const std::shared_ptr<const charT> &chunk, const charT *data, size_type n) {
+        if (n == 0) {
+            return node_ptr();
+        }
+        std::shared_ptr<node> t = std::make_shared<node>();
+        t->m_size = n;
+        t->m_chunk = chunk;
+        t->m_data = data;
+        return t;
+    }
+
+    static node_ptr make_concat(node_ptr l, node_ptr r) {
+        std::shared_ptr<node> t = std::make_shared<node>();
+        t->m_size = l->m_size + r->m_size;
+        t->m_height = (l->m_height > r->m_height ? l->m_height : r->m_height) + 1;
+        t->m_left = std::move(l);
+        t->m_right = std::move(r);
+        return t;
+    }
+
+    // 复制一份字符到新缓冲区，超过kLeafMax时切成共享这块缓冲区的多个叶子
+    static node_ptr from_chars(const charT *s, size_type n) {
+        if (n == 0) {
+            return node_ptr();
+        }
+        std::shared_ptr<const charT> chunk(new charT[n], std::default_delete<charT[]>());
+        traits_type::copy(const_cast<charT *>(chunk.get()), s, n);
+        return build(chunk, chunk.get(), n);
+    }
+
+    static node_ptr build(const std::shared_ptr<const charT> &chunk, const charT *data, size_type n) {
+        if (n <= kLeafMax) {
+            return make_leaf(chunk, data, n);
+        }
+        // 按块数对半分，左右子树的高度差不超过1
+        size_type blocks = (n + kLeafMax - 1) / kLeafMax;
+        size_type left = blocks / 2 * kLeafMax;
+        return make_concat(build(chunk, data, left), build(chunk, data + left, n - left));
+    }
+
+    // 左右子树高度差不超过2时，通过旋转组成一棵平衡的树
+    static node_ptr balance(node_ptr l, node_ptr r) {
+        int hl = height(l), hr = height(r);
+        if (hl > hr + 1) {
+            EASYSTL_TRACE_COUNT("rope::rotate", 1);
+            if (height(l->m_left) >= height(l->m_right)) {
+                return make_concat(l->m_left, make_concat(l->m_right, std::move(r)));
+            }
+            const node_ptr &lr = l->m_right;
+            return make_concat(make_concat(l->m_left, lr->m_left), make_concat(lr->m_right, std::move(r)));
+        }
+        if (hr > hl + 1) {
+            EASYSTL_TRACE_COUNT("rope::rotate", 1);
+            if (height(r->m_right) >= height(r->m_left)) {
+                return make_concat(make_concat(std::move(l), r->m_left), r->m_right);
+            }
+            const node_ptr &rl = r->m_left;
+            return make_concat(make_concat(std::move(l), rl->m_left), make_concat(rl->m_right, r->m_right));
+        }
+        return make_concat(std::move(l), std::move(r));
+    }
+
+    // 连接两棵树：沿较高一棵的边缘下降到高度相近的位置再挂上去，O(|hl - hr| + 1)
+    static node_ptr join(const node_ptr &l, const node_ptr &r) {
+        if (!l) {
+            return r;
+        }
+        if (!r) {
+            return l;
+        }
+        int hl = l->m_height, hr = r->m_height;
+        // 高度差即剩余的递归深度
+        EASYSTL_TRACE_VALUE("rope::join_depth", hl > hr ? hl - hr : hr - hl);
+        if (hl > hr + 1) {
+            return balance(l->m_left, join(l->m_right, r));
+        }
+        if (hr > hl + 1) {
+            return balance(join(l, r->m_left), r->m_right);
+        }
+        if (l->is_leaf() && r->is_leaf() && l->m_size + r->m_size <= kLeafMax) {
+            // 两个小叶子合并，避免碎片化
+            size_type n = l->m_size + r->m_size;
+            std::shared_ptr<const charT> chunk(new charT[n], std::default_delete<charT[]>());
+            charT *p = const_cast<charT *>(chunk.get());
+            traits_type::copy(p, l->m_data, l->m_size);
+            traits_type::copy(p + l->m_size, r->m_data, r->m_size);
+            return make_leaf(chunk, p, n);
+        }
+        return make_concat(l, r);
+    }
+
+    // 按下标pos拆成[0, pos)和[pos, size)两棵树，O(log n)
+    static std::pair<node_ptr, node_ptr> split(const node_ptr &t, size_type pos) {
+        if (!t) {
+            return std::pair<node_ptr, node_ptr>();
+        }
+        if (pos == 0) {
+            return std::make_pair(node_ptr(), t);
+        }
+        if (pos >= t->m_size) {
+            return std::make_pair(t, node_ptr());
+        }
+        if (t->is_leaf()) {
+            return std::make_pair(make_leaf(t->m_chunk, t->m_data, pos),
+                                  make_leaf(t->m_chunk, t->m_data + pos, t->m_size - pos));
+        }
+        size_type left = t->m_left->m_size;
+        if (pos == left) {
+            return std::make_pair(t->m_left, t->m_right);
+        }
+        if (pos < left) {
+            std::pair<node_ptr, node_ptr> p = split(t->m_left, pos);
+            return std::make_pair(std::move(p.first), join(p.second, t->m_right));
+        }
+        std::pair<node_ptr, node_ptr> p = split(t->m_right, pos - left);
+        return std::make_pair(join(t->m_left, p.first), std::move(p.second));
+    }
+
+ private:
+    node_ptr m_root;  // 空rope时为空
+};
+
+template <class charT, class traits>
+constexpr typename basic_rope<charT, traits>::size_type basic_rope<charT, traits>::npos;
+
+template <class charT, class traits>
+constexpr typename basic_rope<charT, traits>::size_type basic_rope<charT, traits>::kLeafMax;
+
+//-=============Non-member function overloads
+template <class charT, class traits>
+basic_rope<charT, traits> operator+(basic_rope<charT, traits> lhs, const basic_rope<charT, traits> &rhs) {
+    return std::move(lhs.append(rhs));
+}
+
+template <class charT, class traits>
+bool operator==(const basic_rope<charT, traits> &lhs, const basic_rope<charT, traits> &rhs) {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+template <class charT, class traits>
+bool operator!=(const basic_rope<charT, traits> &lhs, const basic_rope<charT, traits> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <class charT, class traits>
+bool operator<(const basic_rope<charT, traits> &lhs, const basic_rope<charT, traits> &rhs) {
+    return lhs.compare(rhs) < 0;
+}
+
+template <class charT, class traits>
+void swap(basic_rope<charT, traits> &x, basic_rope<charT, traits> &y) noexcept {
+    x.swap(y);
+}
+
+using rope = basic_rope<char>;
+using wrope = basic_rope<wchar_t>;
+
+}  // namespace nostd
+
+#endif  // !__ROPE_H
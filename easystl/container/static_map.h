@@ -0,0 +1,292 @@
+/*
+ * static_map：键集合固定的只读字符串映射(配置项名、HTTP头名、操作码表)
+ *
+ * 构造时对N个键建一个最小完美哈希(PTHash的做法)，N个键正好放进N个槽位，没有空槽也没有冲突：
+ *   1. 键的64位哈希的高32位决定它属于哪个桶，桶的数量约为N/2
+ *   2. 桶按大小从大到小处理，每个桶找一个pilot，使桶里所有键的位置 mix(hash ^ pilot) % N 都落在空槽上
+ *   3. 记下每个桶的pilot，查找时 哈希 -> 桶 -> pilot -> 槽位，只访问一个槽，再比较一次键
+ * N是模板参数，% N编译成乘法和移位
+ *
+ * C++17起可以在编译期建表(键和值都要是字面类型，编译器要支持is_constant_evaluated，见base/config.h)：
+ *   constexpr nostd::static_map<int, 3> kMethods = {{"GET", 1}, {"POST", 2}, {"PUT", 3}};
+ *   static_assert(kMethods.at("POST") == 2, "");
+ * 成员函数在C++14下已经标成constexpr，但不是所有编译器都接受C++14下的编译期建表，所以只保证C++17起可用；
+ * 更早的标准或者键来自运行期数据时，在启动时构造一次
+ *
+ * 键相同时抛出std::invalid_argument；表建好后不能修改，迭代顺序是槽位顺序，和输入顺序无关
+ * 不保存键的内容，只保存basic_string_view，键指向的字符串要比static_map活得长(字符串字面量总是满足)
+ */
+#ifndef __STATIC_MAP_H
+#define __STATIC_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#include "base/char_traits.h"
+#include "base/config.h"
+#include "base/hash.h"
+#include "container/string_view.h"
+
+namespace nostd {
+
+// 按字符读入64位的字，每个字混合一次；要能在编译期求值，所以不能像hash_bytes那样用memcpy
+template <class charT>
+struct _static_map_hash {
+    static_assert(sizeof(charT) <= 8, "static_map: character type too wide");
+    using uchar = typename std::make_unsigned<charT>::type;
+    static constexpr size_t kPerWord = 8 / sizeof(charT);
+
+    // 低位在前拼接n个字符；运行期小端机器上直接按字节读，结果和逐个字符拼接相同
+    static EASYSTL_CONSTEXPR14 uint64_t word(const charT *s, size_t n) noexcept {
+#if EASYSTL_HAS_CONSTANT_EVALUATED && (defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__))
+        if (!nostd::is_constant_evaluated() && n * sizeof(charT) >= 4) {
+            const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+            size_t bytes = n * sizeof(charT);
+            if (bytes == 8) {
+                return _hash::read64(p);
+            }
+            // 4~7个字节：前后两个可能重叠的4字节，重叠部分的值相同
+            return _hash::read32(p) | (_hash::read32(p + bytes - 4) << ((bytes - 4) * 8));
+        }
+#endif
+        uint64_t w = 0;
+        for (size_t i = 0; i < n; ++i) {
+            w |= static_cast<uint64_t>(static_cast<uchar>(s[i])) << (i * 8 * sizeof(charT));
+        }
+        return w;
+    }
+
+    static EASYSTL_CONSTEXPR14 uint64_t hash(const charT *s, size_t n, uint64_t seed) noexcept {
+        uint64_t h = seed ^ _hash::kSecret0 ^ n;
+        size_t i = 0;
+        for (; i + kPerWord <= n; i += kPerWord) {
+            h = hash_mix(word(s + i, kPerWord) ^ _hash::kSecret1, h ^ _hash::kSecret2);
+        }
+        return hash_mix(word(s + i, n - i) ^ _hash::kSecret1, h ^ _hash::kSecret2);
+    }
+};
+
+template <class T, size_t N, class charT = char, class traits = nostd::char_traits<charT>>
+class basic_static_map {
+    static_assert(N < (size_t(1) << 31), "static_map: too many keys");
+
+ public:
+    using key_type = basic_string_view<charT, traits>;
+    using mapped_type = T;
+    // 不用std::pair：pair的赋值运算符到C++20才是constexpr，编译期建表时要把元素赋值到槽位上
+    struct value_type {
+        constexpr value_type()
+            : first(), second() {}
+        constexpr value_type(key_type k, const T &v)
+            : first(k), second(v) {}
+
+        key_type first;
+        T second;
+    };
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using const_reference = const value_type &;
+    using const_pointer = const value_type *;
+    using const_iterator = const value_type *;
+    using iterator = const_iterator;
+
+ public:
+    // 元素个数必须正好是N
+    EASYSTL_CONSTEXPR14 basic_static_map(std::initializer_list<value_type> items)
+        : m_seed(0), m_pilots(), m_slots() {
+        if (items.size() != N) {
+            throw std::invalid_argument("static_map: wrong number of keys");
+        }
+        _build(items.begin());
+    }
+
+    // 元素有first、second成员(比如std::pair)，first能转换成basic_string_view
+    template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    EASYSTL_CONSTEXPR14 basic_static_map(InputIt first, InputIt last)
+        : m_seed(0), m_pilots(), m_slots() {
+        value_type items[kSlots] = {};
+        size_t n = 0;
+        for (; first != last; ++first, ++n) {
+            if (n == N) {
+                throw std::invalid_argument("static_map: wrong number of keys");
+            }
+            items[n].first = key_type((*first).first);
+            items[n].second = (*first).second;
+        }
+        if (n != N) {
+            throw std::invalid_argument("static_map: wrong number of keys");
+        }
+        _build(items);
+    }
+
+ public:  //-=========iterators
+    constexpr const_iterator begin() const noexcept { return m_slots; }
+    constexpr const_iterator end() const noexcept { return m_slots + N; }
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+    constexpr const_iterator cend() const noexcept { return end(); }
+
+ public:  //-=========Capacity
+    constexpr size_type size() const noexcept { return N; }
+    constexpr size_type max_size() const noexcept { return N; }
+    constexpr bool empty() const noexcept { return N == 0; }
+
+ public:  //-=========Lookup
+    // 一次哈希，读一个pilot，访问一个槽位，比较一次键
+    EASYSTL_CONSTEXPR14 const_iterator find(key_type key) const noexcept {
+        if (N == 0) {
+            return end();
+        }
+        uint64_t h = _hash_of(key, m_seed);
+        const value_type &e = m_slots[_slot(h, m_pilots[_bucket(h)])];
+        return e.first == key ? &e : end();
+    }
+    EASYSTL_CONSTEXPR14 bool contains(key_type key) const noexcept { return find(key) != end(); }
+    EASYSTL_CONSTEXPR14 size_type count(key_type key) const noexcept { return contains(key) ? 1 : 0; }
+    EASYSTL_CONSTEXPR14 const T &at(key_type key) const {
+        const_iterator it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("static_map");
+        }
+        return it->second;
+    }
+
+ private:
+    // 平均每个桶两个键
+    static constexpr size_t kBuckets = N / 2 + 1;
+    static constexpr size_t kSlots = N == 0 ? 1 : N;
+    // 一个seed下找不到pilot时换seed重建；N个键放进N个槽，最后几个桶平均要试O(N)次
+    static constexpr uint32_t kMaxPilot = 1u << 20;
+    static constexpr uint64_t kMaxSeeds = 64;
+
+    static EASYSTL_CONSTEXPR14 uint64_t _hash_of(key_type key, uint64_t seed) noexcept {
+        return _static_map_hash<charT>::hash(key.data(), key.size(), seed);
+    }
+    static constexpr size_t _bucket(uint64_t h) noexcept { return static_cast<size_t>((h >> 32) % kBuckets); }
+    static EASYSTL_CONSTEXPR14 size_t _slot(uint64_t h, uint32_t pilot) noexcept {
+        return static_cast<size_t>(hash_mix(h ^ pilot, _hash::kSecret1) % kSlots);
+    }
+
+    EASYSTL_CONSTEXPR14 void _build(const value_type *items) {
+        for (uint64_t attempt = 0; attempt < kMaxSeeds; ++attempt) {
+            m_seed = hash_mix(attempt + 1, _hash::kSecret0);
+            if (_try_build(items)) {
+                return;
+            }
+        }
+        throw std::runtime_error("static_map: no perfect hash found");
+    }
+
+    // 当前seed下为每个桶找pilot，成功后把元素放进槽位
+    EASYSTL_CONSTEXPR14 bool _try_build(const value_type *items) {
+        uint64_t hashes[kSlots] = {};
+        size_t sizes[kBuckets] = {};
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = _hash_of(items[i].first, m_seed);
+            ++sizes[_bucket(hashes[i])];
+        }
+
+        // 按桶分组：members[starts[b], starts[b] + sizes[b])是桶b的键
+        size_t starts[kBuckets] = {};
+        size_t max_size = 0;
+        for (size_t b = 0, pos = 0; b < kBuckets; ++b) {
+            starts[b] = pos;
+            pos += sizes[b];
+            max_size = sizes[b] > max_size ? sizes[b] : max_size;
+        }
+        size_t members[kSlots] = {};
+        size_t filled[kBuckets] = {};
+        for (size_t i = 0; i < N; ++i) {
+            size_t b = _bucket(hashes[i]);
+            members[starts[b] + filled[b]++] = i;
+        }
+
+        bool taken[kSlots] = {};
+        size_t positions[kSlots] = {};
+        for (size_t s = max_size; s > 0; --s) {
+            for (size_t b = 0; b < kBuckets; ++b) {
+                if (sizes[b] != s) {
+                    continue;
+                }
+                const size_t *keys = members + starts[b];
+                if (!_check_bucket(items, hashes, keys, s)) {
+                    return false;
+                }
+                uint32_t pilot = 0;
+                while (!_fits(hashes, keys, s, pilot, taken, positions)) {
+                    if (++pilot == kMaxPilot) {
+                        return false;
+                    }
+                }
+                for (size_t k = 0; k < s; ++k) {
+                    taken[positions[k]] = true;
+                }
+                m_pilots[b] = pilot;
+            }
+        }
+
+        for (size_t i = 0; i < N; ++i) {
+            size_t b = _bucket(hashes[i]);
+            m_slots[_slot(hashes[i], m_pilots[b])] = items[i];
+        }
+        return true;
+    }
+
+    // 同一个桶里哈希值完全相同的两个键：键也相同就是重复的键，否则只能换seed
+    static EASYSTL_CONSTEXPR14 bool _check_bucket(const value_type *items, const uint64_t *hashes, const size_t *keys,
+                                                  size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = i + 1; j < n; ++j) {
+                if (hashes[keys[i]] != hashes[keys[j]]) {
+                    continue;
+                }
+                if (items[keys[i]].first == items[keys[j]].first) {
+                    throw std::invalid_argument("static_map: duplicate key");
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 桶里的键用这个pilot时都落在空槽上，并且互不冲突；位置写到positions里
+    static EASYSTL_CONSTEXPR14 bool _fits(const uint64_t *hashes, const size_t *keys, size_t n, uint32_t pilot,
+                                          const bool *taken, size_t *positions) noexcept {
+        for (size_t k = 0; k < n; ++k) {
+            size_t p = _slot(hashes[keys[k]], pilot);
+            if (taken[p]) {
+                return false;
+            }
+            for (size_t j = 0; j < k; ++j) {
+                if (positions[j] == p) {
+                    return false;
+                }
+            }
+            positions[k] = p;
+        }
+        return true;
+    }
+
+ private:
+    uint64_t m_seed;
+    uint32_t m_pilots[kBuckets];
+    value_type m_slots[kSlots];
+};
+
+template <class T, size_t N, class charT, class traits>
+constexpr size_t basic_static_map<T, N, charT, traits>::kBuckets;
+template <class T, size_t N, class charT, class traits>
+constexpr size_t basic_static_map<T, N, charT, traits>::kSlots;
+template <class T, size_t N, class charT, class traits>
+constexpr uint32_t basic_static_map<T, N, charT, traits>::kMaxPilot;
+template <class T, size_t N, class charT, class traits>
+constexpr uint64_t basic_static_map<T, N, charT, traits>::kMaxSeeds;
+
+template <class T, size_t N>
+using static_map = basic_static_map<T, N, char>;
+
+}  // namespace nostd
+
+#endif  // !__STATIC_MAP_H
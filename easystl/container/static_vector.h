@@ -0,0 +1,563 @@
+/*
+ * https://en.cppreference.com/w/cpp/container/inplace_vector
+ *
+ * static_vector<T, N>：容量固定为N，元素存放在对象内部，从不申请堆内存
+ * 接口和nostd::vector一致，超出容量时抛std::length_error；try_push_back/try_emplace_back满了返回nullptr
+ * 适合"最多64个header"、"最多重试16次"这类有上限的缓冲区，没有small-buffer vector溢出到堆上的检查
+ *
+ * T是平凡类型(可平凡复制、可平凡默认构造)时直接存T[N]：
+ *  - static_vector本身也可平凡复制，复制时整块复制N个元素
+ *  - C++14起除反向迭代器外的操作都可以在编译期求值。C++14/17的constexpr构造函数必须初始化所有成员，
+ *    构造时会把N个元素清零；C++20起只在编译期求值时清零；C++11不清零
+ * 其余类型存未初始化的缓冲区，元素用uninitialized_*构造，析构时逐个析构
+ */
+#ifndef __STATIC_VECTOR_H
+#define __STATIC_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "algo/algorithm.h"
+#include "base/config.h"
+#include "base/construct.h"
+#include "base/iterator.h"
+#include "base/memory.h"
+
+namespace nostd {
+
+// 能放下[0, N]的最小无符号类型，static_vector<T, 64>的长度只占一个字节
+template <size_t N>
+using _static_vector_size_t = typename std::conditional<
+    N <= UINT8_MAX, uint8_t,
+    typename std::conditional<N <= UINT16_MAX, uint16_t,
+                              typename std::conditional<N <= UINT32_MAX, uint32_t, size_t>::type>::type>::type;
+
+// 直接存T[N]的条件：构造可以用赋值代替，析构什么都不做
+template <class T>
+struct _is_static_vector_trivial
+    : std::integral_constant<bool, std::is_trivial<T>::value && std::is_copy_assignable<T>::value &&
+                                       std::is_move_assignable<T>::value> {};
+
+template <class T, size_t N, bool = _is_static_vector_trivial<T>::value>
+class _static_vector_base;
+
+// 平凡类型：复制、移动、析构都由编译器生成，static_vector也就可平凡复制
+template <class T, size_t N>
+class _static_vector_base<T, N, true> {
+ protected:
+#if EASYSTL_CPLUSPLUS >= 201402L && EASYSTL_CPLUSPLUS < 202002L
+    constexpr _static_vector_base() noexcept
+        : m_data(), m_size(0) {}
+#else
+    EASYSTL_CONSTEXPR20 _static_vector_base() noexcept
+        : m_size(0) {
+        // 编译期求值时不能读未初始化的元素(整体复制时会读到)
+        if (nostd::is_constant_evaluated()) {
+            nostd::fill_n(m_data, N, T());
+        }
+    }
+#endif
+
+    EASYSTL_CONSTEXPR14 T *_data() noexcept { return m_data; }
+    constexpr const T *_data() const noexcept { return m_data; }
+
+    using _stored_size = _static_vector_size_t<N>;
+
+    T m_data[N == 0 ? 1 : N];
+    _stored_size m_size;
+};
+
+// 其余类型：未初始化的缓冲区，复制、移动、析构逐个元素进行
+template <class T, size_t N>
+class _static_vector_base<T, N, false> {
+ protected:
+    _static_vector_base() noexcept
+        : m_size(0) {}
+
+    _static_vector_base(const _static_vector_base &rhs)
+        : m_size(0) {
+        nostd::uninitialized_copy(rhs._data(), rhs._data() + rhs.m_size, _data());
+        m_size = rhs.m_size;
+    }
+
+    // 逐个移动构造，rhs留下同样个数的被移动过的元素
+    _static_vector_base(_static_vector_base &&rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : m_size(0) {
+        nostd::uninitialized_move(rhs._data(), rhs._data() + rhs.m_size, _data());
+        m_size = rhs.m_size;
+    }
+
+    _static_vector_base &operator=(const _static_vector_base &rhs) {
+        if (this != &rhs) {
+            T *p = _data();
+            const T *src = rhs._data();
+            if (rhs.m_size <= m_size) {
+                nostd::copy(src, src + rhs.m_size, p);
+                nostd::destroy(p + rhs.m_size, p + m_size);
+            } else {
+                nostd::copy(src, src + m_size, p);
+                nostd::uninitialized_copy(src + m_size, src + rhs.m_size, p + m_size);
+            }
+            m_size = rhs.m_size;
+        }
+        return *this;
+    }
+
+    _static_vector_base &operator=(_static_vector_base &&rhs) noexcept(std::is_nothrow_move_assignable<T>::value &&
+                                                                       std::is_nothrow_move_constructible<T>::value) {
+        if (this != &rhs) {
+            T *p = _data();
+            T *src = rhs._data();
+            if (rhs.m_size <= m_size) {
+                nostd::move(src, src + rhs.m_size, p);
+                nostd::destroy(p + rhs.m_size, p + m_size);
+            } else {
+                nostd::move(src, src + m_size, p);
+                nostd::uninitialized_move(src + m_size, src + rhs.m_size, p + m_size);
+            }
+            m_size = rhs.m_size;
+        }
+        return *this;
+    }
+
+    ~_static_vector_base() { nostd::destroy(_data(), _data() + m_size); }
+
+    T *_data() noexcept { return reinterpret_cast<T *>(m_buf); }
+    const T *_data() const noexcept { return reinterpret_cast<const T *>(m_buf); }
+
+    using _stored_size = _static_vector_size_t<N>;
+
+    alignas(T) unsigned char m_buf[sizeof(T) * (N == 0 ? 1 : N)];
+    _stored_size m_size;
+};
+
+template <class T, size_t N>
+class static_vector : private _static_vector_base<T, N> {
+    using base = _static_vector_base<T, N>;
+    using base::m_size;
+
+ public:  //-=========member types
+    using value_type = T;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using iterator = value_type *;
+    using const_iterator = const value_type *;
+    using reverse_iterator = nostd::reverse_iterator<iterator>;
+    using const_reverse_iterator = nostd::reverse_iterator<const_iterator>;
+    using difference_type = ptrdiff_t;
+    using size_type = size_t;
+
+ public:
+    //-=========constructor、operator=
+    // 复制、移动、析构由base决定：平凡类型是编译器生成的平凡版本
+    static_vector() = default;
+
+    EASYSTL_CONSTEXPR14 explicit static_vector(size_type n) {
+        _check_size(n);
+        nostd::uninitialized_value_construct_n(data(), n);
+        _set_size(n);
+    }
+
+    // n个默认初始化的元素：平凡类型不清零
+    EASYSTL_CONSTEXPR14 static_vector(size_type n, default_init_t) {
+        _check_size(n);
+        nostd::uninitialized_default_construct_n(data(), n);
+        _set_size(n);
+    }
+
+    EASYSTL_CONSTEXPR14 static_vector(size_type n, const value_type &val) {
+        _check_size(n);
+        nostd::uninitialized_fill_n(data(), n, val);
+        _set_size(n);
+    }
+
+    template <typename iter_t, typename std::enable_if<!std::is_integral<iter_t>::value>::type * = nullptr>
+    EASYSTL_CONSTEXPR14 static_vector(iter_t first, iter_t last) {
+        append_range(first, last);
+    }
+
+    EASYSTL_CONSTEXPR14 static_vector(std::initializer_list<value_type> il) {
+        append_range(il.begin(), il.end());
+    }
+
+    EASYSTL_CONSTEXPR14 static_vector &operator=(std::initializer_list<value_type> il) {
+        assign(il.begin(), il.end());
+        return *this;
+    }
+
+ public:  // -=========iterators
+    EASYSTL_CONSTEXPR14 iterator begin() noexcept { return data(); }
+    EASYSTL_CONSTEXPR14 const_iterator begin() const noexcept { return data(); }
+    EASYSTL_CONSTEXPR14 iterator end() noexcept { return data() + m_size; }
+    EASYSTL_CONSTEXPR14 const_iterator end() const noexcept { return data() + m_size; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    EASYSTL_CONSTEXPR14 const_iterator cbegin() const noexcept { return begin(); }
+    EASYSTL_CONSTEXPR14 const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+ public:  //-=========Capacity
+    EASYSTL_CONSTEXPR14 size_type size() const noexcept { return m_size; }
+    static constexpr size_type max_size() noexcept { return N; }
+    static constexpr size_type capacity() noexcept { return N; }
+    EASYSTL_CONSTEXPR14 bool empty() const noexcept { return m_size == 0; }
+    EASYSTL_CONSTEXPR14 bool full() const noexcept { return m_size == N; }
+
+    // 容量是固定的，只检查n不超过N
+    EASYSTL_CONSTEXPR14 void reserve(size_type n) { _check_size(n); }
+    EASYSTL_CONSTEXPR14 void shrink_to_fit() noexcept {}
+
+    EASYSTL_CONSTEXPR14 void resize(size_type n) {
+        _check_size(n);
+        if (n < size()) {
+            nostd::destroy(begin() + n, end());
+        } else {
+            nostd::uninitialized_value_construct_n(end(), n - size());
+        }
+        _set_size(n);
+    }
+    EASYSTL_CONSTEXPR14 void resize(size_type n, const value_type &val) {
+        _check_size(n);
+        if (n < size()) {
+            nostd::destroy(begin() + n, end());
+        } else {
+            nostd::uninitialized_fill_n(end(), n - size(), val);  // 已有元素不动，val是自己的元素也没关系
+        }
+        _set_size(n);
+    }
+    // 同resize(n)，但新增元素只做默认初始化
+    EASYSTL_CONSTEXPR14 void resize_default_init(size_type n) {
+        _check_size(n);
+        if (n < size()) {
+            nostd::destroy(begin() + n, end());
+        } else {
+            nostd::uninitialized_default_construct_n(end(), n - size());
+        }
+        _set_size(n);
+    }
+
+ public:  //-=========Element access
+    EASYSTL_CONSTEXPR14 reference operator[](size_type n) { return data()[n]; }
+    EASYSTL_CONSTEXPR14 const_reference operator[](size_type n) const { return data()[n]; }
+    EASYSTL_CONSTEXPR14 reference at(size_type n) {
+        if (n >= size()) {
+            throw std::out_of_range("static_vector");
+        }
+        return data()[n];
+    }
+    EASYSTL_CONSTEXPR14 const_reference at(size_type n) const {
+        if (n >= size()) {
+            throw std::out_of_range("static_vector");
+        }
+        return data()[n];
+    }
+    EASYSTL_CONSTEXPR14 reference front() { return data()[0]; }
+    EASYSTL_CONSTEXPR14 const_reference front() const { return data()[0]; }
+    EASYSTL_CONSTEXPR14 reference back() { return data()[m_size - 1]; }
+    EASYSTL_CONSTEXPR14 const_reference back() const { return data()[m_size - 1]; }
+    EASYSTL_CONSTEXPR14 value_type *data() noexcept { return this->_data(); }
+    EASYSTL_CONSTEXPR14 const value_type *data() const noexcept { return this->_data(); }
+
+ public:  //-=========Modifiers
+    EASYSTL_CONSTEXPR14 void assign(size_type n, const value_type &val) {
+        _check_size(n);
+        value_type tmp(val);  // val可能是自己的元素
+        clear();
+        nostd::uninitialized_fill_n(data(), n, tmp);
+        _set_size(n);
+    }
+    template <class InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type * = nullptr>
+    EASYSTL_CONSTEXPR14 void assign(InputIterator first, InputIterator last) {
+        clear();
+        append_range(first, last);
+    }
+    EASYSTL_CONSTEXPR14 void assign(std::initializer_list<value_type> il) {
+        assign(il.begin(), il.end());
+    }
+
+    EASYSTL_CONSTEXPR14 void push_back(const value_type &val) { emplace_back(val); }
+    EASYSTL_CONSTEXPR14 void push_back(value_type &&val) { emplace_back(std::move(val)); }
+
+    // 满了抛std::length_error
+    template <class... Args>
+    EASYSTL_CONSTEXPR14 reference emplace_back(Args &&...args) {
+        if (full()) {
+            throw std::length_error("static_vector");
+        }
+        return *_unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+
+    // 满了返回nullptr，不抛异常
+    template <class... Args>
+    EASYSTL_CONSTEXPR14 pointer try_emplace_back(Args &&...args) {
+        return full() ? nullptr : _unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+    EASYSTL_CONSTEXPR14 pointer try_push_back(const value_type &val) { return try_emplace_back(val); }
+    EASYSTL_CONSTEXPR14 pointer try_push_back(value_type &&val) { return try_emplace_back(std::move(val)); }
+
+    EASYSTL_CONSTEXPR14 void pop_back() {
+        --m_size;
+        nostd::destroy(data() + m_size);
+    }
+
+    EASYSTL_CONSTEXPR14 iterator insert(const_iterator position, const value_type &val) {
+        if (position == cend()) {
+            emplace_back(val);
+            return end() - 1;
+        }
+        value_type tmp(val);  // 开出空位时val可能被移走
+        return _insert_gap(position, 1, _move_one{&tmp});
+    }
+    EASYSTL_CONSTEXPR14 iterator insert(const_iterator position, value_type &&val) {
+        if (position == cend()) {
+            emplace_back(std::move(val));
+            return end() - 1;
+        }
+        return _insert_gap(position, 1, _move_one{&val});
+    }
+    EASYSTL_CONSTEXPR14 iterator insert(const_iterator position, size_type n, const value_type &val) {
+        value_type tmp(val);
+        return _insert_gap(position, n, _fill_value{n, &tmp});
+    }
+    template <class InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type * = nullptr>
+    EASYSTL_CONSTEXPR14 iterator insert(const_iterator position, InputIterator first, InputIterator last) {
+        return insert_range(position, first, last);
+    }
+    EASYSTL_CONSTEXPR14 iterator insert(const_iterator position, std::initializer_list<value_type> il) {
+        return insert_range(position, il.begin(), il.end());
+    }
+
+    template <class... Args>
+    EASYSTL_CONSTEXPR14 iterator emplace(const_iterator position, Args &&...args) {
+        if (position == cend()) {
+            emplace_back(std::forward<Args>(args)...);
+            return end() - 1;
+        }
+        value_type tmp(std::forward<Args>(args)...);
+        return _insert_gap(position, 1, _move_one{&tmp});
+    }
+
+    EASYSTL_CONSTEXPR14 iterator erase(const_iterator position) { return erase(position, position + 1); }
+    EASYSTL_CONSTEXPR14 iterator erase(const_iterator first, const_iterator last) {
+        iterator f = begin() + (first - cbegin());
+        if (first != last) {
+            iterator new_end = nostd::move(begin() + (last - cbegin()), end(), f);
+            nostd::destroy(new_end, end());
+            _set_size(static_cast<size_type>(new_end - begin()));
+        }
+        return f;
+    }
+
+    // 公共部分逐个交换，长的一边多出来的元素移动过去
+    EASYSTL_CONSTEXPR14 void swap(static_vector &other) {
+        static_vector *shorter = this;
+        static_vector *longer = &other;
+        if (shorter->size() > longer->size()) {
+            shorter = &other;
+            longer = this;
+        }
+        const size_type n = shorter->size();
+        const size_type m = longer->size();
+        nostd::swap_ranges(shorter->begin(), shorter->end(), longer->begin());
+        nostd::uninitialized_move(longer->begin() + n, longer->end(), shorter->end());
+        nostd::destroy(longer->begin() + n, longer->end());
+        shorter->_set_size(m);
+        longer->_set_size(n);
+    }
+
+    EASYSTL_CONSTEXPR14 void clear() noexcept {
+        nostd::destroy(begin(), end());
+        m_size = 0;
+    }
+
+    // 前向迭代器先求出个数，一次检查容量后整段构造；单趟的输入迭代器逐个追加
+    template <class InputIterator>
+    EASYSTL_CONSTEXPR14 void append_range(InputIterator first, InputIterator last) {
+        _append_range(first, last, nostd::iterator_category_t<InputIterator>());
+    }
+    template <class Range>
+    EASYSTL_CONSTEXPR14 void append_range(Range &&rg) {
+        append_range(std::begin(rg), std::end(rg));
+    }
+    template <class InputIterator>
+    EASYSTL_CONSTEXPR14 iterator insert_range(const_iterator position, InputIterator first, InputIterator last) {
+        return _insert_range(position, first, last, nostd::iterator_category_t<InputIterator>());
+    }
+    template <class Range>
+    EASYSTL_CONSTEXPR14 iterator insert_range(const_iterator position, Range &&rg) {
+        return insert_range(position, std::begin(rg), std::end(rg));
+    }
+
+ private:
+    using _trivial = std::integral_constant<bool, _is_static_vector_trivial<T>::value>;
+
+    static EASYSTL_CONSTEXPR14 void _check_size(size_type n) {
+        if (n > N) {
+            throw std::length_error("static_vector");
+        }
+    }
+    EASYSTL_CONSTEXPR14 void _set_size(size_type n) noexcept { m_size = static_cast<typename base::_stored_size>(n); }
+
+    template <class... Args>
+    EASYSTL_CONSTEXPR14 pointer _unchecked_emplace_back(Args &&...args) {
+        pointer p = data() + m_size;
+        _construct_at(p, _trivial(), std::forward<Args>(args)...);
+        ++m_size;
+        return p;
+    }
+
+    // 平凡类型用赋值代替构造，编译期也能用
+    template <class... Args>
+    static EASYSTL_CONSTEXPR14 void _construct_at(pointer p, std::true_type, Args &&...args) {
+        *p = value_type(std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    static void _construct_at(pointer p, std::false_type, Args &&...args) {
+        nostd::construct(p, std::forward<Args>(args)...);
+    }
+
+    // 在空位上构造新元素的函数对象。C++17之前lambda不能在常量表达式里调用，所以不用lambda
+    struct _move_one {
+        pointer value;
+        EASYSTL_CONSTEXPR14 void operator()(pointer p) const { nostd::uninitialized_move_n(value, 1, p); }
+    };
+    struct _fill_value {
+        size_type n;
+        const_pointer value;
+        EASYSTL_CONSTEXPR14 void operator()(pointer p) const { nostd::uninitialized_fill_n(p, n, *value); }
+    };
+    template <class ForwardIterator>
+    struct _copy_range {
+        ForwardIterator first;
+        ForwardIterator last;
+        EASYSTL_CONSTEXPR14 void operator()(pointer p) const { nostd::uninitialized_copy(first, last, p); }
+    };
+
+    template <class InputIterator>
+    EASYSTL_CONSTEXPR14 void _append_range(InputIterator first, InputIterator last, nostd::input_iterator_tag) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+    template <class ForwardIterator>
+    EASYSTL_CONSTEXPR14 void _append_range(ForwardIterator first, ForwardIterator last, nostd::forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(nostd::distance(first, last));
+        _check_size(size() + n);
+        nostd::uninitialized_copy(first, last, end());
+        _set_size(size() + n);
+    }
+
+    // 先追加到末尾再转到position，原有元素不受迭代器中途抛异常的影响
+    template <class InputIterator>
+    iterator _insert_range(const_iterator position, InputIterator first, InputIterator last, nostd::input_iterator_tag) {
+        const size_type off = static_cast<size_type>(position - cbegin());
+        const size_type old_size = size();
+        _append_range(first, last, nostd::input_iterator_tag());
+        std::rotate(begin() + off, begin() + old_size, end());
+        return begin() + off;
+    }
+    template <class ForwardIterator>
+    EASYSTL_CONSTEXPR14 iterator _insert_range(const_iterator position, ForwardIterator first, ForwardIterator last,
+                                               nostd::forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(nostd::distance(first, last));
+        return _insert_gap(position, n, _copy_range<ForwardIterator>{first, last});
+    }
+
+    // [position, end)后移n个位置，在空出来的位置上调用construct
+    template <class F>
+    EASYSTL_CONSTEXPR14 iterator _insert_gap(const_iterator position, size_type n, F construct) {
+        iterator pos = begin() + (position - cbegin());
+        if (n == 0) {
+            return pos;
+        }
+        _check_size(size() + n);
+        _fill_gap(pos, n, construct, _trivial());
+        _set_size(size() + n);
+        return pos;
+    }
+
+    // 平凡类型整段后移(运行期是memmove)，构造新元素不会抛异常
+    template <class F>
+    EASYSTL_CONSTEXPR14 void _fill_gap(iterator pos, size_type n, F &construct, std::true_type) {
+        nostd::move_backward(pos, end(), end() + n);
+        construct(pos);
+    }
+    // 构造失败时把后移的元素移回来，容器保持原样
+    template <class F>
+    void _fill_gap(iterator pos, size_type n, F &construct, std::false_type) {
+        iterator last = end();
+        const size_type after = static_cast<size_type>(last - pos);
+        if (after > n) {
+            nostd::uninitialized_move(last - n, last, last);
+            nostd::move_backward(pos, last - n, last);
+            nostd::destroy(pos, pos + n);
+        } else {
+            nostd::uninitialized_move(pos, last, pos + n);
+            nostd::destroy(pos, last);
+        }
+        try {
+            construct(pos);
+        } catch (...) {
+            for (iterator src = pos + n, dst = pos; src != last + n; ++src, ++dst) {
+                nostd::construct(dst, std::move(*src));
+                nostd::destroy(src);
+            }
+            throw;
+        }
+    }
+};
+
+// 元素存放在对象内部，没有指向自身的指针，元素可以按字节搬动时整个static_vector也可以
+template <class T, size_t N>
+struct is_trivially_relocatable<static_vector<T, N>> : is_trivially_relocatable<T> {};
+
+//-=============Non-member function overloads
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator==(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    return lhs.size() == rhs.size() && nostd::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator!=(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator<(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    return nostd::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator>(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    return rhs < lhs;
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator<=(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 bool operator>=(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    return !(lhs < rhs);
+}
+
+template <class T, size_t N>
+EASYSTL_CONSTEXPR14 void swap(static_vector<T, N> &x, static_vector<T, N> &y) {
+    x.swap(y);
+}
+
+}  // namespace nostd
+
+#endif  // !__STATIC_VECTOR_H
@@ -1,181 +1,28 @@
 #ifndef __BASIC_STRING_H
 #define __BASIC_STRING_H
 
+#include <algorithm>
 #include <cstddef>
-#include <cstdint>
-#include <cstdio>  // For EOF.
-#include <cstring>
-#include <cwchar>
-#include <ios>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include "base/allocator.h"
+#include "base/char_traits.h"
+#include "base/charconv.h"
 #include "base/iterator.h"
+#include "base/memory.h"
+#include "base/trace.h"
+#include "base/utf.h"
+#include "container/string_view.h"
 
 namespace nostd {
 
 // https://github.com/dwdwdw/stl/blob/master/llvm/include/string
 
-template <class CharType, class IntType>
-class char_traits_base {
- public:
-    using char_type = CharType;       // char_type:The template parameter (charT)
-    using int_type = IntType;         // int_type: Integral type that can represent all charT values, as well as eof()
-    using off_type = std::streamoff;  // off_type: A type that behaves like streamoff
-    using pos_type = std::streampos;  // pos_type: A type that behaves like streampos
-    using state_type = mbstate_t;     // state_type: Multibyte transformation state type, such as mbstate_t
- public:
-    // 字符比较
-    static bool eq(const char_type &c1, const char_type &c2) noexcept {
-        return c1 == c2;
-    }
-
-    // 字符大小比较
-    static bool lt(const char_type &c1, const char_type &c2) noexcept {
-        return c1 < c2;
-    }
-
-    // 字串长度
-    static size_t length(const char_type *s) noexcept {
-        const char_type __nullchar = char_type(0);  // char()就是'\0'
-        size_t len;
-        for (; !eq(*s, __nullchar); ++s) {
-            ++len;
-        }
-        return len;
-    }
-
-    // 字符赋值
-    static void assign(char_type &c1, const char_type &c2) noexcept { c1 = c2; }
-    // 字符串赋值
-    static char_type *assign(char_type *s, size_t n, char_type c) noexcept {
-        for (size_t i = 0; i < n; ++i)
-            s[i] = c;
-        return s;
-    }
-
-    // 字串比较
-    static int compare(const char_type *s1, const char_type *s2, size_t n) noexcept {
-        for (size_t i = 0; i < n; ++i)
-            if (!eq(s1[i], s2[i]))
-                return s1[i] < s2[i] ? -1 : 1;
-        return 0;
-    }
-
-    // 在串中查找字符
-    static const char_type *find(const char_type *s, size_t n, const char_type &c) noexcept {
-        for (; n > 0; ++s, --n)
-            if (eq(*s, c))
-                return s;
-        return 0;
-    }
-
-    // 字符串移到另一字符串
-    static char_type *move(char_type *__s1, const char_type *__s2, size_t __n) noexcept {
-        char_type *__r = __s1;
-        if (__s1 < __s2) {
-            for (; __n; --__n, ++__s1, ++__s2)
-                assign(*__s1, *__s2);
-        } else if (__s2 < __s1) {
-            // 防止内存重叠导致覆盖
-            __s1 += __n;
-            __s2 += __n;
-            for (; __n; --__n)
-                assign(*--__s1, *--__s2);
-        }
-        return __r;
-    }
-
-    // 拷贝一字符串到另字符串
-    static char_type *copy(char_type *__s1, const char_type *__s2, size_t __n) noexcept {
-        static_assert(__s2 < __s1 || __s2 >= __s1 + __n, "char_traits::copy overlapped range");
-        char_type *__r = __s1;
-        for (; __n; --__n, ++__s1, ++__s2)
-            assign(*__s1, *__s2);
-        return __r;
-    }
-
-    // 返回结束整型值
-    static int_type eof() noexcept {
-        return int_type(EOF);
-    }
-
-    // 判断是否为结束符
-    static int_type not_eof(int_type c) noexcept {
-        return eq_int_type(c, eof()) ? ~eof() : c;
-    }
-
-    // int到char类型的转换
-    static char_type to_char_type(int_type c) noexcept {
-        return static_cast<char_type>(c);
-    }
-
-    // char到int类型的转换
-    static int_type to_int_type(char_type c) noexcept {
-        return static_cast<int_type>(c);
-    }
-
-    // 判断俩int类型是否相等
-    static bool eq_int_type(int_type c1, int_type c2) noexcept {
-        return c1 == c2;
-    }
-};
-
-// 灵活性：可以实现对不同的字符类型定制化字符特征
-template <class _CharT>
-class char_traits : public char_traits_base<_CharT, int> {};
-
-// Specialization for char.
-template <>
-class char_traits<char> : public char_traits_base<char, int> {
- public:
-    static char_type to_char_type(const int_type &c) {
-        return static_cast<char_type>(static_cast<unsigned char>(c));
-    }
-    static int_type to_int_type(const char_type &c) {
-        return static_cast<unsigned char>(c);
-    }
-    static int compare(const char *s1, const char *s2, size_t n) {
-        return memcmp(s1, s2, n);
-    }
-    static size_t length(const char *s) { return strlen(s); }
-    static void assign(char &c1, const char &c2) { c1 = c2; }
-    static char *assign(char *s, size_t n, char c) {
-        memset(s, c, n);
-        return s;
-    }
-};
-
-// Specialization for wchar_t.
-template <>
-class char_traits<wchar_t> : public char_traits_base<wchar_t, wint_t> {
- public:
-    static wchar_t to_char_type(const int_type &c) { return static_cast<wchar_t>(c); }
-    static int_type to_int_type(const wchar_t &c) { return static_cast<int_type>(c); }
-    static int compare(const wchar_t *s1, const wchar_t *s2, size_t n) {
-        return wmemcmp(s1, s2, n);
-    }
-    static size_t length(const wchar_t *s) { return wcslen(s); }
-    static void assign(wchar_t &c1, const wchar_t &c2) { c1 = c2; }
-    static wchar_t *assign(wchar_t *s, size_t n, wchar_t c) {
-        wmemset(s, c, n);
-        return s;
-    }
-};
-
-// Specialization for char16_t.
-template <>
-class char_traits<char16_t> : public char_traits_base<char16_t, uint_least16_t> {
- public:
-    using pos_type = std::u16streampos;
-};
-
-// Specialization for char32_t.
-template <>
-class char_traits<char32_t> : public char_traits_base<char, uint_least32_t> {
- public:
-    using pos_type = std::u32streampos;
-};
-
 template <class charT, class traits = nostd::char_traits<charT>, class Alloc = nostd::allocator<charT>>
 class basic_string {
  public:
@@ -192,6 +39,7 @@ class basic_string {
     using const_iterator = const value_type *;
     using reverse_iterator = nostd::reverse_iterator<iterator>;
     using const_reverse_iterator = nostd::reverse_iterator<const_iterator>;
+    using view_type = basic_string_view<charT, traits>;
 
     allocator_type get_allocator() { return allocator_type(); }
 
@@ -207,9 +55,12 @@ class basic_string {
     basic_string(const charT *s, const allocator_type &alloc = allocator_type());
     basic_string(const charT *s, size_type n, const allocator_type &alloc = allocator_type());
     basic_string(size_type n, charT c, const allocator_type &alloc = allocator_type());
-    template <class InputIterator>
+    // 长度为n，内容不初始化，随后用data()整体写入
+    basic_string(size_type n, default_init_t, const allocator_type &alloc = allocator_type());
+    template <class InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type * = nullptr>
     basic_string(InputIterator first, InputIterator last, const allocator_type &alloc = allocator_type());
     basic_string(std::initializer_list<charT> il, const allocator_type &alloc = allocator_type());
+    explicit basic_string(view_type sv, const allocator_type &alloc = allocator_type());
     basic_string(basic_string &&str) noexcept;
     basic_string(basic_string &&str, const allocator_type &alloc);
 
@@ -221,25 +72,938 @@ class basic_string {
     basic_string &operator=(std::initializer_list<charT> il);
     basic_string &operator=(basic_string &&str) noexcept;
 
+ public:  //-=========iterators
+    iterator begin() noexcept { return data(); }
+    const_iterator begin() const noexcept { return data(); }
+    iterator end() noexcept { return data() + m_size; }
+    const_iterator end() const noexcept { return data() + m_size; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+ public:  //-=========Capacity
+    size_type size() const noexcept { return m_size; }
+    size_type length() const noexcept { return m_size; }
+    size_type max_size() const noexcept { return std::numeric_limits<size_type>::max() / sizeof(charT) - 1; }
+    size_type capacity() const noexcept { return m_cap; }
+    bool empty() const noexcept { return m_size == 0; }
+    void resize(size_type n);
+    void resize(size_type n, charT c);
+    void reserve(size_type n);
+    void shrink_to_fit();
+    void clear() noexcept;
+
+    // 把长度调整为n后调用op(data(), n)，op在[0, n)上写入内容并返回最终长度r(r <= n)
+    // 前size()个字符保留原内容，其余位置不初始化，适合直接在string上解码/读文件
+    template <class Operation>
+    void resize_and_overwrite(size_type n, Operation op);
+
+ public:  //-=========Element access
+    // 没有申请过内存时m_buffer为空，s[size()]/front()要经过data()拿到结尾的'\0'
+    reference operator[](size_type pos) { return data()[pos]; }
+    const_reference operator[](size_type pos) const { return data()[pos]; }
+    reference at(size_type pos);
+    const_reference at(size_type pos) const;
+    reference front() { return data()[0]; }
+    const_reference front() const { return data()[0]; }
+    reference back() { return m_buffer[m_size - 1]; }
+    const_reference back() const { return m_buffer[m_size - 1]; }
+    // 没有申请过内存时指向一个静态的空串，保证c_str()总是以'\0'结尾
+    charT *data() noexcept { return m_buffer != nullptr ? m_buffer : _empty(); }
+    const charT *data() const noexcept { return m_buffer != nullptr ? m_buffer : _empty(); }
+    const charT *c_str() const noexcept { return data(); }
+    operator view_type() const noexcept { return view_type(data(), m_size); }
+
+ public:  //-=========Modifiers
+    basic_string &append(const basic_string &str) { return append(str.data(), str.size()); }
+    basic_string &append(const basic_string &str, size_type pos, size_type len = npos);
+    basic_string &append(const charT *s, size_type n);
+    basic_string &append(const charT *s) { return append(s, traits_type::length(s)); }
+    basic_string &append(size_type n, charT c);
+    template <class InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type * = nullptr>
+    basic_string &append(InputIterator first, InputIterator last);
+    basic_string &append(std::initializer_list<charT> il) { return append(il.begin(), il.size()); }
+    basic_string &append(view_type sv) { return append(sv.data(), sv.size()); }
+    // 前向迭代器先量出长度，最多分配一次再整体写入；单趟的输入迭代器填满剩余容量后按2倍扩容继续填
+    template <class Range>
+    basic_string &append_range(Range &&rg) {
+        return append(std::begin(rg), std::end(rg));
+    }
+
+    basic_string &operator+=(const basic_string &str) { return append(str); }
+    basic_string &operator+=(const charT *s) { return append(s); }
+    basic_string &operator+=(charT c) {
+        push_back(c);
+        return *this;
+    }
+    basic_string &operator+=(std::initializer_list<charT> il) { return append(il); }
+    basic_string &operator+=(view_type sv) { return append(sv); }
+
+    basic_string &assign(const basic_string &str) { return assign(str.data(), str.size()); }
+    basic_string &assign(const charT *s, size_type n);
+    basic_string &assign(const charT *s) { return assign(s, traits_type::length(s)); }
+    basic_string &assign(size_type n, charT c);
+    basic_string &assign(view_type sv) { return assign(sv.data(), sv.size()); }
+
+    basic_string &insert(size_type pos, const charT *s, size_type n);
+    basic_string &insert(size_type pos, const charT *s) { return insert(pos, s, traits_type::length(s)); }
+    basic_string &insert(size_type pos, const basic_string &str) { return insert(pos, str.data(), str.size()); }
+    basic_string &insert(size_type pos, size_type n, charT c);
+    template <class InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type * = nullptr>
+    iterator insert(const_iterator p, InputIterator first, InputIterator last);
+    template <class Range>
+    iterator insert_range(const_iterator p, Range &&rg) {
+        return insert(p, std::begin(rg), std::end(rg));
+    }
+    basic_string &erase(size_type pos = 0, size_type len = npos);
+
+    void push_back(charT c);
+    void pop_back() { m_buffer[--m_size] = charT(); }
+    void swap(basic_string &str) noexcept;
+
+ public:  //-=========String operations
+    basic_string substr(size_type pos = 0, size_type len = npos) const { return basic_string(*this, pos, len); }
+    size_type copy(charT *s, size_type len, size_type pos = 0) const;
+    int compare(const basic_string &str) const noexcept { return _compare(data(), m_size, str.data(), str.size()); }
+    int compare(const charT *s) const { return _compare(data(), m_size, s, traits_type::length(s)); }
+    int compare(size_type pos, size_type len, const basic_string &str) const;
+    int compare(view_type sv) const noexcept { return _compare(data(), m_size, sv.data(), sv.size()); }
+
+    bool starts_with(view_type sv) const noexcept { return view_type(*this).starts_with(sv); }
+    bool starts_with(charT c) const noexcept { return view_type(*this).starts_with(c); }
+    bool starts_with(const charT *s) const { return view_type(*this).starts_with(s); }
+    bool ends_with(view_type sv) const noexcept { return view_type(*this).ends_with(sv); }
+    bool ends_with(charT c) const noexcept { return view_type(*this).ends_with(c); }
+    bool ends_with(const charT *s) const { return view_type(*this).ends_with(s); }
+
+ public:  //-=========Searching(和basic_string_view共用同一套实现)
+    size_type find(view_type sv, size_type pos = 0) const noexcept { return view_type(*this).find(sv, pos); }
+    size_type find(charT c, size_type pos = 0) const noexcept { return view_type(*this).find(c, pos); }
+    size_type find(const charT *s, size_type pos, size_type n) const noexcept { return view_type(*this).find(s, pos, n); }
+    size_type find(const charT *s, size_type pos = 0) const { return view_type(*this).find(s, pos); }
+
+    size_type rfind(view_type sv, size_type pos = npos) const noexcept { return view_type(*this).rfind(sv, pos); }
+    size_type rfind(charT c, size_type pos = npos) const noexcept { return view_type(*this).rfind(c, pos); }
+    size_type rfind(const charT *s, size_type pos, size_type n) const noexcept { return view_type(*this).rfind(s, pos, n); }
+    size_type rfind(const charT *s, size_type pos = npos) const { return view_type(*this).rfind(s, pos); }
+
+    size_type find_first_of(view_type sv, size_type pos = 0) const noexcept { return view_type(*this).find_first_of(sv, pos); }
+    size_type find_first_of(charT c, size_type pos = 0) const noexcept { return view_type(*this).find_first_of(c, pos); }
+    size_type find_first_of(const charT *s, size_type pos, size_type n) const noexcept {
+        return view_type(*this).find_first_of(s, pos, n);
+    }
+    size_type find_first_of(const charT *s, size_type pos = 0) const { return view_type(*this).find_first_of(s, pos); }
+
+    size_type find_last_of(view_type sv, size_type pos = npos) const noexcept { return view_type(*this).find_last_of(sv, pos); }
+    size_type find_last_of(charT c, size_type pos = npos) const noexcept { return view_type(*this).find_last_of(c, pos); }
+    size_type find_last_of(const charT *s, size_type pos, size_type n) const noexcept {
+        return view_type(*this).find_last_of(s, pos, n);
+    }
+    size_type find_last_of(const charT *s, size_type pos = npos) const { return view_type(*this).find_last_of(s, pos); }
+
+    size_type find_first_not_of(view_type sv, size_type pos = 0) const noexcept {
+        return view_type(*this).find_first_not_of(sv, pos);
+    }
+    size_type find_first_not_of(charT c, size_type pos = 0) const noexcept { return view_type(*this).find_first_not_of(c, pos); }
+    size_type find_first_not_of(const charT *s, size_type pos, size_type n) const noexcept {
+        return view_type(*this).find_first_not_of(s, pos, n);
+    }
+    size_type find_first_not_of(const charT *s, size_type pos = 0) const { return view_type(*this).find_first_not_of(s, pos); }
+
+    size_type find_last_not_of(view_type sv, size_type pos = npos) const noexcept {
+        return view_type(*this).find_last_not_of(sv, pos);
+    }
+    size_type find_last_not_of(charT c, size_type pos = npos) const noexcept { return view_type(*this).find_last_not_of(c, pos); }
+    size_type find_last_not_of(const charT *s, size_type pos, size_type n) const noexcept {
+        return view_type(*this).find_last_not_of(s, pos, n);
+    }
+    size_type find_last_not_of(const charT *s, size_type pos = npos) const { return view_type(*this).find_last_not_of(s, pos); }
+
  public:
     // 末尾位置的值，例:
     // if (str.find('a') != string::npos) { /* do something */ }
     static constexpr size_type npos = static_cast<size_type>(-1);
 
  private:
-    iterator m_buffer;  // 储存字符串的起始位置
+    static charT *_empty() noexcept {
+        static charT empty[1] = {charT()};
+        return empty;
+    }
+    static int _compare(const charT *s1, size_type n1, const charT *s2, size_type n2) noexcept {
+        int r = traits_type::compare(s1, s2, n1 < n2 ? n1 : n2);
+        if (r != 0) {
+            return r;
+        }
+        return n1 < n2 ? -1 : (n1 > n2 ? 1 : 0);
+    }
+    // 至少能放下n个字符，按两倍增长
+    size_type _recommend(size_type n) const noexcept {
+        size_type cap = m_cap * 2;
+        return cap < n ? n : (cap < 15 ? 15 : cap);
+    }
+    // 把缓冲区换成容量为cap的新缓冲区，保留内容
+    void _reallocate(size_type cap);
+    // 迭代器区间按类别分派，指向charT的连续迭代器(包括指针)是std::true_type，
+    // 走append(s, n)/insert(pos, s, n)(允许指向自身)
+    template <class Iter>
+    using _range_tag = typename std::conditional<
+        std::is_same<typename std::remove_cv<typename nostd::_contiguous_element<Iter>::type>::type, charT>::value,
+        std::true_type, nostd::iterator_category_t<Iter>>::type;
+    template <class ContiguousIterator>
+    void _append_range(ContiguousIterator first, ContiguousIterator last, std::true_type) {
+        append(nostd::to_address(first), static_cast<size_type>(last - first));
+    }
+    template <class InputIterator>
+    void _append_range(InputIterator first, InputIterator last, nostd::input_iterator_tag);
+    template <class ForwardIterator>
+    void _append_range(ForwardIterator first, ForwardIterator last, nostd::forward_iterator_tag);
+    template <class ContiguousIterator>
+    void _insert_range(size_type pos, ContiguousIterator first, ContiguousIterator last, std::true_type) {
+        insert(pos, nostd::to_address(first), static_cast<size_type>(last - first));
+    }
+    template <class InputIterator>
+    void _insert_range(size_type pos, InputIterator first, InputIterator last, nostd::input_iterator_tag);
+    template <class ForwardIterator>
+    void _insert_range(size_type pos, ForwardIterator first, ForwardIterator last, nostd::forward_iterator_tag);
+    template <class ForwardIterator>
+    static void _write(charT *p, ForwardIterator first, ForwardIterator last) {
+        for (; first != last; ++first, ++p) {
+            traits_type::assign(*p, *first);
+        }
+    }
+    size_type _check_pos(size_type pos) const {
+        if (pos > m_size) {
+            throw std::out_of_range("basic_string");
+        }
+        return pos;
+    }
+
+ private:
+    iterator m_buffer;  // 储存字符串的起始位置，容量为m_cap + 1(结尾的'\0')
     size_type m_size;   // 大小
     size_type m_cap;    // 容量
 };
 
+template <class charT, class traits, class Alloc>
+constexpr typename basic_string<charT, traits, Alloc>::size_type basic_string<charT, traits, Alloc>::npos;
+
+//-=========================constructor、destructor、operator=
 template <class charT, class traits, class Alloc>
 basic_string<charT, traits, Alloc>::basic_string(const allocator_type &alloc)
     : m_buffer(nullptr), m_size(0), m_cap(0) {}
 
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::basic_string(const basic_string &str)
+    : basic_string(str.data(), str.size()) {}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::basic_string(const basic_string &str, const allocator_type &alloc)
+    : basic_string(str.data(), str.size(), alloc) {}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::basic_string(const basic_string &str, size_type pos, size_type len, const allocator_type &alloc)
+    : basic_string(alloc) {
+    str._check_pos(pos);
+    size_type n = str.size() - pos;
+    append(str.data() + pos, len < n ? len : n);
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::basic_string(const charT *s, const allocator_type &alloc)
+    : basic_string(s, traits_type::length(s), alloc) {}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::basic_string(const charT *s, size_type n, const allocator_type &alloc)
+    : basic_string(alloc) {
+    append(s, n);
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::basic_string(size_type n, charT c, const allocator_type &alloc)
+    : basic_string(alloc) {
+    append(n, c);
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::basic_string(size_type n, default_init_t, const allocator_type &alloc)
+    : basic_string(alloc) {
+    if (n > 0) {
+        _reallocate(n);
+        m_size = n;
+        m_buffer[n] = charT();
+    }
+}
+
+template <class charT, class traits, class Alloc>
+template <class InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type *>
+basic_string<charT, traits, Alloc>::basic_string(InputIterator first, InputIterator last, const allocator_type &alloc)
+    : basic_string(alloc) {
+    append(first, last);
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::basic_string(std::initializer_list<charT> il, const allocator_type &alloc)
+    : basic_string(il.begin(), il.size(), alloc) {}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::basic_string(view_type sv, const allocator_type &alloc)
+    : basic_string(sv.data(), sv.size(), alloc) {}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::basic_string(basic_string &&str) noexcept
+    : m_buffer(str.m_buffer), m_size(str.m_size), m_cap(str.m_cap) {
+    str.m_buffer = nullptr;
+    str.m_size = str.m_cap = 0;
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::basic_string(basic_string &&str, const allocator_type &alloc)
+    : basic_string(std::move(str)) {}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc>::~basic_string() {
+    if (m_buffer != nullptr) {
+        allocator_type::deallocate(m_buffer, m_cap + 1);
+    }
+    m_buffer = nullptr;
+    m_size = m_cap = 0;
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::operator=(const basic_string &str) {
+    if (this != &str) {
+        assign(str.data(), str.size());
+    }
+    return *this;
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::operator=(const charT *s) {
+    return assign(s);
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::operator=(charT c) {
+    return assign(1, c);
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::operator=(std::initializer_list<charT> il) {
+    return assign(il.begin(), il.size());
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::operator=(basic_string &&str) noexcept {
+    basic_string tmp(std::move(str));
+    swap(tmp);
+    return *this;
+}
+
+//-=========================Capacity
+template <class charT, class traits, class Alloc>
+void basic_string<charT, traits, Alloc>::_reallocate(size_type cap) {
+    EASYSTL_TRACE_SCOPE("string::reallocate");
+    charT *tmp = allocator_type::allocate(cap + 1);
+    if (m_buffer != nullptr) {
+        traits_type::copy(tmp, m_buffer, m_size);
+        allocator_type::deallocate(m_buffer, m_cap + 1);
+    }
+    tmp[m_size] = charT();
+    m_buffer = tmp;
+    m_cap = cap;
+}
+
+template <class charT, class traits, class Alloc>
+void basic_string<charT, traits, Alloc>::resize(size_type n) {
+    resize(n, charT());
+}
+
+template <class charT, class traits, class Alloc>
+void basic_string<charT, traits, Alloc>::resize(size_type n, charT c) {
+    if (n > m_size) {
+        append(n - m_size, c);
+    } else if (n < m_size) {
+        m_size = n;
+        m_buffer[n] = charT();
+    }
+}
+
+template <class charT, class traits, class Alloc>
+void basic_string<charT, traits, Alloc>::reserve(size_type n) {
+    if (n > m_cap) {
+        _reallocate(n);
+    }
+}
+
+template <class charT, class traits, class Alloc>
+void basic_string<charT, traits, Alloc>::shrink_to_fit() {
+    if (m_size == 0) {
+        basic_string().swap(*this);
+    } else if (m_size < m_cap) {
+        _reallocate(m_size);
+    }
+}
+
+template <class charT, class traits, class Alloc>
+void basic_string<charT, traits, Alloc>::clear() noexcept {
+    if (m_buffer != nullptr) {
+        m_size = 0;
+        m_buffer[0] = charT();
+    }
+}
+
+template <class charT, class traits, class Alloc>
+template <class Operation>
+void basic_string<charT, traits, Alloc>::resize_and_overwrite(size_type n, Operation op) {
+    if (n > m_cap || m_buffer == nullptr) {
+        _reallocate(n > m_cap ? n : m_cap);
+    }
+    size_type r = static_cast<size_type>(op(m_buffer, n));
+    m_size = r < n ? r : n;
+    m_buffer[m_size] = charT();
+}
+
+//-=========================Element access
+template <class charT, class traits, class Alloc>
+typename basic_string<charT, traits, Alloc>::reference basic_string<charT, traits, Alloc>::at(size_type pos) {
+    if (pos >= m_size) {
+        throw std::out_of_range("basic_string");
+    }
+    return m_buffer[pos];
+}
+
+template <class charT, class traits, class Alloc>
+typename basic_string<charT, traits, Alloc>::const_reference basic_string<charT, traits, Alloc>::at(size_type pos) const {
+    if (pos >= m_size) {
+        throw std::out_of_range("basic_string");
+    }
+    return m_buffer[pos];
+}
+
+//-=========================Modifiers
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::append(const basic_string &str, size_type pos, size_type len) {
+    str._check_pos(pos);
+    size_type n = str.size() - pos;
+    return append(str.data() + pos, len < n ? len : n);
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::append(const charT *s, size_type n) {
+    if (n == 0) {
+        return *this;
+    }
+    if (m_size + n > m_cap) {
+        // s可能指向自身，先申请新缓冲区再复制
+        charT *tmp = allocator_type::allocate(_recommend(m_size + n) + 1);
+        traits_type::copy(tmp, data(), m_size);
+        traits_type::copy(tmp + m_size, s, n);
+        if (m_buffer != nullptr) {
+            allocator_type::deallocate(m_buffer, m_cap + 1);
+        }
+        m_cap = _recommend(m_size + n);
+        m_buffer = tmp;
+    } else {
+        traits_type::move(m_buffer + m_size, s, n);
+    }
+    m_size += n;
+    m_buffer[m_size] = charT();
+    return *this;
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::append(size_type n, charT c) {
+    if (n == 0) {
+        return *this;
+    }
+    if (m_size + n > m_cap) {
+        _reallocate(_recommend(m_size + n));
+    }
+    traits_type::assign(m_buffer + m_size, n, c);
+    m_size += n;
+    m_buffer[m_size] = charT();
+    return *this;
+}
+
+template <class charT, class traits, class Alloc>
+template <class InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type *>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::append(InputIterator first, InputIterator last) {
+    _append_range(first, last, _range_tag<InputIterator>());
+    return *this;
+}
+
+// 每轮把剩余容量填满，还有输入时按2倍扩容；中途抛异常时回到原来的长度
+template <class charT, class traits, class Alloc>
+template <class InputIterator>
+void basic_string<charT, traits, Alloc>::_append_range(InputIterator first, InputIterator last, nostd::input_iterator_tag) {
+    const size_type old_size = m_size;
+    try {
+        while (first != last) {
+            if (m_size == m_cap) {
+                _reallocate(_recommend(m_size + 1));
+            }
+            charT *p = m_buffer + m_size;
+            for (charT *e = m_buffer + m_cap; p != e && first != last; ++first, ++p) {
+                traits_type::assign(*p, *first);
+            }
+            m_size = static_cast<size_type>(p - m_buffer);
+        }
+    } catch (...) {
+        m_size = old_size;
+        if (m_buffer != nullptr) {
+            m_buffer[m_size] = charT();
+        }
+        throw;
+    }
+    if (m_buffer != nullptr) {
+        m_buffer[m_size] = charT();
+    }
+}
+
+template <class charT, class traits, class Alloc>
+template <class ForwardIterator>
+void basic_string<charT, traits, Alloc>::_append_range(ForwardIterator first, ForwardIterator last, nostd::forward_iterator_tag) {
+    const size_type n = static_cast<size_type>(nostd::distance(first, last));
+    if (n == 0) {
+        return;
+    }
+    if (m_size + n > m_cap) {
+        // 迭代器可能引用自身的内容，先写到新缓冲区里再换
+        basic_string tmp;
+        tmp.reserve(_recommend(m_size + n));
+        tmp.append(data(), m_size);
+        _write(tmp.m_buffer + m_size, first, last);
+        tmp.m_size = m_size + n;
+        tmp.m_buffer[tmp.m_size] = charT();
+        swap(tmp);
+        return;
+    }
+    try {
+        _write(m_buffer + m_size, first, last);
+    } catch (...) {
+        m_buffer[m_size] = charT();
+        throw;
+    }
+    m_size += n;
+    m_buffer[m_size] = charT();
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::assign(const charT *s, size_type n) {
+    if (n > m_cap || m_buffer == nullptr) {
+        basic_string tmp(s, n);
+        swap(tmp);
+    } else {
+        traits_type::move(m_buffer, s, n);
+        m_size = n;
+        m_buffer[n] = charT();
+    }
+    return *this;
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::assign(size_type n, charT c) {
+    clear();
+    return append(n, c);
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::insert(size_type pos, const charT *s, size_type n) {
+    _check_pos(pos);
+    if (n == 0) {
+        return *this;
+    }
+    if (m_size + n > m_cap) {
+        basic_string tmp;
+        tmp.reserve(_recommend(m_size + n));
+        tmp.append(data(), pos).append(s, n).append(data() + pos, m_size - pos);
+        swap(tmp);
+        return *this;
+    }
+    // 原地插入：s可能指向自身，先挪动后半段，再修正s的位置
+    charT *p = m_buffer + pos;
+    traits_type::move(p + n, p, m_size - pos);
+    if (s >= p && s < m_buffer + m_size) {
+        s += n;
+    } else if (s < p && s + n > p) {
+        // s跨过插入点：前一段没动，后一段被挪走了n个位置
+        size_type head = static_cast<size_type>(p - s);
+        traits_type::move(p, s, head);
+        traits_type::move(p + head, p + n, n - head);
+        m_size += n;
+        m_buffer[m_size] = charT();
+        return *this;
+    }
+    traits_type::move(p, s, n);
+    m_size += n;
+    m_buffer[m_size] = charT();
+    return *this;
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::insert(size_type pos, size_type n, charT c) {
+    _check_pos(pos);
+    if (n == 0) {
+        return *this;
+    }
+    if (m_size + n > m_cap) {
+        _reallocate(_recommend(m_size + n));
+    }
+    charT *p = m_buffer + pos;
+    traits_type::move(p + n, p, m_size - pos);
+    traits_type::assign(p, n, c);
+    m_size += n;
+    m_buffer[m_size] = charT();
+    return *this;
+}
+
+template <class charT, class traits, class Alloc>
+template <class InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type *>
+typename basic_string<charT, traits, Alloc>::iterator basic_string<charT, traits, Alloc>::insert(const_iterator p, InputIterator first,
+                                                                                            InputIterator last) {
+    const size_type pos = static_cast<size_type>(p - data());
+    _insert_range(pos, first, last, _range_tag<InputIterator>());
+    return data() + pos;
+}
+
+// 长度未知：先追加到末尾，再旋转到pos
+template <class charT, class traits, class Alloc>
+template <class InputIterator>
+void basic_string<charT, traits, Alloc>::_insert_range(size_type pos, InputIterator first, InputIterator last,
+                                                       nostd::input_iterator_tag) {
+    const size_type old_size = m_size;
+    _append_range(first, last, nostd::input_iterator_tag());
+    std::rotate(data() + pos, data() + old_size, data() + m_size);
+}
+
+// 迭代器可能引用自身的内容(例如rbegin()/rend())，写入前不能挪动已有字符：
+// 容量不够时写到新缓冲区里；够时先写到末尾的空闲处，再旋转到pos，写入失败时原内容不变
+template <class charT, class traits, class Alloc>
+template <class ForwardIterator>
+void basic_string<charT, traits, Alloc>::_insert_range(size_type pos, ForwardIterator first, ForwardIterator last,
+                                                       nostd::forward_iterator_tag) {
+    const size_type n = static_cast<size_type>(nostd::distance(first, last));
+    if (n == 0) {
+        return;
+    }
+    if (m_size + n > m_cap) {
+        basic_string tmp;
+        tmp.reserve(_recommend(m_size + n));
+        tmp.append(data(), pos);
+        _write(tmp.m_buffer + pos, first, last);
+        tmp.m_size = pos + n;
+        tmp.append(data() + pos, m_size - pos);
+        swap(tmp);
+        return;
+    }
+    try {
+        _write(m_buffer + m_size, first, last);
+    } catch (...) {
+        m_buffer[m_size] = charT();
+        throw;
+    }
+    std::rotate(m_buffer + pos, m_buffer + m_size, m_buffer + m_size + n);
+    m_size += n;
+    m_buffer[m_size] = charT();
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> &basic_string<charT, traits, Alloc>::erase(size_type pos, size_type len) {
+    _check_pos(pos);
+    size_type n = m_size - pos;
+    if (len < n) {
+        n = len;
+    }
+    if (n > 0) {
+        traits_type::move(m_buffer + pos, m_buffer + pos + n, m_size - pos - n);
+        m_size -= n;
+        m_buffer[m_size] = charT();
+    }
+    return *this;
+}
+
+template <class charT, class traits, class Alloc>
+void basic_string<charT, traits, Alloc>::push_back(charT c) {
+    if (m_size == m_cap) {
+        _reallocate(_recommend(m_size + 1));
+    }
+    m_buffer[m_size++] = c;
+    m_buffer[m_size] = charT();
+}
+
+template <class charT, class traits, class Alloc>
+void basic_string<charT, traits, Alloc>::swap(basic_string &str) noexcept {
+    std::swap(m_buffer, str.m_buffer);
+    std::swap(m_size, str.m_size);
+    std::swap(m_cap, str.m_cap);
+}
+
+//-=========================String operations
+template <class charT, class traits, class Alloc>
+typename basic_string<charT, traits, Alloc>::size_type basic_string<charT, traits, Alloc>::copy(charT *s, size_type len, size_type pos) const {
+    _check_pos(pos);
+    size_type n = m_size - pos;
+    if (len < n) {
+        n = len;
+    }
+    traits_type::copy(s, data() + pos, n);
+    return n;
+}
+
+template <class charT, class traits, class Alloc>
+int basic_string<charT, traits, Alloc>::compare(size_type pos, size_type len, const basic_string &str) const {
+    _check_pos(pos);
+    size_type n = m_size - pos;
+    return _compare(data() + pos, len < n ? len : n, str.data(), str.size());
+}
+
+//-=============Non-member function overloads
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> operator+(const basic_string<charT, traits, Alloc> &lhs, const basic_string<charT, traits, Alloc> &rhs) {
+    basic_string<charT, traits, Alloc> ret;
+    ret.reserve(lhs.size() + rhs.size());
+    return std::move(ret.append(lhs).append(rhs));
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> operator+(basic_string<charT, traits, Alloc> &&lhs, const basic_string<charT, traits, Alloc> &rhs) {
+    return std::move(lhs.append(rhs));
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> operator+(const basic_string<charT, traits, Alloc> &lhs, const charT *rhs) {
+    basic_string<charT, traits, Alloc> ret(lhs);
+    return std::move(ret.append(rhs));
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> operator+(basic_string<charT, traits, Alloc> &&lhs, const charT *rhs) {
+    return std::move(lhs.append(rhs));
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> operator+(const charT *lhs, const basic_string<charT, traits, Alloc> &rhs) {
+    basic_string<charT, traits, Alloc> ret(lhs);
+    return std::move(ret.append(rhs));
+}
+
+template <class charT, class traits, class Alloc>
+basic_string<charT, traits, Alloc> operator+(const basic_string<charT, traits, Alloc> &lhs, charT rhs) {
+    basic_string<charT, traits, Alloc> ret(lhs);
+    ret.push_back(rhs);
+    return ret;
+}
+
+template <class charT, class traits, class Alloc>
+bool operator==(const basic_string<charT, traits, Alloc> &lhs, const basic_string<charT, traits, Alloc> &rhs) noexcept {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+template <class charT, class traits, class Alloc>
+bool operator==(const basic_string<charT, traits, Alloc> &lhs, const charT *rhs) {
+    return lhs.compare(rhs) == 0;
+}
+
+template <class charT, class traits, class Alloc>
+bool operator==(const charT *lhs, const basic_string<charT, traits, Alloc> &rhs) {
+    return rhs.compare(lhs) == 0;
+}
+
+template <class charT, class traits, class Alloc>
+bool operator!=(const basic_string<charT, traits, Alloc> &lhs, const basic_string<charT, traits, Alloc> &rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <class charT, class traits, class Alloc>
+bool operator!=(const basic_string<charT, traits, Alloc> &lhs, const charT *rhs) {
+    return !(lhs == rhs);
+}
+
+template <class charT, class traits, class Alloc>
+bool operator<(const basic_string<charT, traits, Alloc> &lhs, const basic_string<charT, traits, Alloc> &rhs) noexcept {
+    return lhs.compare(rhs) < 0;
+}
+
+template <class charT, class traits, class Alloc>
+bool operator<=(const basic_string<charT, traits, Alloc> &lhs, const basic_string<charT, traits, Alloc> &rhs) noexcept {
+    return lhs.compare(rhs) <= 0;
+}
+
+template <class charT, class traits, class Alloc>
+bool operator>(const basic_string<charT, traits, Alloc> &lhs, const basic_string<charT, traits, Alloc> &rhs) noexcept {
+    return lhs.compare(rhs) > 0;
+}
+
+template <class charT, class traits, class Alloc>
+bool operator>=(const basic_string<charT, traits, Alloc> &lhs, const basic_string<charT, traits, Alloc> &rhs) noexcept {
+    return lhs.compare(rhs) >= 0;
+}
+
+template <class charT, class traits, class Alloc>
+void swap(basic_string<charT, traits, Alloc> &x, basic_string<charT, traits, Alloc> &y) noexcept {
+    x.swap(y);
+}
+
 using string = basic_string<char>;
 using wstring = basic_string<wchar_t>;
 using u16string = basic_string<char16_t>;
 using u32string = basic_string<char32_t>;
 
+/*****************************************************************************************/
+// 数值与字符串互相转换，基于to_chars/from_chars，不受locale影响
+// 浮点数输出能精确读回的(接近)最短形式(和std::to_string的"%f"不同)
+/*****************************************************************************************/
+
+namespace _string {
+
+template <class T>
+string to_string_impl(T value) {
+    char buf[32];
+    to_chars_result r = nostd::to_chars(buf, buf + sizeof(buf), value);
+    return string(buf, static_cast<size_t>(r.ptr - buf));
+}
+
+// 和std::stoi一致：跳过前导空白，允许'+'号
+template <class T, class Parse>
+T sto_impl(const string &str, size_t *idx, const char *name, Parse parse) {
+    const char *first = str.c_str();
+    const char *last = first + str.size();
+    const char *p = first;
+    while (p != last && (*p == ' ' || (*p >= '\t' && *p <= '\r'))) {
+        ++p;
+    }
+    bool plus = p != last && *p == '+' && p + 1 != last && *(p + 1) != '-';
+    T value = T();
+    from_chars_result r = parse(plus ? p + 1 : p, last, value);
+    if (r.ec == std::errc::invalid_argument) {
+        throw std::invalid_argument(name);
+    }
+    if (r.ec == std::errc::result_out_of_range) {
+        throw std::out_of_range(name);
+    }
+    if (idx != nullptr) {
+        *idx = static_cast<size_t>(r.ptr - first);
+    }
+    return value;
+}
+
+template <class T>
+T sto_integer(const string &str, size_t *idx, int base, const char *name) {
+    // 和std::stoi/stoul一致：base为0时按前缀推断进制，stoul("-1")得到最大值
+    return sto_impl<T>(str, idx, name, [base](const char *first, const char *last, T &value) {
+        return _charconv::integer_from_chars(first, last, value, base, true);
+    });
+}
+
+// 十进制和inf/nan同std::stod；不解析十六进制浮点数，"0x1p3"只读到开头的0
+template <class T>
+T sto_float(const string &str, size_t *idx, const char *name) {
+    return sto_impl<T>(str, idx, name, [](const char *first, const char *last, T &value) {
+        return nostd::from_chars(first, last, value);
+    });
+}
+
+}  // namespace _string
+
+inline string to_string(int value) { return _string::to_string_impl(value); }
+inline string to_string(long value) { return _string::to_string_impl(value); }
+inline string to_string(long long value) { return _string::to_string_impl(value); }
+inline string to_string(unsigned value) { return _string::to_string_impl(value); }
+inline string to_string(unsigned long value) { return _string::to_string_impl(value); }
+inline string to_string(unsigned long long value) { return _string::to_string_impl(value); }
+inline string to_string(float value) { return _string::to_string_impl(value); }
+inline string to_string(double value) { return _string::to_string_impl(value); }
+
+inline int stoi(const string &str, size_t *idx = nullptr, int base = 10) {
+    return _string::sto_integer<int>(str, idx, base, "stoi");
+}
+inline long stol(const string &str, size_t *idx = nullptr, int base = 10) {
+    return _string::sto_integer<long>(str, idx, base, "stol");
+}
+inline long long stoll(const string &str, size_t *idx = nullptr, int base = 10) {
+    return _string::sto_integer<long long>(str, idx, base, "stoll");
+}
+inline unsigned long stoul(const string &str, size_t *idx = nullptr, int base = 10) {
+    return _string::sto_integer<unsigned long>(str, idx, base, "stoul");
+}
+inline unsigned long long stoull(const string &str, size_t *idx = nullptr, int base = 10) {
+    return _string::sto_integer<unsigned long long>(str, idx, base, "stoull");
+}
+inline float stof(const string &str, size_t *idx = nullptr) { return _string::sto_float<float>(str, idx, "stof"); }
+inline double stod(const string &str, size_t *idx = nullptr) { return _string::sto_float<double>(str, idx, "stod"); }
+
+/*****************************************************************************************/
+// Unicode编码转换，输入不合法时抛出std::invalid_argument
+/*****************************************************************************************/
+
+inline u16string to_utf16(string_view s) {
+    if (!validate_utf8(s.data(), s.size())) {
+        throw std::invalid_argument("to_utf16: invalid UTF-8");
+    }
+    u16string ret;
+    ret.resize_and_overwrite(utf16_length_from_utf8(s.data(), s.size()), [&s](char16_t *p, size_t) {
+        return convert_valid_utf8_to_utf16(s.data(), s.size(), p);
+    });
+    return ret;
+}
+
+inline u32string to_utf32(string_view s) {
+    if (!validate_utf8(s.data(), s.size())) {
+        throw std::invalid_argument("to_utf32: invalid UTF-8");
+    }
+    u32string ret;
+    ret.resize_and_overwrite(utf32_length_from_utf8(s.data(), s.size()), [&s](char32_t *p, size_t) {
+        return convert_valid_utf8_to_utf32(s.data(), s.size(), p);
+    });
+    return ret;
+}
+
+inline string to_utf8(u16string_view s) {
+    if (!validate_utf16(s.data(), s.size())) {
+        throw std::invalid_argument("to_utf8: invalid UTF-16");
+    }
+    string ret;
+    ret.resize_and_overwrite(utf8_length_from_utf16(s.data(), s.size()), [&s](char *p, size_t) {
+        return convert_valid_utf16_to_utf8(s.data(), s.size(), p);
+    });
+    return ret;
+}
+
+inline string to_utf8(u32string_view s) {
+    if (!validate_utf32(s.data(), s.size())) {
+        throw std::invalid_argument("to_utf8: invalid UTF-32");
+    }
+    string ret;
+    ret.resize_and_overwrite(utf8_length_from_utf32(s.data(), s.size()), [&s](char *p, size_t) {
+        return convert_valid_utf32_to_utf8(s.data(), s.size(), p);
+    });
+    return ret;
+}
+
+inline u32string to_utf32(u16string_view s) {
+    if (!validate_utf16(s.data(), s.size())) {
+        throw std::invalid_argument("to_utf32: invalid UTF-16");
+    }
+    u32string ret;
+    ret.resize_and_overwrite(utf32_length_from_utf16(s.data(), s.size()), [&s](char32_t *p, size_t) {
+        return convert_valid_utf16_to_utf32(s.data(), s.size(), p);
+    });
+    return ret;
+}
+
+inline u16string to_utf16(u32string_view s) {
+    if (!validate_utf32(s.data(), s.size())) {
+        throw std::invalid_argument("to_utf16: invalid UTF-32");
+    }
+    u16string ret;
+    ret.resize_and_overwrite(utf16_length_from_utf32(s.data(), s.size()), [&s](char16_t *p, size_t) {
+        return convert_valid_utf32_to_utf16(s.data(), s.size(), p);
+    });
+    return ret;
+}
+
 }  // namespace nostd
 #endif
@@ -0,0 +1,294 @@
+/*
+ * 字符串驻留表(string interning)
+ *
+ * 相同内容的字符串只保存一份，放在interner自己的arena里，返回atom句柄
+ * atom就是指向这份拷贝的指针：比较相等只比较指针，哈希值在驻留时算好存在旁边，
+ * 取内容不需要再查表。atom在interner析构之前一直有效
+ *
+ * string_interner             单线程版本，开放寻址(线性探测)的哈希索引
+ * concurrent_string_interner  按哈希值高位分成kShards个分片，每个分片一把锁；
+ *                             atom可以跨线程自由复制和比较，读取内容不加锁；
+ *                             id由所有分片共享的原子计数器分配，仍然是0..size()-1
+ */
+#ifndef __STRING_INTERNER_H
+#define __STRING_INTERNER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+
+#include "base/allocator.h"
+#include "base/hash.h"
+#include "base/trace.h"
+#include "container/string_view.h"
+#include "container/vector.h"
+
+namespace nostd {
+
+// arena里每个驻留字符串的头部，内容紧跟在后面并以'\0'结尾
+struct _atom_entry {
+    uint64_t m_hash;
+    uint32_t m_size;
+    uint32_t m_id;
+
+    const char *data() const noexcept { return reinterpret_cast<const char *>(this + 1); }
+};
+
+class atom {
+    friend class string_interner;
+
+ public:
+    // 空atom，和任何驻留过的字符串都不相等
+    atom() = default;
+
+    explicit operator bool() const noexcept { return m_entry != nullptr; }
+
+    string_view view() const noexcept { return m_entry ? string_view(m_entry->data(), m_entry->m_size) : string_view("", 0); }
+    const char *c_str() const noexcept { return m_entry ? m_entry->data() : ""; }
+    size_t size() const noexcept { return m_entry ? m_entry->m_size : 0; }
+    // 驻留时计算好的内容哈希
+    size_t hash() const noexcept { return m_entry ? static_cast<size_t>(m_entry->m_hash) : 0; }
+    // 在所属interner中从0开始连续的编号(小于size())，可以用来索引稠密数组
+    uint32_t id() const noexcept { return m_entry ? m_entry->m_id : UINT32_MAX; }
+
+    bool operator==(atom rhs) const noexcept { return m_entry == rhs.m_entry; }
+    bool operator!=(atom rhs) const noexcept { return m_entry != rhs.m_entry; }
+    // 按地址排序，只保证是一个全序，和字典序无关
+    bool operator<(atom rhs) const noexcept { return std::less<const _atom_entry *>()(m_entry, rhs.m_entry); }
+
+ private:
+    explicit atom(const _atom_entry *e) noexcept
+        : m_entry(e) {}
+
+    const _atom_entry *m_entry = nullptr;
+};
+
+struct atom_hash {
+    size_t operator()(atom a) const noexcept { return a.hash(); }
+};
+
+/*****************************************************************************************/
+// string_interner
+/*****************************************************************************************/
+class string_interner {
+    friend class concurrent_string_interner;
+
+ public:
+    using size_type = size_t;
+
+ private:
+    static constexpr size_t kBlockSize = 64 * 1024;  // arena每次申请的大小
+    static constexpr size_t kMinSlots = 64;
+
+ public:
+    string_interner() = default;
+    string_interner(const string_interner &) = delete;
+    string_interner &operator=(const string_interner &) = delete;
+
+    ~string_interner() {
+        for (size_t i = 0; i < m_blocks.size(); ++i) {
+            nostd::allocator<char>::deallocate(m_blocks[i]);
+        }
+        if (m_slots != nullptr) {
+            nostd::allocator<const _atom_entry *>::deallocate(m_slots, m_mask + 1);
+        }
+    }
+
+ public:
+    // 返回s对应的atom，第一次出现时把内容复制进arena
+    atom intern(string_view s) { return intern_hashed(s, hash_bytes(s.data(), s.size())); }
+
+    // 只查找不插入，没有驻留过时返回空atom
+    atom find(string_view s) const { return find_hashed(s, hash_bytes(s.data(), s.size())); }
+
+    bool contains(string_view s) const { return static_cast<bool>(find(s)); }
+
+    // 已驻留的字符串个数
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    // arena和索引占用的字节数
+    size_type memory_usage() const noexcept { return m_arena_bytes + (m_slots ? (m_mask + 1) * sizeof(*m_slots) : 0); }
+
+ private:
+    atom find_hashed(string_view s, uint64_t h) const {
+        if (m_slots == nullptr) {
+            return atom();
+        }
+        for (size_t i = static_cast<size_t>(h) & m_mask;; i = (i + 1) & m_mask) {
+            const _atom_entry *e = m_slots[i];
+            if (e == nullptr) {
+                return atom();
+            }
+            if (equal(e, s, h)) {
+                return atom(e);
+            }
+        }
+    }
+
+    atom intern_hashed(string_view s, uint64_t h) {
+        if (s.size() > UINT32_MAX) {
+            throw std::length_error("string_interner: string too long");
+        }
+        // 装载因子不超过3/4
+        if ((m_size + 1) * 4 > (m_slots ? m_mask + 1 : 0) * 3) {
+            rehash(m_slots ? (m_mask + 1) * 2 : kMinSlots);
+        }
+        size_t i = static_cast<size_t>(h) & m_mask;
+        for (; m_slots[i] != nullptr; i = (i + 1) & m_mask) {
+            if (equal(m_slots[i], s, h)) {
+                return atom(m_slots[i]);
+            }
+        }
+        _atom_entry *e = allocate_entry(s.size());
+        // 分配成功后再取id，中途失败不会在id序列里留下空洞；UINT32_MAX留给空atom
+        uint64_t id = m_id_source ? m_id_source->fetch_add(1, std::memory_order_relaxed) : m_size;
+        if (id >= UINT32_MAX) {
+            throw std::length_error("string_interner: too many strings");
+        }
+        e->m_hash = h;
+        e->m_size = static_cast<uint32_t>(s.size());
+        e->m_id = static_cast<uint32_t>(id);
+        char *p = const_cast<char *>(e->data());
+        if (!s.empty()) {
+            std::memcpy(p, s.data(), s.size());
+        }
+        p[s.size()] = '\0';
+        m_slots[i] = e;
+        ++m_size;
+        return atom(e);
+    }
+
+    static bool equal(const _atom_entry *e, string_view s, uint64_t h) noexcept {
+        return e->m_hash == h && e->m_size == s.size() && (s.empty() || std::memcmp(e->data(), s.data(), s.size()) == 0);
+    }
+
+    // 用保存的哈希值重建索引，不需要重新计算
+    void rehash(size_t slots) {
+        EASYSTL_TRACE_SCOPE("string_interner::rehash");
+        const _atom_entry **tmp = nostd::allocator<const _atom_entry *>::allocate(slots);
+        std::fill(tmp, tmp + slots, nullptr);
+        size_t mask = slots - 1;
+        if (m_slots != nullptr) {
+            for (size_t i = 0; i <= m_mask; ++i) {
+                const _atom_entry *e = m_slots[i];
+                if (e != nullptr) {
+                    size_t j = static_cast<size_t>(e->m_hash) & mask;
+                    while (tmp[j] != nullptr) {
+                        j = (j + 1) & mask;
+                    }
+                    tmp[j] = e;
+                }
+            }
+            nostd::allocator<const _atom_entry *>::deallocate(m_slots, m_mask + 1);
+        }
+        m_slots = tmp;
+        m_mask = mask;
+    }
+
+    // 在arena上按8字节对齐分配一个条目，放不下的大字符串单独申请一块
+    _atom_entry *allocate_entry(size_t len) {
+        size_t bytes = (sizeof(_atom_entry) + len + 1 + 7) & ~size_t(7);
+        if (bytes > kBlockSize / 4) {
+            char *block = nostd::allocator<char>::allocate(bytes);
+            m_blocks.push_back(block);
+            m_arena_bytes += bytes;
+            return reinterpret_cast<_atom_entry *>(block);
+        }
+        if (bytes > m_remain) {
+            m_cur = nostd::allocator<char>::allocate(kBlockSize);
+            m_blocks.push_back(m_cur);
+            m_remain = kBlockSize;
+            m_arena_bytes += kBlockSize;
+        }
+        _atom_entry *e = reinterpret_cast<_atom_entry *>(m_cur);
+        m_cur += bytes;
+        m_remain -= bytes;
+        return e;
+    }
+
+ private:
+    const _atom_entry **m_slots = nullptr;  // 开放寻址的索引，容量是2的幂
+    size_t m_mask = 0;
+    size_type m_size = 0;
+    nostd::vector<char *> m_blocks;  // arena的所有块
+    char *m_cur = nullptr;
+    size_t m_remain = 0;
+    size_t m_arena_bytes = 0;
+    std::atomic<uint64_t> *m_id_source = nullptr;  // 分片时所有分片共用的id计数器，为空时id就是序号
+};
+
+/*****************************************************************************************/
+// concurrent_string_interner
+// 哈希值的高位选分片、低位在分片内做索引，两者互不相关
+/*****************************************************************************************/
+class concurrent_string_interner {
+ public:
+    using size_type = size_t;
+    static constexpr size_t kShards = 16;
+
+ public:
+    concurrent_string_interner() {
+        for (size_t i = 0; i < kShards; ++i) {
+            m_shards[i].m_table.m_id_source = &m_next_id;
+        }
+    }
+    concurrent_string_interner(const concurrent_string_interner &) = delete;
+    concurrent_string_interner &operator=(const concurrent_string_interner &) = delete;
+
+ public:
+    atom intern(string_view s) {
+        uint64_t h = hash_bytes(s.data(), s.size());
+        shard &sh = m_shards[shard_of(h)];
+        std::lock_guard<std::mutex> lock(sh.m_mutex);
+        return sh.m_table.intern_hashed(s, h);
+    }
+
+    atom find(string_view s) const {
+        uint64_t h = hash_bytes(s.data(), s.size());
+        const shard &sh = m_shards[shard_of(h)];
+        std::lock_guard<std::mutex> lock(sh.m_mutex);
+        return sh.m_table.find_hashed(s, h);
+    }
+
+    bool contains(string_view s) const { return static_cast<bool>(find(s)); }
+
+    size_type size() const {
+        size_type n = 0;
+        for (size_t i = 0; i < kShards; ++i) {
+            std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+            n += m_shards[i].m_table.size();
+        }
+        return n;
+    }
+
+ private:
+    static size_t shard_of(uint64_t h) noexcept { return static_cast<size_t>(h >> 60) & (kShards - 1); }
+
+    // 每个分片独占cache line，不同分片的锁之间没有伪共享
+    struct alignas(64) shard {
+        mutable std::mutex m_mutex;
+        string_interner m_table;
+    };
+
+    shard m_shards[kShards];
+    std::atomic<uint64_t> m_next_id{0};
+};
+
+}  // namespace nostd
+
+namespace std {
+
+template <>
+struct hash<nostd::atom> {
+    size_t operator()(nostd::atom a) const noexcept { return a.hash(); }
+};
+
+}  // namespace std
+
+#endif  // !__STRING_INTERNER_H
@@ -0,0 +1,537 @@
+/*
+ * https://en.cppreference.com/w/cpp/string/basic_string_view
+ *
+ * basic_string_view只保存指针和长度，不拥有内存，取子串/切分都不发生分配
+ * 查找全部建立在char_traits的find/compare上，char走memchr/memcmp
+ *
+ * split(view, delim)   按分隔符切分，保留空字段："a,,b" -> "a" "" "b"
+ * tokenize(view, set)  按字符集合切分，跳过空字段："  a  b " -> "a" "b"
+ * 两者都是惰性的range，迭代时才向后查找下一个字段
+ */
+#ifndef __STRING_VIEW_H
+#define __STRING_VIEW_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "base/char_traits.h"
+#include "base/config.h"
+#include "base/iterator.h"
+
+namespace nostd {
+
+template <class charT, class traits = nostd::char_traits<charT>>
+class basic_string_view {
+ public:
+    using traits_type = traits;
+    using value_type = charT;
+    using pointer = charT *;
+    using const_pointer = const charT *;
+    using reference = charT &;
+    using const_reference = const charT &;
+    using const_iterator = const charT *;
+    using iterator = const_iterator;
+    using const_reverse_iterator = nostd::reverse_iterator<const_iterator>;
+    using reverse_iterator = const_reverse_iterator;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+ public:
+    constexpr basic_string_view() noexcept
+        : m_data(nullptr), m_size(0) {}
+    constexpr basic_string_view(const charT *s, size_type n)
+        : m_data(s), m_size(n) {}
+    EASYSTL_CONSTEXPR14 basic_string_view(const charT *s)
+        : m_data(s), m_size(traits_type::length(s)) {}
+
+ public:  //-=========iterators
+    constexpr const_iterator begin() const noexcept { return m_data; }
+    constexpr const_iterator end() const noexcept { return m_data + m_size; }
+    constexpr const_iterator cbegin() const noexcept { return m_data; }
+    constexpr const_iterator cend() const noexcept { return m_data + m_size; }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+ public:  //-=========Capacity
+    constexpr size_type size() const noexcept { return m_size; }
+    constexpr size_type length() const noexcept { return m_size; }
+    constexpr size_type max_size() const noexcept { return npos / sizeof(charT); }
+    constexpr bool empty() const noexcept { return m_size == 0; }
+
+ public:  //-=========Element access
+    constexpr const_reference operator[](size_type pos) const { return m_data[pos]; }
+    const_reference at(size_type pos) const {
+        if (pos >= m_size) {
+            throw std::out_of_range("basic_string_view");
+        }
+        return m_data[pos];
+    }
+    constexpr const_reference front() const { return m_data[0]; }
+    constexpr const_reference back() const { return m_data[m_size - 1]; }
+    constexpr const_pointer data() const noexcept { return m_data; }
+
+ public:  //-=========Modifiers
+    void remove_prefix(size_type n) {
+        m_data += n;
+        m_size -= n;
+    }
+    void remove_suffix(size_type n) { m_size -= n; }
+    void swap(basic_string_view &v) noexcept {
+        std::swap(m_data, v.m_data);
+        std::swap(m_size, v.m_size);
+    }
+
+ public:  //-=========String operations
+    size_type copy(charT *s, size_type n, size_type pos = 0) const {
+        size_type len = _clamp(pos, n);
+        traits_type::copy(s, m_data + pos, len);
+        return len;
+    }
+
+    basic_string_view substr(size_type pos = 0, size_type n = npos) const {
+        return basic_string_view(m_data + pos, _clamp(pos, n));
+    }
+
+    EASYSTL_CONSTEXPR14 int compare(basic_string_view v) const noexcept {
+        size_type n = m_size < v.m_size ? m_size : v.m_size;
+        int r = n == 0 ? 0 : traits_type::compare(m_data, v.m_data, n);
+        if (r != 0) {
+            return r;
+        }
+        return m_size < v.m_size ? -1 : (m_size > v.m_size ? 1 : 0);
+    }
+    int compare(size_type pos1, size_type n1, basic_string_view v) const { return substr(pos1, n1).compare(v); }
+    int compare(size_type pos1, size_type n1, basic_string_view v, size_type pos2, size_type n2) const {
+        return substr(pos1, n1).compare(v.substr(pos2, n2));
+    }
+    int compare(const charT *s) const { return compare(basic_string_view(s)); }
+    int compare(size_type pos1, size_type n1, const charT *s) const { return substr(pos1, n1).compare(basic_string_view(s)); }
+    int compare(size_type pos1, size_type n1, const charT *s, size_type n2) const {
+        return substr(pos1, n1).compare(basic_string_view(s, n2));
+    }
+
+    bool starts_with(basic_string_view v) const noexcept {
+        return m_size >= v.m_size && (v.m_size == 0 || traits_type::compare(m_data, v.m_data, v.m_size) == 0);
+    }
+    bool starts_with(charT c) const noexcept { return !empty() && traits_type::eq(front(), c); }
+    bool starts_with(const charT *s) const { return starts_with(basic_string_view(s)); }
+    bool ends_with(basic_string_view v) const noexcept {
+        return m_size >= v.m_size &&
+               (v.m_size == 0 || traits_type::compare(m_data + m_size - v.m_size, v.m_data, v.m_size) == 0);
+    }
+    bool ends_with(charT c) const noexcept { return !empty() && traits_type::eq(back(), c); }
+    bool ends_with(const charT *s) const { return ends_with(basic_string_view(s)); }
+    bool contains(basic_string_view v) const noexcept { return find(v) != npos; }
+    bool contains(charT c) const noexcept { return find(c) != npos; }
+    bool contains(const charT *s) const { return find(s) != npos; }
+
+ public:  //-=========Searching
+    size_type find(basic_string_view v, size_type pos = 0) const noexcept { return find(v.m_data, pos, v.m_size); }
+    size_type find(charT c, size_type pos = 0) const noexcept {
+        if (pos >= m_size) {
+            return npos;
+        }
+        const charT *p = traits_type::find(m_data + pos, m_size - pos, c);
+        return p == nullptr ? npos : static_cast<size_type>(p - m_data);
+    }
+    // 用首字符在traits::find(memchr)上跳跃，命中后再比较剩下的部分
+    size_type find(const charT *s, size_type pos, size_type n) const noexcept {
+        if (pos > m_size || n > m_size - pos) {
+            return npos;
+        }
+        if (n == 0) {
+            return pos;
+        }
+        const charT *first = m_data + pos;
+        const charT *last = m_data + m_size - n + 1;  // 可能的起点是[first, last)
+        while (first < last) {
+            first = traits_type::find(first, static_cast<size_type>(last - first), s[0]);
+            if (first == nullptr) {
+                return npos;
+            }
+            if (traits_type::compare(first + 1, s + 1, n - 1) == 0) {
+                return static_cast<size_type>(first - m_data);
+            }
+            ++first;
+        }
+        return npos;
+    }
+    size_type find(const charT *s, size_type pos = 0) const { return find(s, pos, traits_type::length(s)); }
+
+    size_type rfind(basic_string_view v, size_type pos = npos) const noexcept { return rfind(v.m_data, pos, v.m_size); }
+    size_type rfind(charT c, size_type pos = npos) const noexcept {
+        if (m_size == 0) {
+            return npos;
+        }
+        for (size_type i = pos < m_size ? pos + 1 : m_size; i > 0; --i) {
+            if (traits_type::eq(m_data[i - 1], c)) {
+                return i - 1;
+            }
+        }
+        return npos;
+    }
+    size_type rfind(const charT *s, size_type pos, size_type n) const noexcept {
+        if (n > m_size) {
+            return npos;
+        }
+        size_type i = m_size - n < pos ? m_size - n : pos;
+        for (;; --i) {
+            if (traits_type::compare(m_data + i, s, n) == 0) {
+                return i;
+            }
+            if (i == 0) {
+                return npos;
+            }
+        }
+    }
+    size_type rfind(const charT *s, size_type pos = npos) const { return rfind(s, pos, traits_type::length(s)); }
+
+    size_type find_first_of(basic_string_view v, size_type pos = 0) const noexcept {
+        return find_first_of(v.m_data, pos, v.m_size);
+    }
+    size_type find_first_of(charT c, size_type pos = 0) const noexcept { return find(c, pos); }
+    size_type find_first_of(const charT *s, size_type pos, size_type n) const noexcept {
+        return _find_first(pos, _charset(s, n), true);
+    }
+    size_type find_first_of(const charT *s, size_type pos = 0) const { return find_first_of(s, pos, traits_type::length(s)); }
+
+    size_type find_last_of(basic_string_view v, size_type pos = npos) const noexcept {
+        return find_last_of(v.m_data, pos, v.m_size);
+    }
+    size_type find_last_of(charT c, size_type pos = npos) const noexcept { return rfind(c, pos); }
+    size_type find_last_of(const charT *s, size_type pos, size_type n) const noexcept {
+        return _find_last(pos, _charset(s, n), true);
+    }
+    size_type find_last_of(const charT *s, size_type pos = npos) const { return find_last_of(s, pos, traits_type::length(s)); }
+
+    size_type find_first_not_of(basic_string_view v, size_type pos = 0) const noexcept {
+        return find_first_not_of(v.m_data, pos, v.m_size);
+    }
+    size_type find_first_not_of(charT c, size_type pos = 0) const noexcept {
+        return find_first_not_of(&c, pos, 1);
+    }
+    size_type find_first_not_of(const charT *s, size_type pos, size_type n) const noexcept {
+        return _find_first(pos, _charset(s, n), false);
+    }
+    size_type find_first_not_of(const charT *s, size_type pos = 0) const {
+        return find_first_not_of(s, pos, traits_type::length(s));
+    }
+
+    size_type find_last_not_of(basic_string_view v, size_type pos = npos) const noexcept {
+        return find_last_not_of(v.m_data, pos, v.m_size);
+    }
+    size_type find_last_not_of(charT c, size_type pos = npos) const noexcept {
+        return find_last_not_of(&c, pos, 1);
+    }
+    size_type find_last_not_of(const charT *s, size_type pos, size_type n) const noexcept {
+        return _find_last(pos, _charset(s, n), false);
+    }
+    size_type find_last_not_of(const charT *s, size_type pos = npos) const {
+        return find_last_not_of(s, pos, traits_type::length(s));
+    }
+
+ private:
+    // 字符集合：单字节字符用256位的位图，一次查表判断；宽字符在集合上做traits::find
+    struct _charset {
+        const charT *m_set;
+        size_type m_n;
+        unsigned char m_bits[sizeof(charT) == 1 ? 32 : 1];
+
+        _charset(const charT *s, size_type n) noexcept
+            : m_set(s), m_n(n), m_bits() {
+            if (sizeof(charT) == 1) {
+                for (size_type i = 0; i < n; ++i) {
+                    unsigned char c = static_cast<unsigned char>(s[i]);
+                    m_bits[c >> 3] |= static_cast<unsigned char>(1u << (c & 7));
+                }
+            }
+        }
+
+        bool contains(charT ch) const noexcept {
+            if (sizeof(charT) == 1) {
+                unsigned char c = static_cast<unsigned char>(ch);
+                return (m_bits[c >> 3] >> (c & 7)) & 1u;
+            }
+            return m_n != 0 && traits_type::find(m_set, m_n, ch) != nullptr;
+        }
+    };
+
+    size_type _find_first(size_type pos, const _charset &set, bool in) const noexcept {
+        for (; pos < m_size; ++pos) {
+            if (set.contains(m_data[pos]) == in) {
+                return pos;
+            }
+        }
+        return npos;
+    }
+
+    size_type _find_last(size_type pos, const _charset &set, bool in) const noexcept {
+        for (size_type i = pos < m_size ? pos + 1 : m_size; i > 0; --i) {
+            if (set.contains(m_data[i - 1]) == in) {
+                return i - 1;
+            }
+        }
+        return npos;
+    }
+
+    // 检查pos并返回从pos开始最多n个字符时的实际长度
+    size_type _clamp(size_type pos, size_type n) const {
+        if (pos > m_size) {
+            throw std::out_of_range("basic_string_view");
+        }
+        size_type rest = m_size - pos;
+        return n < rest ? n : rest;
+    }
+
+ private:
+    const charT *m_data;
+    size_type m_size;
+};
+
+template <class charT, class traits>
+constexpr typename basic_string_view<charT, traits>::size_type basic_string_view<charT, traits>::npos;
+
+//-=============Non-member function overloads
+// 每个比较运算符另外提供和const charT*比较的版本，模板实参推导不会做隐式转换
+template <class charT, class traits>
+EASYSTL_CONSTEXPR14 bool operator==(basic_string_view<charT, traits> lhs, basic_string_view<charT, traits> rhs) noexcept {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+template <class charT, class traits>
+bool operator==(basic_string_view<charT, traits> lhs, const charT *rhs) {
+    return lhs == basic_string_view<charT, traits>(rhs);
+}
+template <class charT, class traits>
+bool operator==(const charT *lhs, basic_string_view<charT, traits> rhs) {
+    return basic_string_view<charT, traits>(lhs) == rhs;
+}
+template <class charT, class traits>
+EASYSTL_CONSTEXPR14 bool operator!=(basic_string_view<charT, traits> lhs, basic_string_view<charT, traits> rhs) noexcept {
+    return !(lhs == rhs);
+}
+template <class charT, class traits>
+bool operator!=(basic_string_view<charT, traits> lhs, const charT *rhs) {
+    return !(lhs == rhs);
+}
+template <class charT, class traits>
+bool operator!=(const charT *lhs, basic_string_view<charT, traits> rhs) {
+    return !(lhs == rhs);
+}
+template <class charT, class traits>
+bool operator<(basic_string_view<charT, traits> lhs, basic_string_view<charT, traits> rhs) noexcept {
+    return lhs.compare(rhs) < 0;
+}
+template <class charT, class traits>
+bool operator<=(basic_string_view<charT, traits> lhs, basic_string_view<charT, traits> rhs) noexcept {
+    return lhs.compare(rhs) <= 0;
+}
+template <class charT, class traits>
+bool operator>(basic_string_view<charT, traits> lhs, basic_string_view<charT, traits> rhs) noexcept {
+    return lhs.compare(rhs) > 0;
+}
+template <class charT, class traits>
+bool operator>=(basic_string_view<charT, traits> lhs, basic_string_view<charT, traits> rhs) noexcept {
+    return lhs.compare(rhs) >= 0;
+}
+
+using string_view = basic_string_view<char>;
+using wstring_view = basic_string_view<wchar_t>;
+using u16string_view = basic_string_view<char16_t>;
+using u32string_view = basic_string_view<char32_t>;
+
+/*****************************************************************************************/
+// split / tokenize
+// 迭代器里保存剩余未切分的部分，++时才查找下一个分隔符；解引用得到指向原串的view
+// 原串必须在遍历期间保持有效
+/*****************************************************************************************/
+
+// 按单个字符或整个分隔串切分，分隔串为空时整个输入作为一个字段
+template <class charT, class traits>
+class split_range {
+ public:
+    using view_type = basic_string_view<charT, traits>;
+    using size_type = typename view_type::size_type;
+
+    class iterator {
+        friend class split_range;
+
+     public:
+        using iterator_category = nostd::forward_iterator_tag;
+        using value_type = view_type;
+        using difference_type = ptrdiff_t;
+        using pointer = const view_type *;
+        using reference = const view_type &;
+
+        iterator() = default;
+
+        reference operator*() const noexcept { return m_field; }
+        pointer operator->() const noexcept { return &m_field; }
+
+        iterator &operator++() {
+            next();
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator tmp = *this;
+            next();
+            return tmp;
+        }
+
+        // 只有遍历结束时m_done为true，其余时候比较字段的起始位置即可
+        bool operator==(const iterator &rhs) const noexcept {
+            return m_done == rhs.m_done && (m_done || m_field.data() == rhs.m_field.data());
+        }
+        bool operator!=(const iterator &rhs) const noexcept { return !(*this == rhs); }
+
+     private:
+        iterator(view_type rest, view_type delim, charT ch, bool by_char)
+            : m_rest(rest), m_delim(delim), m_ch(ch), m_by_char(by_char), m_done(false) {
+            next();
+        }
+
+        void next() {
+            if (m_last) {
+                m_done = true;
+                return;
+            }
+            size_type pos = m_by_char         ? m_rest.find(m_ch)
+                            : m_delim.empty() ? view_type::npos
+                                              : m_rest.find(m_delim);
+            if (pos == view_type::npos) {
+                m_field = m_rest;
+                m_last = true;
+            } else {
+                m_field = m_rest.substr(0, pos);
+                m_rest.remove_prefix(pos + (m_by_char ? 1 : m_delim.size()));
+            }
+        }
+
+        view_type m_rest;
+        view_type m_delim;
+        view_type m_field;
+        charT m_ch = charT();     // 单字符分隔符按值保存，迭代器不指向range对象
+        bool m_by_char = false;
+        bool m_last = false;  // m_field已经是最后一个字段
+        bool m_done = true;
+    };
+
+    split_range(view_type s, view_type delim)
+        : m_s(s), m_delim(delim), m_ch(), m_by_char(false) {}
+    split_range(view_type s, charT delim)
+        : m_s(s), m_delim(), m_ch(delim), m_by_char(true) {}
+
+    iterator begin() const { return iterator(m_s, m_delim, m_ch, m_by_char); }
+    iterator end() const { return iterator(); }
+
+ private:
+    view_type m_s;
+    view_type m_delim;
+    charT m_ch;
+    bool m_by_char;
+};
+
+// 按字符集合切分，连续的分隔符视为一个，首尾的分隔符被忽略
+template <class charT, class traits>
+class tokenize_range {
+ public:
+    using view_type = basic_string_view<charT, traits>;
+    using size_type = typename view_type::size_type;
+
+    class iterator {
+        friend class tokenize_range;
+
+     public:
+        using iterator_category = nostd::forward_iterator_tag;
+        using value_type = view_type;
+        using difference_type = ptrdiff_t;
+        using pointer = const view_type *;
+        using reference = const view_type &;
+
+        iterator() = default;
+
+        reference operator*() const noexcept { return m_token; }
+        pointer operator->() const noexcept { return &m_token; }
+
+        iterator &operator++() {
+            next();
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator tmp = *this;
+            next();
+            return tmp;
+        }
+
+        // token都非空，结束后data()为nullptr
+        bool operator==(const iterator &rhs) const noexcept { return m_token.data() == rhs.m_token.data(); }
+        bool operator!=(const iterator &rhs) const noexcept { return !(*this == rhs); }
+
+     private:
+        iterator(view_type rest, view_type delims)
+            : m_rest(rest), m_delims(delims) {
+            next();
+        }
+
+        void next() {
+            size_type first = m_rest.find_first_not_of(m_delims);
+            if (first == view_type::npos) {
+                m_token = view_type();
+                m_rest = view_type();
+                return;
+            }
+            m_rest.remove_prefix(first);
+            size_type last = m_rest.find_first_of(m_delims);
+            if (last == view_type::npos) {
+                last = m_rest.size();
+            }
+            m_token = m_rest.substr(0, last);
+            m_rest.remove_prefix(last);
+        }
+
+        view_type m_rest;
+        view_type m_delims;
+        view_type m_token;
+    };
+
+    tokenize_range(view_type s, view_type delims)
+        : m_s(s), m_delims(delims) {}
+
+    iterator begin() const { return iterator(m_s, m_delims); }
+    iterator end() const { return iterator(); }
+
+ private:
+    view_type m_s;
+    view_type m_delims;
+};
+
+template <class charT, class traits>
+split_range<charT, traits> split(basic_string_view<charT, traits> s, basic_string_view<charT, traits> delim) {
+    return split_range<charT, traits>(s, delim);
+}
+
+template <class charT, class traits>
+split_range<charT, traits> split(basic_string_view<charT, traits> s, const charT *delim) {
+    return split_range<charT, traits>(s, basic_string_view<charT, traits>(delim));
+}
+
+template <class charT, class traits>
+split_range<charT, traits> split(basic_string_view<charT, traits> s, charT delim) {
+    return split_range<charT, traits>(s, delim);
+}
+
+template <class charT, class traits>
+tokenize_range<charT, traits> tokenize(basic_string_view<charT, traits> s, basic_string_view<charT, traits> delims) {
+    return tokenize_range<charT, traits>(s, delims);
+}
+
+template <class charT, class traits>
+tokenize_range<charT, traits> tokenize(basic_string_view<charT, traits> s, const charT *delims) {
+    return tokenize_range<charT, traits>(s, basic_string_view<charT, traits>(delims));
+}
+
+}  // namespace nostd
+
+#endif  // !__STRING_VIEW_H
@@ -0,0 +1,290 @@
+/*
+ * 分层时间轮(hierarchical timing wheel)
+ * ref: Varghese & Lauck, "Hashed and Hierarchical Timing Wheels"
+ *      linux kernel/timer.c (2.6 cascade 版本)
+ *
+ * 第0层256个槽，每槽1个tick；第1~4层各64个槽，每层槽宽是上一层整层的跨度
+ * 定时器按到期时间与当前时间的差值落到对应层，低层转完一圈时把上一层的一个槽
+ * 重新分发(cascade)到下层。add/cancel都是O(1)，advance均摊每tick O(1)
+ * 低层为空时advance直接跳到下一次cascade的位置，不逐个空槽转动
+ *
+ * 每个槽是一条基于list_node_base的侵入式双向链表，cancel时直接摘链
+ */
+#ifndef __TIMER_WHEEL_H
+#define __TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "base/allocator.h"
+#include "base/construct.h"
+#include "container/list.h"
+#include "container/vector.h"
+
+namespace nostd {
+
+template <typename T>
+class timer_wheel {
+ public:
+    using value_type = T;
+    using size_type = size_t;
+    using tick_type = uint64_t;
+
+ private:
+    static constexpr int kRootBits = 8;
+    static constexpr int kLevelBits = 6;
+    static constexpr int kLevels = 4;  // 第0层之外的层数
+    static constexpr tick_type kRootSize = tick_type(1) << kRootBits;
+    static constexpr tick_type kLevelSize = tick_type(1) << kLevelBits;
+    static constexpr tick_type kRootMask = kRootSize - 1;
+    static constexpr tick_type kLevelMask = kLevelSize - 1;
+    static constexpr tick_type kMaxDelta = (tick_type(1) << (kRootBits + kLevels * kLevelBits)) - 1;
+    static constexpr size_type kSlotCount = kRootSize + kLevels * kLevelSize;
+    static constexpr size_type kBlockSize = 256;  // 节点按块申请
+
+    // 定时器节点，节点内存只在时间轮析构时才归还
+    // 所以过期/取消后的句柄仍能安全地读取m_seq来判断是否失效
+    struct node : public list_node_base {
+        tick_type m_expire = 0;
+        uint64_t m_seq = 0;  // 0表示节点空闲
+        int m_level = 0;     // 所在的层
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage;
+
+        T *value() noexcept { return reinterpret_cast<T *>(&m_storage); }
+    };
+    using node_allocator = nostd::allocator<node>;
+
+ public:
+    // add返回的句柄，用于cancel
+    class handle {
+        friend class timer_wheel;
+
+     public:
+        handle() = default;
+        explicit operator bool() const noexcept { return m_node != nullptr; }
+
+     private:
+        handle(node *n, uint64_t seq)
+            : m_node(n), m_seq(seq) {}
+
+        node *m_node = nullptr;
+        uint64_t m_seq = 0;
+    };
+
+ public:
+    timer_wheel()
+        : m_slots(kSlotCount) {
+        for (size_type i = 0; i < kSlotCount; ++i) {
+            m_slots[i].init();
+        }
+    }
+
+    timer_wheel(const timer_wheel &) = delete;
+    timer_wheel &operator=(const timer_wheel &) = delete;
+
+    ~timer_wheel() {
+        for (size_type i = 0; i < kSlotCount; ++i) {
+            list_node_base &head = m_slots[i];
+            while (!head.empty()) {
+                node *n = static_cast<node *>(head.m_next);
+                n->unhook();
+                nostd::destroy(n->value());
+            }
+        }
+        for (size_type i = 0; i < m_blocks.size(); ++i) {
+            node_allocator::deallocate(m_blocks[i], kBlockSize);
+        }
+    }
+
+ public:
+    // 当前时间(已经推进的tick数)
+    tick_type now() const noexcept { return m_now; }
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    // 添加一个delay个tick之后到期的定时器，delay为0时按1处理
+    template <typename... Args>
+    handle add(tick_type delay, Args &&...args) {
+        node *n = acquire();
+        nostd::construct(n->value(), std::forward<Args>(args)...);
+        n->m_seq = ++m_seq;
+        n->m_expire = m_now + (delay == 0 ? 1 : delay);
+        place(n);
+        ++m_size;
+        return handle(n, n->m_seq);
+    }
+
+    // 取消定时器，已经过期或取消过的句柄返回false
+    bool cancel(handle h) {
+        node *n = h.m_node;
+        if (n == nullptr || n->m_seq != h.m_seq) {
+            return false;
+        }
+        unlink(n);
+        nostd::destroy(n->value());
+        release(n);
+        --m_size;
+        return true;
+    }
+
+    // 推进ticks个tick，每个到期的定时器调用一次fn(T&)，返回过期的定时器个数
+    // 同一个tick到期的定时器整槽摘下后批量回调，回调里可以安全地add/cancel；
+    // fn抛异常时停在那个tick之前，尚未回调的定时器保留在时间轮里
+    template <typename Function>
+    size_type advance(tick_type ticks, Function fn) {
+        size_type fired = 0;
+        while (ticks > 0) {
+            if (m_size == 0) {
+                // 没有待处理的定时器，不需要逐槽转动
+                m_now += ticks;
+                break;
+            }
+            tick_type step = 1;
+            if (m_counts[0] == 0) {
+                // 第0层为空，直接跳到最低的非空层下一次cascade的位置
+                int level = 1;
+                while (m_counts[level] == 0) {
+                    ++level;
+                }
+                tick_type span = tick_type(1) << (kRootBits + (level - 1) * kLevelBits);
+                step = ((m_now | (span - 1)) + 1) - m_now;
+                if (step > ticks) {
+                    m_now += ticks;
+                    break;
+                }
+            }
+            m_now += step;
+            ticks -= step;
+            tick_type index = m_now & kRootMask;
+            if (index == 0) {
+                cascade_from(1);
+            }
+            list_node_base batch;
+            batch.take(m_slots[index]);
+            try {
+                while (!batch.empty()) {
+                    node *n = static_cast<node *>(batch.m_next);
+                    T value(std::move(*n->value()));
+                    unlink(n);
+                    nostd::destroy(n->value());
+                    release(n);
+                    --m_size;
+                    ++fired;
+                    fn(value);
+                }
+            } catch (...) {
+                // 回调抛异常：还没回调的定时器挂回原来的槽(计数没有变)，时间退回上一个tick，
+                // 下一次advance会先把这个槽剩下的定时器处理完。重新cascade同一个槽按到期时间重新分发，结果不变
+                list_node_base &head = m_slots[index];
+                while (!batch.empty()) {
+                    list_node_base *n = batch.m_next;
+                    n->unhook();
+                    n->hook(&head);
+                }
+                --m_now;
+                throw;
+            }
+        }
+        return fired;
+    }
+
+ private:
+    list_node_base &slot(int level, tick_type index) {
+        return level == 0 ? m_slots[index] : m_slots[kRootSize + (level - 1) * kLevelSize + index];
+    }
+
+    // 根据到期时间把节点挂到对应层的槽上
+    void place(node *n) {
+        tick_type expire = n->m_expire;
+        tick_type delta = expire - m_now;
+        if (expire < m_now) {
+            delta = 0;
+            expire = m_now;
+        } else if (delta > kMaxDelta) {
+            // 超出最大跨度的先挂在最高层，cascade时会按真实到期时间重新分发
+            delta = kMaxDelta;
+            expire = m_now + kMaxDelta;
+        }
+        if (delta < kRootSize) {
+            link(n, 0, expire & kRootMask);
+            return;
+        }
+        int level = 1;
+        int shift = kRootBits;
+        while (level < kLevels && delta >= (tick_type(1) << (shift + kLevelBits))) {
+            ++level;
+            shift += kLevelBits;
+        }
+        link(n, level, (expire >> shift) & kLevelMask);
+    }
+
+    void link(node *n, int level, tick_type index) {
+        n->m_level = level;
+        n->hook(&slot(level, index));
+        ++m_counts[level];
+    }
+
+    void unlink(node *n) {
+        n->unhook();
+        --m_counts[n->m_level];
+    }
+
+    // 低层转完一圈，把level层当前槽里的定时器重新分发到下层
+    // 该槽序号为0时说明这一层也转完了一圈，继续处理上一层
+    void cascade_from(int level) {
+        for (; level <= kLevels; ++level) {
+            int shift = kRootBits + (level - 1) * kLevelBits;
+            tick_type index = (m_now >> shift) & kLevelMask;
+            list_node_base pending;
+            pending.take(slot(level, index));
+            while (!pending.empty()) {
+                node *n = static_cast<node *>(pending.m_next);
+                unlink(n);
+                place(n);
+            }
+            if (index != 0) {
+                break;
+            }
+        }
+    }
+
+    node *acquire() {
+        if (m_free == nullptr) {
+            node *block = node_allocator::allocate(kBlockSize);
+            m_blocks.push_back(block);
+            for (size_type i = kBlockSize; i > 0; --i) {
+                node *n = block + (i - 1);
+                nostd::construct(n);
+                n->m_next = m_free;
+                m_free = n;
+            }
+        }
+        node *n = static_cast<node *>(m_free);
+        m_free = n->m_next;
+        n->m_next = nullptr;
+        return n;
+    }
+
+    // 空闲链表借用m_next链接，m_seq清零后旧句柄全部失效
+    void release(node *n) {
+        n->m_seq = 0;
+        n->m_prev = nullptr;
+        n->m_next = m_free;
+        m_free = n;
+    }
+
+ private:
+    nostd::vector<list_node_base> m_slots;  // 所有层的槽，第0层在前
+    nostd::vector<node *> m_blocks;         // 已申请的节点块
+    list_node_base *m_free = nullptr;       // 空闲节点链表
+    tick_type m_now = 0;
+    uint64_t m_seq = 0;
+    size_type m_size = 0;
+    size_type m_counts[kLevels + 1] = {};  // 每一层挂着的定时器个数
+};
+
+}  // namespace nostd
+
+#endif  // !__TIMER_WHEEL_H
@@ -6,14 +6,20 @@
 #define __VECTOR_H
 
 #include <algorithm>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 #include "algo/algorithm.h"
 #include "base/allocator.h"
 #include "base/iterator.h"
 #include "base/memory.h"
+#include "base/trace.h"
 
 namespace nostd {
 
@@ -52,7 +58,14 @@ class vector {
     explicit vector(size_type n) {
         m_begin = allocator_type::allocate(n);
         m_end_of_storage = m_begin + n;
-        m_end = nostd::uninitialized_fill_n(m_begin, n, value_type());
+        m_end = nostd::uninitialized_value_construct_n(m_begin, n);
+    }
+
+    // n个默认初始化的元素：内置类型不清零，随后整体覆盖写入时省掉一遍memset
+    vector(size_type n, default_init_t) {
+        m_begin = allocator_type::allocate(n);
+        m_end_of_storage = m_begin + n;
+        m_end = nostd::uninitialized_default_construct_n(m_begin, n);
     }
 
     vector(size_type n, const value_type &val, const allocator_type &alloc = allocator_type()) {
@@ -62,48 +75,62 @@ class vector {
         nostd::uninitialized_fill(m_begin, m_end, val);
     }
 
-    //  如果不加任何判断,当T是int类型时候 nostd::vector<int> v(10,1) 会走到这个逻辑里面来
-    template <typename iter_t, typename std::enable_if<!std::is_same<iter_t, int>::value>::type * = nullptr>
-    vector(iter_t first, iter_t last, const allocator_type &alloc = allocator_type()) {
-        static_assert(!std::is_same<iter_t, int>::value, "iter_t cannot be int type");
-        size_type n = nostd::distance(first, last);
-        m_begin = allocator_type::allocate(n);
-        m_end_of_storage = m_begin + n;
-        m_end = nostd::uninitialized_copy(first, last, m_begin);
+    //  如果不加任何判断,当T是整数类型时候 nostd::vector<int> v(10,1) 会走到这个逻辑里面来
+    // 前向迭代器按长度一次分配，单趟的输入迭代器边读边扩容
+    template <typename iter_t, typename std::enable_if<!std::is_integral<iter_t>::value>::type * = nullptr>
+    vector(iter_t first, iter_t last, const allocator_type &alloc = allocator_type())
+        : m_begin(nullptr), m_end(nullptr), m_end_of_storage(nullptr) {
+        static_assert(!std::is_integral<iter_t>::value, "iter_t cannot be integral type");
+        append_range(first, last);
     }
 
     vector(const vector &other) {
         m_begin = allocator_type::allocate(other.size());
-        m_end_of_storage = m_begin + other.capacity();
+        m_end_of_storage = m_begin + other.size();
         m_end = nostd::uninitialized_copy(other.begin(), other.end(), m_begin);
     }
     vector(const vector &other, const allocator_type &alloc) {
         m_begin = alloc.allocate(other.size());
-        m_end_of_storage = m_begin + other.capacity();
+        m_end_of_storage = m_begin + other.size();
         m_end = nostd::uninitialized_copy(other.begin(), other.end(), m_begin);
     }
 
-    vector(vector &&other) noexcept {
-        // todo
-    }
-    vector(vector &&other, const allocator_type &alloc) noexcept {
-        // todo
+    // 直接接管other的空间，other变为没有空间的空vector
+    vector(vector &&other) noexcept
+        : m_begin(other.m_begin), m_end(other.m_end), m_end_of_storage(other.m_end_of_storage) {
+        other.m_begin = other.m_end = other.m_end_of_storage = nullptr;
     }
+    // 分配器没有状态，同样直接接管
+    vector(vector &&other, const allocator_type &) noexcept : vector(std::move(other)) {}
 
     vector(std::initializer_list<value_type> il, const allocator_type &alloc = allocator_type()) {
-        // todo
+        m_begin = alloc.allocate(il.size());
+        m_end_of_storage = m_begin + il.size();
+        m_end = nostd::uninitialized_copy(il.begin(), il.end(), m_begin);
     }
 
     vector &operator=(const vector &v) {
-        // todo
+        if (this != &v) {
+            assign(v.begin(), v.end());
+        }
+        return *this;
     }
 
-    vector &operator=(vector &&) noexcept {
-        // todo
+    vector &operator=(vector &&v) noexcept {
+        if (this != &v) {
+            allocator_type::destroy(m_begin, m_end);
+            allocator_type::deallocate(m_begin, m_end_of_storage - m_begin);
+            m_begin = v.m_begin;
+            m_end = v.m_end;
+            m_end_of_storage = v.m_end_of_storage;
+            v.m_begin = v.m_end = v.m_end_of_storage = nullptr;
+        }
+        return *this;
     }
 
     vector &operator=(std::initializer_list<value_type> il) {
-        // todo
+        assign(il.begin(), il.end());
+        return *this;
     }
 
     ~vector() {
@@ -133,14 +160,32 @@ class vector {
     size_type max_size() const noexcept {
         return std::numeric_limits<size_type>::max() / sizeof(value_type);
     }
+    // 新增元素原地值初始化，不要求value_type可复制
     void resize(size_type n) {
-        resize(n, value_type());
+        if (n < size()) {
+            allocator_type::destroy(m_begin + n, m_end);
+            m_end = m_begin + n;
+        } else if (n > size()) {
+            const size_type k = n - size();
+            _insert_gap(m_end, k, [k](iterator p) { nostd::uninitialized_value_construct_n(p, k); });
+        }
     }
     void resize(size_type n, const value_type &val) {
         if (n < size()) {
+            allocator_type::destroy(m_begin + n, m_end);
             m_end = m_begin + n;
-        } else {
-            insert(m_end, n - size(), val);
+        } else if (n > size()) {
+            insert(m_end, n - size(), val);  // val可能是自己的元素，扩容时不能先释放旧空间
+        }
+    }
+    // 同resize(n)，但新增元素只做默认初始化(内置类型的值不确定)，用于随后马上被覆盖写入的场景
+    void resize_default_init(size_type n) {
+        if (n < size()) {
+            allocator_type::destroy(m_begin + n, m_end);
+            m_end = m_begin + n;
+        } else if (n > size()) {
+            reserve(n);
+            m_end = nostd::uninitialized_default_construct_n(m_end, n - size());
         }
     }
     size_type capacity() const noexcept {
@@ -150,23 +195,16 @@ class vector {
         return m_begin == m_end;
     }
     void reserve(size_type n) {
+        if (n > max_size()) {
+            throw std::length_error("vector");
+        }
         if (n > capacity()) {
-            iterator tmp = allocator_type::allocate(n);
-            nostd::uninitialized_copy(m_begin, m_end, tmp);
-            allocator_type::deallocate(m_begin, m_end_of_storage - m_begin);
-            m_begin = tmp;
-            m_end = m_begin + size();
-            m_end_of_storage = m_begin + n;
+            _realloc_insert(n, size(), 0, [](iterator) {});
         }
     }
     void shrink_to_fit() {
         if (size() < capacity()) {
-            iterator tmp = allocator_type::allocate(size());
-            nostd::uninitialized_copy(m_begin, m_end, tmp);
-            allocator_type::deallocate(m_begin, m_end_of_storage - m_begin);
-            m_begin = tmp;
-            m_end = m_begin + size();
-            m_end_of_storage = m_begin + size();
+            _realloc_insert(size(), size(), 0, [](iterator) {});
         }
     }
 
@@ -209,30 +247,51 @@ class vector {
     }
 
  public:  //-=========Modifiers
-    template <typename InputIterator>
+    template <typename InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type * = nullptr>
     void assign(InputIterator first, InputIterator last) {
-        // todo
+        _assign(first, last, nostd::iterator_category_t<InputIterator>());
     }
     void assign(size_type n, const value_type &val) {
-        // todo
+        if (n > capacity()) {
+            vector tmp(n, val);
+            swap(tmp);
+        } else if (n > size()) {
+            nostd::fill(m_begin, m_end, val);
+            m_end = nostd::uninitialized_fill_n(m_end, n - size(), val);
+        } else {
+            nostd::fill_n(m_begin, n, val);
+            allocator_type::destroy(m_begin + n, m_end);
+            m_end = m_begin + n;
+        }
     }
     void assign(std::initializer_list<value_type> il) {
-        // todo
+        assign(il.begin(), il.end());
+    }
+
+    // 追加[first, last)：前向迭代器先量出长度，最多分配一次再整体复制；
+    // 单趟的输入迭代器先填满剩余容量，不够时按2倍扩容继续填
+    template <typename InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type * = nullptr>
+    void append_range(InputIterator first, InputIterator last) {
+        _append_range(first, last, nostd::iterator_category_t<InputIterator>());
+    }
+    template <typename Range>
+    void append_range(Range &&rg) {
+        append_range(std::begin(rg), std::end(rg));
+    }
+    template <typename InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type * = nullptr>
+    iterator insert_range(const_iterator position, InputIterator first, InputIterator last) {
+        return _insert_range(position, first, last, nostd::iterator_category_t<InputIterator>());
+    }
+    template <typename Range>
+    iterator insert_range(const_iterator position, Range &&rg) {
+        return insert_range(position, std::begin(rg), std::end(rg));
     }
 
     void push_back(const value_type &val) {
-        if (m_end == m_end_of_storage) {
-            reserve(size() * 2);
-        }
-        allocator_type::construct(m_end, val);
-        m_end++;
+        emplace_back(val);
     }
     void push_back(value_type &&val) {
-        if (m_end == m_end_of_storage) {
-            reserve(size() * 2);
-        }
-        allocator_type::construct(m_end, std::move(val));
-        m_end++;
+        emplace_back(std::move(val));
     }
     void pop_back() {
         allocator_type::destroy(m_end - 1);
@@ -240,53 +299,272 @@ class vector {
     }
 
     iterator insert(const_iterator position, const value_type &val) {
-        // todo
+        return emplace(position, val);
     }
     iterator insert(const_iterator position, size_type n, const value_type &val) {
-        // todo
+        if (_is_element(&val)) {
+            const value_type tmp(val);  // 挪动元素之前先复制一份
+            return insert(position, n, tmp);
+        }
+        return _insert_gap(position, n, [n, &val](iterator p) { nostd::uninitialized_fill_n(p, n, val); });
     }
-    template <typename InputIterator>
+    template <typename InputIterator, typename std::enable_if<!std::is_integral<InputIterator>::value>::type * = nullptr>
     iterator insert(const_iterator position, InputIterator first, InputIterator last) {
-        // todo
+        return _insert_range(position, first, last, nostd::iterator_category_t<InputIterator>());
     }
     iterator insert(const_iterator position, value_type &&val) {
-        // todo
+        return emplace(position, std::move(val));
     }
     iterator insert(const_iterator position, std::initializer_list<value_type> il) {
-        // todo
+        return insert(position, il.begin(), il.end());
     }
 
     iterator erase(const_iterator position) {
-        // todo
+        return erase(position, position + 1);
     }
+    // 尾部整体前移一次
     iterator erase(const_iterator first, const_iterator last) {
-        // todo
+        iterator f = m_begin + (first - m_begin);
+        iterator l = m_begin + (last - m_begin);
+        if (f != l) {
+            _erase_gap(f, l, _relocatable());
+            m_end -= l - f;
+        }
+        return f;
     }
 
-    void swap(vector &x) {
+    void swap(vector &x) noexcept {
         std::swap(m_begin, x.m_begin);
         std::swap(m_end, x.m_end);
         std::swap(m_end_of_storage, x.m_end_of_storage);
     }
     void clear() noexcept {
-        erase(begin(), end());
+        allocator_type::destroy(m_begin, m_end);
+        m_end = m_begin;
     }
 
     template <typename... Args>
     iterator emplace(const_iterator position, Args &&...args) {
-        // todo
+        if (position == m_end) {
+            emplace_back(std::forward<Args>(args)...);
+            return m_end - 1;
+        }
+        if (m_end == m_end_of_storage) {
+            // 扩容时新元素直接构造在新空间上，此时旧元素还在，参数引用旧元素也没有问题
+            return _insert_gap(position, 1, [&](iterator p) { allocator_type::construct(p, std::forward<Args>(args)...); });
+        }
+        // 参数可能引用要被挪动的元素，先构造出来再挪
+        value_type tmp(std::forward<Args>(args)...);
+        return _insert_gap(position, 1, [&tmp](iterator p) { allocator_type::construct(p, std::move(tmp)); });
     }
     template <typename... Args>
     void emplace_back(Args &&...args) {
-        // todo
+        if (m_end == m_end_of_storage) {
+            _realloc_insert(_recommend(size() + 1), size(), 1,
+                            [&](iterator p) { allocator_type::construct(p, std::forward<Args>(args)...); });
+        } else {
+            allocator_type::construct(m_end, std::forward<Args>(args)...);
+            ++m_end;
+        }
     }
 
  public:  //-=========Allocator
     allocator_type get_allocator() const noexcept {
         return allocator_type();
     }
+
+ private:
+    // 可平凡搬移的元素挪动时直接memmove/memcpy
+    using _relocatable = std::integral_constant<bool, nostd::is_trivially_relocatable<value_type>::value>;
+    // 搬到新空间时，移动构造可能抛异常并且能复制的类型退化为复制，保证失败时旧元素不变
+    using _move_ok = std::integral_constant<bool, std::is_nothrow_move_constructible<value_type>::value ||
+                                                      !std::is_copy_constructible<value_type>::value>;
+
+    bool _is_element(const value_type *p) const noexcept {
+        return !std::less<const value_type *>()(p, m_begin) && std::less<const value_type *>()(p, m_end);
+    }
+
+    // 至少容纳n个元素的新容量，按2倍增长
+    size_type _recommend(size_type n) const {
+        if (n > max_size()) {
+            throw std::length_error("vector");
+        }
+        const size_type cap = capacity();
+        if (cap >= max_size() / 2) {
+            return max_size();
+        }
+        return cap * 2 > n ? cap * 2 : n;
+    }
+
+    template <typename InputIterator>
+    void _assign(InputIterator first, InputIterator last, nostd::input_iterator_tag) {
+        clear();
+        _append_range(first, last, nostd::input_iterator_tag());
+    }
+    template <typename ForwardIterator>
+    void _assign(ForwardIterator first, ForwardIterator last, nostd::forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(nostd::distance(first, last));
+        if (n > capacity()) {
+            vector tmp(first, last);
+            swap(tmp);
+        } else if (n > size()) {
+            ForwardIterator mid = first;
+            nostd::advance(mid, size());
+            nostd::copy(first, mid, m_begin);
+            m_end = nostd::uninitialized_copy(mid, last, m_end);
+        } else {
+            iterator new_end = nostd::copy(first, last, m_begin);
+            allocator_type::destroy(new_end, m_end);
+            m_end = new_end;
+        }
+    }
+
+    // 长度未知：每轮把剩余容量填满，还有输入时按2倍扩容，检查容量的次数是O(log n)而不是每个元素一次
+    template <typename InputIterator>
+    void _append_range(InputIterator first, InputIterator last, nostd::input_iterator_tag) {
+        while (first != last) {
+            if (m_end == m_end_of_storage) {
+                reserve(_recommend(size() + 1));
+            }
+            for (; m_end != m_end_of_storage && first != last; ++first) {
+                allocator_type::construct(m_end, *first);
+                ++m_end;
+            }
+        }
+    }
+    template <typename ForwardIterator>
+    void _append_range(ForwardIterator first, ForwardIterator last, nostd::forward_iterator_tag) {
+        _insert_range(m_end, first, last, nostd::forward_iterator_tag());
+    }
+
+    // 长度未知：先追加到末尾，再旋转到position
+    template <typename InputIterator>
+    iterator _insert_range(const_iterator position, InputIterator first, InputIterator last, nostd::input_iterator_tag) {
+        const size_type off = static_cast<size_type>(position - m_begin);
+        const size_type old_size = size();
+        _append_range(first, last, nostd::input_iterator_tag());
+        std::rotate(m_begin + off, m_begin + old_size, m_end);
+        return m_begin + off;
+    }
+    template <typename ForwardIterator>
+    iterator _insert_range(const_iterator position, ForwardIterator first, ForwardIterator last, nostd::forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(nostd::distance(first, last));
+        return _insert_gap(position, n, [&first, &last](iterator p) { nostd::uninitialized_copy(first, last, p); });
+    }
+
+    // 在position处插入n个由construct(p)构造在[p, p + n)上的元素，construct失败时不能留下构造了一半的对象
+    // 容量够时把尾部整体后移一次空出位置，构造失败再移回去；不够时换一块新空间
+    template <typename F>
+    iterator _insert_gap(const_iterator position, size_type n, F construct) {
+        const size_type off = static_cast<size_type>(position - m_begin);
+        if (n == 0) {
+            return m_begin + off;
+        }
+        if (n > static_cast<size_type>(m_end_of_storage - m_end)) {
+            _realloc_insert(_recommend(size() + n), off, n, construct);
+        } else {
+            iterator pos = m_begin + off;
+            _open_gap(pos, n, _relocatable());
+            try {
+                construct(pos);
+            } catch (...) {
+                _close_gap(pos, n, _relocatable());
+                throw;
+            }
+            m_end += n;
+        }
+        return m_begin + off;
+    }
+
+    // 换一块cap个元素的新空间：先在[off, off + n)上构造新元素，再把[0, off)和[off, size)两段旧元素搬过去
+    // 任何一步失败都只回滚新空间，原vector不变
+    template <typename F>
+    void _realloc_insert(size_type cap, size_type off, size_type n, F construct) {
+        EASYSTL_TRACE_SCOPE("vector::realloc");
+        const size_type new_size = size() + n;
+        iterator tmp = allocator_type::allocate(cap);
+        try {
+            construct(tmp + off);
+            try {
+                _transfer(tmp, off, n, _relocatable());
+            } catch (...) {
+                allocator_type::destroy(tmp + off, tmp + off + n);
+                throw;
+            }
+        } catch (...) {
+            allocator_type::deallocate(tmp, cap);
+            throw;
+        }
+        allocator_type::deallocate(m_begin, m_end_of_storage - m_begin);
+        m_begin = tmp;
+        m_end = tmp + new_size;
+        m_end_of_storage = tmp + cap;
+    }
+
+    // 把全部旧元素搬到tmp，[off, size)这一段后移n个位置，旧元素随后不再析构
+    void _transfer(iterator tmp, size_type off, size_type n, std::true_type) noexcept {
+        nostd::uninitialized_relocate(m_begin, m_begin + off, tmp);
+        nostd::uninitialized_relocate(m_begin + off, m_end, tmp + off + n);
+    }
+    void _transfer(iterator tmp, size_type off, size_type n, std::false_type) {
+        iterator mid = _uninit_transfer(m_begin, m_begin + off, tmp, _move_ok());
+        try {
+            _uninit_transfer(m_begin + off, m_end, tmp + off + n, _move_ok());
+        } catch (...) {
+            allocator_type::destroy(tmp, mid);
+            throw;
+        }
+        allocator_type::destroy(m_begin, m_end);
+    }
+    static iterator _uninit_transfer(iterator first, iterator last, iterator result, std::true_type) {
+        return nostd::uninitialized_move(first, last, result);
+    }
+    static iterator _uninit_transfer(iterator first, iterator last, iterator result, std::false_type) {
+        return nostd::uninitialized_copy(first, last, result);
+    }
+
+    // [pos, end)后移n个位置，[pos, pos + n)变成未初始化的空位，m_end不变
+    void _open_gap(iterator pos, size_type n, std::true_type) noexcept {
+        std::memmove(static_cast<void *>(pos + n), static_cast<const void *>(pos), (m_end - pos) * sizeof(value_type));
+    }
+    void _open_gap(iterator pos, size_type n, std::false_type) {
+        const size_type after = static_cast<size_type>(m_end - pos);
+        if (after > n) {
+            nostd::uninitialized_move(m_end - n, m_end, m_end);
+            nostd::move_backward(pos, m_end - n, m_end);
+            allocator_type::destroy(pos, pos + n);
+        } else {
+            nostd::uninitialized_move(pos, m_end, pos + n);
+            allocator_type::destroy(pos, m_end);
+        }
+    }
+
+    // _open_gap的逆操作，[pos + n, end + n)移回pos
+    void _close_gap(iterator pos, size_type n, std::true_type) noexcept {
+        std::memmove(static_cast<void *>(pos), static_cast<const void *>(pos + n), (m_end - pos) * sizeof(value_type));
+    }
+    void _close_gap(iterator pos, size_type n, std::false_type) noexcept {
+        for (iterator src = pos + n, last = m_end + n; src != last; ++src, ++pos) {
+            allocator_type::construct(pos, std::move(*src));
+            allocator_type::destroy(src);
+        }
+    }
+
+    // 析构[first, last)，尾部前移补上
+    void _erase_gap(iterator first, iterator last, std::true_type) noexcept {
+        allocator_type::destroy(first, last);
+        std::memmove(static_cast<void *>(first), static_cast<const void *>(last), (m_end - last) * sizeof(value_type));
+    }
+    void _erase_gap(iterator first, iterator last, std::false_type) {
+        iterator new_end = nostd::move(last, m_end, first);
+        allocator_type::destroy(new_end, m_end);
+    }
 };
 
+// 只有三个指针，按字节搬到新地址后不析构旧对象即可
+template <typename T, typename Alloc>
+struct is_trivially_relocatable<vector<T, Alloc>> : std::true_type {};
+
 //-=============Non-member function overloads
 template <typename T>
 bool operator==(const nostd::vector<T> &lhs, const std::vector<T> &rhs) {
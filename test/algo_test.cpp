@@ -1,5 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <forward_list>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 #include "algo/algorithm.h"
@@ -69,4 +79,404 @@ TEST(AlgorithmTest, find) {
     } else {
         FAIL();
     }
-}
\ No newline at end of file
+}
+// 生成有序序列，dup_every不为0时每隔dup_every个元素插入一个重复值
+template <typename T>
+static std::vector<T> sorted_ints(std::mt19937_64 &rng, size_t n, uint64_t max_gap, size_t dup_every) {
+    std::vector<T> v;
+    uint64_t cur = rng() % 8;
+    for (size_t i = 0; i < n; ++i) {
+        v.push_back(static_cast<T>(cur));
+        if (dup_every != 0 && i % dup_every == 0) {
+            v.push_back(static_cast<T>(cur));
+        }
+        cur += 1 + rng() % max_gap;
+    }
+    return v;
+}
+
+template <typename T>
+static void check_set_ops(const std::vector<T> &a, const std::vector<T> &b) {
+    std::vector<T> expected, actual(a.size() + b.size());
+    const T *pa = a.data(), *pb = b.data();
+
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    actual.resize(nostd::set_intersection(pa, pa + a.size(), pb, pb + b.size(), &actual[0]) - &actual[0]);
+    EXPECT_EQ(actual, expected);
+
+    expected.clear();
+    actual.resize(a.size() + b.size());
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    actual.resize(nostd::set_union(pa, pa + a.size(), pb, pb + b.size(), &actual[0]) - &actual[0]);
+    EXPECT_EQ(actual, expected);
+
+    expected.clear();
+    actual.resize(a.size() + b.size());
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    actual.resize(nostd::set_difference(pa, pa + a.size(), pb, pb + b.size(), &actual[0]) - &actual[0]);
+    EXPECT_EQ(actual, expected);
+
+    expected.clear();
+    actual.resize(a.size() + b.size());
+    std::set_difference(b.begin(), b.end(), a.begin(), a.end(), std::back_inserter(expected));
+    actual.resize(nostd::set_difference(pb, pb + b.size(), pa, pa + a.size(), &actual[0]) - &actual[0]);
+    EXPECT_EQ(actual, expected);
+}
+
+template <typename T>
+static void check_set_ops_random(uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    const size_t sizes[][2] = {{0, 10}, {3, 5}, {100, 100}, {1000, 1200}, {10, 5000}, {5000, 7}, {4096, 4096}};
+    const size_t dups[] = {0, 0, 37, 3};
+    for (auto &sz : sizes) {
+        for (size_t dup : dups) {
+            for (uint64_t gap : {2, 5, 64}) {
+                check_set_ops(sorted_ints<T>(rng, sz[0], gap, dup), sorted_ints<T>(rng, sz[1], gap, dup == 3 ? 0 : dup));
+            }
+        }
+    }
+}
+
+TEST(AlgorithmTest, set_ops_sorted_int) {
+    check_set_ops_random<uint32_t>(1);
+    check_set_ops_random<int32_t>(2);
+    check_set_ops_random<uint64_t>(3);
+    check_set_ops_random<int64_t>(4);
+    check_set_ops_random<uint16_t>(5);
+}
+
+TEST(AlgorithmTest, set_ops_duplicates_across_blocks) {
+    // 重复元素正好落在SIMD块的边界上
+    std::vector<uint32_t> a = {1, 2, 3, 5, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+    std::vector<uint32_t> b = {0, 2, 4, 5, 7, 9, 11, 13, 14, 15, 16, 17};
+    check_set_ops(a, b);
+    std::vector<uint64_t> c = {1, 2, 3, 4, 4, 4, 4, 4, 5, 6, 7, 8};
+    std::vector<uint64_t> d = {4, 4, 4, 5, 5, 5, 5, 6, 7, 7, 8, 9};
+    check_set_ops(c, d);
+}
+
+TEST(AlgorithmTest, set_ops_generic_iterator) {
+    std::vector<int> a = {1, 3, 3, 5, 7};
+    std::vector<int> b = {3, 4, 5, 5};
+    std::vector<int> out;
+    nostd::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    EXPECT_EQ(out, std::vector<int>({3, 5}));
+    out.clear();
+    nostd::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    EXPECT_EQ(out, std::vector<int>({1, 3, 3, 4, 5, 5, 7}));
+    out.clear();
+    nostd::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    EXPECT_EQ(out, std::vector<int>({1, 3, 3, 3, 4, 5, 5, 5, 7}));
+}
+
+TEST(AlgorithmTest, lower_upper_bound) {
+    std::mt19937_64 rng(7);
+    for (size_t n : {0, 1, 2, 3, 7, 8, 9, 100, 1000, 4097}) {
+        std::vector<int> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.push_back(static_cast<int>(rng() % (n + 1)));
+        }
+        std::sort(v.begin(), v.end());
+        for (int x = -1; x <= static_cast<int>(n) + 1; ++x) {
+            EXPECT_EQ(nostd::lower_bound(v.begin(), v.end(), x), std::lower_bound(v.begin(), v.end(), x));
+            EXPECT_EQ(nostd::upper_bound(v.begin(), v.end(), x), std::upper_bound(v.begin(), v.end(), x));
+            const int *p = v.data();
+            EXPECT_EQ(nostd::lower_bound(p, p + n, x), p + (std::lower_bound(v.begin(), v.end(), x) - v.begin()));
+            EXPECT_EQ(nostd::binary_search(v.begin(), v.end(), x), std::binary_search(v.begin(), v.end(), x));
+        }
+    }
+}
+
+TEST(AlgorithmTest, bound_with_compare) {
+    std::vector<int> v = {9, 7, 7, 7, 5, 3, 1};
+    auto lo = nostd::lower_bound(v.begin(), v.end(), 7, std::greater<int>());
+    auto hi = nostd::upper_bound(v.begin(), v.end(), 7, std::greater<int>());
+    EXPECT_EQ(lo - v.begin(), 1);
+    EXPECT_EQ(hi - v.begin(), 4);
+    auto range = nostd::equal_range(v.begin(), v.end(), 7, std::greater<int>());
+    EXPECT_EQ(range.first, lo);
+    EXPECT_EQ(range.second, hi);
+    EXPECT_TRUE(nostd::binary_search(v.begin(), v.end(), 3, std::greater<int>()));
+    EXPECT_FALSE(nostd::binary_search(v.begin(), v.end(), 4, std::greater<int>()));
+
+    // 非随机访问迭代器
+    std::forward_list<int> fl = {1, 3, 3, 5, 8};
+    EXPECT_EQ(*nostd::lower_bound(fl.begin(), fl.end(), 3), 3);
+    EXPECT_EQ(*nostd::upper_bound(fl.begin(), fl.end(), 3), 5);
+    EXPECT_EQ(nostd::lower_bound(fl.begin(), fl.end(), 9), fl.end());
+}
+
+TEST(AlgorithmTest, copy_move_fast_path) {
+    int src[37];
+    for (int i = 0; i < 37; ++i) {
+        src[i] = i;
+    }
+    int dst[37] = {};
+    EXPECT_EQ(nostd::copy(src, src + 37, dst), dst + 37);
+    EXPECT_TRUE(std::equal(src, src + 37, dst));
+    const int *csrc = src;
+    EXPECT_EQ(nostd::copy_n(csrc, 5, dst + 30), dst + 35);
+    EXPECT_EQ(dst[34], 4);
+    EXPECT_EQ(nostd::copy(src, src, dst), dst);
+
+    // 重叠区间：向前copy，向后copy_backward
+    nostd::copy(src + 1, src + 37, src);
+    EXPECT_EQ(src[0], 1);
+    EXPECT_EQ(src[35], 36);
+    nostd::copy_backward(src, src + 35, src + 36);
+    EXPECT_EQ(src[1], 1);
+    EXPECT_EQ(src[35], 35);
+    nostd::move_backward(src, src + 3, src + 4);
+    EXPECT_EQ(src[3], 2);
+
+    // 非平凡类型走展开的循环
+    std::string strs[6] = {"a", "b", "c", "d", "e", "f"};
+    std::string out[6];
+    EXPECT_EQ(nostd::copy(strs, strs + 6, out), out + 6);
+    EXPECT_EQ(out[5], "f");
+    nostd::move(strs, strs + 6, out);
+    EXPECT_EQ(out[4], "e");
+    EXPECT_TRUE(strs[4].empty());
+
+    // 非随机访问迭代器
+    std::list<int> l = {1, 2, 3};
+    std::vector<int> v;
+    nostd::copy(l.begin(), l.end(), std::back_inserter(v));
+    EXPECT_EQ(v, std::vector<int>({1, 2, 3}));
+}
+
+TEST(AlgorithmTest, fill_fast_path) {
+    int a[19];
+    nostd::fill(a, a + 19, 0);
+    EXPECT_EQ(std::count(a, a + 19, 0), 19);
+    nostd::fill(a, a + 19, -1);
+    EXPECT_EQ(std::count(a, a + 19, -1), 19);
+    nostd::fill(a, a + 19, 0x12345678);
+    EXPECT_EQ(std::count(a, a + 19, 0x12345678), 19);
+    EXPECT_EQ(nostd::fill_n(a, 7, 3), a + 7);
+    EXPECT_EQ(a[6], 3);
+    EXPECT_EQ(a[7], 0x12345678);
+    EXPECT_EQ(nostd::fill_n(a, -1, 3), a);
+
+    char c[10];
+    nostd::fill(c, c + 10, 'x');
+    EXPECT_EQ(std::string(c, 10), "xxxxxxxxxx");
+
+    double d[5];
+    nostd::fill(d, d + 5, 1.5);
+    EXPECT_EQ(d[4], 1.5);
+    nostd::fill_n(d, 5, 0);  // int转换成double
+    EXPECT_EQ(d[4], 0.0);
+
+    struct pod {
+        int x;
+        char y;
+    };
+    pod p[3];
+    nostd::fill(p, p + 3, pod{7, 'z'});
+    EXPECT_EQ(p[2].x, 7);
+    EXPECT_EQ(p[2].y, 'z');
+}
+
+TEST(AlgorithmTest, equal_fast_path) {
+    int a[] = {1, 2, 3, 4, 5};
+    int b[] = {1, 2, 3, 4, 5};
+    EXPECT_TRUE(nostd::equal(a, a + 5, b));
+    b[4] = 6;
+    EXPECT_FALSE(nostd::equal(a, a + 5, b));
+    EXPECT_TRUE(nostd::equal(a, a, b));
+
+    // 浮点数不能按字节比较：0.0 == -0.0
+    double x[] = {0.0, 1.0};
+    double y[] = {-0.0, 1.0};
+    EXPECT_TRUE(nostd::equal(x, x + 2, y));
+
+    EXPECT_TRUE(nostd::equal(a, a + 4, b, [](int l, int r) {
+        return l == r;
+    }));
+}
+
+namespace {
+// 包装了指针的连续迭代器，类似span/string的迭代器
+template <class T>
+class wrapped_iter {
+ public:
+    using iterator_category = nostd::contiguous_iterator_tag;
+    using value_type = typename std::remove_const<T>::type;
+    using difference_type = ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    wrapped_iter() = default;
+    explicit wrapped_iter(T *p) : m_ptr(p) {}
+
+    reference operator*() const { return *m_ptr; }
+    pointer operator->() const { return m_ptr; }
+    reference operator[](difference_type n) const { return m_ptr[n]; }
+    wrapped_iter &operator++() {
+        ++m_ptr;
+        return *this;
+    }
+    wrapped_iter operator++(int) { return wrapped_iter(m_ptr++); }
+    wrapped_iter &operator--() {
+        --m_ptr;
+        return *this;
+    }
+    wrapped_iter operator--(int) { return wrapped_iter(m_ptr--); }
+    wrapped_iter &operator+=(difference_type n) {
+        m_ptr += n;
+        return *this;
+    }
+    wrapped_iter &operator-=(difference_type n) {
+        m_ptr -= n;
+        return *this;
+    }
+    wrapped_iter operator+(difference_type n) const { return wrapped_iter(m_ptr + n); }
+    wrapped_iter operator-(difference_type n) const { return wrapped_iter(m_ptr - n); }
+    difference_type operator-(const wrapped_iter &rhs) const { return m_ptr - rhs.m_ptr; }
+    bool operator==(const wrapped_iter &rhs) const { return m_ptr == rhs.m_ptr; }
+    bool operator!=(const wrapped_iter &rhs) const { return m_ptr != rhs.m_ptr; }
+    bool operator<(const wrapped_iter &rhs) const { return m_ptr < rhs.m_ptr; }
+
+ private:
+    T *m_ptr = nullptr;
+};
+}  // namespace
+
+TEST(AlgorithmTest, contiguous_iterator) {
+    typedef wrapped_iter<int> iter;
+    typedef wrapped_iter<const int> citer;
+    static_assert(nostd::is_contiguous_iterator<int *>::value, "");
+    static_assert(nostd::is_contiguous_iterator<iter>::value, "");
+    static_assert(!nostd::is_contiguous_iterator<nostd::reverse_iterator<iter>>::value, "");
+    static_assert(!nostd::is_contiguous_iterator<std::list<int>::iterator>::value, "");
+    static_assert(!nostd::is_contiguous_iterator<int>::value, "");
+    static_assert(std::is_same<nostd::iterator_category_t<int *>, nostd::contiguous_iterator_tag>::value, "");
+    // 包装过的迭代器也走memmove/memcmp/按字节fill
+    static_assert(nostd::_is_trivial_copy_contiguous<citer, iter>::value, "");
+    static_assert(nostd::_is_trivial_copy_contiguous<citer, int *>::value, "");
+    static_assert(!nostd::_is_trivial_copy_contiguous<iter, citer>::value, "");
+    static_assert(nostd::_is_trivial_fill_contiguous<iter>::value, "");
+    static_assert(nostd::_is_bitwise_equal_contiguous<citer, iter>::value, "");
+#if EASYSTL_CPLUSPLUS >= 202002L && defined(__cpp_lib_concepts)
+    static_assert(nostd::is_contiguous_iterator<std::vector<int>::iterator>::value, "");
+    static_assert(!nostd::is_contiguous_iterator<std::deque<int>::iterator>::value, "");
+#endif
+
+    int a[20];
+    for (int i = 0; i < 20; ++i) {
+        a[i] = i;
+    }
+    EXPECT_EQ(nostd::to_address(iter(a + 3)), a + 3);
+    EXPECT_EQ(nostd::to_address(a + 20), a + 20);
+
+    int b[20] = {};
+    citer first(a), last(a + 20);
+    EXPECT_TRUE(nostd::copy(first, last, iter(b)) == iter(b + 20));
+    EXPECT_TRUE(nostd::equal(first, last, citer(b)));
+    EXPECT_TRUE(nostd::copy_n(first, 5, iter(b + 10)) == iter(b + 15));
+    EXPECT_EQ(b[14], 4);
+    EXPECT_FALSE(nostd::equal(first, last, citer(b)));
+    EXPECT_TRUE(nostd::copy_backward(first, first + 5, iter(b + 20)) == iter(b + 15));
+    EXPECT_EQ(b[15], 0);
+    EXPECT_EQ(b[19], 4);
+
+    nostd::fill(iter(b), iter(b + 20), 7);
+    EXPECT_EQ(std::count(b, b + 20, 7), 20);
+    EXPECT_TRUE(nostd::fill_n(iter(b), 6, -1) == iter(b + 6));
+    EXPECT_EQ(b[5], -1);
+    EXPECT_EQ(b[6], 7);
+
+    // 反向迭代器不连续，走逐个元素的路径
+    int r[20];
+    nostd::copy(nostd::reverse_iterator<citer>(last), nostd::reverse_iterator<citer>(first), r);
+    EXPECT_EQ(r[0], 19);
+    EXPECT_EQ(r[19], 0);
+
+    // 集合运算的整数特化
+    int c[] = {1, 3, 5, 7, 9};
+    std::vector<int> out;
+    nostd::set_intersection(citer(a), citer(a + 20), citer(c), citer(c + 5), std::back_inserter(out));
+    EXPECT_EQ(out, std::vector<int>({1, 3, 5, 7, 9}));
+}
+
+TEST(AlgorithmTest, sort) {
+    std::mt19937_64 rng(42);
+    for (size_t n : {0, 1, 2, 15, 16, 17, 100, 1000, 10000}) {
+        std::vector<int> v(n);
+        for (int &x : v) {
+            x = static_cast<int>(rng() % (n / 2 + 1));  // 大量重复值
+        }
+        std::vector<int> expected = v;
+        std::sort(expected.begin(), expected.end());
+        nostd::sort(v.begin(), v.end());
+        EXPECT_EQ(v, expected);
+        EXPECT_TRUE(nostd::is_sorted(v.begin(), v.end()));
+    }
+
+    // 升序、降序、锯齿这些让朴素快排退化的输入
+    std::vector<int> asc(5000), desc(5000), saw(5000);
+    for (int i = 0; i < 5000; ++i) {
+        asc[i] = i;
+        desc[i] = 5000 - i;
+        saw[i] = i % 64;
+    }
+    for (std::vector<int> *v : {&asc, &desc, &saw}) {
+        nostd::sort(v->begin(), v->end());
+        EXPECT_TRUE(std::is_sorted(v->begin(), v->end()));
+    }
+
+    std::vector<std::string> strs = {"pear", "apple", "fig", "banana", "kiwi", "cherry"};
+    nostd::sort(strs.begin(), strs.end(), std::greater<std::string>());
+    EXPECT_EQ(strs, std::vector<std::string>({"pear", "kiwi", "fig", "cherry", "banana", "apple"}));
+
+    int a[] = {3, 1, 2};
+    EXPECT_EQ(nostd::is_sorted_until(a, a + 3), a + 1);
+    nostd::sort(a, a + 3);
+    EXPECT_TRUE(nostd::is_sorted(a, a + 3));
+}
+
+#if EASYSTL_CPLUSPLUS >= 201402L
+// 编译期生成的表：sort、copy、fill、find、lower_bound在常量表达式里求值
+namespace {
+
+struct sorted_table {
+    int v[40];
+};
+
+constexpr sorted_table make_sorted_table() {
+    sorted_table t{};
+    int src[40] = {};
+    nostd::fill(src, src + 40, 7);
+    for (int i = 0; i < 40; ++i) {
+        src[i] = (i * 37) % 40;  // 0..39的一个排列
+    }
+    nostd::copy(src, src + 40, t.v);
+    nostd::sort(t.v, t.v + 40);
+    return t;
+}
+
+constexpr sorted_table kTable = make_sorted_table();
+
+constexpr bool check_table() {
+    for (int i = 0; i < 40; ++i) {
+        if (kTable.v[i] != i) {
+            return false;
+        }
+    }
+    return nostd::is_sorted(kTable.v, kTable.v + 40) && *nostd::find(kTable.v, kTable.v + 40, 17) == 17 &&
+           nostd::lower_bound(kTable.v, kTable.v + 40, 25) == kTable.v + 25 &&
+           nostd::upper_bound(kTable.v, kTable.v + 40, 25) == kTable.v + 26 &&
+           nostd::binary_search(kTable.v, kTable.v + 40, 39) && nostd::equal(kTable.v, kTable.v + 40, kTable.v);
+}
+
+static_assert(check_table(), "constexpr sort/find/lower_bound");
+
+}  // namespace
+
+TEST(AlgorithmTest, constexpr_table) {
+    // 同一份表在运行期查找结果一致
+    EXPECT_EQ(nostd::lower_bound(kTable.v, kTable.v + 40, 10) - kTable.v, 10);
+    EXPECT_TRUE(check_table());
+}
+#endif
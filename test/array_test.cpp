@@ -0,0 +1,100 @@
+#include "container/array.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+TEST(ArrayTest, Basic) {
+    nostd::array<int, 5> a = {5, 3, 1, 4, 2};
+    EXPECT_EQ(a.size(), 5u);
+    EXPECT_FALSE(a.empty());
+    EXPECT_EQ(a.front(), 5);
+    EXPECT_EQ(a.back(), 2);
+    EXPECT_EQ(a[2], 1);
+    EXPECT_EQ(a.at(3), 4);
+    EXPECT_THROW(a.at(5), std::out_of_range);
+    EXPECT_EQ(a.end() - a.begin(), 5);
+    EXPECT_EQ(*a.rbegin(), 2);
+    EXPECT_EQ(nostd::get<1>(a), 3);
+
+    nostd::sort(a.begin(), a.end());
+    EXPECT_EQ(a, (nostd::array<int, 5>{1, 2, 3, 4, 5}));
+    nostd::array<int, 5> b = {};
+    b.fill(9);
+    EXPECT_EQ(b[4], 9);
+    EXPECT_LT(a, b);
+    swap(a, b);
+    EXPECT_EQ(a[0], 9);
+    EXPECT_EQ(b[0], 1);
+
+    nostd::array<std::string, 2> s = {"x", "y"};
+    EXPECT_EQ(s.at(1), "y");
+    EXPECT_EQ((std::tuple_size<nostd::array<std::string, 2>>::value), 2u);
+
+    nostd::array<int, 0> e = {};
+    EXPECT_TRUE(e.empty());
+    EXPECT_EQ(e.begin(), e.end());
+    EXPECT_EQ(e.data(), nullptr);
+    EXPECT_THROW(e.at(0), std::out_of_range);
+
+    EXPECT_TRUE((std::is_trivially_copyable<nostd::array<int, 4>>::value));
+    EXPECT_TRUE((nostd::is_trivially_relocatable<nostd::array<int, 4>>::value));
+}
+
+// C++11下const的访问就是constexpr的
+constexpr nostd::array<int, 3> kPrimes = {2, 3, 5};
+static_assert(kPrimes.size() == 3 && kPrimes[1] == 3 && kPrimes.back() == 5 && nostd::get<2>(kPrimes) == 5,
+              "constexpr array access");
+
+#if EASYSTL_CPLUSPLUS >= 201402L
+namespace {
+
+// CRC32查找表在编译期生成
+constexpr nostd::array<uint32_t, 256> make_crc_table() {
+    nostd::array<uint32_t, 256> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        t[i] = c;
+    }
+    return t;
+}
+
+constexpr nostd::array<uint32_t, 256> kCrcTable = make_crc_table();
+static_assert(kCrcTable[1] == 0x77073096u && kCrcTable[255] == 0x2D02EF8Du, "constexpr crc table");
+
+constexpr nostd::array<int, 6> make_sorted() {
+    nostd::array<int, 6> a = {6, 1, 5, 2, 4, 3};
+    nostd::array<int, 6> b{};
+    b.fill(0);
+    nostd::copy(a.begin(), a.end(), b.begin());
+    nostd::sort(b.begin(), b.end());
+    a.swap(b);
+    return a;
+}
+
+static_assert(make_sorted() == nostd::array<int, 6>{1, 2, 3, 4, 5, 6}, "constexpr sort on array");
+
+}  // namespace
+
+TEST(ArrayTest, ConstexprTables) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (char ch : std::string("123456789")) {
+        crc = kCrcTable[(crc ^ static_cast<uint8_t>(ch)) & 0xFF] ^ (crc >> 8);
+    }
+    EXPECT_EQ(crc ^ 0xFFFFFFFFu, 0xCBF43926u);
+}
+#endif
+
+#if EASYSTL_CPLUSPLUS >= 201703L
+TEST(ArrayTest, StructuredBinding) {
+    nostd::array<int, 3> a = {1, 2, 3};
+    auto [x, y, z] = a;
+    EXPECT_EQ(x + y + z, 6);
+}
+#endif
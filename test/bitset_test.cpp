@@ -0,0 +1,163 @@
+#include "container/bitset.h"
+
+#include <gtest/gtest.h>
+
+#include <bitset>
+#include <random>
+#include <vector>
+
+TEST(BitsetTest, BasicOperations) {
+    nostd::bitset<100> bs;
+    EXPECT_EQ(bs.size(), 100);
+    EXPECT_TRUE(bs.none());
+    bs.set(0).set(63).set(64).set(99);
+    EXPECT_EQ(bs.count(), 4);
+    EXPECT_TRUE(bs[63]);
+    EXPECT_FALSE(bs[62]);
+    EXPECT_TRUE(bs.test(99));
+    EXPECT_THROW(bs.test(100), std::out_of_range);
+
+    bs.reset(63);
+    EXPECT_FALSE(bs[63]);
+    bs.flip();
+    EXPECT_EQ(bs.count(), 97);  // 超出100位的部分不能被计入
+    bs.set();
+    EXPECT_TRUE(bs.all());
+    EXPECT_EQ((~bs).count(), 0);
+}
+
+TEST(BitsetTest, FindAndWordOps) {
+    nostd::bitset<200> a;
+    nostd::bitset<200> b;
+    a.set(3).set(70).set(150);
+    b.set(70).set(150).set(199);
+
+    EXPECT_EQ(a.find_first(), 3);
+    EXPECT_EQ(a.find_next(3), 70);
+    EXPECT_EQ(a.find_next(70), 150);
+    EXPECT_TRUE(a.find_next(150) == nostd::bitset<200>::npos);
+
+    EXPECT_EQ((a & b).count(), 2);
+    EXPECT_EQ((a | b).count(), 4);
+    EXPECT_EQ((a ^ b).count(), 2);
+    nostd::bitset<200> c = a;
+    c.andnot(b);
+    EXPECT_EQ(c.count(), 1);
+    EXPECT_TRUE(c[3]);
+    EXPECT_TRUE(a.intersects(b));
+    EXPECT_FALSE(c.intersects(b));
+}
+
+TEST(BitsetTest, ShiftMatchesStd) {
+    std::mt19937_64 rng(7);
+    nostd::bitset<190> mine;
+    std::bitset<190> expected;
+    for (int i = 0; i < 60; ++i) {
+        size_t pos = rng() % 190;
+        mine.set(pos);
+        expected.set(pos);
+    }
+    for (size_t shift : {0, 1, 13, 64, 65, 130, 189, 190}) {
+        nostd::bitset<190> l = mine << shift;
+        nostd::bitset<190> r = mine >> shift;
+        std::bitset<190> el = expected << shift;
+        std::bitset<190> er = expected >> shift;
+        for (size_t i = 0; i < 190; ++i) {
+            EXPECT_EQ(l[i], el[i]) << "shl " << shift << " bit " << i;
+            EXPECT_EQ(r[i], er[i]) << "shr " << shift << " bit " << i;
+        }
+        EXPECT_EQ(l.count(), el.count());
+    }
+}
+
+TEST(DynamicBitsetTest, ResizeAndPushBack) {
+    nostd::dynamic_bitset bs;
+    EXPECT_TRUE(bs.empty());
+    for (int i = 0; i < 130; ++i) {
+        bs.push_back(i % 3 == 0);
+    }
+    EXPECT_EQ(bs.size(), 130);
+    EXPECT_EQ(bs.count(), 44);
+    EXPECT_TRUE(bs[129]);
+    bs.pop_back();
+    EXPECT_EQ(bs.size(), 129);
+    EXPECT_EQ(bs.count(), 43);
+
+    bs.resize(300, true);
+    EXPECT_EQ(bs.count(), 43 + 171);
+    bs.resize(10);
+    EXPECT_EQ(bs.count(), 4);
+    bs.resize(200);
+    EXPECT_EQ(bs.count(), 4);  // 缩小时截掉的位不能残留
+    EXPECT_THROW(bs.set(200), std::out_of_range);
+}
+
+TEST(DynamicBitsetTest, BulkOpsMatchReference) {
+    const size_t n = 100003;
+    std::mt19937_64 rng(11);
+    nostd::dynamic_bitset a(n);
+    nostd::dynamic_bitset b(n);
+    std::vector<bool> ra(n), rb(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (rng() % 5 == 0) {
+            a.set(i);
+            ra[i] = true;
+        }
+        if (rng() % 3 == 0) {
+            b.set(i);
+            rb[i] = true;
+        }
+    }
+    size_t and_cnt = 0, or_cnt = 0, xor_cnt = 0, andnot_cnt = 0, a_cnt = 0;
+    for (size_t i = 0; i < n; ++i) {
+        a_cnt += ra[i];
+        and_cnt += ra[i] && rb[i];
+        or_cnt += ra[i] || rb[i];
+        xor_cnt += ra[i] != rb[i];
+        andnot_cnt += ra[i] && !rb[i];
+    }
+    EXPECT_EQ(a.count(), a_cnt);
+    EXPECT_EQ((a & b).count(), and_cnt);
+    EXPECT_EQ((a | b).count(), or_cnt);
+    EXPECT_EQ((a ^ b).count(), xor_cnt);
+    nostd::dynamic_bitset c(a);
+    c.andnot(b);
+    EXPECT_EQ(c.count(), andnot_cnt);
+    EXPECT_EQ((~a).count(), n - a_cnt);
+
+    // find_first/find_next遍历所有的1位
+    size_t visited = 0;
+    size_t prev = 0;
+    for (size_t i = a.find_first(); i != nostd::dynamic_bitset::npos; i = a.find_next(i)) {
+        EXPECT_TRUE(ra[i]);
+        if (visited > 0) {
+            EXPECT_GT(i, prev);
+        }
+        prev = i;
+        ++visited;
+    }
+    EXPECT_EQ(visited, a_cnt);
+
+    nostd::dynamic_bitset small(10);
+    EXPECT_THROW(a &= small, std::invalid_argument);
+}
+
+TEST(DynamicBitsetTest, CopyMoveAndIterate) {
+    nostd::bit_vector v(70);
+    v.set(1).set(69);
+    nostd::bit_vector copy = v;
+    EXPECT_TRUE(copy == v);
+    nostd::bit_vector moved(std::move(copy));
+    EXPECT_TRUE(moved == v);
+    copy = moved;
+    EXPECT_TRUE(copy == v);
+
+    // 迭代器解引用得到的是bool值，auto不会推导出代理对象
+    size_t ones = 0;
+    for (auto bit : v) {
+        ones += bit;
+    }
+    EXPECT_EQ(ones, 2);
+    EXPECT_EQ(v.end() - v.begin(), 70);
+    EXPECT_TRUE(*(v.begin() + 69));
+}
@@ -0,0 +1,264 @@
+#include "base/charconv.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace {
+
+template <class T>
+std::string to_str(T v) {
+    char buf[64];
+    nostd::to_chars_result r = nostd::to_chars(buf, buf + sizeof(buf), v);
+    EXPECT_EQ(r.ec, std::errc());
+    return std::string(buf, r.ptr);
+}
+
+template <class T>
+T parse(const std::string &s, std::errc expect = std::errc()) {
+    T v = T();
+    nostd::from_chars_result r = nostd::from_chars(s.data(), s.data() + s.size(), v);
+    EXPECT_EQ(r.ec, expect) << s;
+    return v;
+}
+
+uint64_t bits_of(double d) {
+    uint64_t b;
+    std::memcpy(&b, &d, sizeof(b));
+    return b;
+}
+
+uint32_t bits_of(float f) {
+    uint32_t b;
+    std::memcpy(&b, &f, sizeof(b));
+    return b;
+}
+
+}  // namespace
+
+TEST(CharconvTest, IntegerToChars) {
+    EXPECT_EQ(to_str(0), "0");
+    EXPECT_EQ(to_str(7), "7");
+    EXPECT_EQ(to_str(-42), "-42");
+    EXPECT_EQ(to_str(1000000), "1000000");
+    EXPECT_EQ(to_str(std::numeric_limits<int>::min()), "-2147483648");
+    EXPECT_EQ(to_str(std::numeric_limits<int64_t>::min()), "-9223372036854775808");
+    EXPECT_EQ(to_str(std::numeric_limits<uint64_t>::max()), "18446744073709551615");
+    EXPECT_EQ(to_str(static_cast<signed char>(-128)), "-128");
+
+    char buf[16];
+    nostd::to_chars_result r = nostd::to_chars(buf, buf + sizeof(buf), 255, 16);
+    EXPECT_EQ(std::string(buf, r.ptr), "ff");
+    r = nostd::to_chars(buf, buf + sizeof(buf), -5, 2);
+    EXPECT_EQ(std::string(buf, r.ptr), "-101");
+
+    r = nostd::to_chars(buf, buf + 3, 12345);
+    EXPECT_EQ(r.ec, std::errc::value_too_large);
+    EXPECT_EQ(r.ptr, buf + 3);
+}
+
+TEST(CharconvTest, IntegerRoundTrip) {
+    std::mt19937_64 rng(1);
+    for (int i = 0; i < 10000; ++i) {
+        int64_t v = static_cast<int64_t>(rng()) >> (rng() % 64);
+        EXPECT_EQ(to_str(v), std::to_string(v));
+        EXPECT_EQ(parse<int64_t>(to_str(v)), v);
+    }
+    for (uint64_t p = 1, i = 0; i < 20; ++i, p *= 10) {
+        EXPECT_EQ(to_str(p), std::to_string(p));
+        EXPECT_EQ(to_str(p - 1), std::to_string(p - 1));
+    }
+}
+
+TEST(CharconvTest, IntegerFromChars) {
+    EXPECT_EQ(parse<int>("123abc"), 123);
+    EXPECT_EQ(parse<int>("-2147483648"), std::numeric_limits<int>::min());
+    EXPECT_EQ(parse<uint8_t>("255"), 255);
+    EXPECT_EQ(parse<int>("7fffffff", std::errc()), 7);
+
+    int v = 99;
+    const char *s = "2147483648xyz";
+    nostd::from_chars_result r = nostd::from_chars(s, s + std::strlen(s), v);
+    EXPECT_EQ(r.ec, std::errc::result_out_of_range);
+    EXPECT_EQ(r.ptr, s + 10);
+    EXPECT_EQ(v, 99);
+
+    parse<uint8_t>("256", std::errc::result_out_of_range);
+    parse<unsigned>("-1", std::errc::invalid_argument);
+    parse<int>("+1", std::errc::invalid_argument);
+    parse<int>("-", std::errc::invalid_argument);
+    parse<int>("", std::errc::invalid_argument);
+
+    s = "zz";
+    r = nostd::from_chars(s, s + 2, v, 36);
+    EXPECT_EQ(r.ec, std::errc());
+    EXPECT_EQ(v, 35 * 36 + 35);
+
+    // base不在[2, 36]之间
+    v = 99;
+    s = "10";
+    for (int base : {0, 1, 37, -1}) {
+        r = nostd::from_chars(s, s + 2, v, base);
+        EXPECT_EQ(r.ec, std::errc::invalid_argument);
+        EXPECT_EQ(r.ptr, s);
+        EXPECT_EQ(v, 99);
+    }
+    // 不接受"0x"前缀
+    s = "0x1f";
+    r = nostd::from_chars(s, s + 4, v, 16);
+    EXPECT_EQ(r.ec, std::errc());
+    EXPECT_EQ(r.ptr, s + 1);
+    EXPECT_EQ(v, 0);
+}
+
+TEST(CharconvTest, DoubleToChars) {
+    EXPECT_EQ(to_str(0.0), "0");
+    EXPECT_EQ(to_str(-0.0), "-0");
+    EXPECT_EQ(to_str(1.0), "1");
+    EXPECT_EQ(to_str(0.1), "0.1");
+    EXPECT_EQ(to_str(-1.5), "-1.5");
+    EXPECT_EQ(to_str(100.0), "100");
+    EXPECT_EQ(to_str(123456.789), "123456.789");
+    EXPECT_EQ(to_str(0.001), "0.001");
+    EXPECT_EQ(to_str(0.0001), "1e-04");
+    EXPECT_EQ(to_str(1e20), "1e+20");
+    EXPECT_EQ(to_str(1e100), "1e+100");
+    EXPECT_EQ(to_str(5e-324), "5e-324");
+    EXPECT_EQ(to_str(1.7976931348623157e308), "1.7976931348623157e+308");
+    EXPECT_EQ(to_str(2.2250738585072014e-308), "2.2250738585072014e-308");
+    EXPECT_EQ(to_str(std::numeric_limits<double>::infinity()), "inf");
+    EXPECT_EQ(to_str(-std::numeric_limits<double>::infinity()), "-inf");
+    EXPECT_EQ(to_str(std::numeric_limits<double>::quiet_NaN()), "nan");
+    EXPECT_EQ(to_str(0.3f), "0.3");
+    EXPECT_EQ(to_str(3.4028235e38f), "3.4028235e+38");
+
+    char buf[4];
+    nostd::to_chars_result r = nostd::to_chars(buf, buf + sizeof(buf), 0.125);
+    EXPECT_EQ(r.ec, std::errc::value_too_large);
+}
+
+// 写出的串必须能被strtod读回原值，并且不超过17位有效数字
+TEST(CharconvTest, DoubleRoundTrip) {
+    std::mt19937_64 rng(2);
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t b = rng();
+        double d;
+        std::memcpy(&d, &b, sizeof(d));
+        if (!std::isfinite(d)) {
+            continue;
+        }
+        std::string s = to_str(d);
+        ASSERT_EQ(bits_of(std::strtod(s.c_str(), nullptr)), b) << s;
+        ASSERT_EQ(bits_of(parse<double>(s)), b) << s;
+        // 有效数字：第一个和最后一个非0数字之间的数字个数
+        size_t first = std::string::npos, last = 0, points = 0;
+        for (size_t j = 0; j < s.size() && s[j] != 'e'; ++j) {
+            if (s[j] >= '1' && s[j] <= '9') {
+                first = first == std::string::npos ? j : first;
+                last = j;
+            }
+        }
+        for (size_t j = first; j < last; ++j) {
+            points += s[j] == '.' ? 1 : 0;
+        }
+        ASSERT_LE(last - first + 1 - points, 17u) << s;
+    }
+    for (int i = 0; i < 20000; ++i) {
+        uint32_t b = static_cast<uint32_t>(rng());
+        float f;
+        std::memcpy(&f, &b, sizeof(f));
+        if (!std::isfinite(f)) {
+            continue;
+        }
+        std::string s = to_str(f);
+        ASSERT_EQ(bits_of(std::strtof(s.c_str(), nullptr)), b) << s;
+        ASSERT_EQ(bits_of(parse<float>(s)), b) << s;
+    }
+}
+
+// 和strtod逐位比较，覆盖快速路径、Eisel-Lemire和大整数精确比较
+TEST(CharconvTest, DoubleFromChars) {
+    const char *cases[] = {
+        "0", "1", "0.1", "3.14159", "1e23", "8.98846567431158e307", "2.2250738585072011e-308",
+        "4.9406564584124654e-324", "2.4703282292062328e-324", "2.4703282292062327e-324",
+        "9007199254740993", "9007199254740992.5", "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203124",
+        "1.00000000000000011102230246251565404236316680908203126",
+        "7.2057594037927933e16", "123456789012345678901234567890", "0.000000000000000000000000000001",
+        "1.7976931348623158e308", "179769313486231580793728971405301e276",
+    };
+    for (const char *s : cases) {
+        // 非零输入舍入成0或无穷大时返回result_out_of_range
+        const bool zero = std::strcmp(s, "0") == 0;
+        const double d = std::strtod(s, nullptr);
+        if (d == 0 && !zero) {
+            parse<double>(s, std::errc::result_out_of_range);
+        } else {
+            EXPECT_EQ(bits_of(parse<double>(s)), bits_of(d)) << s;
+        }
+        const float f = std::strtof(s, nullptr);
+        const bool f_range = f == HUGE_VALF || (f == 0 && !zero);
+        EXPECT_EQ(bits_of(parse<float>(s, f_range ? std::errc::result_out_of_range : std::errc())), f_range ? bits_of(0.0f) : bits_of(f))
+            << s;
+    }
+
+    std::mt19937_64 rng(3);
+    char buf[128];
+    for (int i = 0; i < 50000; ++i) {
+        int n = std::snprintf(buf, sizeof(buf), "%llu.%llue%d", static_cast<unsigned long long>(rng() >> (rng() % 64)),
+                              static_cast<unsigned long long>(rng()), static_cast<int>(rng() % 640) - 330);
+        std::string s(buf, static_cast<size_t>(n));
+        double expect = std::strtod(buf, nullptr);
+        if (std::isinf(expect) || expect == 0) {
+            parse<double>(s, std::errc::result_out_of_range);
+        } else {
+            ASSERT_EQ(bits_of(parse<double>(s)), bits_of(expect)) << s;
+        }
+    }
+}
+
+TEST(CharconvTest, FloatFromCharsSpecial) {
+    EXPECT_EQ(bits_of(parse<double>("-0")), bits_of(-0.0));
+    EXPECT_EQ(bits_of(parse<double>("0e-400")), bits_of(0.0));
+    EXPECT_EQ(bits_of(parse<double>("0.000")), bits_of(0.0));
+    // 下溢：value不变
+    double u = 7.0;
+    const char *us = "1e-400";
+    nostd::from_chars_result ur = nostd::from_chars(us, us + std::strlen(us), u);
+    EXPECT_EQ(ur.ec, std::errc::result_out_of_range);
+    EXPECT_EQ(ur.ptr, us + 6);
+    EXPECT_EQ(u, 7.0);
+    parse<double>("-2.4703282292062327e-324", std::errc::result_out_of_range);
+    parse<float>("1e-46", std::errc::result_out_of_range);
+    EXPECT_EQ(bits_of(parse<double>("4.9406564584124654e-324")), bits_of(std::numeric_limits<double>::denorm_min()));
+    EXPECT_TRUE(std::isinf(parse<double>("inf")));
+    EXPECT_TRUE(std::isinf(parse<double>("-Infinity")));
+    EXPECT_TRUE(std::isnan(parse<double>("nan")));
+    EXPECT_TRUE(std::isnan(parse<double>("NaN(123)")));
+    parse<double>("1e309", std::errc::result_out_of_range);
+    parse<float>("1e39", std::errc::result_out_of_range);
+    parse<double>(".", std::errc::invalid_argument);
+    parse<double>("e5", std::errc::invalid_argument);
+    parse<double>("+1", std::errc::invalid_argument);
+    parse<double>("in", std::errc::invalid_argument);
+
+    // 不完整的指数不被消费
+    double v = 0;
+    const char *s = "2.5e+x";
+    nostd::from_chars_result r = nostd::from_chars(s, s + std::strlen(s), v);
+    EXPECT_EQ(r.ec, std::errc());
+    EXPECT_EQ(r.ptr, s + 3);
+    EXPECT_EQ(v, 2.5);
+
+    s = ".5e1";
+    r = nostd::from_chars(s, s + std::strlen(s), v);
+    EXPECT_EQ(r.ptr, s + 4);
+    EXPECT_EQ(v, 5.0);
+}
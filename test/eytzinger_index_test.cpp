@@ -0,0 +1,78 @@
+#include "container/eytzinger_index.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+TEST(EytzingerIndexTest, Empty) {
+    nostd::eytzinger_index<int> idx;
+    EXPECT_TRUE(idx.empty());
+    EXPECT_EQ(idx.lower_bound(1), nullptr);
+    EXPECT_FALSE(idx.contains(1));
+
+    nostd::vector<int> none;
+    nostd::eytzinger_index<int> idx2(none);
+    EXPECT_EQ(idx2.size(), 0);
+    EXPECT_EQ(idx2.upper_bound(0), nullptr);
+}
+
+TEST(EytzingerIndexTest, MatchesSortedArray) {
+    std::mt19937_64 rng(11);
+    for (size_t n : {1, 2, 3, 7, 8, 15, 16, 17, 100, 1023, 1024, 1025, 5000}) {
+        std::vector<uint32_t> ref;
+        for (size_t i = 0; i < n; ++i) {
+            ref.push_back(static_cast<uint32_t>(rng() % (3 * n)));
+        }
+        std::sort(ref.begin(), ref.end());
+        nostd::vector<uint32_t> sorted;
+        for (uint32_t x : ref) {
+            sorted.push_back(x);
+        }
+        nostd::eytzinger_index<uint32_t> idx(sorted);
+        ASSERT_EQ(idx.size(), n);
+        for (uint32_t x = 0; x <= 3 * n + 1; ++x) {
+            auto lo = std::lower_bound(ref.begin(), ref.end(), x);
+            auto hi = std::upper_bound(ref.begin(), ref.end(), x);
+            const uint32_t *p = idx.lower_bound(x);
+            const uint32_t *q = idx.upper_bound(x);
+            if (lo == ref.end()) {
+                EXPECT_EQ(p, nullptr);
+            } else {
+                ASSERT_NE(p, nullptr);
+                EXPECT_EQ(*p, *lo);
+            }
+            if (hi == ref.end()) {
+                EXPECT_EQ(q, nullptr);
+            } else {
+                ASSERT_NE(q, nullptr);
+                EXPECT_EQ(*q, *hi);
+            }
+            EXPECT_EQ(idx.contains(x), std::binary_search(ref.begin(), ref.end(), x));
+        }
+    }
+}
+
+TEST(EytzingerIndexTest, KeyWithPayload) {
+    struct entry {
+        uint64_t key;
+        int payload;
+    };
+    struct by_key {
+        bool operator()(const entry &a, const entry &b) const { return a.key < b.key; }
+        bool operator()(const entry &a, uint64_t k) const { return a.key < k; }
+        bool operator()(uint64_t k, const entry &a) const { return k < a.key; }
+    };
+    nostd::vector<entry> table;
+    for (int i = 0; i < 300; ++i) {
+        table.push_back(entry{static_cast<uint64_t>(i) * 10, i});
+    }
+    nostd::eytzinger_index<entry, by_key> idx(table);
+    ASSERT_NE(idx.find(uint64_t(1230)), nullptr);
+    EXPECT_EQ(idx.find(uint64_t(1230))->payload, 123);
+    EXPECT_EQ(idx.find(uint64_t(1231)), nullptr);
+    EXPECT_EQ(idx.lower_bound(uint64_t(1231))->payload, 124);
+    EXPECT_EQ(idx.lower_bound(uint64_t(5000)), nullptr);
+}
@@ -0,0 +1,185 @@
+#include "container/format.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct point {
+    int x;
+    int y;
+};
+
+std::string str(const nostd::string &s) { return std::string(s.data(), s.size()); }
+
+}  // namespace
+
+namespace nostd {
+
+template <>
+struct formatter<point> {
+    static void format(string_builder &b, const point &p, const format_spec &) { b.format("({}, {})", p.x, p.y); }
+};
+
+}  // namespace nostd
+
+TEST(FormatTest, BasicTest) {
+    EXPECT_EQ(str(nostd::format("hello")), "hello");
+    EXPECT_EQ(str(nostd::format("{} + {} = {}", 1, 2, 3)), "1 + 2 = 3");
+    EXPECT_EQ(str(nostd::format("{1} {0} {1}", "a", "b")), "b a b");
+    EXPECT_EQ(str(nostd::format("{{{}}}", 7)), "{7}");
+    EXPECT_EQ(str(nostd::format("}}{{")), "}{");
+    EXPECT_EQ(str(nostd::format("{} {} {}", true, 'x', nostd::string("str"))), "true x str");
+    EXPECT_EQ(str(nostd::format("{}", nostd::string_view("view"))), "view");
+    EXPECT_EQ(str(nostd::format("{} {}", 0.1, 1e100)), "0.1 1e+100");
+    EXPECT_EQ(str(nostd::format("{}", 0.3f)), "0.3");
+    EXPECT_EQ(str(nostd::format("{} {}", std::numeric_limits<long long>::min(), std::numeric_limits<uint64_t>::max())),
+              "-9223372036854775808 18446744073709551615");
+    EXPECT_EQ(str(nostd::format("{}", point{1, -2})), "(1, -2)");
+    EXPECT_EQ(str(nostd::format("{:>8}", point{1, 2})), "  (1, 2)");
+    EXPECT_EQ(str(nostd::format("{}", nullptr)), "0x0");
+    EXPECT_EQ(str(nostd::format("{}", reinterpret_cast<const int *>(0x1234))), "0x1234");
+
+    nostd::string out("x=");
+    nostd::format_to(out, "{},y={}", 1, 2);
+    EXPECT_EQ(str(out), "x=1,y=2");
+}
+
+TEST(FormatTest, SpecTest) {
+    EXPECT_EQ(str(nostd::format("[{:5}]", 42)), "[   42]");
+    EXPECT_EQ(str(nostd::format("[{:<5}]", 42)), "[42   ]");
+    EXPECT_EQ(str(nostd::format("[{:*^7}]", "ab")), "[**ab***]");
+    EXPECT_EQ(str(nostd::format("[{:5}]", "ab")), "[ab   ]");
+    EXPECT_EQ(str(nostd::format("[{:.2}]", "abcdef")), "[ab]");
+    EXPECT_EQ(str(nostd::format("[{:05}]", -42)), "[-0042]");
+    EXPECT_EQ(str(nostd::format("[{:+}] [{: }] [{:+}]", 5, 5, -5)), "[+5] [ 5] [-5]");
+    EXPECT_EQ(str(nostd::format("{:x} {:X} {:#x} {:b} {:#B} {:o} {:#o}", 255, 255, 255, 5, 5, 8, 8)),
+              "ff FF 0xff 101 0B101 10 010");
+    EXPECT_EQ(str(nostd::format("[{:#010x}]", 255)), "[0x000000ff]");
+    EXPECT_EQ(str(nostd::format("{:c}{:d}{:x}", 65, 'A', 'A')), "A6541");
+    EXPECT_EQ(str(nostd::format("{:d} {:s}", true, false)), "1 false");
+    EXPECT_EQ(str(nostd::format("{:.3f} {:.2e} {:E} {:g}", 3.14159, 12345.678, 0.5, 1e-5)),
+              "3.142 1.23e+04 5.000000E-01 1e-05");
+    EXPECT_EQ(str(nostd::format("[{:08.3f}] [{:+.1f}] [{:>7}]", -1.5, 2.25, 1.5)), "[-001.500] [+2.2] [    1.5]");
+    EXPECT_EQ(str(nostd::format("{:f} {:F}", std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity())),
+              "inf -INF");
+    EXPECT_EQ(str(nostd::format("[{:06}]", std::numeric_limits<double>::quiet_NaN())), "[   nan]");
+    EXPECT_EQ(str(nostd::format("{:.0f} {:.0f} {:.0f}", 0.5, 1.5, 2.5)), "0 2 2");
+}
+
+// 带精度的浮点数逐字节和snprintf比较
+TEST(FormatTest, FloatPrecisionTest) {
+    std::mt19937_64 rng(4);
+    const char *specs[] = {"%.*f", "%.*e", "%.*g"};
+    nostd::chars_format fmts[] = {nostd::chars_format::fixed, nostd::chars_format::scientific,
+                                  nostd::chars_format::general};
+    char expect[2048], buf[2048];
+    for (int i = 0; i < 30000; ++i) {
+        uint64_t bits = rng();
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        if (i % 2 == 0) {
+            d = static_cast<double>(static_cast<int64_t>(rng() % 2000000) - 1000000) / static_cast<double>(1 + rng() % 1000);
+        }
+        if (!std::isfinite(d)) {
+            continue;
+        }
+        int k = static_cast<int>(rng() % 3);
+        int precision = static_cast<int>(rng() % (i % 100 == 0 ? 800 : 20));
+        if (k == 0 && std::fabs(d) > 1e300) {
+            precision %= 20;
+        }
+        int n = std::snprintf(expect, sizeof(expect), specs[k], precision, d);
+        nostd::to_chars_result r = nostd::to_chars(buf, buf + sizeof(buf), d, fmts[k], precision);
+        ASSERT_EQ(r.ec, std::errc());
+        ASSERT_EQ(std::string(buf, r.ptr), std::string(expect, static_cast<size_t>(n))) << specs[k] << " " << precision;
+    }
+
+    EXPECT_EQ(str(nostd::format("{:.10f}", 0.1f)), "0.1000000015");
+    EXPECT_EQ(str(nostd::format("{:.3f}", 5e-324)), "0.000");
+    EXPECT_EQ(str(nostd::format("{:.1e}", 9.96)), "1.0e+01");
+
+    char out[32];
+    nostd::to_chars_result r = nostd::to_chars(out, out + sizeof(out), 1e-7, nostd::chars_format::fixed);
+    EXPECT_EQ(std::string(out, r.ptr), "0.0000001");
+    r = nostd::to_chars(out, out + sizeof(out), 1234.5, nostd::chars_format::scientific);
+    EXPECT_EQ(std::string(out, r.ptr), "1.2345e+03");
+}
+
+// '#'：总是带小数点，g格式保留末尾的0，和printf的"%#"一致
+TEST(FormatTest, FloatAltTest) {
+    EXPECT_EQ(str(nostd::format("{:#.0f}", 12.0)), "12.");
+    EXPECT_EQ(str(nostd::format("{:#.0e}", 12.0)), "1.e+01");
+    EXPECT_EQ(str(nostd::format("{:#.0E}", 12.0)), "1.E+01");
+    EXPECT_EQ(str(nostd::format("{:#g}", 1.5)), "1.50000");
+    EXPECT_EQ(str(nostd::format("{:#.3g}", 100.0)), "100.");
+    EXPECT_EQ(str(nostd::format("{:#.2g}", 0.0001)), "0.00010");
+    EXPECT_EQ(str(nostd::format("{:#G}", 1e-10)), "1.00000E-10");
+    EXPECT_EQ(str(nostd::format("{:#}", 1.0)), "1.");
+    EXPECT_EQ(str(nostd::format("{:#}", 1e21)), "1.e+21");
+    EXPECT_EQ(str(nostd::format("{:#}", 0.5)), "0.5");
+    EXPECT_EQ(str(nostd::format("{:+#08.0f}", 3.0)), "+000003.");
+    EXPECT_EQ(str(nostd::format("{:#f}", std::numeric_limits<double>::infinity())), "inf");
+
+    std::mt19937_64 rng(5);
+    const char *specs[] = {"%#.*f", "%#.*e", "%#.*g"};
+    const char types[] = {'f', 'e', 'g'};
+    char expect[512], spec[32];
+    for (int i = 0; i < 20000; ++i) {
+        double d = static_cast<double>(static_cast<int64_t>(rng() % 2000000) - 1000000) /
+                   static_cast<double>(1 + rng() % 100000) * std::pow(10.0, static_cast<int>(rng() % 30) - 15);
+        int k = static_cast<int>(rng() % 3);
+        int precision = static_cast<int>(rng() % 12);
+        int n = std::snprintf(expect, sizeof(expect), specs[k], precision, d);
+        std::snprintf(spec, sizeof(spec), "{:#.%d%c}", precision, types[k]);
+        ASSERT_EQ(str(nostd::format(nostd::runtime_format(spec), d)), std::string(expect, static_cast<size_t>(n)))
+            << specs[k] << " " << precision << " " << d;
+    }
+}
+
+TEST(FormatTest, BuilderTest) {
+    nostd::string_builder b(64);
+    EXPECT_TRUE(b.empty());
+    EXPECT_GE(b.capacity(), 64u);
+    b << "n=" << 42 << ' ' << 2.5 << ' ' << true;
+    b.append(", ").append(-7).append(0.25f);
+    b.format(" [{:>4}]", "x");
+    EXPECT_EQ(std::string(b.data(), b.size()), "n=42 2.5 true, -70.25 [   x]");
+    EXPECT_EQ(b.view(), nostd::string_view("n=42 2.5 true, -70.25 [   x]"));
+
+    const char *before = b.data();
+    nostd::string s = b.release();
+    EXPECT_EQ(s.data(), before);
+    EXPECT_TRUE(b.empty());
+
+    for (int i = 0; i < 1000; ++i) {
+        b << i;
+    }
+    EXPECT_EQ(b.size(), 10u + 90u * 2 + 900u * 3);
+    b.clear();
+    EXPECT_EQ(b.size(), 0u);
+}
+
+TEST(FormatTest, ErrorTest) {
+    EXPECT_THROW(nostd::format(nostd::runtime_format("{} {}"), 1), std::invalid_argument);
+    EXPECT_THROW(nostd::format(nostd::runtime_format("{"), 1), std::invalid_argument);
+    EXPECT_THROW(nostd::format(nostd::runtime_format("}"), 1), std::invalid_argument);
+    EXPECT_THROW(nostd::format(nostd::runtime_format("{0} {}"), 1, 2), std::invalid_argument);
+    EXPECT_THROW(nostd::format(nostd::runtime_format("{:d}"), "str"), std::invalid_argument);
+    EXPECT_THROW(nostd::format(nostd::runtime_format("{:s}"), 1.0), std::invalid_argument);
+    EXPECT_THROW(nostd::format(nostd::runtime_format("{:5x5}"), 1), std::invalid_argument);
+    EXPECT_THROW(nostd::format(nostd::runtime_format("{:c}"), 300), std::invalid_argument);
+
+    // 出错时format_to不改变原内容
+    nostd::string out("keep");
+    EXPECT_THROW(nostd::format_to(out, nostd::runtime_format("{}{}"), 1), std::invalid_argument);
+    EXPECT_EQ(str(out), "keep");
+}
@@ -0,0 +1,165 @@
+#include "base/memory.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "base/allocator.h"
+
+namespace {
+
+// 第throw_at次复制时抛异常，live统计存活的对象个数
+struct tracked {
+    static int live;
+    static int copies;
+    static int throw_at;
+
+    int value;
+
+    tracked()
+        : value(-1) { ++live; }
+    tracked(int v)
+        : value(v) { ++live; }
+    tracked(const tracked &other)
+        : value(other.value) {
+        if (++copies == throw_at) {
+            throw std::runtime_error("copy");
+        }
+        ++live;
+    }
+    // 移动可能抛异常，relocate应该退化为复制
+    tracked(tracked &&other)
+        : value(other.value) {
+        ++live;
+        other.value = -2;
+    }
+    ~tracked() { --live; }
+
+    static void reset(int at) {
+        live = 0;
+        copies = 0;
+        throw_at = at;
+    }
+};
+int tracked::live = 0;
+int tracked::copies = 0;
+int tracked::throw_at = 0;
+
+template <typename T>
+struct raw_buffer {
+    explicit raw_buffer(size_t n)
+        : p(nostd::allocator<T>::allocate(n)), n(n) {}
+    ~raw_buffer() { nostd::allocator<T>::deallocate(p, n); }
+    T *p;
+    size_t n;
+};
+
+}  // namespace
+
+TEST(MemoryTest, UninitializedCopyTrivial) {
+    int src[] = {1, 2, 3, 4, 5};
+    raw_buffer<int> buf(5);
+    EXPECT_EQ(nostd::uninitialized_copy(src, src + 5, buf.p), buf.p + 5);
+    EXPECT_EQ(buf.p[4], 5);
+    const int *csrc = src;
+    EXPECT_EQ(nostd::uninitialized_copy_n(csrc, 3, buf.p), buf.p + 3);
+    EXPECT_EQ(nostd::uninitialized_move_n(src, 2, buf.p), buf.p + 2);
+    nostd::uninitialized_fill_n(buf.p, 5, 9);
+    EXPECT_EQ(buf.p[0] + buf.p[4], 18);
+
+    // 不同类型之间走逐个构造
+    raw_buffer<long> lbuf(5);
+    EXPECT_EQ(nostd::uninitialized_copy(src, src + 5, lbuf.p), lbuf.p + 5);
+    EXPECT_EQ(lbuf.p[2], 3L);
+}
+
+TEST(MemoryTest, UninitializedCopyRethrows) {
+    std::vector<tracked> src(6);
+    tracked::reset(4);
+    raw_buffer<tracked> buf(6);
+    EXPECT_THROW(nostd::uninitialized_copy(src.begin(), src.end(), buf.p), std::runtime_error);
+    EXPECT_EQ(tracked::live, 0);  // 已构造的3个都被析构了
+
+    tracked::reset(2);
+    EXPECT_THROW(nostd::uninitialized_fill_n(buf.p, 6, src[0]), std::runtime_error);
+    EXPECT_EQ(tracked::live, 0);
+
+    tracked::reset(5);
+    EXPECT_THROW(nostd::uninitialized_fill(buf.p, buf.p + 6, src[0]), std::runtime_error);
+    EXPECT_EQ(tracked::live, 0);
+
+    tracked::reset(3);
+    EXPECT_THROW(nostd::uninitialized_copy_n(src.begin(), 6, buf.p), std::runtime_error);
+    EXPECT_EQ(tracked::live, 0);
+}
+
+TEST(MemoryTest, ValueAndDefaultConstruct) {
+    raw_buffer<int> buf(8);
+    nostd::fill(buf.p, buf.p + 8, 7);
+    nostd::uninitialized_value_construct(buf.p, buf.p + 8);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(buf.p[i], 0);
+    }
+    nostd::fill(buf.p, buf.p + 8, 7);
+    EXPECT_EQ(nostd::uninitialized_default_construct_n(buf.p, 8), buf.p + 8);
+    EXPECT_EQ(buf.p[3], 7);  // 平凡类型不清零
+
+    tracked::reset(0);
+    raw_buffer<tracked> tbuf(4);
+    nostd::uninitialized_default_construct(tbuf.p, tbuf.p + 4);
+    EXPECT_EQ(tracked::live, 4);
+    EXPECT_EQ(tbuf.p[3].value, -1);
+    nostd::destroy(tbuf.p, tbuf.p + 4);
+    EXPECT_EQ(nostd::uninitialized_value_construct_n(tbuf.p, 4), tbuf.p + 4);
+    EXPECT_EQ(tracked::live, 4);
+    EXPECT_EQ(tracked::copies, 0);  // 原地值初始化，不从临时对象复制
+    nostd::destroy(tbuf.p, tbuf.p + 4);
+
+    // 只能移动的类型
+    raw_buffer<std::unique_ptr<int>> ubuf(3);
+    EXPECT_EQ(nostd::uninitialized_value_construct_n(ubuf.p, 3), ubuf.p + 3);
+    EXPECT_EQ(ubuf.p[2], nullptr);
+    nostd::destroy(ubuf.p, ubuf.p + 3);
+}
+
+TEST(MemoryTest, Relocate) {
+    raw_buffer<std::string> from(3), to(3);
+    nostd::construct(from.p, "alpha");
+    nostd::construct(from.p + 1, std::string(100, 'x'));
+    nostd::construct(from.p + 2, "gamma");
+    EXPECT_EQ(nostd::uninitialized_relocate(from.p, from.p + 3, to.p), to.p + 3);
+    EXPECT_EQ(to.p[0], "alpha");
+    EXPECT_EQ(to.p[1].size(), 100);
+    nostd::destroy(to.p, to.p + 3);
+
+    int ints[] = {1, 2, 3};
+    raw_buffer<int> ibuf(3);
+    EXPECT_EQ(nostd::uninitialized_relocate_n(ints, 3, ibuf.p), ibuf.p + 3);
+    EXPECT_EQ(ibuf.p[2], 3);
+}
+
+TEST(MemoryTest, RelocateStrongGuarantee) {
+    // tracked的移动构造不是noexcept，relocate用复制构造，失败时源对象不受影响
+    tracked::reset(0);
+    raw_buffer<tracked> from(4), to(4);
+    for (int i = 0; i < 4; ++i) {
+        nostd::construct(from.p + i, i);
+    }
+    tracked::throw_at = 3;
+    EXPECT_THROW(nostd::uninitialized_relocate(from.p, from.p + 4, to.p), std::runtime_error);
+    EXPECT_EQ(tracked::live, 4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(from.p[i].value, i);
+    }
+
+    tracked::reset(0);
+    tracked::live = 4;
+    nostd::uninitialized_relocate(from.p, from.p + 4, to.p);
+    EXPECT_EQ(tracked::live, 4);
+    EXPECT_EQ(to.p[3].value, 3);
+    nostd::destroy(to.p, to.p + 4);
+    EXPECT_EQ(tracked::live, 0);
+}
@@ -0,0 +1,134 @@
+#include "container/mmap_vector.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <system_error>
+
+#include "algo/algorithm.h"
+
+namespace {
+
+// 测试结束时删除的临时文件
+struct temp_file {
+    std::string path;
+    temp_file() {
+        char buf[] = "/tmp/easystl_mmap_XXXXXX";
+        int fd = ::mkstemp(buf);
+        ::close(fd);
+        path = buf;
+    }
+    ~temp_file() { std::remove(path.c_str()); }
+};
+
+}  // namespace
+
+TEST(MmapVectorTest, ReadOnlyAndCopyOnWrite) {
+    temp_file tmp;
+    {
+        nostd::file_vector<uint32_t> out(tmp.path);
+        for (uint32_t i = 0; i < 10000; ++i) {
+            out.push_back(i * 3);
+        }
+    }
+
+    nostd::mmap_vector<const uint32_t> ro(tmp.path);
+    ASSERT_EQ(ro.size(), 10000);
+    EXPECT_EQ(ro.front(), 0u);
+    EXPECT_EQ(ro.back(), 9999u * 3);
+    const uint32_t *it = nostd::lower_bound(ro.begin(), ro.end(), 301u);
+    EXPECT_EQ(it - ro.begin(), 101);
+    EXPECT_THROW(ro.at(10000), std::out_of_range);
+
+    // 私有映射上的修改不写回文件
+    {
+        nostd::mmap_vector<uint32_t> cow(tmp.path);
+        cow[0] = 42;
+        EXPECT_EQ(cow[0], 42u);
+        EXPECT_EQ(ro[0], 0u);
+    }
+    nostd::mmap_vector<const uint32_t> again(tmp.path);
+    EXPECT_EQ(again[0], 0u);
+
+    nostd::mmap_vector<const uint32_t> moved(std::move(again));
+    EXPECT_FALSE(again.is_open());
+    EXPECT_EQ(moved.size(), 10000);
+
+    EXPECT_THROW(nostd::mmap_vector<const uint32_t>("/nonexistent/easystl"), std::system_error);
+}
+
+TEST(MmapVectorTest, FileVectorGrowAndReopen) {
+    temp_file tmp;
+    {
+        nostd::file_vector<uint64_t> v(tmp.path);
+        EXPECT_TRUE(v.empty());
+        for (uint64_t i = 0; i < 100000; ++i) {
+            v.push_back(i);
+        }
+        EXPECT_EQ(v.size(), 100000);
+        EXPECT_GE(v.capacity(), v.size());
+        v.pop_back();
+        v.resize(v.size() + 2);
+        EXPECT_EQ(v.back(), 0u);
+        v.sync();
+    }
+    nostd::file_vector<uint64_t> v(tmp.path);
+    ASSERT_EQ(v.size(), 100001);
+    EXPECT_EQ(v.capacity(), v.size());
+    EXPECT_EQ(v[99998], 99998u);
+    EXPECT_EQ(v[99999], 0u);
+    v.resize(10);
+    v.shrink_to_fit();
+    v.push_back(7);
+    EXPECT_EQ(v.size(), 11);
+    EXPECT_EQ(v[10], 7u);
+}
+
+TEST(MmapVectorTest, FileVectorShrinkThenGrow) {
+    temp_file tmp;
+    nostd::file_vector<int> v(tmp.path);
+    for (int i = 0; i < 8; ++i) {
+        v.push_back(100 + i);
+    }
+    size_t cap = v.capacity();
+    v.resize(2);
+    v.resize(5);  // 容量内：旧数据被清零
+    EXPECT_EQ(v[2], 0);
+    EXPECT_EQ(v[4], 0);
+    v.resize(2);
+    v.resize(cap + 3);  // 超出容量：[size, 旧容量)同样清零
+    for (size_t i = 2; i < v.size(); ++i) {
+        ASSERT_EQ(v[i], 0) << i;
+    }
+    EXPECT_EQ(v[1], 101);
+}
+
+TEST(MmapVectorTest, FileVectorPushBackOwnElement) {
+    temp_file tmp;
+    nostd::file_vector<uint64_t> v(tmp.path);
+    v.push_back(42);
+    while (v.size() < v.capacity()) {
+        v.push_back(v.size());
+    }
+    for (int round = 0; round < 4; ++round) {
+        size_t n = v.size();
+        v.push_back(v[0]);  // 已满，扩容时映射可能搬走
+        EXPECT_EQ(v[n], 42u);
+        while (v.size() < v.capacity()) {
+            v.push_back(0);
+        }
+    }
+}
+
+TEST(MmapVectorTest, EmptyFile) {
+    temp_file tmp;
+    nostd::mmap_vector<const int> ro(tmp.path);
+    EXPECT_TRUE(ro.empty());
+    EXPECT_EQ(ro.begin(), ro.end());
+
+    nostd::file_vector<int> v(tmp.path);
+    v.push_back(1);
+    EXPECT_EQ(v.size(), 1);
+}
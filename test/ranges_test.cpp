@@ -0,0 +1,186 @@
+#include "base/ranges.h"
+
+#include <gtest/gtest.h>
+
+#include <forward_list>
+#include <list>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "algo/algorithm.h"
+#include "container/vector.h"
+
+namespace {
+
+template <class R>
+std::vector<nostd::value_type_t<decltype(std::declval<const R &>().begin())>> to_vector(const R &r) {
+    std::vector<nostd::value_type_t<decltype(std::declval<const R &>().begin())>> out;
+    for (auto it = r.begin(); it != r.end(); ++it) {
+        out.push_back(*it);
+    }
+    return out;
+}
+
+struct is_even {
+    bool operator()(int x) const { return x % 2 == 0; }
+};
+
+struct square {
+    int operator()(int x) const { return x * x; }
+};
+
+template <class It>
+using category_of = nostd::iterator_category_t<It>;
+
+}  // namespace
+
+TEST(RangesTest, FilterTransform) {
+    std::vector<int> v = {1, 2, 3, 4, 5, 6, 7, 8};
+    auto evens = v | nostd::views::filter(is_even());
+    EXPECT_EQ(to_vector(evens), (std::vector<int>{2, 4, 6, 8}));
+
+    auto squares = v | nostd::views::filter(is_even()) | nostd::views::transform(square());
+    EXPECT_EQ(to_vector(squares), (std::vector<int>{4, 16, 36, 64}));
+
+    // filter最多双向，可以倒着走
+    auto last = evens.end();
+    --last;
+    EXPECT_EQ(*last, 8);
+    static_assert(std::is_same<category_of<decltype(evens.begin())>, nostd::bidirectional_iterator_tag>::value, "");
+
+    // 通过filter的迭代器修改原容器
+    for (int &x : v | nostd::views::filter(is_even())) {
+        x = -x;
+    }
+    EXPECT_EQ(v, (std::vector<int>{1, -2, 3, -4, 5, -6, 7, -8}));
+
+    // transform保持随机访问，lower_bound走二分
+    std::vector<int> sorted = {1, 2, 3, 4, 5, 6};
+    auto sq = nostd::views::transform(sorted, square());
+    static_assert(std::is_same<category_of<decltype(sq.begin())>, nostd::random_access_iterator_tag>::value, "");
+    EXPECT_EQ(sq.end() - sq.begin(), 6);
+    EXPECT_EQ(sq.begin()[3], 16);
+    EXPECT_EQ(nostd::lower_bound(sq.begin(), sq.end(), 20) - sq.begin(), 4);
+
+    // 空的range和全部被过滤掉
+    std::vector<int> odd = {1, 3, 5};
+    EXPECT_TRUE(to_vector(odd | nostd::views::filter(is_even())).empty());
+    std::vector<int> none;
+    EXPECT_TRUE(to_vector(none | nostd::views::transform(square())).empty());
+}
+
+TEST(RangesTest, TakeDrop) {
+    nostd::vector<int> v;
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(i);
+    }
+    // nostd::vector的迭代器是指针，take/drop之后仍然是指针
+    auto t = v | nostd::views::take(3);
+    static_assert(std::is_same<decltype(t.begin()), int *>::value, "");
+    EXPECT_EQ(to_vector(t), (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(to_vector(v | nostd::views::drop(7)), (std::vector<int>{7, 8, 9}));
+    EXPECT_EQ(to_vector(v | nostd::views::drop(3) | nostd::views::take(2)), (std::vector<int>{3, 4}));
+    EXPECT_TRUE(to_vector(v | nostd::views::drop(20)).empty());
+    EXPECT_EQ(to_vector(v | nostd::views::take(20)).size(), 10u);
+
+    // 前向迭代器用计数
+    std::forward_list<int> fl = {1, 2, 3, 4, 5};
+    auto ft = fl | nostd::views::take(2);
+    EXPECT_EQ(to_vector(ft), (std::vector<int>{1, 2}));
+    EXPECT_EQ(to_vector(fl | nostd::views::take(9)), (std::vector<int>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(to_vector(fl | nostd::views::drop(3)), (std::vector<int>{4, 5}));
+    EXPECT_EQ(nostd::distance(ft.begin(), ft.end()), 2);
+
+    // 先filter再take：只取第一个偶数
+    auto f = fl | nostd::views::filter(is_even()) | nostd::views::take(1);
+    EXPECT_EQ(to_vector(f), (std::vector<int>{2}));
+}
+
+TEST(RangesTest, ZipEnumerate) {
+    std::vector<int> a = {1, 2, 3, 4};
+    std::list<std::string> b = {"one", "two", "three"};
+    auto z = nostd::views::zip(a, b);
+    std::vector<std::string> joined;
+    for (auto p : z) {
+        joined.push_back(std::to_string(p.first) + p.second);
+        p.first *= 10;  // 引用原容器的元素
+    }
+    EXPECT_EQ(joined, (std::vector<std::string>{"1one", "2two", "3three"}));
+    EXPECT_EQ(a, (std::vector<int>{10, 20, 30, 4}));
+    static_assert(std::is_same<category_of<decltype(z.begin())>, nostd::bidirectional_iterator_tag>::value, "");
+
+    // 两边都是随机访问时按较短的长度
+    std::vector<double> c = {0.5, 1.5};
+    auto zr = nostd::views::zip(a, c);
+    EXPECT_EQ(zr.end() - zr.begin(), 2);
+    EXPECT_EQ(zr.begin()[1].second, 1.5);
+
+    std::vector<char> s = {'a', 'b', 'c'};
+    std::vector<std::pair<ptrdiff_t, char>> expected = {{0, 'a'}, {1, 'b'}, {2, 'c'}};
+    EXPECT_EQ(to_vector(s | nostd::views::enumerate), expected);
+    auto e = nostd::views::enumerate(s);
+    EXPECT_EQ(e.end() - e.begin(), 3);
+    EXPECT_EQ((*(e.begin() + 2)).first, 2);
+}
+
+TEST(RangesTest, ChunkStride) {
+    std::vector<int> v = {0, 1, 2, 3, 4, 5, 6};
+    auto c = v | nostd::views::chunk(3);
+    static_assert(std::is_same<category_of<decltype(c.begin())>, nostd::random_access_iterator_tag>::value, "");
+    std::vector<std::vector<int>> chunks;
+    for (auto r : c) {
+        chunks.push_back(to_vector(r));
+    }
+    EXPECT_EQ(chunks, (std::vector<std::vector<int>>{{0, 1, 2}, {3, 4, 5}, {6}}));
+    EXPECT_EQ(c.end() - c.begin(), 3);
+    auto last = c.end();
+    --last;
+    EXPECT_EQ(to_vector(*last), (std::vector<int>{6}));
+    EXPECT_EQ(to_vector(c.begin()[1]), (std::vector<int>{3, 4, 5}));
+    EXPECT_TRUE(c.end() - 2 == c.begin() + 1);
+
+    auto s = v | nostd::views::stride(3);
+    EXPECT_EQ(to_vector(s), (std::vector<int>{0, 3, 6}));
+    EXPECT_EQ(s.end() - s.begin(), 3);
+    EXPECT_EQ(*(s.end() - 1), 6);
+    EXPECT_EQ(s.begin()[1], 3);
+    EXPECT_LT(s.begin(), s.end());
+    std::vector<int> v6 = {0, 1, 2, 3, 4, 5};
+    auto s6 = v6 | nostd::views::stride(2);
+    EXPECT_EQ(*(s6.end() - 1), 4);
+    EXPECT_EQ(s6.end() - s6.begin(), 3);
+
+    // 前向迭代器
+    std::forward_list<int> fl = {0, 1, 2, 3, 4};
+    std::vector<std::vector<int>> fchunks;
+    for (auto r : fl | nostd::views::chunk(2)) {
+        fchunks.push_back(to_vector(r));
+    }
+    EXPECT_EQ(fchunks, (std::vector<std::vector<int>>{{0, 1}, {2, 3}, {4}}));
+    EXPECT_EQ(to_vector(fl | nostd::views::stride(2)), (std::vector<int>{0, 2, 4}));
+    EXPECT_EQ(to_vector(fl | nostd::views::stride(10)), (std::vector<int>{0}));
+}
+
+TEST(RangesTest, ComposeWithAlgorithms) {
+    std::vector<int> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+    // 先组合适配器再应用
+    auto pipeline = nostd::views::filter(is_even()) | nostd::views::transform(square()) | nostd::views::drop(1) |
+                    nostd::views::take(3);
+    auto r = v | pipeline;
+    std::vector<int> out(3);
+    nostd::copy(r.begin(), r.end(), out.begin());
+    EXPECT_EQ(out, (std::vector<int>{4, 16, 36}));
+
+    auto s = v | nostd::views::stride(10) | nostd::views::transform(square());
+    EXPECT_EQ(*nostd::find_if(s.begin(), s.end(), [](int x) { return x > 1000; }), 1600);
+    EXPECT_TRUE(nostd::all_of(s.begin(), s.end(), [](int x) { return x % 100 == 0; }));
+
+    int arr[] = {5, 4, 3, 2, 1};
+    auto head = nostd::views::all(arr) | nostd::views::take(2);
+    EXPECT_EQ(to_vector(head), (std::vector<int>{5, 4}));
+}
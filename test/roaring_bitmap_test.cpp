@@ -0,0 +1,218 @@
+#include "container/roaring_bitmap.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::set<uint32_t> random_ids(uint32_t seed, size_t n, uint32_t range) {
+    std::mt19937 rng(seed);
+    std::set<uint32_t> ids;
+    while (ids.size() < n) {
+        ids.insert(rng() % range);
+    }
+    return ids;
+}
+
+std::vector<uint32_t> to_std(const nostd::roaring_bitmap &rb) {
+    std::vector<uint32_t> out;
+    for (uint32_t v : rb) {
+        out.push_back(v);
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(RoaringBitmapTest, AddRemoveContains) {
+    nostd::roaring_bitmap rb;
+    EXPECT_TRUE(rb.empty());
+    EXPECT_TRUE(rb.add(5));
+    EXPECT_FALSE(rb.add(5));
+    EXPECT_TRUE(rb.add(70000));
+    EXPECT_TRUE(rb.add(0xffffffffu));
+    EXPECT_EQ(rb.cardinality(), 3);
+    EXPECT_EQ(rb.container_count(), 3);
+    EXPECT_TRUE(rb.contains(70000));
+    EXPECT_FALSE(rb.contains(70001));
+    EXPECT_EQ(rb.minimum(), 5);
+    EXPECT_EQ(rb.maximum(), 0xffffffffu);
+
+    EXPECT_TRUE(rb.remove(70000));
+    EXPECT_FALSE(rb.remove(70000));
+    EXPECT_EQ(rb.container_count(), 2);  // 空容器被回收
+    EXPECT_EQ(to_std(rb), (std::vector<uint32_t>{5, 0xffffffffu}));
+}
+
+TEST(RoaringBitmapTest, ArrayBitmapConversion) {
+    nostd::roaring_bitmap rb;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        rb.add(i * 3);  // 前两个桶超过4096，会转成bitmap
+    }
+    EXPECT_EQ(rb.cardinality(), 10000);
+    for (uint32_t i = 0; i < 30000; ++i) {
+        EXPECT_EQ(rb.contains(i), i % 3 == 0);
+    }
+    for (uint32_t i = 0; i < 10000; i += 2) {
+        rb.remove(i * 3);
+    }
+    EXPECT_EQ(rb.cardinality(), 5000);
+    std::vector<uint32_t> values = to_std(rb);
+    ASSERT_EQ(values.size(), 5000);
+    EXPECT_EQ(values[0], 3);
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+    EXPECT_EQ(rb.maximum(), 9999 * 3);
+}
+
+TEST(RoaringBitmapTest, SetOperationsMatchStdSet) {
+    // 覆盖array/bitmap各种组合: 稀疏的大范围集合 + 稠密的小范围集合
+    std::set<uint32_t> a = random_ids(1, 20000, 1 << 18);
+    std::set<uint32_t> b = random_ids(2, 3000, 1 << 20);
+    std::set<uint32_t> dense = random_ids(3, 30000, 1 << 16);
+    a.insert(dense.begin(), dense.end());
+
+    nostd::roaring_bitmap ra(a.begin(), a.end());
+    nostd::roaring_bitmap rb(b.begin(), b.end());
+
+    std::vector<uint32_t> expected;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    EXPECT_EQ(to_std(ra | rb), expected);
+
+    expected.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    EXPECT_EQ(to_std(ra & rb), expected);
+    EXPECT_EQ((ra & rb).cardinality(), expected.size());
+
+    expected.clear();
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    EXPECT_EQ(to_std(ra - rb), expected);
+
+    nostd::roaring_bitmap rc = ra;
+    rc |= rb;
+    EXPECT_TRUE(rc == (ra | rb));
+    rc &= rb;
+    EXPECT_TRUE(rc == rb);
+}
+
+TEST(RoaringBitmapTest, RunOptimize) {
+    nostd::roaring_bitmap rb;
+    rb.add_range(100, 200000);
+    rb.add(300000);
+    uint64_t card = rb.cardinality();
+    EXPECT_EQ(card, 199900 + 1);
+    size_t before = rb.serialized_size();
+    rb.run_optimize();
+    EXPECT_LT(rb.serialized_size(), before / 100);
+    EXPECT_EQ(rb.cardinality(), card);
+    EXPECT_TRUE(rb.contains(100));
+    EXPECT_TRUE(rb.contains(199999));
+    EXPECT_FALSE(rb.contains(200000));
+    EXPECT_FALSE(rb.contains(99));
+
+    // 区间容器参与集合运算、遍历、修改
+    nostd::roaring_bitmap other{150, 250000, 300000};
+    EXPECT_EQ(to_std(rb & other), (std::vector<uint32_t>{150, 300000}));
+    std::vector<uint32_t> values = to_std(rb);
+    ASSERT_EQ(values.size(), card);
+    EXPECT_EQ(values.front(), 100);
+    EXPECT_EQ(values[199899], 199999);
+    EXPECT_TRUE(rb.remove(150));
+    EXPECT_FALSE(rb.contains(150));
+    EXPECT_EQ(rb.cardinality(), card - 1);
+}
+
+TEST(RoaringBitmapTest, SerializeRoundTrip) {
+    std::set<uint32_t> ids = random_ids(4, 50000, 1 << 24);
+    nostd::roaring_bitmap rb(ids.begin(), ids.end());
+    rb.add_range(1u << 28, (1u << 28) + 100000);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1) {
+            rb.run_optimize();
+        }
+        nostd::vector<char> bytes = rb.serialize();
+        EXPECT_EQ(bytes.size(), rb.serialized_size());
+        nostd::roaring_bitmap back = nostd::roaring_bitmap::deserialize(bytes.data(), bytes.size());
+        EXPECT_TRUE(back == rb);
+        EXPECT_THROW(nostd::roaring_bitmap::deserialize(bytes.data(), bytes.size() / 2), std::invalid_argument);
+    }
+
+    // RoaringFormatSpec中的固定格式: {1, 2, 3}
+    nostd::roaring_bitmap small{1, 2, 3};
+    nostd::vector<char> bytes = small.serialize();
+    const unsigned char expected[] = {0x3a, 0x30, 0, 0, 1, 0, 0, 0, 0, 0, 2, 0, 16, 0, 0, 0, 1, 0, 2, 0, 3, 0};
+    ASSERT_EQ(bytes.size(), sizeof(expected));
+    for (size_t i = 0; i < sizeof(expected); ++i) {
+        EXPECT_EQ(static_cast<unsigned char>(bytes[i]), expected[i]);
+    }
+}
+
+// 反序列化的输入不可信，违反容器不变式的数据要被拒绝
+TEST(RoaringBitmapTest, DeserializeRejectsCorruptContainers) {
+    auto rejects = [](const nostd::vector<char> &bytes) {
+        EXPECT_THROW(nostd::roaring_bitmap::deserialize(bytes.data(), bytes.size()), std::invalid_argument);
+    };
+
+    // 数组容器：{1, 2, 3}的值从第16个字节开始
+    nostd::vector<char> bytes = nostd::roaring_bitmap{1, 2, 3}.serialize();
+    std::swap(bytes[18], bytes[20]);  // 1, 3, 2
+    rejects(bytes);
+    bytes[20] = 3;  // 1, 3, 3
+    rejects(bytes);
+
+    // 位图容器：基数和实际置位个数不一致
+    nostd::roaring_bitmap dense;
+    dense.add_range(0, 5000);
+    bytes = dense.serialize();
+    bytes.back() = static_cast<char>(bytes.back() ^ 0x80);
+    rejects(bytes);
+
+    // 区间容器：cookie(4) + run标志(1) + key/基数(4)之后是区间个数和(start, length)
+    nostd::roaring_bitmap runs;
+    runs.add_range(0, 10);
+    runs.add_range(20, 30);
+    runs.run_optimize();
+    bytes = runs.serialize();
+    ASSERT_EQ(bytes.size(), 9u + 2 + 8);
+    EXPECT_TRUE(nostd::roaring_bitmap::deserialize(bytes.data(), bytes.size()) == runs);
+    nostd::vector<char> overlap = bytes;
+    overlap[15] = 5;  // 第二个区间从5开始，和[0, 9]重叠
+    rejects(overlap);
+    nostd::vector<char> unordered = bytes;
+    unordered[11] = 40;  // 第一个区间在第二个之后
+    rejects(unordered);
+    nostd::vector<char> past_end = bytes;
+    past_end[15] = static_cast<char>(0xf8);
+    past_end[16] = static_cast<char>(0xff);  // 0xfff8 + 9 > 0xffff
+    rejects(past_end);
+}
+
+TEST(RoaringBitmapTest, AddRangeOverlapKeepsArray) {
+    nostd::roaring_bitmap rb;
+    rb.add_range(0, 4001);
+    rb.add_range(0, 100);  // 全部重叠，基数仍是4001
+    EXPECT_EQ(rb.cardinality(), 4001u);
+    nostd::vector<char> bytes = rb.serialize();
+    EXPECT_EQ(bytes.size(), rb.serialized_size());
+    nostd::roaring_bitmap back = nostd::roaring_bitmap::deserialize(bytes.data(), bytes.size());
+    EXPECT_TRUE(back == rb);
+    EXPECT_TRUE(back.contains(4000));
+    EXPECT_FALSE(back.contains(4001));
+}
+
+TEST(RoaringBitmapTest, AddRangeClampsToUint32) {
+    nostd::roaring_bitmap rb;
+    rb.add_range((uint64_t(1) << 32) - 2, (uint64_t(1) << 32) + 5);
+    EXPECT_EQ(rb.cardinality(), 2u);
+    EXPECT_TRUE(rb.contains(0xffffffffu));
+    EXPECT_FALSE(rb.contains(0));
+    rb.add_range(uint64_t(1) << 33, (uint64_t(1) << 33) + 10);
+    EXPECT_EQ(rb.cardinality(), 2u);
+}
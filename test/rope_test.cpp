@@ -0,0 +1,107 @@
+#include "container/rope.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+std::string to_std(const nostd::rope &r) {
+    std::string out;
+    for (nostd::string_view v : r.chunks()) {
+        out.append(v.data(), v.size());
+    }
+    return out;
+}
+
+// 用字符迭代器逐个取出
+std::string by_chars(const nostd::rope &r) {
+    std::string out;
+    for (char c : r) {
+        out.push_back(c);
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(RopeTest, Basic) {
+    nostd::rope r("hello");
+    r += " ";
+    r += nostd::rope("world");
+    EXPECT_EQ(r.size(), 11);
+    EXPECT_EQ(to_std(r), "hello world");
+    EXPECT_EQ(r[6], 'w');
+    EXPECT_THROW(r.at(11), std::out_of_range);
+
+    r.insert(5, ",");
+    EXPECT_EQ(to_std(r), "hello, world");
+    r.erase(0, 7);
+    EXPECT_EQ(to_std(r), "world");
+    EXPECT_EQ(to_std(r.substr(1, 3)), "orl");
+    EXPECT_STREQ(r.str().c_str(), "world");
+
+    EXPECT_EQ(by_chars(r), "world");
+    nostd::rope::const_iterator it = r.end();
+    --it;
+    EXPECT_EQ(*it, 'd');
+
+    nostd::rope empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.begin(), empty.end());
+    EXPECT_EQ(empty.str().size(), 0);
+    EXPECT_TRUE(nostd::rope("abc") < nostd::rope("abd"));
+    EXPECT_EQ(nostd::rope("ab") + nostd::rope("c"), nostd::rope("abc"));
+}
+
+TEST(RopeTest, SharingIsCopyOnWrite) {
+    std::string big(100000, 'x');
+    nostd::rope a(big.data(), big.size());
+    nostd::rope b = a;
+    b.insert(50000, "MID");
+    EXPECT_EQ(a.size(), 100000);
+    EXPECT_EQ(b.size(), 100003);
+    EXPECT_EQ(to_std(a), big);
+    EXPECT_EQ(to_std(b.substr(49999, 5)), "xMIDx");
+}
+
+TEST(RopeTest, RandomEditsMatchStdString) {
+    std::mt19937 rng(12345);
+    nostd::rope r;
+    std::string ref;
+    for (int i = 0; i < 3000; ++i) {
+        int op = static_cast<int>(rng() % 4);
+        size_t pos = ref.empty() ? 0 : rng() % (ref.size() + 1);
+        std::string frag(1 + rng() % 40, static_cast<char>('a' + rng() % 26));
+        if (op == 0) {
+            r.append(frag.c_str());
+            ref += frag;
+        } else if (op == 1) {
+            r.insert(pos, frag.c_str());
+            ref.insert(pos, frag);
+        } else if (op == 2) {
+            size_t len = rng() % 64;
+            r.erase(pos, len);
+            ref.erase(pos, len);
+        } else {
+            size_t len = rng() % 2000;
+            nostd::rope sub = r.substr(pos, len);
+            EXPECT_EQ(to_std(sub), ref.substr(pos, len));
+        }
+        ASSERT_EQ(r.size(), ref.size());
+    }
+    EXPECT_EQ(to_std(r), ref);
+    EXPECT_EQ(by_chars(r), ref);
+    // AVL约束下高度是对数级别的
+    EXPECT_LE(r.height(), 40);
+
+    nostd::rope many;
+    for (int i = 0; i < 100000; ++i) {
+        many.push_back(static_cast<char>('0' + i % 10));
+    }
+    EXPECT_EQ(many.size(), 100000);
+    EXPECT_LE(many.height(), 20);
+    EXPECT_EQ(many[12345], '5');
+}
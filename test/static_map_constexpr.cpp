@@ -0,0 +1,16 @@
+// 只有static_assert：static_map头文件注释里承诺的最低标准(C++17)下编译期建表。
+// 默认标准低于C++17时，CMake另外按C++17编译这个文件(EasySTLConstexprCheck)
+#include "base/config.h"
+#include "container/static_map.h"
+
+#if EASYSTL_CPLUSPLUS >= 201703L && EASYSTL_HAS_CONSTANT_EVALUATED
+namespace {
+constexpr nostd::static_map<int, 3> kMethods = {{"GET", 1}, {"POST", 2}, {"PUT", 3}};
+static_assert(kMethods.at("POST") == 2, "doc example");
+static_assert(kMethods.find("PATCH") == kMethods.end(), "missing key");
+static_assert(kMethods.size() == 3, "size");
+
+constexpr nostd::basic_static_map<int, 2, wchar_t> kWide = {{L"on", 1}, {L"off", 0}};
+static_assert(kWide.at(L"off") == 0, "wchar_t keys");
+}  // namespace
+#endif
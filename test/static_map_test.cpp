@@ -0,0 +1,93 @@
+#include "container/static_map.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/config.h"
+
+TEST(StaticMapTest, Basic) {
+    const nostd::static_map<int, 5> methods = {{"GET", 1}, {"POST", 2}, {"PUT", 3}, {"DELETE", 4}, {"", 5}};
+    EXPECT_EQ(methods.size(), 5u);
+    EXPECT_FALSE(methods.empty());
+    EXPECT_EQ(methods.at("GET"), 1);
+    EXPECT_EQ(methods.at("POST"), 2);
+    EXPECT_EQ(methods.at("PUT"), 3);
+    EXPECT_EQ(methods.at("DELETE"), 4);
+    EXPECT_EQ(methods.at(""), 5);
+    EXPECT_TRUE(methods.contains("PUT"));
+    EXPECT_EQ(methods.count("PATCH"), 0u);
+    EXPECT_EQ(methods.find("GE"), methods.end());
+    EXPECT_EQ(methods.find("GETS"), methods.end());
+    EXPECT_EQ(methods.find("get"), methods.end());
+    EXPECT_THROW(methods.at("HEAD"), std::out_of_range);
+
+    // 每个键正好占一个槽位
+    std::set<int> values;
+    for (const auto &e : methods) {
+        EXPECT_EQ(methods.find(e.first), &e);
+        values.insert(e.second);
+    }
+    EXPECT_EQ(values.size(), 5u);
+
+    const nostd::static_map<int, 0> empty = {};
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.begin(), empty.end());
+    EXPECT_FALSE(empty.contains(""));
+
+    const nostd::basic_static_map<int, 2, wchar_t> wide = {{L"key", 1}, {L"kez", 2}};
+    EXPECT_EQ(wide.at(L"kez"), 2);
+    EXPECT_FALSE(wide.contains(L"ke"));
+}
+
+TEST(StaticMapTest, Errors) {
+    typedef nostd::static_map<int, 3> map3;
+    EXPECT_THROW((map3{{"a", 1}, {"b", 2}, {"a", 3}}), std::invalid_argument);
+    EXPECT_THROW((map3{{"a", 1}, {"b", 2}}), std::invalid_argument);
+    std::vector<std::pair<const char *, int>> four = {{"a", 1}, {"b", 2}, {"c", 3}, {"d", 4}};
+    EXPECT_THROW(map3(four.begin(), four.end()), std::invalid_argument);
+}
+
+// 运行期的键，数量覆盖桶很满、需要换pilot很多次的情况
+TEST(StaticMapTest, RuntimeKeys) {
+    const size_t kKeys = 2000;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < kKeys; ++i) {
+        names.push_back("config.section" + std::to_string(i % 37) + ".key" + std::to_string(i));
+    }
+    std::vector<std::pair<nostd::string_view, size_t>> items;
+    for (size_t i = 0; i < kKeys; ++i) {
+        items.emplace_back(nostd::string_view(names[i].data(), names[i].size()), i);
+    }
+    const nostd::static_map<size_t, kKeys> m(items.begin(), items.end());
+    for (size_t i = 0; i < kKeys; ++i) {
+        ASSERT_EQ(m.at(nostd::string_view(names[i].data(), names[i].size())), i);
+        std::string miss = names[i] + "x";
+        EXPECT_FALSE(m.contains(nostd::string_view(miss.data(), miss.size())));
+    }
+    std::set<size_t> seen;
+    for (const auto &e : m) {
+        seen.insert(e.second);
+    }
+    EXPECT_EQ(seen.size(), kKeys);
+}
+
+#if EASYSTL_CPLUSPLUS >= 201703L && EASYSTL_HAS_CONSTANT_EVALUATED
+namespace {
+enum class opcode { nop, load, store, add, jump };
+constexpr nostd::static_map<opcode, 5> kOpcodes = {
+    {"nop", opcode::nop}, {"load", opcode::load}, {"store", opcode::store}, {"add", opcode::add}, {"jump", opcode::jump}};
+static_assert(kOpcodes.at("store") == opcode::store, "built at compile time");
+static_assert(!kOpcodes.contains("mul"), "missing key");
+static_assert(kOpcodes.find("jump")->second == opcode::jump, "find");
+}  // namespace
+
+TEST(StaticMapTest, Constexpr) {
+    EXPECT_EQ(kOpcodes.at("load"), opcode::load);
+    EXPECT_EQ(kOpcodes.size(), 5u);
+}
+#endif
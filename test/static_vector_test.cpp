@@ -0,0 +1,237 @@
+#include "container/static_vector.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+static_assert(std::is_trivially_copyable<nostd::static_vector<int, 8>>::value, "trivial element -> trivially copyable");
+static_assert(!std::is_trivially_copyable<nostd::static_vector<std::string, 8>>::value, "std::string is not trivial");
+static_assert(nostd::is_trivially_relocatable<nostd::static_vector<int, 8>>::value, "relocatable");
+// 长度用能放下N的最小类型
+static_assert(sizeof(nostd::static_vector<char, 64>) == 65, "uint8_t size");
+static_assert(sizeof(nostd::static_vector<char, 1000>) == 1002, "uint16_t size");
+
+TEST(StaticVectorTest, Basic) {
+    nostd::static_vector<int, 4> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), 4u);
+    EXPECT_EQ(v.max_size(), 4u);
+    v.push_back(1);
+    v.emplace_back(2);
+    EXPECT_EQ(v.insert(v.begin(), 0), v.begin());
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(v.back(), 2);
+    EXPECT_EQ(v.at(1), 1);
+    EXPECT_THROW(v.at(3), std::out_of_range);
+    EXPECT_NE(v.try_push_back(3), nullptr);
+    EXPECT_TRUE(v.full());
+    EXPECT_EQ(v.try_push_back(4), nullptr);
+    EXPECT_THROW(v.push_back(4), std::length_error);
+    EXPECT_THROW(v.insert(v.begin(), 9), std::length_error);
+    EXPECT_THROW(v.resize(5), std::length_error);
+    EXPECT_THROW(v.reserve(5), std::length_error);
+    EXPECT_EQ(v, (nostd::static_vector<int, 4>{0, 1, 2, 3}));
+
+    EXPECT_EQ(*v.erase(v.begin() + 1), 2);
+    v.pop_back();
+    EXPECT_EQ(v, (nostd::static_vector<int, 4>{0, 2}));
+    v.resize(4, 7);
+    EXPECT_EQ(v, (nostd::static_vector<int, 4>{0, 2, 7, 7}));
+    v.resize(1);
+    EXPECT_EQ(v.size(), 1u);
+    EXPECT_EQ(*v.rbegin(), 0);
+
+    // 复制是平凡的，按字节整体复制
+    nostd::static_vector<int, 4> w = v;
+    w.assign({5, 6, 7});
+    EXPECT_LT(v, w);
+    swap(v, w);
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_EQ(w.size(), 1u);
+    EXPECT_EQ(v[2], 7);
+    EXPECT_EQ(w[0], 0);
+    v.clear();
+    EXPECT_TRUE(v.empty());
+
+    nostd::static_vector<int, 0> e;
+    EXPECT_TRUE(e.full());
+    EXPECT_EQ(e.try_push_back(1), nullptr);
+
+    // 只能移动的元素
+    nostd::static_vector<std::unique_ptr<int>, 4> u(2);
+    EXPECT_EQ(u[1], nullptr);
+    u[0].reset(new int(3));
+    u.resize(4);
+    EXPECT_EQ(*u[0], 3);
+    EXPECT_EQ(u[3], nullptr);
+}
+
+TEST(StaticVectorTest, InsertEraseRandom) {
+    // 和std::vector对照随机插入删除，覆盖平凡类型和非平凡类型
+    std::mt19937 rng(7);
+    nostd::static_vector<int, 64> a;
+    nostd::static_vector<std::string, 64> b;
+    std::vector<int> ra;
+    std::vector<std::string> rb;
+    for (int step = 0; step < 3000; ++step) {
+        int op = static_cast<int>(rng() % 5);
+        size_t pos = ra.empty() ? 0 : rng() % (ra.size() + 1);
+        size_t n = rng() % 4;
+        if (op <= 1 && ra.size() + n <= 64) {
+            int x = static_cast<int>(rng() % 1000);
+            a.insert(a.begin() + pos, n, x);
+            ra.insert(ra.begin() + pos, n, x);
+            std::string s(rng() % 40, static_cast<char>('a' + x % 26));
+            b.insert(b.begin() + pos, n, s);
+            rb.insert(rb.begin() + pos, n, s);
+        } else if (op == 2 && ra.size() + n <= 64) {
+            std::vector<int> src(n, step);
+            a.insert(a.begin() + pos, src.begin(), src.end());
+            ra.insert(ra.begin() + pos, src.begin(), src.end());
+            std::list<std::string> ls(n, std::to_string(step));
+            b.insert_range(b.begin() + pos, ls);
+            rb.insert(rb.begin() + pos, ls.begin(), ls.end());
+        } else if (op == 3 && !ra.empty()) {
+            size_t first = rng() % ra.size();
+            size_t last = first + rng() % (ra.size() - first + 1);
+            a.erase(a.begin() + first, a.begin() + last);
+            ra.erase(ra.begin() + first, ra.begin() + last);
+            b.erase(b.begin() + first, b.begin() + last);
+            rb.erase(rb.begin() + first, rb.begin() + last);
+        } else if (!ra.empty() && ra.size() < 64) {
+            // 插入自己的元素
+            a.insert(a.begin() + pos, a[ra.size() - 1]);
+            ra.insert(ra.begin() + pos, ra[ra.size() - 1]);
+            b.emplace(b.begin() + pos, b[rb.size() - 1]);
+            rb.insert(rb.begin() + pos, rb[rb.size() - 1]);
+        }
+        ASSERT_EQ(std::vector<int>(a.begin(), a.end()), ra);
+        ASSERT_EQ(std::vector<std::string>(b.begin(), b.end()), rb);
+    }
+
+    // 非平凡类型的复制、移动、交换
+    nostd::static_vector<std::string, 64> c = b;
+    EXPECT_EQ(c, b);
+    nostd::static_vector<std::string, 64> d(std::move(c));
+    EXPECT_EQ(d, b);
+    c = {"x", "y"};
+    c.swap(d);
+    EXPECT_EQ(d.size(), 2u);
+    EXPECT_EQ(c, b);
+    d = b;
+    EXPECT_EQ(d, b);
+    d = nostd::static_vector<std::string, 64>{"z"};
+    EXPECT_EQ(d.size(), 1u);
+    EXPECT_EQ(d[0], "z");
+
+    // 单趟的输入迭代器
+    std::istringstream in("4 5 6");
+    nostd::static_vector<int, 8> f = {1, 9};
+    f.insert(f.begin() + 1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+    EXPECT_EQ(f, (nostd::static_vector<int, 8>{1, 4, 5, 6, 9}));
+}
+
+namespace {
+
+struct counted {
+    static int live;
+    static int copies;
+    static int kLimit;
+    std::string value;
+    explicit counted(std::string v) : value(std::move(v)) { ++live; }
+    counted(const counted &o) : value(o.value) {
+        if (++copies == kLimit) {
+            throw std::runtime_error("copy");
+        }
+        ++live;
+    }
+    counted(counted &&o) noexcept : value(std::move(o.value)) { ++live; }
+    counted &operator=(const counted &o) = default;
+    counted &operator=(counted &&o) noexcept = default;
+    ~counted() { --live; }
+};
+int counted::live = 0;
+int counted::copies = 0;
+int counted::kLimit = 0;
+
+}  // namespace
+
+TEST(StaticVectorTest, ExceptionSafetyAndLifetime) {
+    {
+        std::vector<counted> src;
+        for (int i = 0; i < 4; ++i) {
+            src.emplace_back(std::to_string(i));
+        }
+        nostd::static_vector<counted, 16> v;
+        for (int i = 0; i < 5; ++i) {
+            v.emplace_back(std::string(30, 'a' + i));
+        }
+        // 尾部挪开后构造失败，挪回原处
+        counted::copies = 0;
+        counted::kLimit = 3;
+        EXPECT_THROW(v.insert(v.begin() + 2, src.begin(), src.end()), std::runtime_error);
+        EXPECT_EQ(v.size(), 5u);
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_EQ(v[i].value, std::string(30, 'a' + i));
+        }
+        counted::kLimit = 0;
+        v.insert(v.begin() + 1, 3, src[0]);
+        v.erase(v.begin(), v.begin() + 2);
+        v.erase(v.begin() + 2, v.end());
+        EXPECT_EQ(counted::live, 4 + 2);
+    }
+    EXPECT_EQ(counted::live, 0);
+}
+
+#if EASYSTL_CPLUSPLUS >= 201402L
+namespace {
+
+// 编译期筛出100以内的素数
+constexpr nostd::static_vector<int, 32> primes_below_100() {
+    nostd::static_vector<int, 32> v;
+    for (int n = 2; n < 100; ++n) {
+        bool prime = true;
+        for (int p : v) {
+            if (n % p == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) {
+            v.push_back(n);
+        }
+    }
+    return v;
+}
+
+constexpr nostd::static_vector<int, 32> kPrimes = primes_below_100();
+static_assert(kPrimes.size() == 25 && kPrimes[0] == 2 && kPrimes.back() == 97, "constexpr static_vector");
+
+constexpr bool edit_at_compile_time() {
+    nostd::static_vector<int, 8> v = {5, 1, 4};
+    v.insert(v.begin() + 1, 2, 9);  // 5 9 9 1 4
+    v.erase(v.begin());              // 9 9 1 4
+    nostd::sort(v.begin(), v.end());  // 1 4 9 9
+    nostd::static_vector<int, 8> w(2, 3);
+    w.swap(v);
+    return w.size() == 4 && w[1] == 4 && v.size() == 2 && v[0] == 3 &&
+           nostd::binary_search(w.begin(), w.end(), 9) && w.try_push_back(1) != nullptr;
+}
+static_assert(edit_at_compile_time(), "constexpr insert/erase/swap");
+
+}  // namespace
+
+TEST(StaticVectorTest, Constexpr) {
+    EXPECT_EQ(kPrimes[24], 97);
+    EXPECT_TRUE(edit_at_compile_time());
+}
+#endif
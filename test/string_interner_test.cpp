@@ -0,0 +1,102 @@
+#include "container/string_interner.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "container/string.h"
+
+TEST(StringInternerTest, Dedup) {
+    nostd::string_interner interner;
+    nostd::atom a = interner.intern("field_name");
+    nostd::string s("field_name");
+    nostd::atom b = interner.intern(s);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a.c_str(), s.c_str());
+    EXPECT_EQ(a.view(), "field_name");
+    EXPECT_STREQ(b.c_str(), "field_name");
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_EQ(a.id(), 0u);
+    EXPECT_EQ(interner.size(), 1);
+
+    nostd::atom c = interner.intern("other");
+    EXPECT_NE(a, c);
+    EXPECT_EQ(c.id(), 1u);
+    EXPECT_EQ(interner.find("other"), c);
+    EXPECT_FALSE(interner.find("missing"));
+    EXPECT_FALSE(interner.contains("missing"));
+    EXPECT_EQ(interner.size(), 2);
+
+    nostd::atom empty = interner.intern("");
+    EXPECT_TRUE(empty);
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_EQ(interner.intern(nostd::string_view()), empty);
+
+    nostd::atom null;
+    EXPECT_FALSE(null);
+    EXPECT_STREQ(null.c_str(), "");
+}
+
+TEST(StringInternerTest, ManyStringsSurviveRehash) {
+    nostd::string_interner interner;
+    std::vector<nostd::atom> atoms;
+    std::vector<std::string> keys;
+    for (int i = 0; i < 20000; ++i) {
+        keys.push_back("tag_" + std::to_string(i) + std::string(i % 50, 'x'));
+        atoms.push_back(interner.intern(nostd::string_view(keys.back().data(), keys.back().size())));
+    }
+    // 一个超过arena块大小的长串
+    std::string big(100000, 'b');
+    nostd::atom big_atom = interner.intern(nostd::string_view(big.data(), big.size()));
+    EXPECT_EQ(big_atom.size(), big.size());
+
+    std::unordered_set<nostd::atom> uniq(atoms.begin(), atoms.end());
+    EXPECT_EQ(uniq.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        nostd::string_view k(keys[i].data(), keys[i].size());
+        EXPECT_EQ(interner.intern(k), atoms[i]);
+        EXPECT_EQ(atoms[i].view(), k);
+        EXPECT_EQ(atoms[i].id(), i);
+    }
+    EXPECT_EQ(interner.size(), keys.size() + 1);
+}
+
+TEST(StringInternerTest, Concurrent) {
+    nostd::concurrent_string_interner interner;
+    const int kThreads = 4;
+    const int kKeys = 2000;
+    std::vector<std::vector<nostd::atom>> results(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&interner, &results, t]() {
+            for (int i = 0; i < kKeys; ++i) {
+                std::string key = "k" + std::to_string((i * 7 + t) % kKeys);
+                results[t].push_back(interner.intern(nostd::string_view(key.data(), key.size())));
+            }
+        });
+    }
+    for (std::thread &th : threads) {
+        th.join();
+    }
+    EXPECT_EQ(interner.size(), kKeys);
+    std::set<uint32_t> ids;
+    for (int i = 0; i < kKeys; ++i) {
+        std::string key = "k" + std::to_string(i);
+        nostd::atom a = interner.find(nostd::string_view(key.data(), key.size()));
+        ASSERT_TRUE(a);
+        EXPECT_EQ(a.view(), nostd::string_view(key.data(), key.size()));
+        ids.insert(a.id());
+    }
+    EXPECT_EQ(ids.size(), static_cast<size_t>(kKeys));
+    EXPECT_EQ(*ids.rbegin(), static_cast<uint32_t>(kKeys - 1));  // 各分片共用计数器，id是稠密的
+    for (int t = 0; t < kThreads; ++t) {
+        for (int i = 0; i < kKeys; ++i) {
+            std::string key = "k" + std::to_string((i * 7 + t) % kKeys);
+            EXPECT_EQ(results[t][i], interner.find(nostd::string_view(key.data(), key.size())));
+        }
+    }
+}
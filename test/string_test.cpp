@@ -2,9 +2,184 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 TEST(StringTest, BasicTest) {
     std::string str1;
     nostd::string str2;
-}
\ No newline at end of file
+    EXPECT_TRUE(str2.empty());
+    EXPECT_STREQ(str2.c_str(), "");
+
+    nostd::string s("hello");
+    s += ' ';
+    s += "world";
+    EXPECT_EQ(s.size(), 11);
+    EXPECT_STREQ(s.c_str(), "hello world");
+    EXPECT_EQ(s.substr(6), nostd::string("world"));
+    EXPECT_THROW(s.at(11), std::out_of_range);
+
+    s.insert(5, ",");
+    EXPECT_EQ(s, "hello, world");
+    s.insert(0, s.c_str() + 7, 5);  // 源在自身内部
+    EXPECT_EQ(s, "worldhello, world");
+    s.erase(0, 5);
+    EXPECT_EQ(s, "hello, world");
+    s.append(s);
+    EXPECT_EQ(s, "hello, worldhello, world");
+
+    nostd::string a("abc"), b("abd");
+    EXPECT_TRUE(a < b);
+    EXPECT_EQ(a + b, "abcabd");
+    a.resize(5, 'x');
+    EXPECT_EQ(a, "abcxx");
+    a.resize(2);
+    EXPECT_EQ(a, "ab");
+}
+
+TEST(StringTest, ResizeAndOverwrite) {
+    nostd::string s("ab");
+    s.resize_and_overwrite(10, [](char *p, size_t n) {
+        EXPECT_EQ(p[0], 'a');
+        EXPECT_EQ(p[1], 'b');
+        std::memcpy(p + 2, "cdef", 4);
+        return n - 4;
+    });
+    EXPECT_EQ(s.size(), 6);
+    EXPECT_EQ(s, "abcdef");
+    EXPECT_EQ(s.c_str()[6], '\0');
+
+    s.resize_and_overwrite(3, [](char *, size_t n) { return n; });
+    EXPECT_EQ(s, "abc");
+
+    nostd::string empty;
+    empty.resize_and_overwrite(0, [](char *, size_t) { return 0; });
+    EXPECT_TRUE(empty.empty());
+    EXPECT_STREQ(empty.c_str(), "");
+
+    nostd::string buf(8, nostd::default_init);
+    EXPECT_EQ(buf.size(), 8);
+    std::memcpy(buf.data(), "01234567", 8);
+    EXPECT_EQ(buf, "01234567");
+}
+
+TEST(StringTest, AssignToDefaultConstructed) {
+    nostd::string a;
+    a = nostd::string();
+    EXPECT_TRUE(a.empty());
+    const nostd::string empty;
+    a = empty;  // 拷贝赋值，m_buffer仍为空
+    EXPECT_TRUE(a.empty());
+    EXPECT_STREQ(a.c_str(), "");
+
+    nostd::string b;
+    b.assign("");
+    EXPECT_TRUE(b.empty());
+    EXPECT_STREQ(b.c_str(), "");
+    b.assign("xyz");
+    EXPECT_EQ(b, "xyz");
+
+    // 空串的s[size()]是结尾的'\0'
+    nostd::string c;
+    EXPECT_EQ(c[0], '\0');
+    EXPECT_EQ(c.front(), '\0');
+    const nostd::string &cc = c;
+    EXPECT_EQ(cc[0], '\0');
+    EXPECT_EQ(cc.front(), '\0');
+}
+
+TEST(StringTest, NumericConversion) {
+    EXPECT_EQ(nostd::to_string(-123), "-123");
+    EXPECT_EQ(nostd::to_string(18446744073709551615ULL), "18446744073709551615");
+    EXPECT_EQ(nostd::to_string(0.1), "0.1");
+    EXPECT_EQ(nostd::to_string(1e21), "1e+21");
+
+    size_t idx = 0;
+    EXPECT_EQ(nostd::stoi(nostd::string("  +42px"), &idx), 42);
+    EXPECT_EQ(idx, 5);
+    EXPECT_EQ(nostd::stoi(nostd::string("-ff"), nullptr, 16), -255);
+    EXPECT_EQ(nostd::stoull(nostd::string("18446744073709551615")), 18446744073709551615ULL);
+    EXPECT_EQ(nostd::stoi(nostd::string("0x1f"), &idx, 16), 31);
+    EXPECT_EQ(idx, 4);
+    EXPECT_EQ(nostd::stoi(nostd::string("1f"), nullptr, 16), 31);
+    EXPECT_EQ(nostd::stoi(nostd::string("0x1f"), nullptr, 0), 31);
+    EXPECT_EQ(nostd::stol(nostd::string(" -0X1F"), nullptr, 0), -31);
+    EXPECT_EQ(nostd::stoul(nostd::string("017"), nullptr, 0), 15ul);
+    EXPECT_EQ(nostd::stoi(nostd::string("42"), nullptr, 0), 42);
+    EXPECT_EQ(nostd::stoi(nostd::string("0"), &idx, 0), 0);
+    EXPECT_EQ(idx, 1);
+    EXPECT_EQ(nostd::stoi(nostd::string("0xg"), &idx, 0), 0);  // 同strtol，"0x"后没有数字时只读到0
+    EXPECT_EQ(idx, 1);
+    EXPECT_EQ(nostd::stoi(nostd::string("-0x80000000"), nullptr, 0), std::numeric_limits<int>::min());
+    // 同strtoul，负数按无符号取反
+    EXPECT_EQ(nostd::stoul(nostd::string("-1")), std::numeric_limits<unsigned long>::max());
+    EXPECT_EQ(nostd::stoull(nostd::string(" -0x10"), nullptr, 0), 0ULL - 16);
+    EXPECT_THROW(nostd::stoull(nostd::string("-18446744073709551616")), std::out_of_range);
+    // 不支持十六进制浮点数
+    EXPECT_EQ(nostd::stod(nostd::string("0x1p3"), &idx), 0.0);
+    EXPECT_EQ(idx, 1);
+    EXPECT_EQ(nostd::stod(nostd::string(" 2.5e3 "), &idx), 2500.0);
+    EXPECT_EQ(idx, 6);
+    EXPECT_EQ(nostd::stof(nostd::string("0.1")), 0.1f);
+
+    EXPECT_THROW(nostd::stoi(nostd::string("abc")), std::invalid_argument);
+    EXPECT_THROW(nostd::stoi(nostd::string("+-1")), std::invalid_argument);
+    EXPECT_THROW(nostd::stoi(nostd::string("99999999999")), std::out_of_range);
+    EXPECT_THROW(nostd::stoi(nostd::string("12"), nullptr, 1), std::invalid_argument);
+    EXPECT_THROW(nostd::stoi(nostd::string("12"), nullptr, 37), std::invalid_argument);
+    EXPECT_THROW(nostd::stod(nostd::string("1e400")), std::out_of_range);
+}
+
+TEST(StringTest, AppendInsertRange) {
+    std::list<char> chars{'a', 'b', 'c'};
+    nostd::string s("xy");
+    s.append_range(chars);
+    EXPECT_STREQ(s.c_str(), "xyabc");
+    s.append(s.begin(), s.end());  // 指向自身，需要扩容
+    EXPECT_STREQ(s.c_str(), "xyabcxyabc");
+    s.append(s.rbegin(), s.rend());
+    EXPECT_STREQ(s.c_str(), "xyabcxyabccbayxcbayx");
+
+    std::vector<char> big(1000, 'z');
+    nostd::string t;
+    t.append_range(big);
+    EXPECT_EQ(t.size(), 1000u);
+    EXPECT_EQ(t.capacity(), 1000u);  // 前向迭代器按长度一次分配
+    EXPECT_EQ(t[999], 'z');
+
+    // 单趟的输入迭代器
+    std::istringstream in("hello world");
+    nostd::string u("<>");
+    nostd::string::iterator it = u.insert(u.begin() + 1, std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    EXPECT_EQ(it, u.begin() + 1);
+    EXPECT_STREQ(u.c_str(), "<hello world>");
+    std::istringstream in2(std::string(5000, 'q'));
+    nostd::string q(std::istreambuf_iterator<char>(in2), (std::istreambuf_iterator<char>()));
+    EXPECT_EQ(q.size(), 5000u);
+    EXPECT_EQ(q.back(), 'q');
+
+    nostd::string v("1234");
+    v.insert_range(v.begin() + 2, std::list<char>{'-', '-'});
+    EXPECT_STREQ(v.c_str(), "12--34");
+    v.reserve(100);
+    v.insert_range(v.end(), std::vector<char>{'!'});
+    v.insert(v.begin(), v.begin() + 2, v.begin() + 4);  // 指针走insert(pos, s, n)，允许指向自身
+    EXPECT_STREQ(v.c_str(), "--12--34!");
+
+    // 非指针迭代器指向自身，结果和先复制出一个临时串再插入一样
+    nostd::string w("abcdef");
+    w.reserve(32);
+    w.insert(w.begin() + 1, w.rbegin(), w.rend());
+    EXPECT_STREQ(w.c_str(), "afedcbabcdef");
+    nostd::string x("abcdef");  // 容量不够，走新缓冲区
+    x.insert(x.begin() + 1, x.rbegin(), x.rend());
+    EXPECT_STREQ(x.c_str(), "afedcbabcdef");
+    w.insert(w.begin(), w.rbegin() + 2, w.rbegin() + 5);
+    EXPECT_STREQ(w.c_str(), "dcbafedcbabcdef");
+}
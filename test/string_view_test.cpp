@@ -0,0 +1,109 @@
+#include "container/string_view.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "container/string.h"
+
+using nostd::string_view;
+
+namespace {
+
+template <class Range>
+std::vector<std::string> collect(const Range &r) {
+    std::vector<std::string> out;
+    for (string_view v : r) {
+        out.emplace_back(v.data(), v.size());
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(StringViewTest, Basic) {
+    string_view v("hello world");
+    EXPECT_EQ(v.size(), 11);
+    EXPECT_EQ(v.front(), 'h');
+    EXPECT_EQ(v.back(), 'd');
+    EXPECT_EQ(v.substr(6), "world");
+    EXPECT_EQ(v.substr(6, 2), "wo");
+    EXPECT_THROW(v.substr(12), std::out_of_range);
+    EXPECT_THROW(v.at(11), std::out_of_range);
+    EXPECT_TRUE(v.starts_with("hello"));
+    EXPECT_TRUE(v.ends_with('d'));
+    EXPECT_FALSE(v.ends_with("hello"));
+
+    string_view w = v;
+    w.remove_prefix(6);
+    w.remove_suffix(1);
+    EXPECT_EQ(w, "worl");
+    EXPECT_TRUE(string_view("abc") < string_view("abd"));
+    EXPECT_TRUE(string_view("ab") < string_view("abc"));
+    EXPECT_EQ(string_view().compare(string_view("")), 0);
+
+    nostd::string s(v);
+    EXPECT_EQ(s, "hello world");
+    string_view back = s;
+    EXPECT_EQ(back.data(), s.data());
+    s += string_view("!!", 1);
+    EXPECT_EQ(s, "hello world!");
+}
+
+TEST(StringViewTest, FindFamily) {
+    const std::string ref = "abcabcXYZ abc, xyz;;abc";
+    string_view v(ref.data(), ref.size());
+    const char *needles[] = {"", "a", "abc", "c,", "xyz;", ";;", "zz", "abcabcXYZ abc, xyz;;abc!"};
+    for (const char *n : needles) {
+        for (size_t pos = 0; pos <= ref.size() + 1; ++pos) {
+            EXPECT_EQ(v.find(n, pos), ref.find(n, pos)) << n << " " << pos;
+            EXPECT_EQ(v.rfind(n, pos), ref.rfind(n, pos)) << n << " " << pos;
+            EXPECT_EQ(v.find_first_of(n, pos), ref.find_first_of(n, pos)) << n << " " << pos;
+            EXPECT_EQ(v.find_last_of(n, pos), ref.find_last_of(n, pos)) << n << " " << pos;
+            EXPECT_EQ(v.find_first_not_of(n, pos), ref.find_first_not_of(n, pos)) << n << " " << pos;
+            EXPECT_EQ(v.find_last_not_of(n, pos), ref.find_last_not_of(n, pos)) << n << " " << pos;
+        }
+        EXPECT_EQ(v.rfind(n), ref.rfind(n)) << n;
+        EXPECT_EQ(v.find_last_of(n), ref.find_last_of(n)) << n;
+    }
+    for (char c : std::string("aZ;q")) {
+        EXPECT_EQ(v.find(c, 3), ref.find(c, 3));
+        EXPECT_EQ(v.rfind(c), ref.rfind(c));
+        EXPECT_EQ(v.find_first_not_of(c), ref.find_first_not_of(c));
+        EXPECT_EQ(v.find_last_not_of(c), ref.find_last_not_of(c));
+    }
+    EXPECT_EQ(string_view().find(""), 0u);
+    EXPECT_EQ(string_view().rfind('a'), string_view::npos);
+
+    nostd::string s(ref.c_str());
+    EXPECT_EQ(s.find("xyz"), ref.find("xyz"));
+    EXPECT_EQ(s.find_last_of(", "), ref.find_last_of(", "));
+    EXPECT_TRUE(s.starts_with("abc"));
+
+    nostd::wstring_view wv(L"key=value");
+    EXPECT_EQ(wv.find(L'='), 3u);
+    EXPECT_EQ(wv.find_first_of(L"=v"), 3u);
+    EXPECT_EQ(wv.find_last_not_of(L"eu"), 6u);
+}
+
+TEST(StringViewTest, SplitAndTokenize) {
+    string_view line("a,,b,c,");
+    EXPECT_EQ(collect(nostd::split(line, ',')), (std::vector<std::string>{"a", "", "b", "c", ""}));
+    EXPECT_EQ(collect(nostd::split(string_view(""), ',')), (std::vector<std::string>{""}));
+    EXPECT_EQ(collect(nostd::split(string_view("k1: v1: v2"), ": ")), (std::vector<std::string>{"k1", "v1", "v2"}));
+    EXPECT_EQ(collect(nostd::split(string_view("abc"), "")), (std::vector<std::string>{"abc"}));
+
+    EXPECT_EQ(collect(nostd::tokenize(string_view("  GET /index.html\tHTTP/1.1 \n"), " \t\n")),
+              (std::vector<std::string>{"GET", "/index.html", "HTTP/1.1"}));
+    EXPECT_TRUE(collect(nostd::tokenize(string_view(" \t "), " \t")).empty());
+
+    // 切出的view指向原串
+    auto r = nostd::split(line, ',');
+    auto it = r.begin();
+    EXPECT_EQ(it->data(), line.data());
+    ++it;
+    ++it;
+    EXPECT_EQ(it->data(), line.data() + 3);
+}
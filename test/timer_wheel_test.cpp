@@ -0,0 +1,146 @@
+#include "container/timer_wheel.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+TEST(TimerWheelTest, FireInOrder) {
+    nostd::timer_wheel<int> tw;
+    tw.add(3, 3);
+    tw.add(1, 1);
+    tw.add(2, 2);
+    tw.add(0, 0);  // delay为0按1处理
+    EXPECT_EQ(tw.size(), 4);
+
+    std::vector<int> fired;
+    auto collect = [&fired](int v) {
+        fired.push_back(v);
+    };
+    EXPECT_EQ(tw.advance(1, collect), 2);
+    EXPECT_EQ(tw.advance(2, collect), 2);
+    EXPECT_TRUE(tw.empty());
+    EXPECT_EQ(tw.now(), 3);
+    ASSERT_EQ(fired.size(), 4);
+    EXPECT_EQ(fired[2], 2);
+    EXPECT_EQ(fired[3], 3);
+}
+
+TEST(TimerWheelTest, Cancel) {
+    nostd::timer_wheel<int> tw;
+    auto h1 = tw.add(10, 1);
+    auto h2 = tw.add(1000, 2);
+    EXPECT_TRUE(tw.cancel(h1));
+    EXPECT_FALSE(tw.cancel(h1));
+    EXPECT_EQ(tw.size(), 1);
+
+    int count = 0;
+    tw.advance(2000, [&count](int) {
+        ++count;
+    });
+    EXPECT_EQ(count, 1);
+    EXPECT_FALSE(tw.cancel(h2));  // 已经过期
+
+    // 节点被复用后，旧句柄不能取消新的定时器
+    auto h3 = tw.add(5, 3);
+    EXPECT_FALSE(tw.cancel(h1));
+    EXPECT_TRUE(tw.cancel(h3));
+}
+
+TEST(TimerWheelTest, CascadeAcrossLevels) {
+    const uint64_t delays[] = {1, 255, 256, 257, 16383, 16384, 1u << 20, (1ull << 26) + 7, (1ull << 32) + 3};
+    nostd::timer_wheel<uint64_t> tw;
+    tw.advance(123, [](uint64_t) {});  // 从一个非对齐的位置开始
+    for (uint64_t d : delays) {
+        tw.add(d, tw.now() + d);
+    }
+    uint64_t start = tw.now();
+    size_t count = 0;
+    tw.advance((1ull << 32) + 10, [&](uint64_t expire) {
+        EXPECT_EQ(expire, tw.now());
+        ++count;
+    });
+    EXPECT_EQ(count, sizeof(delays) / sizeof(delays[0]));
+    EXPECT_EQ(tw.now(), start + (1ull << 32) + 10);
+}
+
+TEST(TimerWheelTest, AddAndCancelInCallback) {
+    nostd::timer_wheel<int> tw;
+    nostd::timer_wheel<int>::handle victim;
+    tw.add(1, 1);
+    victim = tw.add(1, 2);
+    std::vector<int> fired;
+    tw.advance(3, [&](int v) {
+        fired.push_back(v);
+        if (v == 1) {
+            tw.cancel(victim);
+            tw.add(1, 3);
+        }
+    });
+    ASSERT_EQ(fired.size(), 2);
+    EXPECT_EQ(fired[0], 1);
+    EXPECT_EQ(fired[1], 3);
+}
+
+TEST(TimerWheelTest, RandomAgainstModel) {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<uint64_t> dist(1, 100000);
+    nostd::timer_wheel<int> tw;
+    std::multimap<uint64_t, int> model;
+    std::vector<nostd::timer_wheel<int>::handle> handles;
+    for (int i = 0; i < 5000; ++i) {
+        uint64_t d = dist(rng);
+        handles.push_back(tw.add(d, i));
+        model.emplace(d, i);
+    }
+    for (int i = 0; i < 5000; i += 7) {
+        EXPECT_TRUE(tw.cancel(handles[i]));
+    }
+    std::map<int, uint64_t> fired;
+    tw.advance(100000, [&](int v) {
+        fired[v] = tw.now();
+    });
+    EXPECT_TRUE(tw.empty());
+    for (const auto &kv : model) {
+        if (kv.second % 7 == 0) {
+            EXPECT_EQ(fired.count(kv.second), 0);
+        } else {
+            EXPECT_EQ(fired[kv.second], kv.first);
+        }
+    }
+}
+
+TEST(TimerWheelTest, ThrowingCallback) {
+    nostd::timer_wheel<int> tw;
+    for (int i = 0; i < 5; ++i) {
+        tw.add(10, i);
+    }
+    tw.add(300, 100);  // 在上层，第256个tick时cascade
+    for (int i = 0; i < 3; ++i) {
+        tw.add(256, 200 + i);
+    }
+    std::vector<int> fired;
+    int throws = 0;
+    auto fn = [&](int v) {
+        fired.push_back(v);
+        if (v == 1 || v == 201) {
+            ++throws;
+            throw std::runtime_error("callback");
+        }
+    };
+    EXPECT_THROW(tw.advance(20, fn), std::runtime_error);
+    EXPECT_EQ(tw.size(), 7u);  // 0和1已经回调
+    EXPECT_EQ(tw.advance(1, fn), 3u);
+    EXPECT_EQ(fired, (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(tw.size(), 4u);
+
+    EXPECT_THROW(tw.advance(1000, fn), std::runtime_error);
+    EXPECT_EQ(tw.size(), 2u);
+    EXPECT_EQ(tw.advance(1000, fn), 2u);
+    EXPECT_EQ(fired, (std::vector<int>{0, 1, 2, 3, 4, 200, 201, 202, 100}));
+    EXPECT_TRUE(tw.empty());
+    EXPECT_EQ(throws, 2);
+}
@@ -0,0 +1,157 @@
+// 只在这个文件里打开埋点；用匿名命名空间里的类型实例化容器，保证用到的是带埋点的实例
+#ifndef EASYSTL_TRACE
+#    define EASYSTL_TRACE 1
+#endif
+
+#include "base/trace.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "algo/algorithm.h"
+#include "container/rope.h"
+#include "container/vector.h"
+
+namespace {
+
+struct traced_int {
+    int v;
+    bool operator<(const traced_int &o) const { return v < o.v; }
+    bool operator>(const traced_int &o) const { return v > o.v; }
+};
+
+struct traced_traits : nostd::char_traits<char> {};
+
+using traced_rope = nostd::basic_rope<char, traced_traits>;
+
+uint64_t count_of(const char *name) { return nostd::trace_registry::instance().snapshot(name).count; }
+
+}  // namespace
+
+TEST(TraceTest, VectorGrowth) {
+    uint64_t before = count_of("vector::realloc");
+    nostd::vector<traced_int> v;  // 默认构造预分配16个元素
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(traced_int{i});
+    }
+    // 16 -> 32 -> 64 -> 128
+    EXPECT_EQ(count_of("vector::realloc") - before, 3u);
+    v.reserve(10);  // 不扩容时不计
+    EXPECT_EQ(count_of("vector::realloc") - before, 3u);
+    nostd::trace_stats st = nostd::trace_registry::instance().snapshot("vector::realloc");
+    EXPECT_EQ(st.kind, nostd::trace_kind::scope);
+    EXPECT_GT(st.total, 0u);
+    EXPECT_GE(st.total, st.max);
+}
+
+TEST(TraceTest, HeapSortAndRope) {
+    std::vector<traced_int> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(traced_int{(i * 7919) % 1000});
+    }
+    uint64_t make = count_of("make_heap"), sort = count_of("sort_heap");
+    nostd::make_heap(v.data(), v.data() + v.size());
+    nostd::sort_heap(v.data(), v.data() + v.size());
+    EXPECT_EQ(count_of("make_heap") - make, 1u);
+    EXPECT_EQ(count_of("sort_heap") - sort, 1u);
+
+    // 内省排序记录递归深度
+    uint64_t sorts = count_of("sort::depth");
+    nostd::sort(v.begin(), v.end(), [](const traced_int &l, const traced_int &r) { return r < l; });
+    EXPECT_EQ(count_of("sort::depth") - sorts, 1u);
+    EXPECT_GT(nostd::trace_registry::instance().snapshot("sort::depth").max, 0u);
+
+    // 逐个追加叶子，树必须旋转才能保持平衡；全局打开埋点时其它测试里的rope也会计入，先清零
+    nostd::trace_registry::instance().reset();
+    traced_rope r;
+    std::string leaf(512, 'x');
+    for (int i = 0; i < 64; ++i) {
+        r.append(leaf.data(), leaf.size());
+    }
+    EXPECT_GT(count_of("rope::rotate"), 0u);
+    nostd::trace_stats depth = nostd::trace_registry::instance().snapshot("rope::join_depth");
+    EXPECT_EQ(depth.kind, nostd::trace_kind::value);
+    EXPECT_GT(depth.count, 0u);
+    EXPECT_LE(depth.max, static_cast<uint64_t>(r.height()));
+}
+
+TEST(TraceTest, Macros) {
+    for (int i = 1; i <= 4; ++i) {
+        EASYSTL_TRACE_SCOPE("test::scope");
+        EASYSTL_TRACE_COUNT("test::counter", i);
+        EASYSTL_TRACE_VALUE("test::value", i * 10);
+    }
+    nostd::trace_registry &reg = nostd::trace_registry::instance();
+    EXPECT_EQ(reg.snapshot("test::scope").count, 4u);
+    nostd::trace_stats c = reg.snapshot("test::counter");
+    EXPECT_EQ(c.count, 4u);
+    EXPECT_EQ(c.total, 10u);
+    EXPECT_EQ(c.max, 4u);
+    nostd::trace_stats v = reg.snapshot("test::value");
+    EXPECT_EQ(v.total, 100u);
+    EXPECT_EQ(v.max, 40u);
+    EXPECT_EQ(reg.snapshot("test::missing").count, 0u);
+
+    // 不同线程里同名的埋点合并
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) {
+                EASYSTL_TRACE_COUNT("test::threads", 1);
+            }
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(reg.snapshot("test::threads").total, 4000u);
+}
+
+TEST(TraceTest, ChromeTrace) {
+    nostd::trace_registry &reg = nostd::trace_registry::instance();
+    reg.reset();
+    EXPECT_EQ(reg.snapshot("test::scope").count, 0u);
+
+    // 没有录制时只计数
+    {
+        EASYSTL_TRACE_SCOPE("test::scope");
+    }
+    EXPECT_EQ(reg.event_count(), 0u);
+
+    reg.start();
+    EXPECT_TRUE(reg.recording());
+    {
+        EASYSTL_TRACE_SCOPE("test::scope");
+        EASYSTL_TRACE_VALUE("test::value", 7);
+    }
+    std::thread([] { EASYSTL_TRACE_SCOPE("test::thread_scope"); }).join();  // 线程退出后事件仍然保留
+    reg.stop();
+    EXPECT_EQ(reg.event_count(), 3u);
+    EXPECT_EQ(reg.dropped(), 0u);
+    EXPECT_EQ(reg.snapshot("test::scope").count, 2u);
+
+    char buf[1 << 14] = {};
+    std::FILE *f = fmemopen(buf, sizeof(buf) - 1, "w");
+    reg.write_chrome_trace(f);
+    std::fclose(f);
+    EXPECT_EQ(std::strncmp(buf, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 39), 0);
+    EXPECT_NE(std::strstr(buf, "\"name\":\"test::scope\",\"cat\":\"easystl\",\"ph\":\"X\""), nullptr);
+    EXPECT_NE(std::strstr(buf, "\"name\":\"test::thread_scope\""), nullptr);
+    EXPECT_NE(std::strstr(buf, "\"ph\":\"C\""), nullptr);
+    EXPECT_NE(std::strstr(buf, "\"args\":{\"value\":7}"), nullptr);
+    EXPECT_NE(std::strstr(buf, "\"otherData\":{"), nullptr);
+    EXPECT_NE(std::strstr(buf, "\"test::scope\":\"count=2 "), nullptr);
+
+    f = fmemopen(buf, sizeof(buf) - 1, "w");
+    reg.dump(f);
+    std::fclose(f);
+    EXPECT_NE(std::strstr(buf, "test::value"), nullptr);
+
+    reg.reset();
+    EXPECT_EQ(reg.event_count(), 0u);
+}
@@ -0,0 +1,142 @@
+#include "base/tracking_allocator.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "container/string.h"
+#include "container/vector.h"
+
+namespace {
+
+EASYSTL_ALLOC_SITE(vector_site);
+EASYSTL_ALLOC_SITE(string_site);
+EASYSTL_ALLOC_SITE(thread_site);
+EASYSTL_ALLOC_SITE(reset_site);
+
+}  // namespace
+
+TEST(TrackingAllocatorTest, VectorGrowth) {
+    using alloc = nostd::tracking_allocator<int, nostd::allocator<int>, vector_site>;
+    {
+        nostd::vector<int, alloc> v;  // 默认构造预分配16个元素
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(i);
+        }
+        nostd::alloc_stats st = alloc::stats();
+        // 16 -> 32 -> 64 -> 128
+        EXPECT_EQ(st.allocations, 4u);
+        EXPECT_EQ(st.deallocations, 3u);
+        EXPECT_EQ(st.reallocations, 3u);
+        EXPECT_EQ(st.bytes_allocated, (16u + 32u + 64u + 128u) * sizeof(int));
+        EXPECT_EQ(st.live_bytes, static_cast<int64_t>(128 * sizeof(int)));
+        EXPECT_EQ(st.peak_live_bytes, (64u + 128u) * sizeof(int));
+        EXPECT_EQ(st.histogram[nostd::alloc_stats::bucket_of(16 * sizeof(int))], 1u);
+        EXPECT_EQ(st.histogram[nostd::alloc_stats::bucket_of(128 * sizeof(int))], 1u);
+    }
+    nostd::alloc_stats st = alloc::stats();
+    EXPECT_EQ(st.deallocations, 4u);
+    EXPECT_EQ(st.live_bytes, 0);
+    EXPECT_STREQ(alloc::site().name(), "vector_site");
+    EXPECT_STREQ(alloc::site().type_name(), "int");
+
+    // reserve到位之后不再扩容
+    {
+        nostd::vector<int, alloc> v;
+        v.reserve(1000);
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+        }
+    }
+    EXPECT_EQ(alloc::stats().reallocations, 4u);
+}
+
+TEST(TrackingAllocatorTest, StringGrowth) {
+    using alloc = nostd::tracking_allocator<char, nostd::allocator<char>, string_site>;
+    using tracked_string = nostd::basic_string<char, nostd::char_traits<char>, alloc>;
+    {
+        tracked_string s;
+        for (int i = 0; i < 1000; ++i) {
+            s.push_back('x');
+        }
+        EXPECT_EQ(s.size(), 1000u);
+        nostd::alloc_stats st = alloc::stats();
+        EXPECT_GT(st.allocations, 1u);
+        EXPECT_EQ(st.reallocations, st.allocations - 1);
+        EXPECT_EQ(st.live_bytes, static_cast<int64_t>(s.capacity() + 1));
+    }
+    EXPECT_EQ(alloc::stats().live_bytes, 0);
+}
+
+TEST(TrackingAllocatorTest, Threads) {
+    using alloc = nostd::tracking_allocator<double, nostd::allocator<double>, thread_site>;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) {
+                double *p = alloc::allocate(8);
+                alloc::deallocate(p, 8);
+            }
+        });
+    }
+    // 线程运行期间也可以读统计
+    nostd::alloc_stats running = alloc::stats();
+    EXPECT_LE(running.allocations, 4000u);
+    for (std::thread &t : threads) {
+        t.join();
+    }
+    nostd::alloc_stats st = alloc::stats();
+    EXPECT_EQ(st.allocations, 4000u);
+    EXPECT_EQ(st.deallocations, 4000u);
+    EXPECT_EQ(st.bytes_allocated, 4000u * 8 * sizeof(double));
+    EXPECT_EQ(st.live_bytes, 0);
+    EXPECT_GE(st.peak_live_bytes, 8 * sizeof(double));
+    EXPECT_LE(st.peak_live_bytes, 4 * 8 * sizeof(double));
+}
+
+TEST(TrackingAllocatorTest, ResetAndDump) {
+    using alloc = nostd::tracking_allocator<int, nostd::allocator<int>, reset_site>;
+    int *keep = alloc::allocate(10);
+    int *tmp = alloc::allocate(100);
+    alloc::deallocate(tmp, 100);
+    nostd::alloc_registry::instance().reset();
+    nostd::alloc_stats st = alloc::stats();
+    EXPECT_EQ(st.allocations, 0u);
+    EXPECT_EQ(st.live_bytes, static_cast<int64_t>(10 * sizeof(int)));
+    EXPECT_EQ(st.peak_live_bytes, 10 * sizeof(int));
+
+    int *p = alloc::allocate(3);
+    EXPECT_EQ(alloc::stats().allocations, 1u);
+    EXPECT_EQ(alloc::stats().histogram[nostd::alloc_stats::bucket_of(12)], 1u);
+
+    bool found = false;
+    nostd::alloc_registry::instance().for_each([&found](const nostd::alloc_site &s, const nostd::alloc_stats &) {
+        found = found || std::strcmp(s.name(), "reset_site") == 0;
+    });
+    EXPECT_TRUE(found);
+
+    char buf[1 << 14] = {};
+    std::FILE *f = fmemopen(buf, sizeof(buf) - 1, "w");
+    nostd::alloc_registry::instance().dump(f);
+    std::fclose(f);
+    EXPECT_NE(std::strstr(buf, "reset_site"), nullptr);
+    EXPECT_NE(std::strstr(buf, "<=16:1"), nullptr);
+
+    alloc::deallocate(p, 3);
+    alloc::deallocate(keep, 10);
+}
+
+TEST(TrackingAllocatorTest, BucketOf) {
+    EXPECT_EQ(nostd::alloc_stats::bucket_of(0), 0u);
+    EXPECT_EQ(nostd::alloc_stats::bucket_of(1), 0u);
+    EXPECT_EQ(nostd::alloc_stats::bucket_of(2), 1u);
+    EXPECT_EQ(nostd::alloc_stats::bucket_of(3), 2u);
+    EXPECT_EQ(nostd::alloc_stats::bucket_of(4), 2u);
+    EXPECT_EQ(nostd::alloc_stats::bucket_of(4096), 12u);
+    EXPECT_EQ(nostd::alloc_stats::bucket_of(4097), 13u);
+    EXPECT_EQ(nostd::alloc_stats::bucket_of(size_t(1) << 40), nostd::alloc_stats::kBuckets - 1);
+}
@@ -0,0 +1,273 @@
+#include "base/utf.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "container/string.h"
+
+namespace {
+
+// 参考实现：逐字节按Unicode标准表3-7检查
+bool reference_valid(const std::string &s) {
+    size_t i = 0, n = s.size();
+    while (i < n) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        size_t len;
+        unsigned char lo = 0x80, hi = 0xBF;
+        if (c < 0x80) {
+            ++i;
+            continue;
+        } else if (c >= 0xC2 && c <= 0xDF) {
+            len = 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            len = 3;
+            lo = c == 0xE0 ? 0xA0 : 0x80;
+            hi = c == 0xED ? 0x9F : 0xBF;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            len = 4;
+            lo = c == 0xF0 ? 0x90 : 0x80;
+            hi = c == 0xF4 ? 0x8F : 0xBF;
+        } else {
+            return false;
+        }
+        if (i + len > n) {
+            return false;
+        }
+        for (size_t k = 1; k < len; ++k) {
+            unsigned char d = static_cast<unsigned char>(s[i + k]);
+            if (d < (k == 1 ? lo : 0x80) || d > (k == 1 ? hi : 0xBF)) {
+                return false;
+            }
+        }
+        i += len;
+    }
+    return true;
+}
+
+char32_t random_code_point(std::mt19937 &rng) {
+    switch (rng() % 4) {
+        case 0:
+            return rng() % 0x80;
+        case 1:
+            return 0x80 + rng() % (0x800 - 0x80);
+        case 2: {
+            char32_t c = 0x800 + rng() % (0x10000 - 0x800);
+            return c >= 0xD800 && c <= 0xDFFF ? c - 0x800 : c;
+        }
+        default:
+            return 0x10000 + rng() % (0x110000 - 0x10000);
+    }
+}
+
+std::u32string random_text(std::mt19937 &rng, size_t n, bool mostly_ascii) {
+    std::u32string s;
+    for (size_t i = 0; i < n; ++i) {
+        s.push_back(mostly_ascii && rng() % 16 != 0 ? static_cast<char32_t>('a' + rng() % 26) : random_code_point(rng));
+    }
+    return s;
+}
+
+std::string encode(const std::u32string &s) {
+    std::string out(s.size() * 4, '\0');
+    out.resize(nostd::convert_valid_utf32_to_utf8(s.data(), s.size(), &out[0]));
+    return out;
+}
+
+}  // namespace
+
+TEST(UtfTest, ValidateKnownCases) {
+    EXPECT_TRUE(nostd::validate_utf8("", 0));
+    std::string ok = "hello, \xe4\xb8\x96\xe7\x95\x8c \xf0\x9f\x98\x80";
+    EXPECT_TRUE(nostd::validate_utf8(ok.data(), ok.size()));
+
+    struct bad_case {
+        const char *s;
+        nostd::utf_error error;
+        size_t pos;
+    } bad[] = {
+        {"ab\x80", nostd::utf_error::too_long, 2},
+        {"ab\xc3", nostd::utf_error::too_short, 2},
+        {"\xc3(", nostd::utf_error::too_short, 0},
+        {"\xc0\xaf", nostd::utf_error::overlong, 0},
+        {"\xe0\x80\xaf", nostd::utf_error::overlong, 0},
+        {"x\xed\xa0\x80", nostd::utf_error::surrogate, 1},
+        {"\xf4\x90\x80\x80", nostd::utf_error::too_large, 0},
+        {"\xf8\x88\x80\x80\x80", nostd::utf_error::header_bits, 0},
+    };
+    for (const bad_case &c : bad) {
+        size_t n = std::strlen(c.s);
+        EXPECT_FALSE(nostd::validate_utf8(c.s, n)) << c.s;
+        nostd::utf_result r = nostd::validate_utf8_with_errors(c.s, n);
+        EXPECT_EQ(r.error, c.error) << c.s;
+        EXPECT_EQ(r.count, c.pos) << c.s;
+    }
+
+    // 错误出现在长串中间，跨过向量块的边界
+    std::string long_text(100, 'a');
+    long_text[63] = '\xe4';
+    nostd::utf_result r = nostd::validate_utf8_with_errors(long_text.data(), long_text.size());
+    EXPECT_EQ(r.error, nostd::utf_error::too_short);
+    EXPECT_EQ(r.count, 63);
+}
+
+TEST(UtfTest, ValidateMatchesReference) {
+    std::mt19937 rng(1);
+    for (int round = 0; round < 3000; ++round) {
+        std::string s = encode(random_text(rng, rng() % 80, round % 2 == 0));
+        ASSERT_TRUE(nostd::validate_utf8(s.data(), s.size()));
+        // 随机改坏几个字节
+        int edits = static_cast<int>(rng() % 3);
+        for (int k = 0; k < edits && !s.empty(); ++k) {
+            s[rng() % s.size()] = static_cast<char>(rng() % 256);
+        }
+        bool expect = reference_valid(s);
+        ASSERT_EQ(nostd::validate_utf8(s.data(), s.size()), expect);
+        nostd::utf_result r = nostd::validate_utf8_with_errors(s.data(), s.size());
+        ASSERT_EQ(r.error == nostd::utf_error::ok, expect);
+        if (!expect) {
+            // 出错位置之前的部分是合法的
+            ASSERT_LT(r.count, s.size());
+            ASSERT_TRUE(reference_valid(s.substr(0, r.count)));
+        }
+    }
+    // 所有2字节和3字节序列
+    for (unsigned a = 0x80; a < 0x100; ++a) {
+        for (unsigned b = 0; b < 0x100; ++b) {
+            std::string s = std::string(30, 'x') + static_cast<char>(a) + static_cast<char>(b) + "\x80";
+            ASSERT_EQ(nostd::validate_utf8(s.data(), s.size()), reference_valid(s));
+            s.pop_back();
+            ASSERT_EQ(nostd::validate_utf8(s.data(), s.size()), reference_valid(s));
+        }
+    }
+}
+
+TEST(UtfTest, RoundTrip) {
+    std::mt19937 rng(2);
+    for (int round = 0; round < 500; ++round) {
+        std::u32string text = random_text(rng, rng() % 200, round % 2 == 0);
+        std::string u8 = encode(text);
+
+        std::u16string u16(nostd::utf16_length_from_utf8(u8.data(), u8.size()), u'\0');
+        nostd::utf_result r = nostd::convert_utf8_to_utf16(u8.data(), u8.size(), &u16[0]);
+        ASSERT_EQ(r.error, nostd::utf_error::ok);
+        ASSERT_EQ(r.count, u16.size());
+        ASSERT_TRUE(nostd::validate_utf16(u16.data(), u16.size()));
+
+        std::u32string u32(nostd::utf32_length_from_utf8(u8.data(), u8.size()), U'\0');
+        r = nostd::convert_utf8_to_utf32(u8.data(), u8.size(), &u32[0]);
+        ASSERT_EQ(r.count, u32.size());
+        ASSERT_EQ(u32, text);
+
+        std::u32string from16(nostd::utf32_length_from_utf16(u16.data(), u16.size()), U'\0');
+        r = nostd::convert_utf16_to_utf32(u16.data(), u16.size(), &from16[0]);
+        ASSERT_EQ(r.count, from16.size());
+        ASSERT_EQ(from16, text);
+
+        std::u16string to16(nostd::utf16_length_from_utf32(text.data(), text.size()), u'\0');
+        r = nostd::convert_utf32_to_utf16(text.data(), text.size(), &to16[0]);
+        ASSERT_EQ(r.count, to16.size());
+        ASSERT_EQ(to16, u16);
+
+        std::string back(nostd::utf8_length_from_utf16(u16.data(), u16.size()), '\0');
+        r = nostd::convert_utf16_to_utf8(u16.data(), u16.size(), &back[0]);
+        ASSERT_EQ(r.count, back.size());
+        ASSERT_EQ(back, u8);
+        ASSERT_EQ(nostd::utf8_length_from_utf32(text.data(), text.size()), u8.size());
+    }
+}
+
+TEST(UtfTest, InvalidUtf16AndUtf32) {
+    const char16_t lone_high[] = {u'a', 0xD800, u'b'};
+    nostd::utf_result r = nostd::validate_utf16_with_errors(lone_high, 3);
+    EXPECT_EQ(r.error, nostd::utf_error::surrogate);
+    EXPECT_EQ(r.count, 1);
+    const char16_t lone_low[] = {u'a', u'b', u'c', u'd', u'e', u'f', u'g', u'h', 0xDC00};
+    EXPECT_FALSE(nostd::validate_utf16(lone_low, 9));
+    EXPECT_FALSE(nostd::validate_utf16(lone_high, 2));
+
+    const char32_t bad32[] = {U'a', U'b', U'c', U'd', 0x110000};
+    r = nostd::validate_utf32_with_errors(bad32, 5);
+    EXPECT_EQ(r.error, nostd::utf_error::too_large);
+    EXPECT_EQ(r.count, 4);
+    const char32_t sur32[] = {U'a', 0xDFFF};
+    EXPECT_EQ(nostd::validate_utf32_with_errors(sur32, 2).error, nostd::utf_error::surrogate);
+}
+
+TEST(UtfTest, StringConversion) {
+    nostd::string s("caf\xc3\xa9 \xf0\x9f\x8d\xb5");
+    nostd::u16string u16 = nostd::to_utf16(s);
+    EXPECT_EQ(u16.size(), 7);
+    EXPECT_EQ(u16[3], u'é');
+    EXPECT_EQ(u16[5], 0xD83C);
+    nostd::u32string u32 = nostd::to_utf32(s);
+    EXPECT_EQ(u32.size(), 6);
+    EXPECT_EQ(u32[5], U'\U0001F375');
+    EXPECT_EQ(nostd::to_utf8(u16), s);
+    EXPECT_EQ(nostd::to_utf8(u32), s);
+    EXPECT_EQ(nostd::to_utf32(u16), u32);
+    EXPECT_EQ(nostd::to_utf16(u32), u16);
+    EXPECT_TRUE(nostd::to_utf16("").empty());
+    EXPECT_THROW(nostd::to_utf16("\xff"), std::invalid_argument);
+    EXPECT_THROW(nostd::to_utf8(nostd::u16string_view(u16.data(), 6)), std::invalid_argument);
+}
+
+TEST(UtfTest, StreamAcrossChunks) {
+    std::mt19937 rng(3);
+    std::u32string text = random_text(rng, 300, false);
+    std::string u8 = encode(text);
+    std::u16string u16(nostd::utf16_length_from_utf8(u8.data(), u8.size()), u'\0');
+    nostd::convert_valid_utf8_to_utf16(u8.data(), u8.size(), &u16[0]);
+
+    for (int round = 0; round < 200; ++round) {
+        nostd::utf8_stream_validator validator;
+        nostd::utf8_stream_converter<char32_t> to32;
+        nostd::utf16_stream_converter to8;
+        std::u32string got32;
+        std::string got8;
+        size_t i = 0, j = 0;
+        while (i < u8.size() || j < u16.size()) {
+            size_t n = std::min<size_t>(rng() % 7, u8.size() - i);
+            ASSERT_TRUE(validator.feed(u8.data() + i, n));
+            std::vector<char32_t> out(decltype(to32)::max_output(n));
+            nostd::utf_result r = to32.convert(u8.data() + i, n, out.data());
+            ASSERT_EQ(r.error, nostd::utf_error::ok);
+            got32.append(out.data(), r.count);
+            i += n;
+
+            size_t m = std::min<size_t>(rng() % 5, u16.size() - j);
+            std::vector<char> out8(nostd::utf16_stream_converter::max_output(m));
+            r = to8.convert(u16.data() + j, m, out8.data());
+            ASSERT_EQ(r.error, nostd::utf_error::ok);
+            got8.append(out8.data(), r.count);
+            j += m;
+        }
+        EXPECT_TRUE(validator.finish());
+        EXPECT_EQ(to32.finish().error, nostd::utf_error::ok);
+        EXPECT_EQ(to8.finish().error, nostd::utf_error::ok);
+        EXPECT_EQ(got32, text);
+        EXPECT_EQ(got8, u8);
+    }
+
+    // 截断在多字节序列中间
+    nostd::utf8_stream_validator validator;
+    EXPECT_TRUE(validator.feed("a\xe4\xb8", 3));
+    EXPECT_FALSE(validator.finish());
+    EXPECT_TRUE(validator.feed("\x96", 1));
+    EXPECT_TRUE(validator.finish());
+    // 跨段的非法序列
+    EXPECT_TRUE(validator.feed("\xed", 1));
+    EXPECT_FALSE(validator.feed("\xa0\x80", 2));
+    EXPECT_FALSE(validator.finish());
+
+    nostd::utf16_stream_converter to8;
+    char buf[8];
+    const char16_t high = 0xD83D;
+    EXPECT_EQ(to8.convert(&high, 1, buf).count, 0);
+    EXPECT_EQ(to8.finish().error, nostd::utf_error::surrogate);
+    EXPECT_EQ(to8.convert(u"x", 1, buf).error, nostd::utf_error::surrogate);
+}
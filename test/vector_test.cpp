@@ -2,8 +2,18 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "base/tracking_allocator.h"
+
 using namespace nostd;
 
 TEST(VectorTest, DefaultConstructor) {
@@ -26,4 +36,286 @@ TEST(VectorTest, DefaultConstructor) {
 
     nostd::vector<int> nostdv4(nostdv3, nostdv3.get_allocator());
     EXPECT_EQ(nostdv4, nostdv3);
-}
\ No newline at end of file
+}
+TEST(VectorTest, ResizeDefaultInit) {
+    nostd::vector<int> v(4, 7);
+    v.resize_default_init(10);
+    EXPECT_EQ(v.size(), 10);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(v[i], 7);
+    }
+    for (int i = 0; i < 10; ++i) {
+        v[i] = i;
+    }
+    v.resize_default_init(3);
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_EQ(v[2], 2);
+
+    nostd::vector<unsigned char> buf(64, nostd::default_init);
+    EXPECT_EQ(buf.size(), 64);
+
+    // 非平凡类型仍然调用默认构造
+    nostd::vector<std::vector<int>> nested(3, nostd::default_init);
+    nested.resize_default_init(5);
+    EXPECT_EQ(nested.size(), 5);
+    EXPECT_TRUE(nested[4].empty());
+}
+
+TEST(VectorTest, MoveSemantics) {
+    nostd::vector<std::string> a(100, "hello");
+    const std::string *p = a.data();
+    nostd::vector<std::string> b(std::move(a));
+    EXPECT_EQ(b.data(), p);  // 直接接管空间，不复制元素
+    EXPECT_EQ(b.size(), 100u);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(a.capacity(), 0u);
+
+    a.push_back("again");  // 被移走的vector仍然可用
+    EXPECT_EQ(a.size(), 1u);
+
+    nostd::vector<std::string> c;
+    c = std::move(b);
+    EXPECT_EQ(c.data(), p);
+    EXPECT_EQ(c[99], "hello");
+    EXPECT_TRUE(b.empty());
+
+    auto make = [] {
+        nostd::vector<int> v{1, 2, 3};
+        return v;
+    };
+    nostd::vector<int> d = make();
+    EXPECT_EQ(d, (std::vector<int>{1, 2, 3}));
+
+    // 只能移动的元素
+    nostd::vector<std::unique_ptr<int>> u(3);
+    EXPECT_EQ(u.size(), 3u);
+    EXPECT_EQ(u[0], nullptr);
+    u[1].reset(new int(5));
+    u.resize(6);
+    EXPECT_EQ(*u[1], 5);
+    EXPECT_EQ(u[5], nullptr);
+}
+
+TEST(VectorTest, AssignAndInitializerList) {
+    nostd::vector<int> v{1, 2, 3, 4};
+    EXPECT_EQ(v, (std::vector<int>{1, 2, 3, 4}));
+    v = {5, 6};
+    EXPECT_EQ(v, (std::vector<int>{5, 6}));
+    v.assign(3, 9);
+    EXPECT_EQ(v, (std::vector<int>{9, 9, 9}));
+    v.assign(100, 1);
+    EXPECT_EQ(v.size(), 100u);
+    v.assign({7, 8});
+    EXPECT_EQ(v, (std::vector<int>{7, 8}));
+
+    nostd::vector<std::string> s{"a", "b", "c"};
+    nostd::vector<std::string> t{"x"};
+    t = s;
+    EXPECT_EQ(t, (std::vector<std::string>{"a", "b", "c"}));
+    t = t;
+    EXPECT_EQ(t.size(), 3u);
+    std::vector<std::string> big(50, "long string that does not fit in sso");
+    t.assign(big.data(), big.data() + big.size());
+    EXPECT_EQ(t, big);
+    t.assign(big.data(), big.data() + 2);
+    EXPECT_EQ(t.size(), 2u);
+}
+
+// 随机的插入/删除，和std::vector对照
+template <class T, class Gen>
+void check_insert_erase(Gen gen) {
+    nostd::vector<T> v;
+    std::vector<T> ref;
+    unsigned seed = 12345;
+    auto next = [&seed](unsigned n) {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 8) % n;
+    };
+    for (int round = 0; round < 2000; ++round) {
+        size_t pos = next(static_cast<unsigned>(ref.size() + 1));
+        switch (next(6)) {
+            case 0: {
+                T x = gen(round);
+                v.insert(v.begin() + pos, x);
+                ref.insert(ref.begin() + pos, x);
+                break;
+            }
+            case 1: {
+                size_t n = next(5);
+                T x = gen(round);
+                v.insert(v.begin() + pos, n, x);
+                ref.insert(ref.begin() + pos, n, x);
+                break;
+            }
+            case 2: {
+                std::vector<T> src;
+                for (size_t i = next(8); i > 0; --i) {
+                    src.push_back(gen(round + static_cast<int>(i)));
+                }
+                v.insert(v.begin() + pos, src.data(), src.data() + src.size());
+                ref.insert(ref.begin() + pos, src.begin(), src.end());
+                break;
+            }
+            case 3:
+                v.emplace(v.begin() + pos, gen(round));
+                ref.emplace(ref.begin() + pos, gen(round));
+                break;
+            case 4:
+                if (pos < ref.size()) {
+                    EXPECT_EQ(v.erase(v.begin() + pos) - v.begin(), static_cast<ptrdiff_t>(pos));
+                    ref.erase(ref.begin() + pos);
+                }
+                break;
+            default: {
+                size_t n = std::min<size_t>(next(4), ref.size() - pos);
+                v.erase(v.begin() + pos, v.begin() + pos + n);
+                ref.erase(ref.begin() + pos, ref.begin() + pos + n);
+                break;
+            }
+        }
+        ASSERT_EQ(v, ref);
+    }
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(VectorTest, InsertErase) {
+    check_insert_erase<int>([](int i) { return i; });
+    check_insert_erase<std::string>([](int i) { return std::string(static_cast<size_t>(i % 40), 'a' + i % 26); });
+    // 可平凡搬移的非平凡类型
+    check_insert_erase<nostd::vector<int>>([](int i) { return nostd::vector<int>(static_cast<size_t>(i % 5), i); });
+
+    nostd::vector<int> v{1, 2, 3};
+    EXPECT_EQ(*v.insert(v.begin() + 1, {7, 8}), 7);
+    EXPECT_EQ(v, (std::vector<int>{1, 7, 8, 2, 3}));
+    EXPECT_EQ(v.erase(v.begin(), v.begin()) - v.begin(), 0);
+    nostd::vector<int>::iterator it = v.erase(v.begin() + 3, v.end());
+    EXPECT_EQ(it, v.end());
+    EXPECT_EQ(v, (std::vector<int>{1, 7, 8}));
+}
+
+TEST(VectorTest, EmplaceAndAliasing) {
+    nostd::vector<std::pair<int, std::string>> p;
+    p.emplace_back(1, "one");
+    p.emplace(p.begin(), 0, "zero");
+    EXPECT_EQ(p[0].second, "zero");
+    EXPECT_EQ(p[1].first, 1);
+
+    // 参数引用自己的元素：扩容、挪动时都要先取到值
+    nostd::vector<std::string> s;
+    s.reserve(4);
+    s.push_back(std::string(40, 'x'));
+    while (s.size() < s.capacity()) {
+        s.push_back(s[0]);
+    }
+    s.push_back(s[0]);
+    EXPECT_EQ(s.back(), std::string(40, 'x'));
+    s.insert(s.begin(), s.back());
+    s.insert(s.begin(), 3, s[2]);
+    s.emplace(s.begin() + 1, s[3]);
+    for (const std::string &x : s) {
+        EXPECT_EQ(x, std::string(40, 'x'));
+    }
+    nostd::vector<int> v{1, 2, 3};
+    v.resize(v.capacity() + 1, v[1]);
+    EXPECT_EQ(v.back(), 2);
+}
+
+namespace {
+
+// 第kLimit次复制时抛异常
+struct throwing {
+    static int copies;
+    static int kLimit;
+    std::string value;
+    explicit throwing(std::string v) : value(std::move(v)) {}
+    throwing(const throwing &o) : value(o.value) {
+        if (++copies == kLimit) {
+            throw std::runtime_error("copy");
+        }
+    }
+    throwing(throwing &&o) noexcept : value(std::move(o.value)) {}
+    throwing &operator=(const throwing &o) = default;
+    throwing &operator=(throwing &&o) noexcept = default;
+};
+int throwing::copies = 0;
+int throwing::kLimit = 0;
+
+}  // namespace
+
+TEST(VectorTest, InsertExceptionSafety) {
+    std::vector<throwing> src;
+    for (int i = 0; i < 4; ++i) {
+        src.emplace_back(std::to_string(i));
+    }
+    nostd::vector<throwing> v;
+    const size_t cap = v.capacity();
+    for (int i = 0; i < 5; ++i) {
+        v.emplace_back(std::string(30, 'a' + i));
+    }
+    // 容量够：尾部挪开后构造失败，挪回原处
+    throwing::copies = 0;
+    throwing::kLimit = 3;
+    EXPECT_THROW(v.insert(v.begin() + 2, src.data(), src.data() + src.size()), std::runtime_error);
+    // 容量不够：新空间整体回滚
+    throwing::copies = 0;
+    EXPECT_THROW(v.insert(v.begin() + 1, cap, src[0]), std::runtime_error);
+    EXPECT_EQ(v.size(), 5u);
+    EXPECT_EQ(v.capacity(), cap);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(v[i].value, std::string(30, 'a' + i));
+    }
+    throwing::kLimit = 0;
+}
+
+namespace {
+
+EASYSTL_ALLOC_SITE(append_range_site);
+
+}  // namespace
+
+TEST(VectorTest, AppendInsertRange) {
+    // 前向迭代器：量一次长度，只分配一次
+    using alloc = nostd::tracking_allocator<int, nostd::allocator<int>, append_range_site>;
+    std::list<int> src;
+    for (int i = 0; i < 10000; ++i) {
+        src.push_back(i);
+    }
+    nostd::vector<int, alloc> v(src.begin(), src.end());
+    EXPECT_EQ(alloc::stats().allocations, 1u);
+    EXPECT_EQ(v.capacity(), 10000u);
+    v.append_range(src);
+    EXPECT_EQ(alloc::stats().allocations, 2u);
+    EXPECT_EQ(v.size(), 20000u);
+    EXPECT_EQ(v[10000], 0);
+    EXPECT_EQ(v.back(), 9999);
+
+    // std容器的迭代器
+    std::vector<int> stdv{1, 2, 3};
+    nostd::vector<int> w(stdv.begin(), stdv.end());
+    w.append_range(stdv.begin(), stdv.end());
+    w.append_range(w);  // 追加自身
+    EXPECT_EQ(w, (std::vector<int>{1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3}));
+    nostd::vector<int>::iterator it = w.insert_range(w.begin() + 1, std::list<int>{7, 8});
+    EXPECT_EQ(it - w.begin(), 1);
+    EXPECT_EQ(w[1], 7);
+    EXPECT_EQ(w[2], 8);
+    EXPECT_EQ(w[3], 2);
+
+    // 单趟的输入迭代器
+    std::istringstream in("5 6 7 8 9");
+    nostd::vector<int> r{1, 2};
+    r.insert_range(r.begin() + 1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+    EXPECT_EQ(r, (std::vector<int>{1, 5, 6, 7, 8, 9, 2}));
+    std::istringstream in2("1 2 3");
+    nostd::vector<int> e(std::istream_iterator<int>(in2), (std::istream_iterator<int>()));
+    EXPECT_EQ(e, (std::vector<int>{1, 2, 3}));
+    std::istringstream in3("4 5");
+    e.assign(std::istream_iterator<int>(in3), std::istream_iterator<int>());
+    EXPECT_EQ(e, (std::vector<int>{4, 5}));
+
+    nostd::vector<std::string> strs;
+    strs.append_range(std::vector<std::string>(3, "abc"));
+    strs.insert_range(strs.begin(), std::list<std::string>{"x"});
+    EXPECT_EQ(strs, (std::vector<std::string>{"x", "abc", "abc", "abc"}));
+}